@@ -100,6 +100,9 @@ FILES="
    pngwtran.c
    pngwutil.c
 
+   intel/filter_sse2_intrinsics.c
+   intel/intel_init.c
+
    png.h
    pngpriv.h
    pngstruct.h
@@ -28,6 +28,13 @@ SOURCES += \
     pngwtran.c \
     pngwutil.c
 
+qtConfig(sse2) {
+    DEFINES += PNG_INTEL_SSE
+    SOURCES += \
+        intel/filter_sse2_intrinsics.c \
+        intel/intel_init.c
+}
+
 TR_EXCLUDE += $$PWD/*
 
 include(../zlib_dependency.pri)
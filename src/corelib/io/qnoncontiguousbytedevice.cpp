@@ -345,15 +345,14 @@ bool QNonContiguousByteDeviceIoDeviceImpl::advanceReadPointer(qint64 amount)
     else
         emit readProgress(totalAdvancements, size());
 
-    // advancing over that what has actually been read before
+    // advancing over that what has actually been read before, for instance
+    // because the data was sent straight from the file the device reads
     if (currentReadBufferPosition > currentReadBufferAmount) {
-        qint64 i = currentReadBufferPosition - currentReadBufferAmount;
-        while (i > 0) {
-            if (device->getChar(nullptr) == false) {
-                emit readProgress(totalAdvancements - i, size());
-                return false; // ### FIXME handle eof
-            }
-            i--;
+        const qint64 i = currentReadBufferPosition - currentReadBufferAmount;
+        const qint64 skipped = device->skip(i);
+        if (skipped < i) {
+            emit readProgress(totalAdvancements - (i - qMax(skipped, qint64(0))), size());
+            return false; // ### FIXME handle eof
         }
 
         currentReadBufferPosition = 0;
@@ -46,8 +46,14 @@
 #include <qstringlist.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
+#include <qatomic.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <iterator>
 
 QT_BEGIN_NAMESPACE
 
@@ -113,6 +119,72 @@ private:
 };
 
 
+namespace {
+// Item counts below which the parallel sort/filter mode stays on the
+// calling thread, and the amount of work handed to a pool thread at a time.
+enum {
+    ParallelSortFilterThreshold = 4096,
+    ParallelSortFilterChunkSize = 1024
+};
+
+/*
+    Calls \a function(begin, end) for consecutive ranges of at most
+    \a chunkSize items that together cover [0, count). Idle threads of the
+    global thread pool pick up chunks alongside the calling thread, which
+    also does the work if no pool thread is free, so this never waits for
+    the pool to drain. Returns once every chunk has been processed.
+*/
+template <typename Function>
+void parallelForChunks(int count, int chunkSize, const Function &function)
+{
+    const int chunkCount = (count + chunkSize - 1) / chunkSize;
+    QAtomicInt nextChunk = 0;
+    const auto work = [&]() {
+        for (int chunk = nextChunk.fetchAndAddRelaxed(1); chunk < chunkCount;
+             chunk = nextChunk.fetchAndAddRelaxed(1)) {
+            const int begin = chunk * chunkSize;
+            function(begin, qMin(begin + chunkSize, count));
+        }
+    };
+#if QT_CONFIG(thread)
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore finished;
+    const int wantedHelpers = qMin(chunkCount, pool->maxThreadCount()) - 1;
+    int helpers = 0;
+    while (helpers < wantedHelpers && pool->tryStart([&]() { work(); finished.release(); }))
+        ++helpers;
+    work();
+    finished.acquire(helpers);
+#else
+    work();
+#endif
+}
+
+/*
+    Stable sort of \a items: runs of ParallelSortFilterChunkSize items are
+    sorted in parallel and then merged pairwise, each level of merges again
+    running in parallel.
+*/
+template <typename LessThan>
+void parallelStableSort(QList<int> &items, const LessThan &lessThan)
+{
+    const int count = items.size();
+    int *data = items.data();
+    parallelForChunks(count, ParallelSortFilterChunkSize, [&](int begin, int end) {
+        std::stable_sort(data + begin, data + end, lessThan);
+    });
+    for (int width = ParallelSortFilterChunkSize; width < count; width *= 2) {
+        const int pairs = (count + 2 * width - 1) / (2 * width);
+        parallelForChunks(pairs, 1, [&](int pair, int) {
+            const int begin = pair * 2 * width;
+            const int middle = qMin(begin + width, count);
+            const int end = qMin(begin + 2 * width, count);
+            std::inplace_merge(data + begin, data + middle, data + end, lessThan);
+        });
+    }
+}
+} // unnamed namespace
+
 //this struct is used to store what are the rows that are removed
 //between a call to rowsAboutToBeRemoved and rowsRemoved
 //it avoids readding rows to the mapping that are currently being removed
@@ -180,6 +252,7 @@ public:
     bool accept_children;
     bool complete_insert;
     bool dynamic_sortfilter;
+    bool parallel_sortfilter;
     QRowsRemoval itemsBeingRemoved;
 
     QModelIndexPairList saved_persistent_indexes;
@@ -260,6 +333,8 @@ public:
     int find_source_sort_column() const;
     void sort_source_rows(QList<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    void resort_source_rows(QList<int> &source_to_proxy, QList<int> &proxy_to_source,
+                            QList<int> &source_rows, const QModelIndex &source_parent);
     QList<QPair<int, QList<int>>> proxy_intervals_for_source_items_to_add(
         const QList<int> &proxy_to_source, const QList<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -306,6 +381,11 @@ public:
     bool needsReorder(const QList<int> &source_rows, const QModelIndex &source_parent) const;
 
     bool filterAcceptsRowInternal(int source_row, const QModelIndex &source_parent) const;
+    QList<bool> filterAcceptsRowsInParallel(const QModelIndex &source_parent, int count) const;
+    inline bool parallelSortFilterApplies(int item_count) const
+    {
+        return parallel_sortfilter && item_count >= ParallelSortFilterThreshold;
+    }
     bool recursiveChildAcceptsRow(int source_row, const QModelIndex &source_parent) const;
     bool recursiveParentAcceptsRow(const QModelIndex &source_parent) const;
 };
@@ -342,6 +422,25 @@ bool QSortFilterProxyModelPrivate::filterAcceptsRowInternal(int source_row, cons
     return false;
 }
 
+/*!
+  \internal
+
+  Evaluates filterAcceptsRowInternal() for the first \a count rows of
+  \a source_parent on the global thread pool and returns the result
+  for each row.
+*/
+QList<bool> QSortFilterProxyModelPrivate::filterAcceptsRowsInParallel(
+    const QModelIndex &source_parent, int count) const
+{
+    QList<bool> accepted(count);
+    bool *data = accepted.data();
+    parallelForChunks(count, ParallelSortFilterChunkSize, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            data[i] = filterAcceptsRowInternal(i, source_parent);
+    });
+    return accepted;
+}
+
 bool QSortFilterProxyModelPrivate::recursiveParentAcceptsRow(const QModelIndex &source_parent) const
 {
     Q_Q(const QSortFilterProxyModel);
@@ -412,9 +511,17 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
 
     int source_rows = model->rowCount(source_parent);
     m->source_rows.reserve(source_rows);
-    for (int i = 0; i < source_rows; ++i) {
-        if (filterAcceptsRowInternal(i, source_parent))
-            m->source_rows.append(i);
+    if (parallelSortFilterApplies(source_rows)) {
+        const QList<bool> accepted = filterAcceptsRowsInParallel(source_parent, source_rows);
+        for (int i = 0; i < source_rows; ++i) {
+            if (accepted.at(i))
+                m->source_rows.append(i);
+        }
+    } else {
+        for (int i = 0; i < source_rows; ++i) {
+            if (filterAcceptsRowInternal(i, source_parent))
+                m->source_rows.append(i);
+        }
     }
     int source_cols = model->columnCount(source_parent);
     m->source_columns.reserve(source_cols);
@@ -586,18 +693,77 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
+        const bool parallel = parallelSortFilterApplies(source_rows.size());
         if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
-            std::stable_sort(source_rows.begin(), source_rows.end(), lt);
+            if (parallel)
+                parallelStableSort(source_rows, lt);
+            else
+                std::stable_sort(source_rows.begin(), source_rows.end(), lt);
         } else {
             QSortFilterProxyModelGreaterThan gt(source_sort_column, source_parent, model, q);
-            std::stable_sort(source_rows.begin(), source_rows.end(), gt);
+            if (parallel)
+                parallelStableSort(source_rows, gt);
+            else
+                std::stable_sort(source_rows.begin(), source_rows.end(), gt);
         }
     } else { // restore the source model order
         std::stable_sort(source_rows.begin(), source_rows.end());
     }
 }
 
+/*!
+  \internal
+
+  Moves the mapped \a source_rows, whose sort key has changed, to their new
+  position in \a proxy_to_source without emitting any signals. The other
+  rows keep their relative order, so only \a source_rows are sorted; each of
+  them is then placed with one binary search while the mapping is rebuilt
+  in a single pass.
+*/
+void QSortFilterProxyModelPrivate::resort_source_rows(
+    QList<int> &source_to_proxy, QList<int> &proxy_to_source,
+    QList<int> &source_rows, const QModelIndex &source_parent)
+{
+    Q_Q(QSortFilterProxyModel);
+    Q_ASSERT(source_sort_column >= 0);
+    QModelIndex proxy_parent = q->mapFromSource(source_parent);
+    if (!proxy_parent.isValid() && source_parent.isValid())
+        return; // nothing to do (source_parent is not mapped)
+
+    for (int source_row : qAsConst(source_rows))
+        source_to_proxy[source_row] = -1;
+    proxy_to_source.erase(std::remove_if(proxy_to_source.begin(), proxy_to_source.end(),
+                                         [&source_to_proxy](int source_row) {
+                                             return source_to_proxy.at(source_row) == -1;
+                                         }),
+                          proxy_to_source.end());
+    sort_source_rows(source_rows, source_parent);
+
+    QList<int> merged;
+    merged.reserve(proxy_to_source.size() + source_rows.size());
+    auto pos = proxy_to_source.cbegin();
+    const auto end = proxy_to_source.cend();
+    const auto merge = [&](const auto &lessThan) {
+        for (int source_row : qAsConst(source_rows)) {
+            // Changed rows go after unchanged rows that compare equal, as
+            // insert_source_items() would place them
+            const auto next = std::upper_bound(pos, end, source_row, lessThan);
+            std::copy(pos, next, std::back_inserter(merged));
+            merged.append(source_row);
+            pos = next;
+        }
+    };
+    if (sort_order == Qt::AscendingOrder)
+        merge(QSortFilterProxyModelLessThan(source_sort_column, source_parent, model, q));
+    else
+        merge(QSortFilterProxyModelGreaterThan(source_sort_column, source_parent, model, q));
+    std::copy(pos, end, std::back_inserter(merged));
+
+    proxy_to_source = std::move(merged);
+    build_source_to_proxy_mapping(proxy_to_source, source_to_proxy);
+}
+
 /*!
   \internal
 
@@ -1230,13 +1396,22 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     const QModelIndex &source_parent, Qt::Orientation orient)
 {
     Q_Q(QSortFilterProxyModel);
+    QList<bool> rows_accepted;
+    if (orient == Qt::Vertical && parallelSortFilterApplies(source_to_proxy.size()))
+        rows_accepted = filterAcceptsRowsInParallel(source_parent, source_to_proxy.size());
+    const auto accepts = [&](int source_item) {
+        if (orient == Qt::Vertical) {
+            return rows_accepted.isEmpty()
+                    ? filterAcceptsRowInternal(source_item, source_parent)
+                    : rows_accepted.at(source_item);
+        }
+        return q->filterAcceptsColumn(source_item, source_parent);
+    };
     // Figure out which mapped items to remove
     QList<int> source_items_remove;
     for (int i = 0; i < proxy_to_source.count(); ++i) {
         const int source_item = proxy_to_source.at(i);
-        if ((orient == Qt::Vertical)
-            ? !filterAcceptsRowInternal(source_item, source_parent)
-            : !q->filterAcceptsColumn(source_item, source_parent)) {
+        if (!accepts(source_item)) {
             // This source item does not satisfy the filter, so it must be removed
             source_items_remove.append(source_item);
         }
@@ -1246,9 +1421,7 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     int source_count = source_to_proxy.size();
     for (int source_item = 0; source_item < source_count; ++source_item) {
         if (source_to_proxy.at(source_item) == -1) {
-            if ((orient == Qt::Vertical)
-                ? filterAcceptsRowInternal(source_item, source_parent)
-                : q->filterAcceptsColumn(source_item, source_parent)) {
+            if (accepts(source_item)) {
                 // This source item satisfies the filter, so it must be added
                 source_items_insert.append(source_item);
             }
@@ -1331,11 +1504,31 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
         QList<int> source_rows_insert;
         QList<int> source_rows_change;
         QList<int> source_rows_resort;
+        const int start = source_top_left.row();
         int end = qMin(source_bottom_right.row(), m->proxy_rows.count() - 1);
-        for (int source_row = source_top_left.row(); source_row <= end; ++source_row) {
+        QList<bool> rows_accepted;
+        if (dynamic_sortfilter && parallelSortFilterApplies(end - start + 1)) {
+            rows_accepted.resize(end - start + 1);
+            bool *accepted = rows_accepted.data();
+            parallelForChunks(end - start + 1, ParallelSortFilterChunkSize, [&](int begin, int last) {
+                for (int i = begin; i < last; ++i) {
+                    const int source_row = start + i;
+                    if (m->proxy_rows.at(source_row) != -1
+                        || !itemsBeingRemoved.contains(source_parent, source_row)) {
+                        accepted[i] = filterAcceptsRowInternal(source_row, source_parent);
+                    }
+                }
+            });
+        }
+        const auto accepts = [&](int source_row) {
+            return rows_accepted.isEmpty()
+                    ? filterAcceptsRowInternal(source_row, source_parent)
+                    : rows_accepted.at(source_row - start);
+        };
+        for (int source_row = start; source_row <= end; ++source_row) {
             if (dynamic_sortfilter) {
                 if (m->proxy_rows.at(source_row) != -1) {
-                    if (!filterAcceptsRowInternal(source_row, source_parent)) {
+                    if (!accepts(source_row)) {
                         // This source row no longer satisfies the filter, so it must be removed
                         source_rows_remove.append(source_row);
                     } else if (source_sort_column >= source_top_left.column() && source_sort_column <= source_bottom_right.column()) {
@@ -1346,7 +1539,7 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
                         source_rows_change.append(source_row);
                     }
                 } else {
-                    if (!itemsBeingRemoved.contains(source_parent, source_row) && filterAcceptsRowInternal(source_row, source_parent)) {
+                    if (!itemsBeingRemoved.contains(source_parent, source_row) && accepts(source_row)) {
                         // This source row now satisfies the filter, so it must be added
                         source_rows_insert.append(source_row);
                     }
@@ -1379,11 +1572,8 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
                 parents << q->mapFromSource(source_parent);
                 emit q->layoutAboutToBeChanged(parents, QAbstractItemModel::VerticalSortHint);
                 QModelIndexPairList source_indexes = store_persistent_indexes();
-                remove_source_items(m->proxy_rows, m->source_rows, source_rows_resort,
-                        source_parent, Qt::Vertical, false);
-                sort_source_rows(source_rows_resort, source_parent);
-                insert_source_items(m->proxy_rows, m->source_rows, source_rows_resort,
-                        source_parent, Qt::Vertical, false);
+                resort_source_rows(m->proxy_rows, m->source_rows, source_rows_resort,
+                                   source_parent);
                 update_persistent_indexes(source_indexes);
                 emit q->layoutChanged(parents, QAbstractItemModel::VerticalSortHint);
             }
@@ -1870,6 +2060,19 @@ void QSortFilterProxyModelPrivate::_q_sourceColumnsMoved(
     proxy model to its original state, losing selection information, and will
     cause the proxy model to be repopulated.
 
+    \section1 Parallel Sorting and Filtering
+
+    Filtering and sorting run on the thread that owns the proxy model, which
+    for models with hundreds of thousands of rows can take noticeable time.
+    If filterAcceptsRow() and lessThan() only read from the source model, and
+    the source model supports concurrent reads, setting the
+    \l parallelSortFilterEnabled property lets the proxy model spread this
+    work over the global QThreadPool.
+
+    Independently of that setting, when dataChanged() affects the sort
+    column, only the changed rows are sorted again and merged back into the
+    existing order.
+
     \section1 Subclassing
 
     Since QAbstractProxyModel and its subclasses are derived from
@@ -1907,6 +2110,7 @@ QSortFilterProxyModel::QSortFilterProxyModel(QObject *parent)
     d->filter_recursive = false;
     d->accept_children = false;
     d->dynamic_sortfilter = true;
+    d->parallel_sortfilter = false;
     d->complete_insert = false;
     connect(this, SIGNAL(modelReset()), this, SLOT(_q_clearMapping()));
 }
@@ -2857,6 +3061,53 @@ void QSortFilterProxyModel::setAutoAcceptChildRows(bool accept)
     emit autoAcceptChildRowsChanged(accept);
 }
 
+/*!
+    \since 6.0
+    \property QSortFilterProxyModel::parallelSortFilterEnabled
+    \brief whether filtering and sorting of large models may be spread over
+    the threads of the global QThreadPool.
+
+    When enabled, levels of the source model with at least a few thousand rows
+    are filtered and sorted in chunks on idle threads of
+    QThreadPool::globalInstance(), with the calling thread taking part in the
+    work. The result, including the order of rows that compare equal, is the
+    same as without this setting.
+
+    filterAcceptsRow() and lessThan() are then called concurrently from
+    several threads, so this is only safe if they, and the data(), index(),
+    parent() and rowCount() functions of the source model they rely on, can be
+    called concurrently for reading. They must not modify the proxy model or
+    the source model, or call functions of the proxy model that map indexes.
+
+    The default value is false.
+
+    \sa filterAcceptsRow(), lessThan()
+*/
+
+/*!
+    \since 6.0
+    \fn void QSortFilterProxyModel::parallelSortFilterEnabledChanged(bool parallelSortFilterEnabled)
+
+    \brief This signal is emitted when the value of the \a parallelSortFilterEnabled property is changed.
+
+    \sa parallelSortFilterEnabled
+*/
+bool QSortFilterProxyModel::isParallelSortFilterEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->parallel_sortfilter;
+}
+
+void QSortFilterProxyModel::setParallelSortFilterEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    if (d->parallel_sortfilter == enable)
+        return;
+
+    d->parallel_sortfilter = enable;
+    emit parallelSortFilterEnabledChanged(enable);
+}
+
 /*!
    \since 4.3
 
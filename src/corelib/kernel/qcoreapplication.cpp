@@ -68,6 +68,7 @@
 #include <qelapsedtimer.h>
 #include <qlibraryinfo.h>
 #include <qvarlengtharray.h>
+#include <private/qeventpool_p.h>
 #include <private/qfactoryloader_p.h>
 #include <private/qfunctions_p.h>
 #include <private/qlocale_p.h>
@@ -2230,7 +2231,7 @@ QEvent *QCoreApplicationPrivate::cloneEvent(QEvent *e)
     case QEvent::None:
         return new QEvent(*e);
     case QEvent::Timer:
-        return new QTimerEvent(*static_cast<QTimerEvent*>(e));
+        return new QPooledEvent<QTimerEvent>(*static_cast<QTimerEvent*>(e));
     default:
         Q_ASSERT_X(false, "cloneEvent()", "not implemented");
         break;
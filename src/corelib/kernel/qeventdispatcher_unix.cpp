@@ -55,6 +55,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <limits>
+
 #ifndef QT_NO_EVENTFD
 #  include <sys/eventfd.h>
 #endif
@@ -226,14 +228,133 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0)
+        initEpoll();
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
-    // cleanup timers
-    qDeleteAll(timerList);
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+}
+
+#if QT_CONFIG(epoll)
+// The epoll event bits have the same values as their poll() counterparts on
+// Linux, which lets us reuse QSocketNotifierSetUNIX::events() and
+// markPendingSocketNotifiers() unchanged.
+static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI
+              && EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        perror("QEventDispatcherUNIXPrivate: Unable to create epoll instance");
+        return false;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+        perror("QEventDispatcherUNIXPrivate: Unable to watch thread pipe with epoll");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpoll(int fd, short oldEvents, short newEvents)
+{
+    if (epollFd < 0 || oldEvents == newEvents)
+        return;
+
+    if (epollUnsupportedFds.contains(fd)) {
+        if (!newEvents)
+            epollUnsupportedFds.removeOne(fd);
+        return;
+    }
+
+    epoll_event ev = {};
+    ev.events = quint32(newEvents);
+    ev.data.fd = fd;
+
+    if (!newEvents) {
+        // the kernel already dropped the registration if fd was closed
+        if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev) == -1 && errno != EBADF && errno != ENOENT)
+            qErrnoWarning("QSocketNotifier: Unable to stop watching socket %d", fd);
+        return;
+    }
+
+    int ret = epoll_ctl(epollFd, oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+    if (ret == -1 && errno == ENOENT) // closed and reused behind our back
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    else if (ret == -1 && errno == EEXIST)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+
+    if (ret == -1) {
+        if (errno == EPERM) {
+            // regular files and directories can't be watched by epoll, but
+            // poll() always reports them as ready, so emulate that
+            epollUnsupportedFds.append(fd);
+        } else {
+            qErrnoWarning("QSocketNotifier: Unable to watch socket %d", fd);
+        }
+    }
 }
 
+int QEventDispatcherUNIXPrivate::epollWait(const timespec *timeout)
+{
+    int msecs = -1;
+    if (!epollUnsupportedFds.isEmpty()) {
+        msecs = 0;
+    } else if (timeout) {
+        // epoll_wait() only has millisecond granularity; round up so we
+        // don't wake up just before the next timer and spin
+        const qint64 ms = qint64(timeout->tv_sec) * 1000 + (timeout->tv_nsec + 999999) / 1000000;
+        msecs = int(qMin(ms, qint64(std::numeric_limits<int>::max())));
+    }
+
+    const qsizetype maxEvents = socketNotifiers.size() + 1;
+    if (epollEvents.size() < maxEvents)
+        epollEvents.resize(maxEvents);
+
+    const int ready = epoll_wait(epollFd, epollEvents.data(), int(epollEvents.size()), msecs);
+    if (ready == -1) {
+        if (errno != EINTR)
+            perror("epoll_wait");
+        return 0;
+    }
+
+    int nevents = 0;
+    pollfds.clear();
+    for (int i = 0; i < ready; ++i) {
+        const epoll_event &ev = epollEvents.at(i);
+        pollfd pfd = qt_make_pollfd(ev.data.fd, 0);
+        pfd.revents = short(ev.events);
+        if (pfd.fd == threadPipe.fds[0])
+            nevents += threadPipe.check(pfd);
+        else if (socketNotifiers.contains(pfd.fd))
+            pollfds.append(pfd);
+    }
+
+    for (int fd : qAsConst(epollUnsupportedFds)) {
+        pollfd pfd = qt_make_pollfd(fd, 0);
+        pfd.revents = socketNotifiers.value(fd).events();
+        pollfds.append(pfd);
+    }
+
+    return nevents + activateSocketNotifiers();
+}
+#endif // QT_CONFIG(epoll)
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -411,7 +532,13 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = notifier;
+    d->updateEpoll(sockfd, oldEvents, sn_set.events());
+#else
     sn_set.notifiers[type] = notifier;
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -450,7 +577,13 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
     sn_set.notifiers[type] = nullptr;
+    d->updateEpoll(sockfd, oldEvents, sn_set.events());
+#else
+    sn_set.notifiers[type] = nullptr;
+#endif
 
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
@@ -487,6 +620,17 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
+    int nevents = 0;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && include_notifiers) {
+        nevents += d->epollWait(tm);
+        if (include_timers)
+            nevents += d->activateTimers();
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
     d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
@@ -497,8 +641,6 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
-    int nevents = 0;
-
     switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
     case -1:
         perror("qt_safe_poll");
@@ -58,6 +58,10 @@
 #include "QtCore/qvarlengtharray.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -138,9 +142,23 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpoll(int fd, short oldEvents, short newEvents);
+    int epollWait(const timespec *timeout);
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
+#if QT_CONFIG(epoll)
+    // epoll(7) keeps the registrations in the kernel, so a wakeup only
+    // costs O(ready descriptors) instead of O(registered descriptors)
+    int epollFd = -1;
+    QList<epoll_event> epollEvents;
+    QList<int> epollUnsupportedFds; // regular files etc, always ready
+#endif
+
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
 
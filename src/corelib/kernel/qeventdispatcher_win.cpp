@@ -51,6 +51,7 @@
 
 #include "qelapsedtimer.h"
 #include "qcoreapplication_p.h"
+#include <private/qeventpool_p.h>
 #include <private/qthread_p.h>
 #include <private/qwineventnotifier_p.h>
 
@@ -122,7 +123,7 @@ void WINAPI QT_WIN_CALLBACK qt_fast_timer_proc(uint timerId, uint /*reserved*/,
         return;
     auto t = reinterpret_cast<WinTimerInfo*>(user);
     Q_ASSERT(t);
-    QCoreApplication::postEvent(t->dispatcher, new QTimerEvent(t->timerId));
+    QCoreApplication::postEvent(t->dispatcher, new QPooledEvent<QTimerEvent>(t->timerId));
 }
 
 static inline UINT inputQueueMask()
@@ -385,7 +386,7 @@ void QEventDispatcherWin32Private::registerTimer(WinTimerInfo *t)
     uint interval = t->interval;
     if (interval == 0u) {
         // optimization for single-shot-zero-timer
-        QCoreApplication::postEvent(q, new QZeroTimerEvent(t->timerId));
+        QCoreApplication::postEvent(q, new QPooledEvent<QZeroTimerEvent>(t->timerId));
         ok = true;
     } else if (interval < 20u || t->timerType == Qt::PreciseTimer) {
         // 3/2016: Although MSDN states timeSetEvent() is deprecated, the function
@@ -998,7 +999,7 @@ bool QEventDispatcherWin32::event(QEvent *e)
             } else {
                 if (t->interval == 0 && t->inTimerEvent) {
                     // post the next zero timer event as long as the timer was not restarted
-                    QCoreApplication::postEvent(this, new QZeroTimerEvent(zte->timerId()));
+                    QCoreApplication::postEvent(this, new QPooledEvent<QZeroTimerEvent>(zte->timerId()));
                 }
 
                 t->inTimerEvent = false;
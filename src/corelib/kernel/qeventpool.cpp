@@ -0,0 +1,377 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qeventpool_p.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+
+#include <cstddef>
+#include <cstdlib>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QEventPool
+    \inmodule QtCore
+
+    QEventPool recycles the storage of short-lived objects that are created in
+    one thread and, typically, destroyed in another one, such as the events
+    posted for queued connections.
+
+    Each thread owns a set of free lists, one per size class. Blocks released
+    by the owning thread go back to its local free list without any atomic
+    operation; blocks released by any other thread are pushed onto a lock-free
+    "remote" list, which the owner takes over in one exchange once its local
+    list runs dry. Since only the owner ever removes blocks from the remote
+    list, and always all of them at once, the list is not subject to the ABA
+    problem.
+
+    The events that Qt itself posts at a high rate are allocated from the
+    pool, either through class-specific allocation functions (QMetaCallEvent)
+    or by wrapping their type in QPooledEvent. statistics() reports how
+    effective the pools are.
+
+    When a thread exits, its pool frees all cached blocks and is marked as
+    orphaned. Blocks that are still alive at that point keep referring to it;
+    they are freed directly when they are released, and the last one of them
+    destroys the pool. An exited thread therefore never leaves more than its
+    own live blocks behind.
+*/
+
+namespace {
+
+constexpr size_t Granularity = 32;
+constexpr int SizeClassCount = 8;   // blocks of up to 256 bytes, header included
+constexpr int MaxCachedBlocks = 512;
+
+struct QEventPoolData;
+
+struct alignas(std::max_align_t) BlockHeader
+{
+    QEventPoolData *pool;           // nullptr if the block was not pooled
+    int sizeClass;
+};
+
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+struct QEventPoolData
+{
+    struct Bin {
+        FreeBlock *local = nullptr;
+        int localCount = 0;
+        QAtomicPointer<FreeBlock> remote;
+    };
+    Bin bins[SizeClassCount];
+    QEventPoolData *nextRegistered = nullptr;
+
+    // blocks handed out and not yet back in a free list; only ever touched
+    // by the owning thread
+    qint64 outstanding = 0;
+    // once the owner has exited: blocks still alive, minus those released
+    // before the owner published its count; the pool dies when it hits zero
+    QAtomicInteger<qint64> orphanedBlocks;
+
+    // only ever written by the owning thread
+    QAtomicInteger<quint64> allocations;
+    QAtomicInteger<quint64> reused;
+    QAtomicInteger<quint64> remoteReturns;
+
+    void *allocate(int sizeClass);
+    void release(FreeBlock *block, int sizeClass);
+    void releaseRemote(FreeBlock *block, int sizeClass) noexcept;
+    void trim();
+    void orphan();
+    void releaseOrphaned(qint64 count) noexcept;
+};
+
+// stored in the remote list of every bin of a pool whose thread has exited
+FreeBlock orphanedMarker = { nullptr };
+
+inline FreeBlock *toFreeBlock(BlockHeader *header)
+{
+    return reinterpret_cast<FreeBlock *>(header);
+}
+
+inline BlockHeader *toHeader(FreeBlock *block)
+{
+    return reinterpret_cast<BlockHeader *>(block);
+}
+
+inline size_t blockSize(int sizeClass)
+{
+    return size_t(sizeClass + 1) * Granularity;
+}
+
+inline void increment(QAtomicInteger<quint64> &counter, quint64 amount = 1)
+{
+    counter.storeRelaxed(counter.loadRelaxed() + amount);
+}
+
+QBasicMutex poolsMutex;
+QEventPoolData *registeredPools = nullptr;
+QEventPool::Statistics retiredStatistics;   // of the pools already destroyed
+
+thread_local QEventPoolData *currentPool = nullptr;
+thread_local bool currentPoolReleased = false;
+
+struct QEventPoolReleaser
+{
+    ~QEventPoolReleaser()
+    {
+        QEventPoolData *pool = currentPool;
+        currentPool = nullptr;
+        currentPoolReleased = true;
+        pool->orphan();
+    }
+};
+
+QEventPoolData *acquirePool()
+{
+    if (Q_UNLIKELY(currentPoolReleased))
+        return nullptr;     // thread is exiting
+
+    QEventPoolData *pool = new QEventPoolData;
+    {
+        QMutexLocker locker(&poolsMutex);
+        pool->nextRegistered = registeredPools;
+        registeredPools = pool;
+    }
+
+    static thread_local QEventPoolReleaser releaser;
+    Q_UNUSED(releaser);
+    currentPool = pool;
+    return pool;
+}
+
+void *QEventPoolData::allocate(int sizeClass)
+{
+    Bin &bin = bins[sizeClass];
+    if (!bin.local) {
+        // adopt whatever other threads have given back in the meantime
+        FreeBlock *list = bin.remote.fetchAndStoreAcquire(nullptr);
+        int count = 0;
+        int excessCount = 0;
+        for (FreeBlock *block = list; block; block = block->next) {
+            if (++count == MaxCachedBlocks) {
+                FreeBlock *excess = block->next;
+                block->next = nullptr;
+                while (excess) {
+                    FreeBlock *next = excess->next;
+                    ::free(excess);
+                    excess = next;
+                    ++excessCount;
+                }
+                break;
+            }
+        }
+        bin.local = list;
+        bin.localCount = count;
+        outstanding -= count + excessCount;
+        increment(remoteReturns, count + excessCount);
+    }
+
+    increment(allocations);
+    ++outstanding;
+    BlockHeader *header;
+    if (FreeBlock *block = bin.local) {
+        bin.local = block->next;
+        --bin.localCount;
+        increment(reused);
+        header = toHeader(block);
+    } else {
+        header = static_cast<BlockHeader *>(::malloc(blockSize(sizeClass)));
+        Q_CHECK_PTR(header);
+    }
+    header->pool = this;
+    header->sizeClass = sizeClass;
+    return header + 1;
+}
+
+void QEventPoolData::release(FreeBlock *block, int sizeClass)
+{
+    Bin &bin = bins[sizeClass];
+    --outstanding;
+    if (bin.localCount >= MaxCachedBlocks) {
+        ::free(block);
+        return;
+    }
+    block->next = bin.local;
+    bin.local = block;
+    ++bin.localCount;
+}
+
+void QEventPoolData::releaseRemote(FreeBlock *block, int sizeClass) noexcept
+{
+    QAtomicPointer<FreeBlock> &remote = bins[sizeClass].remote;
+    FreeBlock *head = remote.loadAcquire();
+    do {
+        if (head == &orphanedMarker) {
+            ::free(block);
+            releaseOrphaned(1);
+            return;
+        }
+        block->next = head;
+    } while (!remote.testAndSetOrdered(head, block, head));
+}
+
+void QEventPoolData::trim()
+{
+    for (Bin &bin : bins) {
+        FreeBlock *block = bin.local;
+        while (block) {
+            FreeBlock *next = block->next;
+            ::free(block);
+            block = next;
+        }
+        bin.local = nullptr;
+        bin.localCount = 0;
+    }
+}
+
+// Called by the owning thread when it exits. From then on, blocks released
+// by other threads are freed immediately and the last one destroys the pool.
+void QEventPoolData::orphan()
+{
+    trim();
+    for (Bin &bin : bins) {
+        FreeBlock *block = bin.remote.fetchAndStoreOrdered(&orphanedMarker);
+        while (block) {
+            FreeBlock *next = block->next;
+            ::free(block);
+            --outstanding;
+            block = next;
+        }
+    }
+    // blocks released from now on have been counted down from zero already
+    releaseOrphaned(-outstanding);
+}
+
+void QEventPoolData::releaseOrphaned(qint64 count) noexcept
+{
+    // both the owner's (negated) count and each release go through here, so
+    // the counter reaches zero exactly once, after the last of them
+    if (orphanedBlocks.fetchAndSubOrdered(count) != count)
+        return;
+
+    QMutexLocker locker(&poolsMutex);
+    for (QEventPoolData **link = &registeredPools; *link; link = &(*link)->nextRegistered) {
+        if (*link == this) {
+            *link = nextRegistered;
+            break;
+        }
+    }
+    retiredStatistics.allocations += allocations.loadRelaxed();
+    retiredStatistics.reused += reused.loadRelaxed();
+    retiredStatistics.remoteReturns += remoteReturns.loadRelaxed();
+    locker.unlock();
+    delete this;
+}
+
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Returns storage for an object of \a size bytes, suitably aligned for any
+    type. The storage must be released with deallocate().
+*/
+void *QEventPool::allocate(size_t size)
+{
+    const size_t total = size + sizeof(BlockHeader);
+    const int sizeClass = int((total - 1) / Granularity);
+    if (sizeClass < SizeClassCount) {
+        QEventPoolData *pool = currentPool;
+        if (Q_LIKELY(pool) || (pool = acquirePool()))
+            return pool->allocate(sizeClass);
+    }
+
+    auto header = static_cast<BlockHeader *>(::malloc(total));
+    Q_CHECK_PTR(header);
+    header->pool = nullptr;
+    header->sizeClass = -1;
+    return header + 1;
+}
+
+/*!
+    \internal
+
+    Releases \a ptr, which must have been returned by allocate(), from any
+    thread. Does nothing if \a ptr is \nullptr.
+*/
+void QEventPool::deallocate(void *ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    BlockHeader *header = static_cast<BlockHeader *>(ptr) - 1;
+    QEventPoolData *pool = header->pool;
+    if (!pool)
+        ::free(header);
+    else if (pool == currentPool)
+        pool->release(toFreeBlock(header), header->sizeClass);
+    else
+        pool->releaseRemote(toFreeBlock(header), header->sizeClass);
+}
+
+/*!
+    \internal
+
+    Returns the counters of all pools, including those of threads that have
+    exited. The values are only approximate while other threads allocate.
+*/
+QEventPool::Statistics QEventPool::statistics()
+{
+    QMutexLocker locker(&poolsMutex);
+    Statistics result = retiredStatistics;
+    result.pools = 0;
+    for (QEventPoolData *pool = registeredPools; pool; pool = pool->nextRegistered) {
+        result.allocations += pool->allocations.loadRelaxed();
+        result.reused += pool->reused.loadRelaxed();
+        result.remoteReturns += pool->remoteReturns.loadRelaxed();
+        ++result.pools;
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
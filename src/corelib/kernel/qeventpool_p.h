@@ -0,0 +1,93 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QEVENTPOOL_P_H
+#define QEVENTPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QEventPool
+{
+public:
+    struct Statistics {
+        quint64 allocations = 0;    // requests served by a thread's pool
+        quint64 reused = 0;         // ...of which came from a free list
+        quint64 remoteReturns = 0;  // blocks given back by other threads
+        int pools = 0;              // pools currently allocated
+    };
+
+    static void *allocate(size_t size);
+    static void deallocate(void *ptr) noexcept;
+
+    static Statistics statistics();
+};
+
+// Allocates Event from the posting thread's QEventPool; use for the events
+// that Qt itself creates and posts at a high rate.
+template <typename Event>
+class QPooledEvent final : public Event
+{
+public:
+    template <typename... Args>
+    explicit QPooledEvent(Args &&... args)
+        : Event(std::forward<Args>(args)...)
+    {}
+
+    static void *operator new(size_t size) { return QEventPool::allocate(size); }
+    static void operator delete(void *ptr) noexcept { QEventPool::deallocate(ptr); }
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTPOOL_P_H
@@ -509,10 +509,11 @@ inline void QMetaCallEvent::allocArgs()
         return;
 
     constexpr size_t each = sizeof(void*) + sizeof(QMetaType);
-    void *const memory = d.nargs_ * each > sizeof(prealloc_) ?
-        calloc(d.nargs_, each) : prealloc_;
-
-    Q_CHECK_PTR(memory);
+    void *memory = prealloc_;
+    if (d.nargs_ * each > sizeof(prealloc_)) {
+        memory = QEventPool::allocate(d.nargs_ * each);
+        memset(memory, 0, d.nargs_ * each);
+    }
     d.args_ = static_cast<void **>(memory);
 }
 
@@ -596,7 +597,7 @@ QMetaCallEvent::~QMetaCallEvent()
                 t[i].destroy(d.args_[i]);
         }
         if (reinterpret_cast<void*>(d.args_) != reinterpret_cast<void*>(prealloc_))
-            free(d.args_);
+            QEventPool::deallocate(d.args_);
     }
     if (d.slotObj_)
         d.slotObj_->destroyIfLastRef();
@@ -2241,7 +2242,7 @@ void QObject::removeEventFilter(QObject *obj)
 */
 void QObject::deleteLater()
 {
-    QCoreApplication::postEvent(this, new QDeferredDeleteEvent());
+    QCoreApplication::postEvent(this, new QPooledEvent<QDeferredDeleteEvent>());
 }
 
 /*!
@@ -61,6 +61,7 @@
 #include "QtCore/qsharedpointer.h"
 #include "QtCore/qvariant.h"
 #include "QtCore/qproperty.h"
+#include "QtCore/private/qeventpool_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -549,6 +550,10 @@ public:
 
     ~QMetaCallEvent() override;
 
+    // recycled through per-thread pools, see QEventPool
+    static void *operator new(size_t size) { return QEventPool::allocate(size); }
+    static void operator delete(void *ptr) noexcept { QEventPool::deallocate(ptr); }
+
     inline int id() const { return d.method_offset_ + d.method_relative_; }
     inline const void * const* args() const { return d.args_; }
     inline void ** args() { return d.args_; }
@@ -40,6 +40,7 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
@@ -86,6 +87,11 @@ QTimerInfoList::QTimerInfoList()
     firstTimerInfo = nullptr;
 }
 
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(heap);
+}
+
 timespec QTimerInfoList::updateCurrentTime()
 {
     return (currentTime = qt_gettime());
@@ -146,11 +152,9 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 */
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    // repair all timers; shifting every timeout keeps the heap ordered
+    for (QTimerInfo *t : qAsConst(heap))
         t->timeout = t->timeout + diff;
-    }
 }
 
 void QTimerInfoList::repairTimersIfNeeded()
@@ -171,17 +175,143 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  Heap helpers. Timers with the same timeout are ordered by insertion,
+  which keeps them firing in the order they were (re)started.
 */
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
+inline bool QTimerInfoList::heapLess(qsizetype i, qsizetype j) const
+{
+    const QTimerInfo * const a = heap.at(i);
+    const QTimerInfo * const b = heap.at(j);
+    if (a->timeout < b->timeout)
+        return true;
+    if (b->timeout < a->timeout)
+        return false;
+    return a->sequence < b->sequence;
+}
+
+inline void QTimerInfoList::heapSwap(qsizetype i, qsizetype j)
+{
+    qSwap(heap[i], heap[j]);
+    heap[i]->heapIndex = i;
+    heap[j]->heapIndex = j;
+}
+
+void QTimerInfoList::siftUp(qsizetype i)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    while (i > 0) {
+        const qsizetype parent = (i - 1) / 2;
+        if (!heapLess(i, parent))
             break;
+        heapSwap(i, parent);
+        i = parent;
     }
-    insert(index+1, ti);
+}
+
+void QTimerInfoList::siftDown(qsizetype i)
+{
+    const qsizetype n = heap.size();
+    for (;;) {
+        qsizetype smallest = i;
+        const qsizetype left = 2 * i + 1;
+        const qsizetype right = left + 1;
+        if (left < n && heapLess(left, smallest))
+            smallest = left;
+        if (right < n && heapLess(right, smallest))
+            smallest = right;
+        if (smallest == i)
+            break;
+        heapSwap(i, smallest);
+        i = smallest;
+    }
+}
+
+void QTimerInfoList::heapRemove(QTimerInfo *t)
+{
+    const qsizetype i = t->heapIndex;
+    Q_ASSERT(heap.at(i) == t);
+    const qsizetype last = heap.size() - 1;
+    if (i != last) {
+        heapSwap(i, last);
+        heap.removeLast();
+        siftDown(i);
+        siftUp(i);
+    } else {
+        heap.removeLast();
+    }
+}
+
+/*
+  insert timer info into the heap
+*/
+void QTimerInfoList::timerInsert(QTimerInfo *ti)
+{
+    ti->sequence = nextSequence++;
+    ti->heapIndex = heap.size();
+    heap.append(ti);
+    siftUp(ti->heapIndex);
+}
+
+/*
+  remove a registered timer and delete it
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *t)
+{
+    heapRemove(t);
+    timersById.remove(t->id);
+    if (t == firstTimerInfo)
+        firstTimerInfo = nullptr;
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+}
+
+/*
+  Returns the first timer that is not currently being activated, or null.
+*/
+QTimerInfo *QTimerInfoList::firstWaitingTimer() const
+{
+    if (heap.isEmpty())
+        return nullptr;
+    QTimerInfo *t = heap.constFirst();
+    if (!t->activateRef)
+        return t;
+
+    // only happens while a timer event handler runs a nested event loop
+    t = nullptr;
+    for (QTimerInfo *candidate : heap) {
+        if (candidate->activateRef)
+            continue;
+        if (!t || candidate->timeout < t->timeout
+            || (!(t->timeout < candidate->timeout) && candidate->sequence < t->sequence)) {
+            t = candidate;
+        }
+    }
+    return t;
+}
+
+/*
+  Returns the number of timers that have expired at currentTime, visiting
+  only those timers and their direct children in the heap.
+*/
+int QTimerInfoList::expiredCount(const timespec &currentTime) const
+{
+    int count = 0;
+    QVarLengthArray<qsizetype, 64> pending;
+    if (!heap.isEmpty())
+        pending.append(0);
+    while (!pending.isEmpty()) {
+        const qsizetype i = pending.last();
+        pending.removeLast();
+        if (currentTime < heap.at(i)->timeout)
+            continue;
+        ++count;
+        const qsizetype left = 2 * i + 1;
+        if (left < heap.size())
+            pending.append(left);
+        if (left + 1 < heap.size())
+            pending.append(left + 1);
+    }
+    return count;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -385,13 +515,7 @@ bool QTimerInfoList::timerWait(timespec &tm)
     repairTimersIfNeeded();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
-    }
+    QTimerInfo *t = firstWaitingTimer();
 
     if (!t)
       return false;
@@ -419,16 +543,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -490,6 +611,8 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
+    timersByObject.insert(object, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -503,57 +626,38 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
+    QTimerInfo *t = timersById.value(timerId);
+    if (!t) {
+        // id not found
+        return false;
     }
-    // id not found
-    return false;
+
+    timersByObject.remove(t->obj, t);
+    timerRemove(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
-    }
+    const QList<QTimerInfo *> timers = timersByObject.values(object);
+    timersByObject.remove(object);
+    for (QTimerInfo *t : timers)
+        timerRemove(t);
     return true;
 }
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    for (auto it = timersByObject.constFind(object); it != timersByObject.cend() && it.key() == object; ++it) {
+        const QTimerInfo * const t = it.value();
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -575,11 +679,7 @@ int QTimerInfoList::activateTimers()
 
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    maxCount = expiredCount(currentTime);
 
     //fire the timers.
     while (maxCount--) {
@@ -600,8 +700,8 @@ int QTimerInfoList::activateTimers()
             firstTimerInfo = currentTimerInfo;
         }
 
-        // remove from list
-        removeFirst();
+        // remove from the heap
+        heapRemove(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +70,8 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    qsizetype heapIndex; // - position in QTimerInfoList's heap
+    quint64 sequence; // - insertion order among timers with the same timeout
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -77,7 +80,9 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+// Timers are kept in a binary min-heap ordered by timeout, so arming and
+// disarming a timer is O(log n) rather than O(n) in the number of timers.
+class Q_CORE_EXPORT QTimerInfoList
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
@@ -92,8 +97,29 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    QList<QTimerInfo *> heap;
+    QHash<int, QTimerInfo *> timersById;
+    QMultiHash<QObject *, QTimerInfo *> timersByObject;
+    quint64 nextSequence = 0;
+
+    bool heapLess(qsizetype i, qsizetype j) const;
+    void heapSwap(qsizetype i, qsizetype j);
+    void siftUp(qsizetype i);
+    void siftDown(qsizetype i);
+    void heapRemove(QTimerInfo *t);
+    QTimerInfo *firstWaitingTimer() const;
+    int expiredCount(const timespec &currentTime) const;
+    void timerRemove(QTimerInfo *t);
+
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
+    Q_DISABLE_COPY(QTimerInfoList)
+
+    bool isEmpty() const { return heap.isEmpty(); }
+    qsizetype size() const { return heap.size(); }
+    // the timer that expires first
+    QTimerInfo *constFirst() const { return heap.constFirst(); }
 
     timespec currentTime;
     timespec updateCurrentTime();
@@ -1058,6 +1058,7 @@ QCborValue QCborContainerPrivate::extractAt_complex(Element e)
     } else {
         // just share with the original byte data
         container->data = data;
+        container->externalData = externalData;
         container->elements.reserve(1);
         container->elements.append(e);
     }
@@ -1481,7 +1482,8 @@ static Element decodeBasicValueFromCbor(QCborStreamReader &reader)
     return e;
 }
 
-static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                                             const QByteArray &externalData)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
@@ -1506,6 +1508,8 @@ static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &
         d = new QCborContainerPrivate;
         d->ref.storeRelaxed(1);
     }
+    if (d)
+        d->externalData = externalData;
 
     reader.enterContainer();
     if (reader.lastError() != QCborError::NoError)
@@ -1520,7 +1524,8 @@ static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &
     return d;
 }
 
-static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                      const QByteArray &externalData)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
@@ -1528,6 +1533,7 @@ static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRe
     }
 
     auto d = new QCborContainerPrivate;
+    d->externalData = externalData;
     d->append(reader.toTag());
     reader.next();
 
@@ -1653,7 +1659,7 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
 
     // update size
     if (r.status == QCborStreamReader::EndOfString && e.flags & Element::HasByteData) {
-        auto b = new (dataPtr() + e.value) ByteData;
+        auto b = new (dataPtr() + e.value) ByteData();
         b->len = data.size() - e.value - int(sizeof(*b));
         usedData += b->len;
 
@@ -1682,6 +1688,67 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
     elements.append(e);
 }
 
+// in qcborstreamreader.cpp
+extern QCborStreamReader::StringResult<qsizetype>
+qt_cbor_stream_reference_string_chunk(QCborStreamReaderPrivate *d, QCborStreamReader *q,
+                                      const char **ptr);
+
+/*
+    Like decodeStringFromCbor(), but references the string in externalData
+    instead of copying it. Chunked strings are not contiguous in the
+    source, so they are still copied.
+*/
+void QCborContainerPrivate::referenceStringFromCbor(QCborStreamReader &reader)
+{
+    if (!reader.isLengthKnown())
+        return decodeStringFromCbor(reader);
+
+    Element e = {};
+    e.type = (reader.isByteArray() ? QCborValue::ByteArray : QCborValue::String);
+    if (reader.lastError() != QCborError::NoError)
+        return;
+
+    const char *ptr = nullptr;
+    auto r = qt_cbor_stream_reference_string_chunk(reader.d.data(), &reader, &ptr);
+    if (r.status != QCborStreamReader::Ok)
+        return;                     // error
+    const qsizetype len = r.data;
+
+    if (e.type == QCborValue::String) {
+        auto utf8result = QUtf8::isValidUtf8(QByteArrayView(ptr, len));
+        if (!utf8result.isValidUtf8) {
+            setErrorInReader(reader, { QCborError::InvalidUtf8String });
+            return;
+        }
+        if (Q_UNLIKELY(len > MaxStringSize)) {
+            setErrorInReader(reader, { QCborError::DataTooLarge });
+            return;
+        }
+        if (utf8result.isValidAscii)
+            e.flags |= Element::StringIsAscii;
+    }
+
+    // skip the end of the string
+    const char *end;
+    r = qt_cbor_stream_reference_string_chunk(reader.d.data(), &reader, &end);
+    if (r.status != QCborStreamReader::EndOfString)
+        return;                     // error
+
+    // store the pointer in place of the data, as decodeStringFromCbor() would
+    // store the data itself
+    if (len) {
+        e.flags |= Element::HasByteData;
+        e.value = addByteData(reinterpret_cast<const char *>(&ptr), sizeof(ptr));
+        auto b = reinterpret_cast<ByteData *>(data.data() + e.value);
+        b->len = len;
+        b->external = 1;
+        usedData += len - qsizetype(sizeof(ptr));
+    } else {
+        e.flags = {};
+    }
+    elements.append(e);
+}
+
 void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
 {
     QCborStreamReader::Type t = reader.type();
@@ -1697,17 +1764,20 @@ void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int r
 
     case QCborStreamReader::ByteArray:
     case QCborStreamReader::String:
-        decodeStringFromCbor(reader);
+        if (externalData.isNull())
+            decodeStringFromCbor(reader);
+        else
+            referenceStringFromCbor(reader);
         break;
 
     case QCborStreamReader::Array:
     case QCborStreamReader::Map:
         return append(makeValue(t == QCborStreamReader::Array ? QCborValue::Array : QCborValue::Map, -1,
-                                createContainerFromCbor(reader, remainingRecursionDepth),
+                                createContainerFromCbor(reader, remainingRecursionDepth, externalData),
                                 MoveContainer));
 
     case QCborStreamReader::Tag:
-        return append(taggedValueFromCbor(reader, remainingRecursionDepth));
+        return append(taggedValueFromCbor(reader, remainingRecursionDepth, externalData));
 
     case QCborStreamReader::Invalid:
         return;                 // probably a decode error
@@ -2437,6 +2507,11 @@ enum { MaximumRecursionDepth = 1024 };
     \sa toCbor(), toDiagnosticNotation(), toVariant(), toJsonValue()
  */
 QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
+{
+    return QCborContainerPrivate::valueFromCbor(reader, QByteArray());
+}
+
+QCborValue QCborContainerPrivate::valueFromCbor(QCborStreamReader &reader, const QByteArray &externalData)
 {
     QCborValue result;
     auto t = reader.type();
@@ -2465,23 +2540,27 @@ QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
     case QCborStreamReader::ByteArray:
     case QCborStreamReader::String:
         result.n = 0;
-        result.t = reader.isString() ? String : ByteArray;
+        result.t = reader.isString() ? QCborValue::String : QCborValue::ByteArray;
         result.container = new QCborContainerPrivate;
         result.container->ref.ref();
-        result.container->decodeStringFromCbor(reader);
+        result.container->externalData = externalData;
+        if (externalData.isNull())
+            result.container->decodeStringFromCbor(reader);
+        else
+            result.container->referenceStringFromCbor(reader);
         break;
 
     // containers
     case QCborStreamReader::Array:
     case QCborStreamReader::Map:
         result.n = -1;
-        result.t = reader.isArray() ? Array : Map;
-        result.container = createContainerFromCbor(reader, MaximumRecursionDepth);
+        result.t = reader.isArray() ? QCborValue::Array : QCborValue::Map;
+        result.container = createContainerFromCbor(reader, MaximumRecursionDepth, externalData);
         break;
 
     // tag
     case QCborStreamReader::Tag:
-        result = taggedValueFromCbor(reader, MaximumRecursionDepth);
+        result = taggedValueFromCbor(reader, MaximumRecursionDepth, externalData);
         break;
     }
 
@@ -2521,6 +2600,38 @@ QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error)
     return result;
 }
 
+/*!
+    \since 6.0
+
+    Decodes one item from the CBOR stream found in the byte array \a ba, like
+    fromCbor(), but without copying the contents of strings and byte arrays:
+    the returned value and the values it contains refer to the data of \a ba
+    instead. This roughly halves the memory needed for documents that consist
+    mostly of strings and byte arrays, and makes decoding them faster.
+
+    The returned value keeps a shallow copy of \a ba. If \a ba was created
+    with QByteArray::fromRawData(), for example over memory returned by
+    QFile::map(), that memory must remain valid and unmodified for as long as
+    the returned value, or any value obtained from it, exists. Values copied
+    into other containers and strings that had to be reassembled from chunks
+    are copied as usual.
+
+    The error state is stored in \a error, as with fromCbor().
+
+    \sa fromCbor(), QByteArray::fromRawData(), QFile::map()
+ */
+QCborValue QCborValue::fromRawCbor(const QByteArray &ba, QCborParserError *error)
+{
+    QCborStreamReader reader(ba);
+    // make sure externalData is not null, so that it selects referencing
+    QCborValue result = QCborContainerPrivate::valueFromCbor(reader, ba.isNull() ? QByteArray("") : ba);
+    if (error) {
+        error->error = reader.lastError();
+        error->offset = reader.currentOffset();
+    }
+    return result;
+}
+
 /*!
     \fn QCborValue QCborValue::fromCbor(const char *data, qsizetype len, QCborParserError *error)
     \fn QCborValue QCborValue::fromCbor(const quint8 *data, qsizetype len, QCborParserError *error)
@@ -99,12 +99,20 @@ static_assert(sizeof(Element) == 16);
 
 struct ByteData
 {
-    QByteArray::size_type len;
+    // The bytes normally follow this header. If external is set, a pointer to
+    // them follows instead, referencing the buffer that was passed to
+    // QCborValue::fromRawCbor() (see QCborContainerPrivate::externalData).
+    QByteArray::size_type len : std::numeric_limits<QByteArray::size_type>::digits;
+    std::make_unsigned_t<QByteArray::size_type> external : 1;
 
-    const char *byte() const        { return reinterpret_cast<const char *>(this + 1); }
-    char *byte()                    { return reinterpret_cast<char *>(this + 1); }
-    const QChar *utf16() const      { return reinterpret_cast<const QChar *>(this + 1); }
-    QChar *utf16()                  { return reinterpret_cast<QChar *>(this + 1); }
+    bool isExternal() const         { return external != 0; }
+    const char *byte() const
+    {
+        if (isExternal())
+            return *reinterpret_cast<const char * const *>(this + 1);
+        return reinterpret_cast<const char *>(this + 1);
+    }
+    const QChar *utf16() const      { return reinterpret_cast<const QChar *>(byte()); }
 
     QByteArray toByteArray() const  { return QByteArray(byte(), len); }
     QString toString() const        { return QString(utf16(), len / 2); }
@@ -117,6 +125,7 @@ struct ByteData
 };
 static_assert(std::is_trivial<ByteData>::value);
 static_assert(std::is_standard_layout<ByteData>::value);
+static_assert(sizeof(ByteData) == sizeof(QByteArray::size_type));
 } // namespace QtCbor
 
 Q_DECLARE_TYPEINFO(QtCbor::Element, Q_PRIMITIVE_TYPE);
@@ -132,6 +141,7 @@ public:
     QByteArray::size_type usedData = 0;
     QByteArray data;
     QList<QtCbor::Element> elements;
+    QByteArray externalData;    // keeps external ByteData alive; see QCborValue::fromRawCbor()
 
     void deref() { if (!ref.deref()) delete this; }
     void compact(qsizetype reserved);
@@ -157,10 +167,10 @@ public:
         data.resize(offset + increment);
 
         char *ptr = data.begin() + offset;
-        auto b = new (ptr) QtCbor::ByteData;
+        auto b = new (ptr) QtCbor::ByteData();
         b->len = len;
         if (block)
-            memcpy(b->byte(), block, len);
+            memcpy(ptr + sizeof(QtCbor::ByteData), block, len);
 
         return offset;
     }
@@ -175,7 +185,8 @@ public:
         Q_ASSERT(offset + sizeof(QtCbor::ByteData) <= size_t(data.size()));
 
         auto b = reinterpret_cast<const QtCbor::ByteData *>(data.constData() + offset);
-        Q_ASSERT(offset + sizeof(*b) + size_t(b->len) <= size_t(data.size()));
+        Q_ASSERT(offset + sizeof(*b)
+                 + (b->isExternal() ? sizeof(const char *) : size_t(b->len)) <= size_t(data.size()));
         return b;
     }
     const QtCbor::ByteData *byteData(qsizetype idx) const
@@ -416,6 +427,8 @@ public:
 
     void decodeValueFromCbor(QCborStreamReader &reader, int remainiingStackDepth);
     void decodeStringFromCbor(QCborStreamReader &reader);
+    void referenceStringFromCbor(QCborStreamReader &reader);
+    static QCborValue valueFromCbor(QCborStreamReader &reader, const QByteArray &externalData);
     static inline void setErrorInReader(QCborStreamReader &reader, QCborError error);
 };
 
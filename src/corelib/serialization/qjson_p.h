@@ -212,6 +212,8 @@ public:
         result.value = v;
         return result;
     }
+
+    static const QCborValue &asCbor(const QJsonValue &v) { return v.value; }
 };
 
 class Variant
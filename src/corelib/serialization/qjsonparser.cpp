@@ -47,6 +47,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -379,6 +380,33 @@ error:
     return QCborValue();
 }
 
+/*
+    Parses a single value of any type that starts right at the beginning of
+    the input, and ignores whatever follows it. Used by QJsonStreamReader,
+    which has already determined the extent of the value; as in a complete
+    document, strings, numbers and literals must be followed by at least one
+    more byte.
+*/
+QCborValue Parser::parseFragment(QJsonParseError *error)
+{
+    container = new QCborContainerPrivate;
+    lastError = QJsonParseError::IllegalValue;
+    if (json < end && parseValue()) {
+        if (error) {
+            error->offset = 0;
+            error->error = QJsonParseError::NoError;
+        }
+        return container->valueAt(0);
+    }
+
+    container.reset();
+    if (error) {
+        error->offset = json - head;
+        error->error  = lastError;
+    }
+    return QCborValue();
+}
+
 static void sortContainer(QCborContainerPrivate *container)
 {
     using Forward = QJsonPrivate::KeyIterator;
@@ -825,6 +853,49 @@ static inline bool scanEscapeSequence(const char *&json, const char *end, uint *
     return true;
 }
 
+// Advances json past the longest run of characters that need no further
+// inspection inside a string: US-ASCII other than the quotation mark and the
+// reverse solidus. Long keys and values are the common case in large
+// documents, so check 16 bytes at a time where we can.
+static inline void skipPlainAscii(const char *&json, const char *end)
+{
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while (json + 16 <= end) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                       _mm_cmpeq_epi8(data, backslash));
+        // non-ASCII bytes have their high bit set, which PMOVMSKB picks up as is
+        uint mask = uint(_mm_movemask_epi8(_mm_or_si128(special, data)));
+        if (mask) {
+            json += qCountTrailingZeroBits(mask);
+            return;
+        }
+        json += 16;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vmaxv is only available on Aarch64
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t highBit = vdupq_n_u8(0x80);
+    while (json + 16 <= end) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(json));
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, quote), vceqq_u8(data, backslash)),
+                                      vtstq_u8(data, highBit));
+        if (vmaxvq_u8(special))
+            break;      // the loop below finds the exact position
+        json += 16;
+    }
+#endif
+
+    while (json < end) {
+        const uchar ch = uchar(*json);
+        if (ch == '"' || ch == '\\' || ch >= 0x80)
+            break;
+        ++json;
+    }
+}
+
 static inline bool scanUtf8Char(const char *&json, const char *end, uint *result)
 {
     const auto *usrc = reinterpret_cast<const uchar *>(json);
@@ -848,6 +919,9 @@ bool Parser::parseString()
     bool isUtf8 = true;
     bool isAscii = true;
     while (json < end) {
+        skipPlainAscii(json, end);
+        if (json >= end)
+            break;
         uint ch = 0;
         if (*json == '"')
             break;
@@ -886,10 +960,17 @@ bool Parser::parseString()
 
     DEBUG << "has escape sequences";
 
-    json = start;
-
-    QString ucs4;
+    // everything up to the first escape sequence has been validated already
+    --json;
+    QString ucs4 = QString::fromUtf8(start, json - start);
     while (json < end) {
+        const char *run = json;
+        skipPlainAscii(json, end);
+        if (json != run)
+            ucs4.append(QLatin1String(run, json - run));
+        if (json >= end)
+            break;
+
         uint ch = 0;
         if (*json == '"')
             break;
@@ -65,6 +65,7 @@ public:
     Parser(const char *json, int length);
 
     QCborValue parse(QJsonParseError *error);
+    QCborValue parseFragment(QJsonParseError *error);
 
 private:
     inline void eatBOM();
@@ -0,0 +1,1026 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamreader.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+#include "qjson_p.h"
+#include "qjsonparser_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QJsonStreamReader class is a fast parser for reading JSON
+    incrementally from a QIODevice or from chunks of data.
+
+    Unlike QJsonDocument::fromJson(), which needs the complete document in
+    memory and builds a tree of all of its values, QJsonStreamReader reads
+    one token at a time and only keeps the data of the current token. This
+    makes it suitable for documents that are too large to be held in memory,
+    and for streams of concatenated or newline-delimited JSON values.
+
+    The reader provides a pull API similar to that of QXmlStreamReader:
+    readNext() advances to the next token and returns its type. For names,
+    name() returns the key of the current object member; for strings,
+    numbers, booleans and null, value() returns the value of the token.
+    readValue() reads a complete value, including all of its nested
+    elements, into a QJsonValue; it is the most convenient way to process a
+    stream of records one at a time:
+
+    \code
+    QFile file("records.ndjson");
+    file.open(QIODevice::ReadOnly);
+    QJsonStreamReader reader(&file);
+    while (!reader.atEnd()) {
+        const QJsonValue record = reader.readValue();
+        if (reader.hasError())
+            break;
+        if (!record.isUndefined())
+            process(record.toObject());
+    }
+    \endcode
+
+    Strings, numbers and all other values are validated and decoded by the
+    same code as QJsonDocument::fromJson() uses, and errors are reported
+    with the same QJsonParseError::ParseError codes.
+
+    \section1 Incremental parsing
+
+    If the data read so far ends in the middle of a token, readNext()
+    returns NoToken and atEnd() returns \c true. Once more data is available
+    (after addData(), or when the device emits QIODevice::readyRead()),
+    calling readNext() again continues where the reader left off.
+
+    Incomplete input only becomes an error once the input is finished: after
+    finishInput() was called, when the device was closed or a random-access
+    device was read to its end, or when all data of a sequential device was
+    read after it emitted QIODevice::readChannelFinished().
+
+    Between top-level values, readNext() returns EndDocument when no more
+    data is available; reading continues if more values are added later.
+    Since a number can only be known to be complete once the next character
+    has been seen, a top-level number at the very end of the input is only
+    reported once the input is finished.
+
+    \section1 Memory use
+
+    The reader keeps the data of the current token in memory, and the data
+    of the whole value while readValue() or skipValue() reads it. If that
+    data grows beyond maximumValueSize(), reading fails with
+    QJsonParseError::DocumentTooLarge. Objects and arrays may be nested at
+    most 1024 levels deep, as in QJsonDocument::fromJson().
+
+    \sa QJsonStreamWriter, QJsonDocument, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken          The reader has not read anything yet, or needs
+                            more data to read the next token.
+    \value Invalid          An error has occurred, reported in error() and
+                            errorString().
+    \value StartObject      The reader reports the start of an object.
+    \value EndObject        The reader reports the end of an object.
+    \value StartArray       The reader reports the start of an array.
+    \value EndArray         The reader reports the end of an array.
+    \value Name             The reader reports the key of an object member;
+                            see name().
+    \value String           The reader reports a string value; see value().
+    \value Number           The reader reports a number; see value().
+    \value Bool             The reader reports \c true or \c false; see value().
+    \value Null             The reader reports \c null.
+    \value EndDocument      The reader has read all top-level values that
+                            were available.
+*/
+
+static const int nestingLimit = 1024;   // as in QJsonPrivate::Parser
+static const qint64 readChunkSize = 16 * 1024;
+static const qsizetype defaultMaximumValueSize = 128 * 1024 * 1024;
+
+class QJsonStreamReaderPrivate
+{
+public:
+    // what the grammar allows at the current position
+    enum Expect : quint8 {
+        ExpectValue,                // at top level, after a name or a comma in an array
+        ExpectValueOrEndArray,      // right after [
+        ExpectNameOrEndObject,      // right after {
+        ExpectName,                 // after a comma in an object
+        ExpectSeparatorOrEnd        // after a value in an array or object
+    };
+
+    enum ScanResult {
+        Complete,
+        Incomplete,
+        Failed
+    };
+
+    ~QJsonStreamReaderPrivate() { QObject::disconnect(readChannelConnection); }
+
+    void reset();
+    void discard();
+    bool refill();
+    bool inputFinished() const;
+    bool checkSize(qsizetype from);
+    bool skipSpace(qsizetype &p) const;
+    qsizetype scanString(qsizetype p) const;
+    bool decode(qsizetype from, qsizetype to, bool needsTerminator, QCborValue *result);
+    ScanResult fail(QJsonParseError::ParseError code, qsizetype at);
+    void commit(QJsonStreamReader::TokenType token, qsizetype start, qsizetype next, Expect e);
+    ScanResult readToken();
+    ScanResult readValueToken(qsizetype p, Expect e);
+    void rollBack(qsizetype start, Expect e);
+    QJsonValue readContainer();
+    bool skipContainer();
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qint64 bufferOffset = 0;        // stream offset of buffer[0]
+    qsizetype pos = 0;              // next byte to read
+    qsizetype tokenStart = 0;       // first byte of the current token
+    qsizetype keepFrom = -1;        // start of the container being skipped
+    qsizetype maximumValueSize = defaultMaximumValueSize;
+
+    QVarLengthArray<char, 16> containers;   // '{' or '[' for each open container
+    Expect expect = ExpectValue;
+    Expect tokenExpect = ExpectValue;       // expect before the current token
+
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    QString currentName;
+    QJsonValue currentValue = QJsonValue(QJsonValue::Undefined);
+
+    QJsonParseError::ParseError error = QJsonParseError::NoError;
+    qint64 errorOffset = 0;
+    bool starved = false;           // the last read ran out of data
+    bool bomChecked = false;
+    bool inputComplete = false;     // finishInput() was called
+    bool channelFinished = false;   // the sequential device emitted readChannelFinished()
+    QMetaObject::Connection readChannelConnection;
+};
+
+void QJsonStreamReaderPrivate::reset()
+{
+    QObject::disconnect(readChannelConnection);
+    buffer.clear();
+    bufferOffset = 0;
+    pos = tokenStart = 0;
+    keepFrom = -1;
+    containers.clear();
+    expect = tokenExpect = ExpectValue;
+    type = QJsonStreamReader::NoToken;
+    currentName.clear();
+    currentValue = QJsonValue(QJsonValue::Undefined);
+    error = QJsonParseError::NoError;
+    errorOffset = 0;
+    starved = false;
+    bomChecked = false;
+    inputComplete = false;
+    channelFinished = false;
+}
+
+// Drops the data that precedes the current token and the container being
+// skipped, if any.
+void QJsonStreamReaderPrivate::discard()
+{
+    const qsizetype start = keepFrom >= 0 ? qMin(keepFrom, tokenStart) : tokenStart;
+    if (start <= 0)
+        return;
+    buffer.remove(0, start);
+    bufferOffset += start;
+    pos -= start;
+    tokenStart -= start;
+    if (keepFrom >= 0)
+        keepFrom -= start;
+}
+
+/*
+    Reads more data from the device, first dropping what precedes the current
+    token, so that the buffer never holds much more than one token. Reads at
+    least as much as is buffered already, so that rescanning a long token
+    after each read stays linear overall.
+*/
+bool QJsonStreamReaderPrivate::refill()
+{
+    if (!device)
+        return false;
+
+    discard();
+    const QByteArray chunk = device->read(qMax(readChunkSize, qint64(buffer.size())));
+    if (chunk.isEmpty())
+        return false;
+    buffer += chunk;
+    return true;
+}
+
+bool QJsonStreamReaderPrivate::inputFinished() const
+{
+    if (!device)
+        return inputComplete;
+    if (!device->isOpen())
+        return true;
+    if (!device->atEnd())
+        return false;
+    // a sequential device can receive more data until its read channel closes
+    return inputComplete || !device->isSequential() || channelFinished;
+}
+
+// Fails if the data kept from 'from' on may not grow any further.
+bool QJsonStreamReaderPrivate::checkSize(qsizetype from)
+{
+    if (buffer.size() - from < maximumValueSize)
+        return true;
+    fail(QJsonParseError::DocumentTooLarge, from);
+    return false;
+}
+
+bool QJsonStreamReaderPrivate::skipSpace(qsizetype &p) const
+{
+    const char *data = buffer.constData();
+    const qsizetype size = buffer.size();
+    while (p < size) {
+        const char c = data[p];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            return true;
+        ++p;
+    }
+    return false;
+}
+
+// Returns the position after the closing quote of the string starting at p,
+// or -1 if the string does not end within the buffer.
+qsizetype QJsonStreamReaderPrivate::scanString(qsizetype p) const
+{
+    const char *data = buffer.constData();
+    const qsizetype size = buffer.size();
+    for (++p; p < size; ++p) {
+        if (data[p] == '\\')
+            ++p;
+        else if (data[p] == '"')
+            return p + 1;
+    }
+    return -1;
+}
+
+/*
+    Decodes the value in [from, to) with QJsonPrivate::Parser. Strings,
+    numbers and literals need to be followed by one more byte, which is
+    taken from the buffer when present.
+*/
+bool QJsonStreamReaderPrivate::decode(qsizetype from, qsizetype to, bool needsTerminator,
+                                      QCborValue *result)
+{
+    const char *data = buffer.constData() + from;
+    qsizetype length = to - from;
+    QByteArray copy;
+    if (needsTerminator) {
+        if (to >= buffer.size()) {
+            copy = QByteArray(data, length);
+            copy += ' ';
+            data = copy.constData();
+        }
+        ++length;
+    }
+
+    QJsonParseError parseError;
+    QJsonPrivate::Parser parser(data, int(length));
+    *result = parser.parseFragment(&parseError);
+    if (parseError.error == QJsonParseError::NoError)
+        return true;
+
+    fail(parseError.error, from + parseError.offset);
+    return false;
+}
+
+QJsonStreamReaderPrivate::ScanResult
+QJsonStreamReaderPrivate::fail(QJsonParseError::ParseError code, qsizetype at)
+{
+    error = code;
+    errorOffset = bufferOffset + at;
+    type = QJsonStreamReader::Invalid;
+    currentName.clear();
+    currentValue = QJsonValue(QJsonValue::Undefined);
+    return Failed;
+}
+
+void QJsonStreamReaderPrivate::commit(QJsonStreamReader::TokenType token, qsizetype start,
+                                      qsizetype next, Expect e)
+{
+    type = token;
+    tokenStart = start;
+    tokenExpect = e;
+    pos = next;
+    switch (token) {
+    case QJsonStreamReader::StartObject:
+        containers.append('{');
+        expect = ExpectNameOrEndObject;
+        break;
+    case QJsonStreamReader::StartArray:
+        containers.append('[');
+        expect = ExpectValueOrEndArray;
+        break;
+    case QJsonStreamReader::EndObject:
+    case QJsonStreamReader::EndArray:
+        containers.removeLast();
+        Q_FALLTHROUGH();
+    default:
+        expect = containers.isEmpty() ? ExpectValue : ExpectSeparatorOrEnd;
+        break;
+    case QJsonStreamReader::Name:
+        expect = ExpectValue;
+        break;
+    }
+    if (token != QJsonStreamReader::String && token != QJsonStreamReader::Number
+            && token != QJsonStreamReader::Bool && token != QJsonStreamReader::Null) {
+        currentValue = QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*
+    Tries to read the next token. Nothing is changed unless the token is
+    complete, so that the read can be repeated once more data is available.
+*/
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::readToken()
+{
+    const bool finished = inputFinished();
+    if (!bomChecked && (device || !buffer.isEmpty())) {
+        // wait until a partial byte order mark is either complete or not one
+        const qsizetype available = qMin(buffer.size(), qsizetype(3));
+        if (memcmp(buffer.constData(), "\xef\xbb\xbf", size_t(available)) == 0) {
+            if (available < 3 && !finished)
+                return Incomplete;
+            if (available == 3)
+                pos = qMax(pos, available);
+        }
+        bomChecked = true;
+    }
+
+    qsizetype p = pos;
+    Expect e = expect;
+    while (true) {
+        if (!skipSpace(p)) {
+            if (containers.isEmpty() && e == ExpectValue) {
+                if (finished || !device) {
+                    commit(QJsonStreamReader::EndDocument, p, p, e);
+                    return Complete;
+                }
+                return Incomplete;
+            }
+            if (!finished)
+                return Incomplete;
+            return fail(containers.last() == '{' ? QJsonParseError::UnterminatedObject
+                                                 : QJsonParseError::UnterminatedArray, p);
+        }
+
+        const char c = buffer.at(p);
+        switch (e) {
+        case ExpectSeparatorOrEnd:
+            if (c == ',') {
+                ++p;
+                e = containers.last() == '{' ? ExpectName : ExpectValue;
+                continue;
+            }
+            if (containers.last() == '{') {
+                if (c != '}')
+                    return fail(QJsonParseError::UnterminatedObject, p);
+                commit(QJsonStreamReader::EndObject, p, p + 1, e);
+            } else {
+                if (c != ']')
+                    return fail(QJsonParseError::MissingValueSeparator, p);
+                commit(QJsonStreamReader::EndArray, p, p + 1, e);
+            }
+            return Complete;
+
+        case ExpectNameOrEndObject:
+            if (c == '}') {
+                commit(QJsonStreamReader::EndObject, p, p + 1, e);
+                return Complete;
+            }
+            Q_FALLTHROUGH();
+        case ExpectName: {
+            if (c != '"') {
+                return fail(c == '}' ? QJsonParseError::MissingObject
+                                     : QJsonParseError::UnterminatedObject, p);
+            }
+            const qsizetype end = scanString(p);
+            if (end < 0)
+                return finished ? fail(QJsonParseError::UnterminatedString, buffer.size())
+                                : Incomplete;
+            qsizetype q = end;
+            if (!skipSpace(q))
+                return finished ? fail(QJsonParseError::MissingNameSeparator, q) : Incomplete;
+            if (buffer.at(q) != ':')
+                return fail(QJsonParseError::MissingNameSeparator, q);
+
+            QCborValue key;
+            if (!decode(p, end, true, &key))
+                return Failed;
+            currentName = key.toString();
+            commit(QJsonStreamReader::Name, p, q + 1, e);
+            return Complete;
+        }
+
+        case ExpectValueOrEndArray:
+            if (c == ']') {
+                commit(QJsonStreamReader::EndArray, p, p + 1, e);
+                return Complete;
+            }
+            Q_FALLTHROUGH();
+        case ExpectValue:
+            return readValueToken(p, e);
+        }
+    }
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::readValueToken(qsizetype p, Expect e)
+{
+    const bool finished = inputFinished();
+    const char *data = buffer.constData();
+    const qsizetype size = buffer.size();
+    QJsonStreamReader::TokenType token;
+    qsizetype end;
+
+    switch (data[p]) {
+    case '{':
+    case '[':
+        if (containers.size() >= nestingLimit)
+            return fail(QJsonParseError::DeepNesting, p);
+        commit(data[p] == '{' ? QJsonStreamReader::StartObject : QJsonStreamReader::StartArray,
+               p, p + 1, e);
+        return Complete;
+
+    case '}':
+    case ']':
+        return fail(QJsonParseError::MissingObject, p);
+    case ',':
+        return fail(QJsonParseError::IllegalValue, p);
+
+    case '"':
+        end = scanString(p);
+        if (end < 0)
+            return finished ? fail(QJsonParseError::UnterminatedString, size) : Incomplete;
+        token = QJsonStreamReader::String;
+        break;
+
+    case 't':
+    case 'f':
+    case 'n':
+        end = p + (data[p] == 'f' ? 5 : 4);
+        if (end > size) {
+            if (!finished)
+                return Incomplete;
+            end = size;
+        }
+        token = data[p] == 'n' ? QJsonStreamReader::Null : QJsonStreamReader::Bool;
+        break;
+
+    default:
+        end = p;
+        while (end < size && ((data[end] >= '0' && data[end] <= '9') || data[end] == '-'
+                              || data[end] == '+' || data[end] == '.' || data[end] == 'e'
+                              || data[end] == 'E')) {
+            ++end;
+        }
+        if (end == size && !finished)
+            return Incomplete;
+        token = QJsonStreamReader::Number;
+        break;
+    }
+
+    QCborValue value;
+    if (!decode(p, end, true, &value))
+        return Failed;
+    currentValue = QJsonPrivate::Value::fromTrustedCbor(value);
+    commit(token, p, end, e);
+    return Complete;
+}
+
+/*
+    Reads the object or array that the current token opens, up to its end,
+    and decodes it in one go.
+*/
+QJsonValue QJsonStreamReaderPrivate::readContainer()
+{
+    // positions are kept relative to tokenStart, which refill() may move
+    qsizetype scanned = pos - tokenStart;
+    int depth = 1;
+    bool inString = false;
+    while (true) {
+        const char *data = buffer.constData();
+        const qsizetype size = buffer.size();
+        qsizetype q = tokenStart + scanned;
+        while (q < size && depth) {
+            const char c = data[q++];
+            if (inString) {
+                if (c == '\\') {
+                    if (q == size) {
+                        --q;    // look at the escape again once there is more data
+                        break;
+                    }
+                    ++q;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '{' || c == '[') {
+                // the limit counts the containers around this one, too
+                if (containers.size() + depth > nestingLimit) {
+                    fail(QJsonParseError::DeepNesting, q - 1);
+                    return QJsonValue(QJsonValue::Undefined);
+                }
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            }
+        }
+
+        if (!depth) {
+            QCborValue value;
+            if (!decode(tokenStart, q, false, &value))
+                return QJsonValue(QJsonValue::Undefined);
+            commit(containers.last() == '{' ? QJsonStreamReader::EndObject
+                                            : QJsonStreamReader::EndArray, q - 1, q, expect);
+            return QJsonPrivate::Value::fromTrustedCbor(value);
+        }
+
+        scanned = q - tokenStart;
+        if (!checkSize(tokenStart))
+            return QJsonValue(QJsonValue::Undefined);
+        if (refill())
+            continue;
+
+        if (inputFinished()) {
+            // let the parser find out what exactly is wrong
+            QCborValue value;
+            decode(tokenStart, buffer.size(), true, &value);
+            if (error == QJsonParseError::NoError) {
+                fail(containers.last() == '{' ? QJsonParseError::UnterminatedObject
+                                              : QJsonParseError::UnterminatedArray,
+                     buffer.size());
+            }
+            return QJsonValue(QJsonValue::Undefined);
+        }
+
+        // roll back to before the start of the container and wait for more
+        rollBack(tokenStart, tokenExpect);
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*
+    Goes back to before the StartObject or StartArray token at 'start',
+    which was read when the grammar expected 'e'.
+*/
+void QJsonStreamReaderPrivate::rollBack(qsizetype start, Expect e)
+{
+    containers.resize(containers.size() - 1);
+    expect = e;
+    pos = tokenStart = start;
+    type = QJsonStreamReader::NoToken;
+    currentValue = QJsonValue(QJsonValue::Undefined);
+    starved = true;
+}
+
+/*
+    Skips the object or array that the current token opens, validating its
+    tokens without decoding it as a whole. Its data is kept, so that the
+    reader can go back to its start if the input ends before it does.
+*/
+bool QJsonStreamReaderPrivate::skipContainer()
+{
+    const qsizetype outerDepth = containers.size() - 1;
+    const Expect startExpect = tokenExpect;
+    keepFrom = tokenStart;
+    while (containers.size() > outerDepth) {
+        tokenStart = pos;
+        switch (readToken()) {
+        case Complete:
+            continue;
+        case Failed:
+            keepFrom = -1;
+            return false;
+        case Incomplete:
+            if (!checkSize(keepFrom)) {
+                keepFrom = -1;
+                return false;
+            }
+            if (refill())
+                continue;
+            break;
+        }
+
+        // more containers may have been opened since
+        const qsizetype start = keepFrom;
+        keepFrom = -1;
+        containers.resize(outerDepth + 1);
+        rollBack(start, startExpect);
+        return false;
+    }
+    keepFrom = -1;
+    return true;
+}
+
+/*!
+    Constructs a stream reader without data. Use setDevice() or addData()
+    to provide input.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a stream reader that reads from \a device, which must already
+    be open.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a stream reader that reads from \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    addData(data);
+}
+
+/*!
+    Destroys the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device, resetting the state of the reader.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->reset();
+    d->device = device;
+    if (device && device->isSequential()) {
+        QJsonStreamReaderPrivate *priv = d.data();
+        d->readChannelConnection = QObject::connect(device, &QIODevice::readChannelFinished,
+                                                    [priv] { priv->channelFinished = true; });
+    }
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr if none was set.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Adds more \a data for the reader to read. This function does nothing if
+    the reader has a device(), or if finishInput() was called.
+
+    \sa readNext(), finishInput(), clear()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    if (d->inputComplete) {
+        qWarning("QJsonStreamReader: addData() after finishInput()");
+        return;
+    }
+    // drop what has been read already
+    d->discard();
+    d->buffer += data;
+    d->starved = false;
+}
+
+/*!
+    Tells the reader that no more data will follow the data passed with
+    addData(), or the data that device() currently has available. Reading
+    then reports a top-level number at the end of the input, and incomplete
+    input as an error, instead of waiting for more data.
+
+    Devices that can tell when their input ends do not need this, see
+    \l{Incremental parsing}. For a sequential device such as a pipe, call it
+    when the device has no more data, for instance after QProcess::finished().
+
+    \sa addData(), atEnd()
+*/
+void QJsonStreamReader::finishInput()
+{
+    d->inputComplete = true;
+    d->starved = false;
+}
+
+/*!
+    Sets the maximum number of bytes that the data of one token, or of the
+    value being read by readValue() or skipped by skipValue(), may occupy
+    to \a size. If it grows larger, reading fails with
+    QJsonParseError::DocumentTooLarge. The default is 128 MB.
+
+    \sa maximumValueSize()
+*/
+void QJsonStreamReader::setMaximumValueSize(qsizetype size)
+{
+    d->maximumValueSize = size;
+}
+
+/*!
+    Returns the maximum number of bytes that the data of one value may
+    occupy.
+
+    \sa setMaximumValueSize()
+*/
+qsizetype QJsonStreamReader::maximumValueSize() const
+{
+    return d->maximumValueSize;
+}
+
+/*!
+    Removes all data from the reader and resets its state, including the
+    device, if any.
+
+    \sa setDevice(), addData()
+*/
+void QJsonStreamReader::clear()
+{
+    d->reset();
+    d->device = nullptr;
+}
+
+/*!
+    Returns \c true if the reader has read all of the available data, or if
+    an error has occurred; otherwise returns \c false.
+
+    After more data becomes available, this function returns \c false again.
+
+    \sa readNext(), hasError()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    if (d->error != QJsonParseError::NoError)
+        return true;
+    if (d->type == EndDocument || (d->type == NoToken && d->starved)) {
+        if (d->device)
+            return d->device->atEnd();
+        return d->starved || d->pos >= d->buffer.size();
+    }
+    return false;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    If more data is needed to read the token, returns NoToken. Once an error
+    has occurred, returns Invalid without reading anything.
+
+    \sa tokenType(), atEnd()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    if (d->error != QJsonParseError::NoError)
+        return Invalid;
+
+    d->starved = false;
+    d->tokenStart = d->pos;
+    while (true) {
+        switch (d->readToken()) {
+        case QJsonStreamReaderPrivate::Complete:
+        case QJsonStreamReaderPrivate::Failed:
+            return d->type;
+        case QJsonStreamReaderPrivate::Incomplete:
+            if (!d->checkSize(d->tokenStart))
+                return Invalid;
+            if (d->refill())
+                continue;
+            d->type = NoToken;
+            d->starved = true;
+            d->currentValue = QJsonValue(QJsonValue::Undefined);
+            return NoToken;
+        }
+    }
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa readNext()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->type;
+}
+
+/*!
+    Returns the number of objects and arrays the current token is nested in.
+    A StartObject or StartArray token counts the container it opens.
+*/
+int QJsonStreamReader::depth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns the offset of the current token in the input, or, if an error
+    has occurred, the offset at which it was detected.
+*/
+qint64 QJsonStreamReader::offset() const
+{
+    if (d->error != QJsonParseError::NoError)
+        return d->errorOffset;
+    return d->bufferOffset + d->tokenStart;
+}
+
+/*!
+    Returns the key of the object member if the current token is a Name;
+    otherwise, returns the key of the last member read.
+*/
+QString QJsonStreamReader::name() const
+{
+    return d->currentName;
+}
+
+/*!
+    Returns the value of the current token if it is a String, Number, Bool
+    or Null; otherwise returns an undefined QJsonValue.
+
+    \sa readValue()
+*/
+QJsonValue QJsonStreamReader::value() const
+{
+    return d->currentValue;
+}
+
+/*!
+    Reads a complete value and returns it. If the current token is
+    StartObject or StartArray, the whole object or array is read, and the
+    reader is positioned on the matching EndObject or EndArray token.
+    Otherwise, the next token is read first, and the value it starts is
+    returned; this makes it possible to call readValue() in a loop to read a
+    sequence of values.
+
+    To read the elements of an array one at a time, read its StartArray
+    token and the first token of each element with readNext(), and call
+    readValue() for the elements that are objects or arrays:
+
+    \code
+    reader.readNext(); // StartArray
+    while (reader.readNext() != QJsonStreamReader::EndArray && !reader.hasError()) {
+        const QJsonValue element = reader.value().isUndefined() ? reader.readValue()
+                                                                 : reader.value();
+        process(element);
+    }
+    \endcode
+
+    Returns an undefined QJsonValue if an error occurred, if the data
+    ended, or if more data is needed to read the complete value; in the last
+    case, the reader goes back to before the value, and calling readValue()
+    again once more data is available reads it from the start.
+
+    \sa value(), skipValue()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    TokenType token = d->type;
+    if (token != StartObject && token != StartArray)
+        token = readNext();
+
+    switch (token) {
+    case StartObject:
+    case StartArray:
+        return d->readContainer();
+    case String:
+    case Number:
+    case Bool:
+    case Null:
+        return d->currentValue;
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*!
+    Skips the current value, as readValue() would read it, without
+    decoding it. Returns \c true if the value was skipped, and \c false if
+    an error occurred, or if there was no value or not enough data to skip
+    it; in the last case, the reader goes back to before the value, as
+    readValue() does.
+
+    \sa readValue()
+*/
+bool QJsonStreamReader::skipValue()
+{
+    TokenType token = d->type;
+    if (token != StartObject && token != StartArray)
+        token = readNext();
+
+    switch (token) {
+    case StartObject:
+    case StartArray:
+        return d->skipContainer();
+    case String:
+    case Number:
+    case Bool:
+    case Null:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*!
+    Returns \c true if an error has occurred.
+
+    \sa error(), errorString()
+*/
+bool QJsonStreamReader::hasError() const
+{
+    return d->error != QJsonParseError::NoError;
+}
+
+/*!
+    Returns the type of the error that occurred, or
+    QJsonParseError::NoError.
+
+    \sa errorString(), offset()
+*/
+QJsonParseError::ParseError QJsonStreamReader::error() const
+{
+    return d->error;
+}
+
+/*!
+    Returns a human-readable description of the error that occurred, or an
+    empty string if there was none.
+
+    \sa error()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    if (d->error == QJsonParseError::NoError)
+        return QString();
+    QJsonParseError parseError;
+    parseError.offset = int(d->errorOffset);
+    parseError.error = d->error;
+    return parseError.errorString();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
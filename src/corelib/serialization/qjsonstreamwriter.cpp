@@ -0,0 +1,409 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamwriter.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+#include "qjson_p.h"
+#include "qjsonwriter_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QJsonStreamWriter class writes JSON incrementally to a
+    QIODevice or a QByteArray.
+
+    QJsonStreamWriter is the counterpart of QJsonStreamReader: instead of
+    building a QJsonDocument and converting it with QJsonDocument::toJson(),
+    values are written as they are produced, so that arbitrarily large
+    documents can be written with bounded memory.
+
+    Objects and arrays are opened with writeStartObject() and
+    writeStartArray() and closed with writeEndObject() and writeEndArray().
+    Each member of an object is written as a call to writeName() followed by
+    the value. Complete QJsonValue, QJsonObject or QJsonArray values can be
+    written with writeValue().
+
+    Any number of values can be written at the top level; each one is
+    followed by a newline, so that the output in the default
+    QJsonDocument::Compact format is newline-delimited JSON:
+
+    \code
+    QJsonStreamWriter writer(&file);
+    for (const Record &record : records) {
+        writer.writeStartObject();
+        writer.writeName(u"id");
+        writer.writeInteger(record.id);
+        writer.writeName(u"message");
+        writer.writeString(record.message);
+        writer.writeEndObject();
+    }
+    \endcode
+
+    In the QJsonDocument::Indented format, the output for each top-level
+    value is the same as that of QJsonDocument::toJson(). Strings are escaped
+    and numbers formatted by the same code as QJsonDocument uses.
+
+    Output is written to the device whenever a top-level value is complete,
+    when enough data has accumulated, on flush(), and when the writer is
+    destroyed.
+
+    \sa QJsonStreamReader, QJsonDocument
+*/
+
+static const qsizetype flushThreshold = 16 * 1024;
+
+class QJsonStreamWriterPrivate
+{
+public:
+    struct Level {
+        char closer;
+        bool hasElements;
+    };
+
+    QByteArray &out() { return target ? *target : pending; }
+    void separate();
+    void beginValue();
+    void endValue();
+    void endContainer();
+    void flush();
+
+    QIODevice *device = nullptr;
+    QByteArray *target = nullptr;   // when writing to a QByteArray
+    QByteArray pending;             // not yet written to device
+    QVarLengthArray<Level, 16> levels;
+    bool compact = true;
+    bool nameWritten = false;
+    bool error = false;
+};
+
+// writes the separator and indentation before the next element of a container
+void QJsonStreamWriterPrivate::separate()
+{
+    Level &level = levels.last();
+    QByteArray &json = out();
+    if (level.hasElements)
+        json += compact ? "," : ",\n";
+    level.hasElements = true;
+    if (!compact)
+        json += QByteArray(4 * levels.size(), ' ');
+}
+
+void QJsonStreamWriterPrivate::beginValue()
+{
+    if (levels.isEmpty())
+        return;
+    if (levels.last().closer == '}') {
+        Q_ASSERT_X(nameWritten, "QJsonStreamWriter", "writeName() must precede object members");
+        nameWritten = false;
+        return;
+    }
+    separate();
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (levels.isEmpty()) {
+        out() += '\n';
+        flush();
+    } else if (pending.size() >= flushThreshold) {
+        flush();
+    }
+}
+
+void QJsonStreamWriterPrivate::endContainer()
+{
+    const Level level = levels.last();
+    levels.removeLast();
+    QByteArray &json = out();
+    if (!compact) {
+        if (level.hasElements)
+            json += '\n';
+        json += QByteArray(4 * levels.size(), ' ');
+    }
+    json += level.closer;
+    endValue();
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (!device || pending.isEmpty())
+        return;
+    if (device->write(pending) != pending.size())
+        error = true;
+    pending.clear();
+}
+
+/*!
+    Constructs a writer without a device. Use setDevice() before writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter()
+    : d(new QJsonStreamWriterPrivate)
+{
+}
+
+/*!
+    Constructs a writer that writes to \a device, which must already be
+    open.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : QJsonStreamWriter()
+{
+    d->device = device;
+}
+
+/*!
+    Constructs a writer that appends to \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : QJsonStreamWriter()
+{
+    d->target = data;
+}
+
+/*!
+    Flushes pending output and destroys the writer. Objects and arrays that
+    have not been closed are left open.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Flushes pending output to the current device and makes the writer write
+    to \a device from now on, starting at the top level.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->target = nullptr;
+    d->levels.clear();
+    d->nameWritten = false;
+    d->error = false;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if there is none
+    or the writer appends to a QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the output format to \a format. The default is
+    QJsonDocument::Compact.
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->compact = format == QJsonDocument::Compact;
+}
+
+/*!
+    Returns the output format.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->compact ? QJsonDocument::Compact : QJsonDocument::Indented;
+}
+
+/*!
+    Starts a new object.
+
+    \sa writeEndObject(), writeName()
+*/
+void QJsonStreamWriter::writeStartObject()
+{
+    d->beginValue();
+    d->out() += d->compact ? "{" : "{\n";
+    d->levels.append({ '}', false });
+}
+
+/*!
+    Ends the current object.
+
+    \sa writeStartObject()
+*/
+void QJsonStreamWriter::writeEndObject()
+{
+    Q_ASSERT_X(!d->levels.isEmpty() && d->levels.last().closer == '}' && !d->nameWritten,
+               "QJsonStreamWriter::writeEndObject", "no object to end");
+    d->endContainer();
+}
+
+/*!
+    Starts a new array.
+
+    \sa writeEndArray()
+*/
+void QJsonStreamWriter::writeStartArray()
+{
+    d->beginValue();
+    d->out() += d->compact ? "[" : "[\n";
+    d->levels.append({ ']', false });
+}
+
+/*!
+    Ends the current array.
+
+    \sa writeStartArray()
+*/
+void QJsonStreamWriter::writeEndArray()
+{
+    Q_ASSERT_X(!d->levels.isEmpty() && d->levels.last().closer == ']',
+               "QJsonStreamWriter::writeEndArray", "no array to end");
+    d->endContainer();
+}
+
+/*!
+    Writes \a name as the key of the next member of the current object. The
+    value must be written next.
+*/
+void QJsonStreamWriter::writeName(QStringView name)
+{
+    Q_ASSERT_X(!d->levels.isEmpty() && d->levels.last().closer == '}' && !d->nameWritten,
+               "QJsonStreamWriter::writeName", "not expecting a member name");
+    d->separate();
+    QByteArray &json = d->out();
+    json += '"';
+    json += QJsonPrivate::Writer::escapedString(name);
+    json += d->compact ? "\":" : "\": ";
+    d->nameWritten = true;
+}
+
+/*!
+    Writes the string \a value.
+*/
+void QJsonStreamWriter::writeString(QStringView value)
+{
+    d->beginValue();
+    QByteArray &json = d->out();
+    json += '"';
+    json += QJsonPrivate::Writer::escapedString(value);
+    json += '"';
+    d->endValue();
+}
+
+/*!
+    Writes the integer \a value.
+*/
+void QJsonStreamWriter::writeInteger(qint64 value)
+{
+    d->beginValue();
+    d->out() += QByteArray::number(value);
+    d->endValue();
+}
+
+/*!
+    Writes the number \a value. As JSON cannot represent infinities and NaN,
+    they are written as \c null.
+*/
+void QJsonStreamWriter::writeDouble(double value)
+{
+    d->beginValue();
+    QJsonPrivate::Writer::valueToJson(QCborValue(value), d->out(), 0, d->compact);
+    d->endValue();
+}
+
+/*!
+    Writes \c true or \c false, depending on \a value.
+*/
+void QJsonStreamWriter::writeBool(bool value)
+{
+    d->beginValue();
+    d->out() += value ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    Writes \c null.
+*/
+void QJsonStreamWriter::writeNull()
+{
+    d->beginValue();
+    d->out() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \a value, including all of its elements if it is an object or an
+    array. Undefined values are written as \c null.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    d->beginValue();
+    QJsonPrivate::Writer::valueToJson(QJsonPrivate::Value::asCbor(value), d->out(),
+                                      d->compact ? 0 : int(d->levels.size()), d->compact);
+    d->endValue();
+}
+
+/*!
+    Writes all pending output to the device.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+/*!
+    Returns \c true if writing to the device failed.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d->error;
+}
+
+QT_END_NAMESPACE
@@ -482,6 +482,292 @@ static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *
 }
 #endif
 
+// The functions below convert runs of two-byte (U+0080 to U+07FF, e.g. Greek,
+// Cyrillic, Hebrew, Arabic) and three-byte (U+0800 to U+FFFF, e.g. CJK)
+// sequences. Each validates a whole register of sequences, converts it, and
+// advances past the leading valid ones, leaving anything else (invalid input,
+// ASCII, sequences of a different length) to the scalar code. They always
+// store a full register, so callers need at least as much room in the output
+// as the normal worst case for the remaining input.
+#if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+enum { MultiByteDecodeMinimum = 16, MultiByteEncodeMinimum = 8 };
+
+// Returns the number of leading 16-bit lanes set in the comparison result.
+static inline uint leadingLanes(__m128i ok)
+{
+    return qCountTrailingZeroBits(~uint(_mm_movemask_epi8(ok))) / 2;
+}
+
+static inline bool simdDecodeTwoByte(ushort *&dst, const uchar *&src)
+{
+    // eight sequences: the lead byte in the low half of each lane, the
+    // continuation byte in the high half
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+    // check for 110xxxxx 10xxxxxx, rejecting the overlong 0xC0 and 0xC1 leads
+    __m128i ok = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xc0e0))),
+                                 _mm_set1_epi16(short(0x80c0)));
+    const __m128i overlong = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(0x1e)),
+                                             _mm_setzero_si128());
+    ok = _mm_andnot_si128(overlong, ok);
+    const uint n = leadingLanes(ok);
+    if (!n)
+        return false;
+
+    const __m128i high = _mm_slli_epi16(_mm_and_si128(data, _mm_set1_epi16(0x1f)), 6);
+    const __m128i low = _mm_and_si128(_mm_srli_epi16(data, 8), _mm_set1_epi16(0x3f));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(high, low));
+    dst += n;
+    src += 2 * n;
+    return true;
+}
+
+static inline bool simdEncodeTwoByte(uchar *&dst, const ushort *&src)
+{
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+    // 0x80 <= c < 0x800
+    __m128i ok = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))),
+                                 _mm_setzero_si128());
+    const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))),
+                                          _mm_setzero_si128());
+    ok = _mm_andnot_si128(ascii, ok);
+    const uint n = leadingLanes(ok);
+    if (!n)
+        return false;
+
+    const __m128i lead = _mm_or_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0xc0));
+    const __m128i cont = _mm_slli_epi16(_mm_or_si128(_mm_and_si128(data, _mm_set1_epi16(0x3f)),
+                                                     _mm_set1_epi16(0x80)), 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(lead, cont));
+    dst += 2 * n;
+    src += n;
+    return true;
+}
+
+#  ifdef __SSSE3__
+static inline bool simdDecodeThreeByte(ushort *&dst, const uchar *&src)
+{
+    // gather the bytes of five sequences into the 16-bit lanes of three registers
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i b0 = _mm_shuffle_epi8(data, _mm_setr_epi8(0, -1, 3, -1, 6, -1, 9, -1, 12, -1,
+                                                            -1, -1, -1, -1, -1, -1));
+    const __m128i b1 = _mm_shuffle_epi8(data, _mm_setr_epi8(1, -1, 4, -1, 7, -1, 10, -1, 13, -1,
+                                                            -1, -1, -1, -1, -1, -1));
+    const __m128i b2 = _mm_shuffle_epi8(data, _mm_setr_epi8(2, -1, 5, -1, 8, -1, 11, -1, 14, -1,
+                                                            -1, -1, -1, -1, -1, -1));
+
+    // check for 1110xxxx 10xxxxxx 10xxxxxx
+    const __m128i contMask = _mm_set1_epi16(0xc0);
+    const __m128i contTag = _mm_set1_epi16(0x80);
+    __m128i ok = _mm_cmpeq_epi16(_mm_and_si128(b0, _mm_set1_epi16(0xf0)), _mm_set1_epi16(0xe0));
+    ok = _mm_and_si128(ok, _mm_cmpeq_epi16(_mm_and_si128(b1, contMask), contTag));
+    ok = _mm_and_si128(ok, _mm_cmpeq_epi16(_mm_and_si128(b2, contMask), contTag));
+
+    const __m128i c = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(b0, 12),
+                                                _mm_slli_epi16(_mm_and_si128(b1, _mm_set1_epi16(0x3f)), 6)),
+                                   _mm_and_si128(b2, _mm_set1_epi16(0x3f)));
+
+    // reject overlong sequences (c < 0x800) and surrogates
+    const __m128i top = _mm_and_si128(c, _mm_set1_epi16(short(0xf800)));
+    ok = _mm_andnot_si128(_mm_cmpeq_epi16(top, _mm_setzero_si128()), ok);
+    ok = _mm_andnot_si128(_mm_cmpeq_epi16(top, _mm_set1_epi16(short(0xd800))), ok);
+    ok = _mm_and_si128(ok, _mm_setr_epi16(-1, -1, -1, -1, -1, 0, 0, 0));
+    const uint n = leadingLanes(ok);
+    if (!n)
+        return false;
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), c);
+    dst += n;
+    src += 3 * n;
+    return true;
+}
+
+static inline bool simdEncodeThreeByte(uchar *&dst, const ushort *&src)
+{
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+    // 0x800 <= c, excluding surrogates
+    const __m128i top = _mm_and_si128(data, _mm_set1_epi16(short(0xf800)));
+    const __m128i bad = _mm_or_si128(_mm_cmpeq_epi16(top, _mm_setzero_si128()),
+                                     _mm_cmpeq_epi16(top, _mm_set1_epi16(short(0xd800))));
+    const uint n = leadingLanes(_mm_xor_si128(bad, _mm_set1_epi32(-1)));
+    if (!n)
+        return false;
+
+    const __m128i contTag = _mm_set1_epi16(0x80);
+    const __m128i b0 = _mm_or_si128(_mm_srli_epi16(data, 12), _mm_set1_epi16(0xe0));
+    const __m128i b1 = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0x3f)), contTag);
+    const __m128i b2 = _mm_or_si128(_mm_and_si128(data, _mm_set1_epi16(0x3f)), contTag);
+
+    // interleave the first, second and third bytes of the eight sequences
+    const __m128i b01 = _mm_packus_epi16(b0, b1);
+    const __m128i b22 = _mm_packus_epi16(b2, b2);
+    const __m128i first = _mm_or_si128(
+            _mm_shuffle_epi8(b01, _mm_setr_epi8(0, 8, -1, 1, 9, -1, 2, 10, -1, 3, 11, -1, 4, 12, -1, 5)),
+            _mm_shuffle_epi8(b22, _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1)));
+    const __m128i second = _mm_or_si128(
+            _mm_shuffle_epi8(b01, _mm_setr_epi8(13, -1, 6, 14, -1, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+            _mm_shuffle_epi8(b22, _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), first);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + 16), second);
+    dst += 3 * n;
+    src += n;
+    return true;
+}
+#  else
+static inline bool simdDecodeThreeByte(ushort *&, const uchar *&)
+{
+    return false;
+}
+
+static inline bool simdEncodeThreeByte(uchar *&, const ushort *&)
+{
+    return false;
+}
+#  endif
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+enum { MultiByteDecodeMinimum = 24, MultiByteEncodeMinimum = 8 };
+
+// Returns the number of leading lanes set in the comparison result.
+static inline uint leadingLanes(uint8x8_t ok)
+{
+    return qCountTrailingZeroBits(~vget_lane_u64(vreinterpret_u64_u8(ok), 0)) / 8;
+}
+
+static inline uint leadingLanes(uint16x8_t ok)
+{
+    return leadingLanes(vmovn_u16(ok));
+}
+
+static inline bool simdDecodeTwoByte(ushort *&dst, const uchar *&src)
+{
+    // eight sequences: the lead byte in the low half of each lane, the
+    // continuation byte in the high half
+    const uint16x8_t data = vreinterpretq_u16_u8(vld1q_u8(src));
+
+    // check for 110xxxxx 10xxxxxx, rejecting the overlong 0xC0 and 0xC1 leads
+    uint16x8_t ok = vceqq_u16(vandq_u16(data, vdupq_n_u16(0xc0e0)), vdupq_n_u16(0x80c0));
+    ok = vandq_u16(ok, vtstq_u16(data, vdupq_n_u16(0x1e)));
+    const uint n = leadingLanes(ok);
+    if (!n)
+        return false;
+
+    const uint16x8_t high = vshlq_n_u16(vandq_u16(data, vdupq_n_u16(0x1f)), 6);
+    const uint16x8_t low = vandq_u16(vshrq_n_u16(data, 8), vdupq_n_u16(0x3f));
+    vst1q_u16(dst, vorrq_u16(high, low));
+    dst += n;
+    src += 2 * n;
+    return true;
+}
+
+static inline bool simdEncodeTwoByte(uchar *&dst, const ushort *&src)
+{
+    const uint16x8_t data = vld1q_u16(src);
+
+    // 0x80 <= c < 0x800
+    uint16x8_t ok = vceqq_u16(vandq_u16(data, vdupq_n_u16(0xf800)), vdupq_n_u16(0));
+    ok = vandq_u16(ok, vtstq_u16(data, vdupq_n_u16(0xff80)));
+    const uint n = leadingLanes(ok);
+    if (!n)
+        return false;
+
+    const uint16x8_t lead = vorrq_u16(vshrq_n_u16(data, 6), vdupq_n_u16(0xc0));
+    const uint16x8_t cont = vshlq_n_u16(vorrq_u16(vandq_u16(data, vdupq_n_u16(0x3f)),
+                                                  vdupq_n_u16(0x80)), 8);
+    vst1q_u8(dst, vreinterpretq_u8_u16(vorrq_u16(lead, cont)));
+    dst += 2 * n;
+    src += n;
+    return true;
+}
+
+static inline bool simdDecodeThreeByte(ushort *&dst, const uchar *&src)
+{
+    // eight sequences, deinterleaved into their first, second and third bytes
+    const uint8x8x3_t data = vld3_u8(src);
+
+    // check for 1110xxxx 10xxxxxx 10xxxxxx
+    const uint8x8_t contMask = vdup_n_u8(0xc0);
+    const uint8x8_t contTag = vdup_n_u8(0x80);
+    uint8x8_t ok = vceq_u8(vand_u8(data.val[0], vdup_n_u8(0xf0)), vdup_n_u8(0xe0));
+    ok = vand_u8(ok, vceq_u8(vand_u8(data.val[1], contMask), contTag));
+    ok = vand_u8(ok, vceq_u8(vand_u8(data.val[2], contMask), contTag));
+
+    const uint8x8_t payload = vdup_n_u8(0x3f);
+    const uint16x8_t c = vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(data.val[0]), 12),
+                                             vshlq_n_u16(vmovl_u8(vand_u8(data.val[1], payload)), 6)),
+                                   vmovl_u8(vand_u8(data.val[2], payload)));
+
+    // reject overlong sequences (c < 0x800) and surrogates
+    const uint16x8_t top = vandq_u16(c, vdupq_n_u16(0xf800));
+    const uint16x8_t bad = vorrq_u16(vceqq_u16(top, vdupq_n_u16(0)), vceqq_u16(top, vdupq_n_u16(0xd800)));
+    ok = vbic_u8(ok, vmovn_u16(bad));
+    const uint n = leadingLanes(ok);
+    if (!n)
+        return false;
+
+    vst1q_u16(dst, c);
+    dst += n;
+    src += 3 * n;
+    return true;
+}
+
+static inline bool simdEncodeThreeByte(uchar *&dst, const ushort *&src)
+{
+    const uint16x8_t data = vld1q_u16(src);
+
+    // 0x800 <= c, excluding surrogates
+    const uint16x8_t top = vandq_u16(data, vdupq_n_u16(0xf800));
+    const uint16x8_t bad = vorrq_u16(vceqq_u16(top, vdupq_n_u16(0)), vceqq_u16(top, vdupq_n_u16(0xd800)));
+    const uint n = leadingLanes(vmvnq_u16(bad));
+    if (!n)
+        return false;
+
+    const uint16x8_t contTag = vdupq_n_u16(0x80);
+    uint8x8x3_t bytes;
+    bytes.val[0] = vmovn_u16(vorrq_u16(vshrq_n_u16(data, 12), vdupq_n_u16(0xe0)));
+    bytes.val[1] = vmovn_u16(vorrq_u16(vandq_u16(vshrq_n_u16(data, 6), vdupq_n_u16(0x3f)), contTag));
+    bytes.val[2] = vmovn_u16(vorrq_u16(vandq_u16(data, vdupq_n_u16(0x3f)), contTag));
+    vst3_u8(dst, bytes);
+    dst += 3 * n;
+    src += n;
+    return true;
+}
+#endif
+
+#if (defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)) \
+    || (defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64))
+static inline bool simdDecodeNonAscii(ushort *&dst, const uchar *&src, const uchar *end)
+{
+    if (end - src < MultiByteDecodeMinimum)
+        return false;
+    if (*src >= 0xc2 && *src < 0xe0)
+        return simdDecodeTwoByte(dst, src);
+    if ((*src & 0xf0) == 0xe0)
+        return simdDecodeThreeByte(dst, src);
+    return false;
+}
+
+static inline bool simdEncodeNonAscii(uchar *&dst, const ushort *&src, const ushort *end)
+{
+    if (end - src < MultiByteEncodeMinimum || *src < 0x80)
+        return false;
+    if (*src < 0x800)
+        return simdEncodeTwoByte(dst, src);
+    return simdEncodeThreeByte(dst, src);
+}
+#else
+static inline bool simdDecodeNonAscii(ushort *&, const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static inline bool simdEncodeNonAscii(uchar *&, const ushort *&, const ushort *)
+{
+    return false;
+}
+#endif
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(QStringView in)
@@ -500,6 +786,9 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
             break;
 
         do {
+            if (simdEncodeNonAscii(dst, src, end))
+                continue;
+
             ushort u = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, dst, src, end);
             if (res < 0) {
@@ -567,6 +856,9 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
             break;
 
         do {
+            if (simdEncodeNonAscii(cursor, src, end))
+                continue;
+
             ushort uc = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, cursor, src, end);
             if (Q_LIKELY(res >= 0))
@@ -654,6 +946,9 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, QByteArrayView in) noexcept
                 break;
 
             do {
+                if (simdDecodeNonAscii(dst, src, end))
+                    continue;
+
                 uchar b = *src++;
                 int res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
                 if (res < 0) {
@@ -756,6 +1051,8 @@ QChar *QUtf8::convertToUnicode(QChar *out, QByteArrayView in, QStringConverter::
     while (res >= 0 && src < end) {
         if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
             break;
+        if (simdDecodeNonAscii(dst, src, end))
+            continue;
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -39,44 +39,69 @@
 
 #include "qresultstore.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace QtPrivate {
 
+/*!
+  \internal
+
+  Returns the position of the last item in \a store that starts at or before
+  \a index, or -1 if there is none. Results are mostly added and looked up in
+  order, so the last item is checked before searching.
+ */
+static qsizetype findItemAtOrBefore(const ResultItemList &store, int index)
+{
+    if (store.isEmpty() || index < store.first().index)
+        return -1;
+    if (store.last().index <= index)
+        return store.size() - 1;
+    const auto it = std::upper_bound(store.cbegin(), store.cend(), index,
+                                     [](int index, const IndexedResultItem &entry) {
+                                         return index < entry.index;
+                                     });
+    return (it - store.cbegin()) - 1;
+}
+
 /*!
   \internal
 
   Finds result in \a store by \a index
  */
-static ResultIteratorBase findResult(const QMap<int, ResultItem> &store, int index)
+static ResultIteratorBase findResult(const ResultItemList &store, int index)
 {
-    if (store.isEmpty())
-        return ResultIteratorBase(store.end());
-    QMap<int, ResultItem>::const_iterator it = store.lowerBound(index);
-
-    // lowerBound returns either an iterator to the result or an iterator
-    // to the nearest greater index. If the latter happens it might be
-    // that the result is stored in a vector at the previous index.
-    if (it == store.end()) {
-        --it;
-        if (it.value().isVector() == false) {
-            return ResultIteratorBase(store.end());
-        }
-    } else {
-        if (it.key() > index) {
-            if (it == store.begin())
-                return ResultIteratorBase(store.end());
-            --it;
-        }
-    }
+    const qsizetype position = findItemAtOrBefore(store, index);
+    if (position == -1)
+        return ResultIteratorBase(&store, store.size());
+
+    // The result is either the item itself, or stored in a vector that
+    // starts at a lower index.
+    const IndexedResultItem &entry = store.at(position);
+    const int vectorIndex = index - entry.index;
+    if (vectorIndex >= entry.item.count())
+        return ResultIteratorBase(&store, store.size());
+    return ResultIteratorBase(&store, position, vectorIndex);
+}
 
-    const int vectorIndex = index - it.key();
+/*!
+  \internal
 
-    if (vectorIndex >= it.value().count())
-        return ResultIteratorBase(store.end());
-    else if (it.value().isVector() == false && vectorIndex != 0)
-        return ResultIteratorBase(store.end());
-    return ResultIteratorBase(it, vectorIndex);
+  Stores \a item at \a index in \a store, replacing any item that
+  starts at the same index.
+ */
+static void insertItem(ResultItemList &store, int index, const ResultItem &item)
+{
+    if (store.isEmpty() || store.last().index < index) {
+        store.append({ index, item });
+        return;
+    }
+    const qsizetype position = findItemAtOrBefore(store, index);
+    if (position != -1 && store.at(position).index == index)
+        store[position].item = item;
+    else
+        store.insert(position + 1, { index, item });
 }
 
 /*!
@@ -95,19 +120,19 @@ static ResultIteratorBase findResult(const QMap<int, ResultItem> &store, int ind
  */
 
 ResultIteratorBase::ResultIteratorBase()
- : mapIterator(QMap<int, ResultItem>::const_iterator()), m_vectorIndex(0) { }
-ResultIteratorBase::ResultIteratorBase(QMap<int, ResultItem>::const_iterator _mapIterator, int _vectorIndex)
- : mapIterator(_mapIterator), m_vectorIndex(_vectorIndex) { }
+ : m_items(nullptr), m_position(0), m_vectorIndex(0) { }
+ResultIteratorBase::ResultIteratorBase(const ResultItemList *items, qsizetype position, int _vectorIndex)
+ : m_items(items), m_position(position), m_vectorIndex(_vectorIndex) { }
 
 int ResultIteratorBase::vectorIndex() const { return m_vectorIndex; }
-int ResultIteratorBase::resultIndex() const { return mapIterator.key() + m_vectorIndex; }
+int ResultIteratorBase::resultIndex() const { return m_items->at(m_position).index + m_vectorIndex; }
 
 ResultIteratorBase ResultIteratorBase::operator++()
 {
     if (canIncrementVectorIndex()) {
         ++m_vectorIndex;
     } else {
-        ++mapIterator;
+        ++m_position;
         m_vectorIndex = 0;
     }
     return *this;
@@ -115,18 +140,19 @@ ResultIteratorBase ResultIteratorBase::operator++()
 
 int ResultIteratorBase::batchSize() const
 {
-    return mapIterator.value().count();
+    return item().count();
 }
 
 void ResultIteratorBase::batchedAdvance()
 {
-    ++mapIterator;
+    ++m_position;
     m_vectorIndex = 0;
 }
 
 bool ResultIteratorBase::operator==(const ResultIteratorBase &other) const
 {
-    return (mapIterator == other.mapIterator && m_vectorIndex == other.m_vectorIndex);
+    return (m_items == other.m_items && m_position == other.m_position
+            && m_vectorIndex == other.m_vectorIndex);
 }
 
 bool ResultIteratorBase::operator!=(const ResultIteratorBase &other) const
@@ -136,17 +162,17 @@ bool ResultIteratorBase::operator!=(const ResultIteratorBase &other) const
 
 bool ResultIteratorBase::isVector() const
 {
-    return mapIterator.value().isVector();
+    return item().isVector();
 }
 
 bool ResultIteratorBase::canIncrementVectorIndex() const
 {
-    return (m_vectorIndex + 1 < mapIterator.value().m_count);
+    return (m_vectorIndex + 1 < item().m_count);
 }
 
 bool ResultIteratorBase::isValid() const
 {
-    return mapIterator.value().isValid();
+    return item().isValid();
 }
 
 ResultStoreBase::ResultStoreBase()
@@ -180,7 +206,7 @@ void ResultStoreBase::syncResultCount()
 void ResultStoreBase::insertResultItemIfValid(int index, ResultItem &resultItem)
 {
     if (resultItem.isValid()) {
-        m_results[index] = resultItem;
+        insertItem(m_results, index, resultItem);
         syncResultCount();
     } else {
         filteredResults += resultItem.count();
@@ -191,7 +217,7 @@ int ResultStoreBase::insertResultItem(int index, ResultItem &resultItem)
 {
     int storeIndex;
     if (m_filterMode && index != -1 && index > insertIndex) {
-        pendingResults[index] = resultItem;
+        insertItem(pendingResults, index, resultItem);
         storeIndex = index;
     } else {
         storeIndex = updateInsertIndex(index, resultItem.count());
@@ -207,22 +233,23 @@ bool ResultStoreBase::containsValidResultItem(int index) const
     const bool inPending = m_filterMode && index != -1 && index > insertIndex;
     const auto &store = inPending ? pendingResults : m_results;
     auto it = findResult(store, index);
-    return it != ResultIteratorBase(store.end()) && it.isValid();
+    return it != ResultIteratorBase(&store, store.size()) && it.isValid();
 }
 
 void ResultStoreBase::syncPendingResults()
 {
     // check if we can insert any of the pending results:
-    QMap<int, ResultItem>::iterator it = pendingResults.begin();
-    while (it != pendingResults.end()) {
-        int index = it.key();
+    while (!pendingResults.isEmpty()) {
+        int index = pendingResults.first().index;
         if (index != resultCount + filteredResults)
             break;
 
-        ResultItem result = it.value();
+        ResultItem result = pendingResults.first().item;
+        pendingResults.removeFirst();
+        // the result is no longer pending; later ones at lower indexes are
+        // duplicates and have to be looked up in m_results
+        insertIndex = qMax(insertIndex, index + result.count());
         insertResultItemIfValid(index - filteredResults, result);
-        pendingResults.erase(it);
-        it = pendingResults.begin();
     }
 }
 
@@ -249,12 +276,12 @@ int ResultStoreBase::addResults(int index, const void *results, int vectorSize,
 
 ResultIteratorBase ResultStoreBase::begin() const
 {
-    return ResultIteratorBase(m_results.begin());
+    return ResultIteratorBase(&m_results, 0);
 }
 
 ResultIteratorBase ResultStoreBase::end() const
 {
-    return ResultIteratorBase(m_results.end());
+    return ResultIteratorBase(&m_results, m_results.size());
 }
 
 bool ResultStoreBase::hasNextResult() const
@@ -40,7 +40,7 @@
 #ifndef QTCORE_RESULTSTORE_H
 #define QTCORE_RESULTSTORE_H
 
-#include <QtCore/qmap.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qdebug.h>
 
 #include <utility>
@@ -72,11 +72,30 @@ public:
     const void *result; // if count is 0 it's a result, otherwise it's a vector.
 };
 
+// A ResultItem together with the index of its first result. The store keeps
+// these sorted by index in one contiguous array: results are reported in
+// order or close to it, so new items are nearly always appended, and both
+// lookups and iteration stay within consecutive memory.
+struct IndexedResultItem
+{
+    int index;
+    ResultItem item;
+};
+
+} // namespace QtPrivate
+
+Q_DECLARE_TYPEINFO(QtPrivate::ResultItem, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(QtPrivate::IndexedResultItem, Q_PRIMITIVE_TYPE);
+
+namespace QtPrivate {
+
+typedef QList<IndexedResultItem> ResultItemList;
+
 class Q_CORE_EXPORT ResultIteratorBase
 {
 public:
     ResultIteratorBase();
-    ResultIteratorBase(QMap<int, ResultItem>::const_iterator _mapIterator, int _vectorIndex = 0);
+    ResultIteratorBase(const ResultItemList *items, qsizetype position, int _vectorIndex = 0);
     int vectorIndex() const;
     int resultIndex() const;
 
@@ -90,7 +109,10 @@ public:
     bool isValid() const;
 
 protected:
-    QMap<int, ResultItem>::const_iterator mapIterator;
+    const ResultItem &item() const { return m_items->at(m_position).item; }
+
+    const ResultItemList *m_items;
+    qsizetype m_position;
     int m_vectorIndex;
 public:
     template <typename T>
@@ -115,10 +137,10 @@ public:
     template <typename T>
     const T *pointer() const
     {
-        if (mapIterator.value().isVector())
-            return &(reinterpret_cast<const QList<T> *>(mapIterator.value().result)->at(m_vectorIndex));
+        if (item().isVector())
+            return &(reinterpret_cast<const QList<T> *>(item().result)->at(m_vectorIndex));
         else
-            return reinterpret_cast<const T *>(mapIterator.value().result);
+            return reinterpret_cast<const T *>(item().result);
     }
 };
 
@@ -146,24 +168,22 @@ protected:
     void syncResultCount();
     int updateInsertIndex(int index, int _count);
 
-    QMap<int, ResultItem> m_results;
+    ResultItemList m_results;
     int insertIndex;     // The index where the next results(s) will be inserted.
     int resultCount;     // The number of consecutive results stored, starting at index 0.
 
     bool m_filterMode;
-    QMap<int, ResultItem> pendingResults;
+    ResultItemList pendingResults;
     int filteredResults;
 
     template <typename T>
-    static void clear(QMap<int, ResultItem> &store)
+    static void clear(ResultItemList &store)
     {
-        QMap<int, ResultItem>::const_iterator mapIterator = store.constBegin();
-        while (mapIterator != store.constEnd()) {
-            if (mapIterator.value().isVector())
-                delete reinterpret_cast<const QList<T> *>(mapIterator.value().result);
+        for (const IndexedResultItem &entry : qAsConst(store)) {
+            if (entry.item.isVector())
+                delete reinterpret_cast<const QList<T> *>(entry.item.result);
             else
-                delete reinterpret_cast<const T *>(mapIterator.value().result);
-            ++mapIterator;
+                delete reinterpret_cast<const T *>(entry.item.result);
         }
         store.clear();
     }
@@ -242,9 +262,6 @@ public:
 
 } // namespace QtPrivate
 
-Q_DECLARE_TYPEINFO(QtPrivate::ResultItem, Q_PRIMITIVE_TYPE);
-
-
 QT_END_NAMESPACE
 
 #endif
@@ -60,6 +60,7 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    int workQueue;
 };
 
 /*
@@ -71,7 +72,7 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(nullptr)
+    :manager(manager), runnable(nullptr), workQueue(manager->allThreads.count())
 {
     setStackSize(manager->stackSize);
 }
@@ -88,27 +89,35 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // in work-stealing mode, keep going without the pool mutex
+                    // unless the shared queue has something more important
+                    r = nullptr;
+                    if (manager->workQueues && !manager->highPriorityQueued.loadAcquire())
+                        r = manager->takeStealable(workQueue);
+                } while (r);
                 locker.relock();
             }
 
@@ -116,6 +125,12 @@ void QThreadPoolThread::run()
             if (manager->tooManyThreadsActive())
                 break;
 
+            if (manager->workQueues && !manager->highPriorityQueued.loadRelaxed()) {
+                r = manager->takeStealable(workQueue);
+                if (r)
+                    continue;
+            }
+
             if (manager->queue.isEmpty()) {
                 r = nullptr;
                 break;
@@ -128,18 +143,28 @@ void QThreadPoolThread::run()
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updateQueueState();
         } while (true);
 
         // if too many threads are active, expire this thread
         bool expired = manager->tooManyThreadsActive();
         if (!expired) {
             manager->waitingThreads.enqueue(this);
+            manager->updateQueueState();
+            // a concurrent tryStartUnlocked() may have queued a task before
+            // it could see that we are about to sleep
+            if (manager->workQueues && manager->hasStealableTasks()) {
+                manager->waitingThreads.removeOne(this);
+                manager->updateQueueState();
+                continue;
+            }
             registerThreadInactive();
             // wait for work, exiting after the expiry timeout is reached
             runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
             ++manager->activeThreads;
             if (manager->waitingThreads.removeOne(this))
                 expired = true;
+            manager->updateQueueState();
             if (!manager->allThreads.contains(this)) {
                 registerThreadInactive();
                 break;
@@ -147,6 +172,7 @@ void QThreadPoolThread::run()
         }
         if (expired) {
             manager->expiredThreads.enqueue(this);
+            manager->updateQueueState();
             registerThreadInactive();
             break;
         }
@@ -164,7 +190,12 @@ void QThreadPoolThread::registerThreadInactive()
     \internal
 */
 QThreadPoolPrivate:: QThreadPoolPrivate()
-{ }
+{
+    if (qEnvironmentVariableIntValue("QT_THREADPOOL_WORK_STEALING") > 0) {
+        workQueueCount = qMax(1, maxThreadCount);
+        workQueues.reset(new WorkQueue[workQueueCount]);
+    }
+}
 
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
@@ -221,6 +252,100 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
 }
 
+/*!
+    \internal
+
+    Work-stealing mode: queues \a task on a worker queue without taking the
+    pool mutex, provided that all threads are busy and will look at the worker
+    queues before going to sleep. Returns \c false if the caller needs to go
+    through the regular, locked path instead.
+*/
+bool QThreadPoolPrivate::tryStartUnlocked(QRunnable *task)
+{
+    if (!workQueues || !canStartUnlocked.loadAcquire())
+        return false;
+
+    enqueueStealable(task);
+
+    // A thread that went to sleep between the check above and the enqueue
+    // either saw the task when re-checking the worker queues, or cleared
+    // canStartUnlocked before doing so; in the latter case wake it up.
+    if (!canStartUnlocked.loadAcquire()) {
+        QMutexLocker locker(&mutex);
+        if (!waitingThreads.isEmpty())
+            waitingThreads.takeFirst()->runnableReady.wakeOne();
+        tryToStartMoreThreads();
+    }
+    return true;
+}
+
+void QThreadPoolPrivate::enqueueStealable(QRunnable *task)
+{
+    Q_ASSERT(workQueues);
+    // tasks started from a pool thread stay local to that thread
+    int index;
+    const QThreadPoolThread *thread = qobject_cast<QThreadPoolThread *>(QThread::currentThread());
+    if (thread && thread->manager == this)
+        index = thread->workQueue % workQueueCount;
+    else
+        index = uint(nextWorkQueue.fetchAndAddRelaxed(1)) % uint(workQueueCount);
+
+    WorkQueue &workQueue = workQueues[index];
+    QMutexLocker locker(&workQueue.mutex);
+    workQueue.tasks.append(task);
+    workQueue.size.storeRelease(workQueue.tasks.size());
+}
+
+/*!
+    \internal
+
+    Returns the next task from the worker queue \a home, or steals one from
+    another worker queue if that one is empty.
+*/
+QRunnable *QThreadPoolPrivate::takeStealable(int home)
+{
+    for (int i = 0; i < workQueueCount; ++i) {
+        WorkQueue &workQueue = workQueues[(home + i) % workQueueCount];
+        if (!workQueue.size.loadAcquire())
+            continue;
+        QMutexLocker locker(&workQueue.mutex);
+        if (workQueue.tasks.isEmpty())
+            continue;
+        QRunnable *task = workQueue.tasks.takeFirst();
+        workQueue.size.storeRelease(workQueue.tasks.size());
+        return task;
+    }
+    return nullptr;
+}
+
+bool QThreadPoolPrivate::hasStealableTasks() const
+{
+    // lock every queue, see tryStartUnlocked()
+    for (int i = 0; i < workQueueCount; ++i) {
+        QMutexLocker locker(&workQueues[i].mutex);
+        if (!workQueues[i].tasks.isEmpty())
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Updates the flags read by the work-stealing fast paths. Must be called
+    with the mutex held after changing the queue or the thread state.
+*/
+void QThreadPoolPrivate::updateQueueState()
+{
+    if (!workQueues)
+        return;
+
+    highPriorityQueued.storeRelease(!queue.isEmpty() && queue.constFirst()->priority() > 0);
+    canStartUnlocked.storeRelease(waitingThreads.isEmpty()
+                                  && allThreads.count() > expiredThreads.count()
+                                  && activeThreadCount() >= maxThreadCount);
+}
+
 int QThreadPoolPrivate::activeThreadCount() const
 {
     return (allThreads.count()
@@ -244,6 +369,16 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+
+    // hand tasks from the worker queues to threads that became available
+    while (workQueues && activeThreadCount() < maxThreadCount) {
+        QRunnable *r = takeStealable(0);
+        if (!r)
+            break;
+        tryStart(r);
+    }
+
+    updateQueueState();
 }
 
 bool QThreadPoolPrivate::tooManyThreadsActive() const
@@ -280,6 +415,7 @@ void QThreadPoolPrivate::reset()
     allThreadsCopy.swap(allThreads);
     expiredThreads.clear();
     waitingThreads.clear();
+    updateQueueState();
     mutex.unlock();
 
     for (QThreadPoolThread *thread: qAsConst(allThreadsCopy)) {
@@ -300,10 +436,27 @@ void QThreadPoolPrivate::reset()
 */
 bool QThreadPoolPrivate::waitForDone(const QDeadlineTimer &timer)
 {
-    while (!(queue.isEmpty() && activeThreads == 0) && !timer.hasExpired())
+    while (!isIdle() && !timer.hasExpired()) {
+        // a task queued without the pool mutex may have missed the last
+        // thread going to sleep; hand it to a thread instead of waiting
+        if (activeThreads == 0)
+            tryToStartMoreThreads();
         noActiveThreads.wait(&mutex, timer);
+    }
+
+    return isIdle();
+}
 
-    return queue.isEmpty() && activeThreads == 0;
+/*!
+    \internal
+
+    Returns \c true if no task is queued, either in the shared queue or in the
+    worker queues, and no thread is running a task. Must be called with the
+    mutex held.
+*/
+bool QThreadPoolPrivate::isIdle() const
+{
+    return queue.isEmpty() && activeThreads == 0 && (!workQueues || !hasStealableTasks());
 }
 
 bool QThreadPoolPrivate::waitForDone(int msecs)
@@ -316,14 +469,21 @@ bool QThreadPoolPrivate::waitForDone(int msecs)
         reset();
         // More threads can be started during reset(), in that case continue
         // waiting if we still have time left.
-    } while ((!queue.isEmpty() || activeThreads) && !timer.hasExpired());
+    } while (!isIdle() && !timer.hasExpired());
 
-    return queue.isEmpty() && activeThreads == 0;
+    return isIdle();
 }
 
 void QThreadPoolPrivate::clear()
 {
     QMutexLocker locker(&mutex);
+    while (QRunnable *r = takeStealable(0)) {
+        if (r->autoDelete()) {
+            locker.unlock();
+            delete r;
+            locker.relock();
+        }
+    }
     while (!queue.isEmpty()) {
         auto *page = queue.takeLast();
         while (!page->isFinished()) {
@@ -336,6 +496,7 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updateQueueState();
 }
 
 /*!
@@ -369,6 +530,16 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                 d->queue.removeOne(page);
                 delete page;
             }
+            d->updateQueueState();
+            return true;
+        }
+    }
+
+    for (int i = 0; i < d->workQueueCount; ++i) {
+        QThreadPoolPrivate::WorkQueue &workQueue = d->workQueues[i];
+        QMutexLocker queueLocker(&workQueue.mutex);
+        if (workQueue.tasks.removeOne(runnable)) {
+            workQueue.size.storeRelease(workQueue.tasks.size());
             return true;
         }
     }
@@ -500,14 +671,21 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->tryStartUnlocked(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable)) {
-        d->enqueueTask(runnable, priority);
+        if (priority == 0 && d->workQueues)
+            d->enqueueStealable(runnable);
+        else
+            d->enqueueTask(runnable, priority);
 
         if (!d->waitingThreads.isEmpty())
             d->waitingThreads.takeFirst()->runnableReady.wakeOne();
     }
+    d->updateQueueState();
 }
 
 /*!
@@ -549,10 +727,9 @@ bool QThreadPool::tryStart(QRunnable *runnable)
 
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
-    if (d->tryStart(runnable))
-        return true;
-
-    return false;
+    const bool started = d->tryStart(runnable);
+    d->updateQueueState();
+    return started;
 }
 
 /*!
@@ -575,8 +752,10 @@ bool QThreadPool::tryStart(std::function<void()> functionToRun)
         return false;
 
     QRunnable *runnable = QRunnable::create(std::move(functionToRun));
-    if (d->tryStart(runnable))
+    if (d->tryStart(runnable)) {
+        d->updateQueueState();
         return true;
+    }
     delete runnable;
     return false;
 }
@@ -672,6 +851,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateQueueState();
 }
 
 /*! \property QThreadPool::stackSize
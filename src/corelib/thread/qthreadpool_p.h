@@ -59,6 +59,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <memory>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -166,10 +168,33 @@ public:
     void reset();
     bool waitForDone(int msecs);
     bool waitForDone(const QDeadlineTimer &timer);
+    bool isIdle() const;
     void clear();
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    // work-stealing mode, enabled with QT_THREADPOOL_WORK_STEALING
+    struct alignas(64) WorkQueue
+    {
+        QMutex mutex;
+        QList<QRunnable *> tasks;
+        QAtomicInt size;
+    };
+
+    bool tryStartUnlocked(QRunnable *task);
+    void enqueueStealable(QRunnable *task);
+    QRunnable *takeStealable(int home);
+    bool hasStealableTasks() const;
+    void updateQueueState();
+
+    std::unique_ptr<WorkQueue[]> workQueues;
+    int workQueueCount = 0;
+    QAtomicInt nextWorkQueue;
+    // all threads are busy, so start() may skip the pool mutex
+    QAtomicInt canStartUnlocked;
+    // the shared queue holds tasks that must run before the work queues
+    QAtomicInt highPriorityQueued;
+
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
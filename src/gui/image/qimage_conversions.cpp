@@ -46,15 +46,6 @@
 #include <private/qimage_p.h>
 
 #include <qendian.h>
-#if QT_CONFIG(thread)
-#include <qsemaphore.h>
-#include <qthreadpool.h>
-#ifdef Q_OS_WASM
-// WebAssembly has threads; however we can't block the main thread.
-#else
-#define QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-#endif
-#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -233,28 +224,7 @@ void convert_generic(QImageData *dest, const QImageData *src, Qt::ImageConversio
         }
     };
 
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = src->nbytes / (1<<16);
-    segments = std::min(segments, src->height);
-
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments <= 1 || !threadPool || threadPool->contains(QThread::currentThread()))
-        return convertSegment(0, src->height);
-
-    QSemaphore semaphore;
-    int y = 0;
-    for (int i = 0; i < segments; ++i) {
-        int yn = (src->height - y) / (segments - i);
-        threadPool->start([&, y, yn]() {
-            convertSegment(y, y + yn);
-            semaphore.release(1);
-        });
-        y += yn;
-    }
-    semaphore.acquire(segments);
-#else
-    convertSegment(0, src->height);
-#endif
+    qt_convertImageSegments(src, convertSegment);
 }
 
 void convert_generic_over_rgb64(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -288,28 +258,8 @@ void convert_generic_over_rgb64(QImageData *dest, const QImageData *src, Qt::Ima
             destData += dest->bytes_per_line;
         }
     };
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = src->nbytes / (1<<16);
-    segments = std::min(segments, src->height);
 
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments <= 1 || !threadPool || threadPool->contains(QThread::currentThread()))
-        return convertSegment(0, src->height);
-
-    QSemaphore semaphore;
-    int y = 0;
-    for (int i = 0; i < segments; ++i) {
-        int yn = (src->height - y) / (segments - i);
-        threadPool->start([&, y, yn]() {
-            convertSegment(y, y + yn);
-            semaphore.release(1);
-        });
-        y += yn;
-    }
-    semaphore.acquire(segments);
-#else
-    convertSegment(0, src->height);
-#endif
+    qt_convertImageSegments(src, convertSegment);
 }
 
 bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::ImageConversionFlags flags)
@@ -541,14 +491,19 @@ static void convert_passthrough(QImageData *dest, const QImageData *src, Qt::Ima
 
     const int src_bpl = src->bytes_per_line;
     const int dest_bpl = dest->bytes_per_line;
-    const uchar *src_data = src->data;
-    uchar *dest_data = dest->data;
 
-    for (int i = 0; i < src->height; ++i) {
-        memcpy(dest_data, src_data, src_bpl);
-        src_data += src_bpl;
-        dest_data += dest_bpl;
-    }
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        uchar *dest_data = dest->data + yStart * dest->bytes_per_line;
+
+        for (int i = yStart; i < yEnd; ++i) {
+            memcpy(dest_data, src_data, src_bpl);
+            src_data += src_bpl;
+            dest_data += dest_bpl;
+        }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<QImage::Format Format>
@@ -648,16 +603,20 @@ static void convert_RGB888_to_RGB(QImageData *dest, const QImageData *src, Qt::I
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const uchar *src_data = (uchar *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
     Rgb888ToRgbConverter line_converter= rgbx ? qt_convert_rgb888_to_rgbx8888 : qt_convert_rgb888_to_rgb32;
 
-    for (int i = 0; i < src->height; ++i) {
-        line_converter(dest_data, src_data, src->width);
-        src_data += src->bytes_per_line;
-        dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
-    }
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            line_converter(dest_data, src_data, src->width);
+            src_data += src->bytes_per_line;
+            dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
+        }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static void convert_ARGB_to_RGBx(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -669,19 +628,24 @@ static void convert_ARGB_to_RGBx(QImageData *dest, const QImageData *src, Qt::Im
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const quint32 *src_data = (quint32 *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const quint32 *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = ARGB2RGBA(0xff000000 | *src_data);
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const quint32 *src_data = (quint32 *) (src->data + yStart * src->bytes_per_line);
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint32 *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = ARGB2RGBA(0xff000000 | *src_data);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static void convert_ARGB_to_RGBA(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -693,19 +657,24 @@ static void convert_ARGB_to_RGBA(QImageData *dest, const QImageData *src, Qt::Im
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const quint32 *src_data = (quint32 *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const quint32 *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = ARGB2RGBA(*src_data);
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const quint32 *src_data = (quint32 *) (src->data + yStart * src->bytes_per_line);
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint32 *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = ARGB2RGBA(*src_data);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<QImage::Format DestFormat>
@@ -714,17 +683,22 @@ static bool convert_ARGB_to_RGBA_inplace(QImageData *data, Qt::ImageConversionFl
     Q_ASSERT(data->format == QImage::Format_ARGB32 || data->format == QImage::Format_ARGB32_Premultiplied);
 
     const int pad = (data->bytes_per_line >> 2) - data->width;
-    quint32 *rgb_data = (quint32 *) data->data;
     constexpr uint mask = (DestFormat == QImage::Format_RGBX8888) ? 0xff000000 : 0;
 
-    for (int i = 0; i < data->height; ++i) {
-        const quint32 *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = ARGB2RGBA(*rgb_data | mask);
-            ++rgb_data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        quint32 *rgb_data = (quint32 *) (data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint32 *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = ARGB2RGBA(*rgb_data | mask);
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
 
     data->format = DestFormat;
     return true;
@@ -739,19 +713,24 @@ static void convert_RGBA_to_ARGB(QImageData *dest, const QImageData *src, Qt::Im
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const quint32 *src_data = (quint32 *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const quint32 *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = RGBA2ARGB(*src_data);
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const quint32 *src_data = (quint32 *) (src->data + yStart * src->bytes_per_line);
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint32 *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = RGBA2ARGB(*src_data);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<QImage::Format DestFormat>
@@ -760,17 +739,22 @@ static bool convert_RGBA_to_ARGB_inplace(QImageData *data, Qt::ImageConversionFl
     Q_ASSERT(data->format == QImage::Format_RGBX8888 || data->format == QImage::Format_RGBA8888 || data->format == QImage::Format_RGBA8888_Premultiplied);
 
     const int pad = (data->bytes_per_line >> 2) - data->width;
-    QRgb *rgb_data = (QRgb *) data->data;
     constexpr uint mask = (DestFormat == QImage::Format_RGB32) ? 0xff000000 : 0;
 
-    for (int i = 0; i < data->height; ++i) {
-        const QRgb *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = mask | RGBA2ARGB(*rgb_data);
-            ++rgb_data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        QRgb *rgb_data = (QRgb *) (data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgb *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = mask | RGBA2ARGB(*rgb_data);
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
     data->format = DestFormat;
     return true;
 }
@@ -785,15 +769,20 @@ static void convert_rgbswap_generic(QImageData *dest, const QImageData *src, Qt:
 
     const qsizetype sbpl = src->bytes_per_line;
     const qsizetype dbpl = dest->bytes_per_line;
-    const uchar *src_data = src->data;
-    uchar *dest_data = dest->data;
 
-    for (int i = 0; i < src->height; ++i) {
-        func(dest_data, src_data, src->width);
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        uchar *dest_data = dest->data + yStart * dest->bytes_per_line;
 
-        src_data += sbpl;
-        dest_data += dbpl;
-    }
+        for (int i = yStart; i < yEnd; ++i) {
+            func(dest_data, src_data, src->width);
+
+            src_data += sbpl;
+            dest_data += dbpl;
+        }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static bool convert_rgbswap_generic_inplace(QImageData *data, Qt::ImageConversionFlags)
@@ -802,12 +791,17 @@ static bool convert_rgbswap_generic_inplace(QImageData *data, Qt::ImageConversio
     Q_ASSERT(func);
 
     const qsizetype bpl = data->bytes_per_line;
-    uchar *line_data = data->data;
 
-    for (int i = 0; i < data->height; ++i) {
-        func(line_data, line_data, data->width);
-        line_data += bpl;
-    }
+    auto convertSegment = [=](int yStart, int yEnd) {
+        uchar *line_data = data->data + yStart * data->bytes_per_line;
+
+        for (int i = yStart; i < yEnd; ++i) {
+            func(line_data, line_data, data->width);
+            line_data += bpl;
+        }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
 
     switch (data->format) {
     case QImage::Format_RGB888:
@@ -849,24 +843,29 @@ static void convert_ARGB_to_A2RGB30(QImageData *dest, const QImageData *src, Qt:
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const quint32 *src_data = (quint32 *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const quint32 *end = src_data + src->width;
-        while (src_data < end) {
-            QRgb c = *src_data;
-            if (RGBA)
-                c = RGBA2ARGB(c);
-            const uint alpha = (qAlpha(c) >> 6) * 85;
-            c = BYTE_MUL(c, alpha);
-            *dest_data = (qConvertRgb32ToRgb30<PixelOrder>(c) & 0x3fffffff) | (alpha << 30);
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const quint32 *src_data = (quint32 *) (src->data + yStart * src->bytes_per_line);
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint32 *end = src_data + src->width;
+            while (src_data < end) {
+                QRgb c = *src_data;
+                if (RGBA)
+                    c = RGBA2ARGB(c);
+                const uint alpha = (qAlpha(c) >> 6) * 85;
+                c = BYTE_MUL(c, alpha);
+                *dest_data = (qConvertRgb32ToRgb30<PixelOrder>(c) & 0x3fffffff) | (alpha << 30);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<QtPixelOrder PixelOrder, bool RGBA>
@@ -876,21 +875,26 @@ static bool convert_ARGB_to_A2RGB30_inplace(QImageData *data, Qt::ImageConversio
     Q_ASSERT(!RGBA || data->format == QImage::Format_RGBA8888);
 
     const int pad = (data->bytes_per_line >> 2) - data->width;
-    QRgb *rgb_data = (QRgb *) data->data;
-
-    for (int i = 0; i < data->height; ++i) {
-        const QRgb *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            QRgb c = *rgb_data;
-            if (RGBA)
-                c = RGBA2ARGB(c);
-            const uint alpha = (qAlpha(c) >> 6) * 85;
-            c = BYTE_MUL(c, alpha);
-            *rgb_data = (qConvertRgb32ToRgb30<PixelOrder>(c) & 0x3fffffff) | (alpha << 30);
-            ++rgb_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        QRgb *rgb_data = (QRgb *) (data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgb *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                QRgb c = *rgb_data;
+                if (RGBA)
+                    c = RGBA2ARGB(c);
+                const uint alpha = (qAlpha(c) >> 6) * 85;
+                c = BYTE_MUL(c, alpha);
+                *rgb_data = (qConvertRgb32ToRgb30<PixelOrder>(c) & 0x3fffffff) | (alpha << 30);
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
 
     data->format = (PixelOrder == PixelOrderRGB) ? QImage::Format_A2RGB30_Premultiplied
                                                  : QImage::Format_A2BGR30_Premultiplied;
@@ -930,20 +934,25 @@ static void convert_A2RGB30_PM_to_RGB30(QImageData *dest, const QImageData *src,
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const quint32 *src_data = (quint32 *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const quint32 *end = src_data + src->width;
-        while (src_data < end) {
-            const uint p = 0xc0000000 | qUnpremultiplyRgb30(*src_data);
-            *dest_data = (rgbswap) ? qRgbSwapRgb30(p) : p;
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const quint32 *src_data = (quint32 *) (src->data + yStart * src->bytes_per_line);
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint32 *end = src_data + src->width;
+            while (src_data < end) {
+                const uint p = 0xc0000000 | qUnpremultiplyRgb30(*src_data);
+                *dest_data = (rgbswap) ? qRgbSwapRgb30(p) : p;
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<bool rgbswap>
@@ -952,17 +961,22 @@ static bool convert_A2RGB30_PM_to_RGB30_inplace(QImageData *data, Qt::ImageConve
     Q_ASSERT(data->format == QImage::Format_A2RGB30_Premultiplied || data->format == QImage::Format_A2BGR30_Premultiplied);
 
     const int pad = (data->bytes_per_line >> 2) - data->width;
-    uint *rgb_data = (uint *) data->data;
-
-    for (int i = 0; i < data->height; ++i) {
-        const uint *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            const uint p = 0xc0000000 | qUnpremultiplyRgb30(*rgb_data);
-            *rgb_data = (rgbswap) ? qRgbSwapRgb30(p) : p;
-            ++rgb_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        uint *rgb_data = (uint *) (data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const uint *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                const uint p = 0xc0000000 | qUnpremultiplyRgb30(*rgb_data);
+                *rgb_data = (rgbswap) ? qRgbSwapRgb30(p) : p;
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
 
     if (data->format == QImage::Format_A2RGB30_Premultiplied)
         data->format = (rgbswap) ? QImage::Format_BGR30 : QImage::Format_RGB30;
@@ -994,21 +1008,26 @@ static void convert_A2RGB30_PM_to_ARGB(QImageData *dest, const QImageData *src,
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const quint32 *src_data = (quint32 *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const quint32 *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = qConvertA2rgb30ToArgb32<PixelOrder>(qUnpremultiplyRgb30(*src_data));
-            if (RGBA)
-                *dest_data = ARGB2RGBA(*dest_data);
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const quint32 *src_data = (quint32 *) (src->data + yStart * src->bytes_per_line);
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint32 *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = qConvertA2rgb30ToArgb32<PixelOrder>(qUnpremultiplyRgb30(*src_data));
+                if (RGBA)
+                    *dest_data = ARGB2RGBA(*dest_data);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<QtPixelOrder PixelOrder, bool RGBA>
@@ -1017,18 +1036,23 @@ static bool convert_A2RGB30_PM_to_ARGB_inplace(QImageData *data, Qt::ImageConver
     Q_ASSERT(data->format == QImage::Format_A2RGB30_Premultiplied || data->format == QImage::Format_A2BGR30_Premultiplied);
 
     const int pad = (data->bytes_per_line >> 2) - data->width;
-    uint *rgb_data = (uint *) data->data;
-
-    for (int i = 0; i < data->height; ++i) {
-        const uint *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = qConvertA2rgb30ToArgb32<PixelOrder>(qUnpremultiplyRgb30(*rgb_data));
-            if (RGBA)
-                *rgb_data = ARGB2RGBA(*rgb_data);
-            ++rgb_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        uint *rgb_data = (uint *) (data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const uint *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = qConvertA2rgb30ToArgb32<PixelOrder>(qUnpremultiplyRgb30(*rgb_data));
+                if (RGBA)
+                    *rgb_data = ARGB2RGBA(*rgb_data);
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
     if (RGBA)
         data->format = QImage::Format_RGBA8888;
     else
@@ -1045,19 +1069,24 @@ static void convert_RGBA_to_RGB(QImageData *dest, const QImageData *src, Qt::Ima
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const uint *src_data = (const uint *)src->data;
-    uint *dest_data = (uint *)dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const uint *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = RGBA2ARGB(*src_data) | 0xff000000;
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uint *src_data = (const uint *)(src->data + yStart * src->bytes_per_line);
+        uint *dest_data = (uint *)(dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const uint *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = RGBA2ARGB(*src_data) | 0xff000000;
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static void swap_bit_order(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -1088,19 +1117,24 @@ static void mask_alpha_converter(QImageData *dest, const QImageData *src, Qt::Im
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const uint *src_data = (const uint *)src->data;
-    uint *dest_data = (uint *)dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const uint *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = *src_data | 0xff000000;
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uint *src_data = (const uint *)(src->data + yStart * src->bytes_per_line);
+        uint *dest_data = (uint *)(dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const uint *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = *src_data | 0xff000000;
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<QImage::Format DestFormat>
@@ -1110,16 +1144,21 @@ static bool mask_alpha_converter_inplace(QImageData *data, Qt::ImageConversionFl
             || DestFormat == QImage::Format_RGB32
             || DestFormat == QImage::Format_RGBX8888);
     const int pad = (data->bytes_per_line >> 2) - data->width;
-    QRgb *rgb_data = (QRgb *) data->data;
 
-    for (int i = 0; i < data->height; ++i) {
-        const QRgb *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = *rgb_data | 0xff000000;
-            ++rgb_data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        QRgb *rgb_data = (QRgb *) (data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgb *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = *rgb_data | 0xff000000;
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
     data->format = DestFormat;
     return true;
 }
@@ -1135,19 +1174,24 @@ static void mask_alpha_converter_RGBx(QImageData *dest, const QImageData *src, Q
 
     const int src_pad = (src->bytes_per_line >> 2) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const uint *src_data = (const uint *)src->data;
-    uint *dest_data = (uint *)dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const uint *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = *src_data | 0x000000ff;
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uint *src_data = (const uint *)(src->data + yStart * src->bytes_per_line);
+        uint *dest_data = (uint *)(dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const uint *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = *src_data | 0x000000ff;
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 #endif
 }
 
@@ -1159,16 +1203,21 @@ static bool mask_alpha_converter_rgbx_inplace(QImageData *data, Qt::ImageConvers
     Q_UNUSED(flags);
 
     const int pad = (data->bytes_per_line >> 2) - data->width;
-    QRgb *rgb_data = (QRgb *) data->data;
 
-    for (int i = 0; i < data->height; ++i) {
-        const QRgb *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = *rgb_data | 0x000000fff;
-            ++rgb_data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        QRgb *rgb_data = (QRgb *) (data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgb *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = *rgb_data | 0x000000fff;
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
     data->format = QImage::Format_RGBX8888;
     return true;
 #endif
@@ -1183,16 +1232,20 @@ static void convert_RGBA64_to_ARGB32(QImageData *dest, const QImageData *src, Qt
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const uchar *srcData = src->data;
-    uchar *destData = dest->data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *srcData = src->data + yStart * src->bytes_per_line;
+        uchar *destData = dest->data + yStart * dest->bytes_per_line;
+
+        for (int i = yStart; i < yEnd; ++i) {
+            uint *d = reinterpret_cast<uint *>(destData);
+            const QRgba64 *s = reinterpret_cast<const QRgba64 *>(srcData);
+            qt_convertRGBA64ToARGB32<RGBA>(d, s, src->width);
+            srcData += src->bytes_per_line;
+            destData += dest->bytes_per_line;
+        }
+    };
 
-    for (int i = 0; i < src->height; ++i) {
-        uint *d = reinterpret_cast<uint *>(destData);
-        const QRgba64 *s = reinterpret_cast<const QRgba64 *>(srcData);
-        qt_convertRGBA64ToARGB32<RGBA>(d, s, src->width);
-        srcData += src->bytes_per_line;
-        destData += dest->bytes_per_line;
-    }
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<bool RGBA>
@@ -1204,15 +1257,20 @@ static void convert_ARGB32_to_RGBA64(QImageData *dest, const QImageData *src, Qt
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const uchar *src_data = src->data;
-    uchar *dest_data = dest->data;
     const FetchAndConvertPixelsFunc64 fetch = qPixelLayouts[src->format + 1].fetchToRGBA64PM;
 
-    for (int i = 0; i < src->height; ++i) {
-        fetch(reinterpret_cast<QRgba64 *>(dest_data), src_data, 0, src->width, nullptr, nullptr);
-        src_data += src->bytes_per_line;;
-        dest_data += dest->bytes_per_line;
-    }
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        uchar *dest_data = dest->data + yStart * dest->bytes_per_line;
+
+        for (int i = yStart; i < yEnd; ++i) {
+            fetch(reinterpret_cast<QRgba64 *>(dest_data), src_data, 0, src->width, nullptr, nullptr);
+            src_data += src->bytes_per_line;;
+            dest_data += dest->bytes_per_line;
+        }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static void convert_RGBA64_to_RGBx64(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -1224,20 +1282,25 @@ static void convert_RGBA64_to_RGBx64(QImageData *dest, const QImageData *src, Qt
 
     const int src_pad = (src->bytes_per_line >> 3) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 3) - dest->width;
-    const QRgba64 *src_data = reinterpret_cast<const QRgba64 *>(src->data);
-    QRgba64 *dest_data = reinterpret_cast<QRgba64 *>(dest->data);
-
-    for (int i = 0; i < src->height; ++i) {
-        const QRgba64 *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = *src_data;
-            dest_data->setAlpha(65535);
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const QRgba64 *src_data = reinterpret_cast<const QRgba64 *>(src->data + yStart * src->bytes_per_line);
+        QRgba64 *dest_data = reinterpret_cast<QRgba64 *>(dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgba64 *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = *src_data;
+                dest_data->setAlpha(65535);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static bool convert_RGBA64_to_RGBx64_inplace(QImageData *data, Qt::ImageConversionFlags)
@@ -1245,16 +1308,21 @@ static bool convert_RGBA64_to_RGBx64_inplace(QImageData *data, Qt::ImageConversi
     Q_ASSERT(data->format == QImage::Format_RGBA64);
 
     const int pad = (data->bytes_per_line >> 3) - data->width;
-    QRgba64 *rgb_data = reinterpret_cast<QRgba64 *>(data->data);
 
-    for (int i = 0; i < data->height; ++i) {
-        const QRgba64 *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            rgb_data->setAlpha(65535);
-            ++rgb_data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        QRgba64 *rgb_data = reinterpret_cast<QRgba64 *>(data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgba64 *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                rgb_data->setAlpha(65535);
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
     data->format = QImage::Format_RGBX64;
     return true;
 }
@@ -1268,19 +1336,24 @@ static void convert_RGBA64_to_RGBA64PM(QImageData *dest, const QImageData *src,
 
     const int src_pad = (src->bytes_per_line >> 3) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 3) - dest->width;
-    const QRgba64 *src_data = reinterpret_cast<const QRgba64 *>(src->data);
-    QRgba64 *dest_data = reinterpret_cast<QRgba64 *>(dest->data);
-
-    for (int i = 0; i < src->height; ++i) {
-        const QRgba64 *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = src_data->premultiplied();
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const QRgba64 *src_data = reinterpret_cast<const QRgba64 *>(src->data + yStart * src->bytes_per_line);
+        QRgba64 *dest_data = reinterpret_cast<QRgba64 *>(dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgba64 *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = src_data->premultiplied();
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static bool convert_RGBA64_to_RGBA64PM_inplace(QImageData *data, Qt::ImageConversionFlags)
@@ -1288,16 +1361,21 @@ static bool convert_RGBA64_to_RGBA64PM_inplace(QImageData *data, Qt::ImageConver
     Q_ASSERT(data->format == QImage::Format_RGBA64);
 
     const int pad = (data->bytes_per_line >> 3) - data->width;
-    QRgba64 *rgb_data = reinterpret_cast<QRgba64 *>(data->data);
 
-    for (int i = 0; i < data->height; ++i) {
-        const QRgba64 *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = rgb_data->premultiplied();
-            ++rgb_data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        QRgba64 *rgb_data = reinterpret_cast<QRgba64 *>(data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgba64 *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = rgb_data->premultiplied();
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
     data->format = QImage::Format_RGBA64_Premultiplied;
     return true;
 }
@@ -1312,21 +1390,26 @@ static void convert_RGBA64PM_to_RGBA64(QImageData *dest, const QImageData *src,
 
     const int src_pad = (src->bytes_per_line >> 3) - src->width;
     const int dest_pad = (dest->bytes_per_line >> 3) - dest->width;
-    const QRgba64 *src_data = reinterpret_cast<const QRgba64 *>(src->data);
-    QRgba64 *dest_data = reinterpret_cast<QRgba64 *>(dest->data);
-
-    for (int i = 0; i < src->height; ++i) {
-        const QRgba64 *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = src_data->unpremultiplied();
-            if (MaskAlpha)
-                dest_data->setAlpha(65535);
-            ++src_data;
-            ++dest_data;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const QRgba64 *src_data = reinterpret_cast<const QRgba64 *>(src->data + yStart * src->bytes_per_line);
+        QRgba64 *dest_data = reinterpret_cast<QRgba64 *>(dest->data + yStart * dest->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgba64 *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = src_data->unpremultiplied();
+                if (MaskAlpha)
+                    dest_data->setAlpha(65535);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 template<bool MaskAlpha>
@@ -1335,18 +1418,23 @@ static bool convert_RGBA64PM_to_RGBA64_inplace(QImageData *data, Qt::ImageConver
     Q_ASSERT(data->format == QImage::Format_RGBA64_Premultiplied);
 
     const int pad = (data->bytes_per_line >> 3) - data->width;
-    QRgba64 *rgb_data = reinterpret_cast<QRgba64 *>(data->data);
 
-    for (int i = 0; i < data->height; ++i) {
-        const QRgba64 *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = rgb_data->unpremultiplied();
-            if (MaskAlpha)
-                rgb_data->setAlpha(65535);
-            ++rgb_data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        QRgba64 *rgb_data = reinterpret_cast<QRgba64 *>(data->data + yStart * data->bytes_per_line);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgba64 *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = rgb_data->unpremultiplied();
+                if (MaskAlpha)
+                    rgb_data->setAlpha(65535);
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    };
+
+    qt_convertImageSegments(data, convertSegment);
     data->format = MaskAlpha ? QImage::Format_RGBX64 : QImage::Format_RGBA64;
     return true;
 }
@@ -1361,19 +1449,24 @@ static void convert_gray16_to_RGBA64(QImageData *dest, const QImageData *src, Qt
 
     const qsizetype sbpl = src->bytes_per_line;
     const qsizetype dbpl = dest->bytes_per_line;
-    const uchar *src_data = src->data;
-    uchar *dest_data = dest->data;
 
-    for (int i = 0; i < src->height; ++i) {
-        const quint16 *src_line = reinterpret_cast<const quint16 *>(src_data);
-        QRgba64 *dest_line = reinterpret_cast<QRgba64 *>(dest_data);
-        for (int j = 0; j < src->width; ++j) {
-            quint16 s = src_line[j];
-            dest_line[j] = qRgba64(s, s, s, 0xFFFF);
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        uchar *dest_data = dest->data + yStart * dest->bytes_per_line;
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const quint16 *src_line = reinterpret_cast<const quint16 *>(src_data);
+            QRgba64 *dest_line = reinterpret_cast<QRgba64 *>(dest_data);
+            for (int j = 0; j < src->width; ++j) {
+                quint16 s = src_line[j];
+                dest_line[j] = qRgba64(s, s, s, 0xFFFF);
+            }
+            src_data += sbpl;
+            dest_data += dbpl;
         }
-        src_data += sbpl;
-        dest_data += dbpl;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static void convert_RGBA64_to_gray16(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -1386,19 +1479,24 @@ static void convert_RGBA64_to_gray16(QImageData *dest, const QImageData *src, Qt
 
     const qsizetype sbpl = src->bytes_per_line;
     const qsizetype dbpl = dest->bytes_per_line;
-    const uchar *src_data = src->data;
-    uchar *dest_data = dest->data;
 
-    for (int i = 0; i < src->height; ++i) {
-        const QRgba64 *src_line = reinterpret_cast<const QRgba64 *>(src_data);
-        quint16 *dest_line = reinterpret_cast<quint16 *>(dest_data);
-        for (int j = 0; j < src->width; ++j) {
-            QRgba64 s = src_line[j].unpremultiplied();
-            dest_line[j] = qGray(s.red(), s.green(), s.blue());
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        uchar *dest_data = dest->data + yStart * dest->bytes_per_line;
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgba64 *src_line = reinterpret_cast<const QRgba64 *>(src_data);
+            quint16 *dest_line = reinterpret_cast<quint16 *>(dest_data);
+            for (int j = 0; j < src->width; ++j) {
+                QRgba64 s = src_line[j].unpremultiplied();
+                dest_line[j] = qGray(s.red(), s.green(), s.blue());
+            }
+            src_data += sbpl;
+            dest_data += dbpl;
         }
-        src_data += sbpl;
-        dest_data += dbpl;
-    }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static QList<QRgb> fix_color_table(const QList<QRgb> &ctbl, QImage::Format format)
@@ -2015,20 +2113,26 @@ static void convert_Indexed8_to_X32(QImageData *dest, const QImageData *src, Qt:
     }
 
     int w = src->width;
-    const uchar *src_data = src->data;
-    uchar *dest_data = dest->data;
     const QRgb *colorTablePtr = colorTable.constData();
-    for (int y = 0; y < src->height; y++) {
-        uint *p = reinterpret_cast<uint *>(dest_data);
-        const uchar *b = src_data;
-        uint *end = p + w;
 
-        while (p < end)
-            *p++ = colorTablePtr[*b++];
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        uchar *dest_data = dest->data + yStart * dest->bytes_per_line;
 
-        src_data += src->bytes_per_line;
-        dest_data += dest->bytes_per_line;
-    }
+        for (int y = yStart; y < yEnd; ++y) {
+            uint *p = reinterpret_cast<uint *>(dest_data);
+            const uchar *b = src_data;
+            uint *end = p + w;
+
+            while (p < end)
+                *p++ = colorTablePtr[*b++];
+
+            src_data += src->bytes_per_line;
+            dest_data += dest->bytes_per_line;
+        }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 static void convert_Mono_to_X32(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -99,14 +99,18 @@ void convert_RGB888_to_RGB32_neon(QImageData *dest, const QImageData *src, Qt::I
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const uchar *src_data = (uchar *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
+    auto convertSegment = [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + yStart * src->bytes_per_line;
+        quint32 *dest_data = (quint32 *) (dest->data + yStart * dest->bytes_per_line);
 
-    for (int i = 0; i < src->height; ++i) {
-        qt_convert_rgb888_to_rgb32_neon(dest_data, src_data, src->width);
-        src_data += src->bytes_per_line;
-        dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
-    }
+        for (int i = yStart; i < yEnd; ++i) {
+            qt_convert_rgb888_to_rgb32_neon(dest_data, src_data, src->width);
+            src_data += src->bytes_per_line;
+            dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
+        }
+    };
+
+    qt_convertImageSegments(src, convertSegment);
 }
 
 QT_END_NAMESPACE
@@ -57,6 +57,16 @@
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#ifdef Q_OS_WASM
+// WebAssembly has threads; however we can't block the main thread.
+#else
+#define QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
+#endif
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -164,6 +174,37 @@ bool convert_generic_inplace_over_rgb64(QImageData *data, QImage::Format dst_for
 
 void dither_to_Mono(QImageData *dst, const QImageData *src, Qt::ImageConversionFlags flags, bool fromalpha);
 
+// Calls convertSegment(yStart, yEnd) for bands of rows together covering the image.
+// Images larger than 64KB are split into bands of about that size, which are run
+// on the global thread pool. Only use this for conversions where each row can be
+// converted independently of the others.
+template<typename Segment>
+inline void qt_convertImageSegments(const QImageData *image, Segment convertSegment)
+{
+#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
+    int segments = image->nbytes / (1<<16);
+    segments = std::min(segments, image->height);
+
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    if (segments <= 1 || !threadPool || threadPool->contains(QThread::currentThread()))
+        return convertSegment(0, image->height);
+
+    QSemaphore semaphore;
+    int y = 0;
+    for (int i = 0; i < segments; ++i) {
+        int yn = (image->height - y) / (segments - i);
+        threadPool->start([&, y, yn]() {
+            convertSegment(y, y + yn);
+            semaphore.release(1);
+        });
+        y += yn;
+    }
+    semaphore.acquire(segments);
+#else
+    convertSegment(0, image->height);
+#endif
+}
+
 const uchar *qt_get_bitflip_array();
 Q_GUI_EXPORT void qGamma_correct_back_to_linear_cs(QImage *image);
 
@@ -170,6 +170,11 @@
     the transformation metadata of an image. A handler that supports this option
     should not apply the transformation itself.
 
+    \value BandedReading. A handler which supports this option implements
+    readBand(), and can decode an image in bands of scan lines without
+    holding the whole image in memory. It should also support the Size option.
+    This value was added in Qt 6.0.
+
 \if !defined(qt6)
     \value TransformedByDefault. A handler that reports support for this feature
     will have image transformation metadata applied by default on read.
@@ -434,6 +439,30 @@ bool QImageIOHandler::write(const QImage &image)
     return false;
 }
 
+/*!
+    \since 6.0
+
+    Reads the next band of at most \a maximumHeight scan lines of the
+    current image from the device into \a band. Returns \c true on
+    success; otherwise returns \c false. Bands are read from top to bottom,
+    and each band has the full width of the image; once the last band of an
+    image has been read, the handler moves on to the next image.
+
+    Handlers that reimplement this function should report support for the
+    BandedReading option. Options such as ClipRect and ScaledSize do not
+    apply to bands.
+
+    The default implementation does nothing, and simply returns \c false.
+
+    \sa read(), QImageReader::readBand()
+*/
+bool QImageIOHandler::readBand(QImage *band, int maximumHeight)
+{
+    Q_UNUSED(band);
+    Q_UNUSED(maximumHeight);
+    return false;
+}
+
 /*!
     Sets the option \a option with the value \a value.
 
@@ -73,6 +73,7 @@ public:
     virtual bool canRead() const = 0;
     virtual bool read(QImage *image) = 0;
     virtual bool write(const QImage &image);
+    virtual bool readBand(QImage *band, int maximumHeight);
 
     enum ImageOption {
         Size,
@@ -97,6 +98,7 @@ public:
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
         , TransformedByDefault
 #endif
+        , BandedReading
     };
 
     enum Transformation {
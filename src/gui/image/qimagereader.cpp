@@ -487,6 +487,13 @@ public:
         DoNotApplyTransform
     } autoTransform;
 
+    // banded reading
+    QImage bandImage;
+    int bandLine;
+    int bandImageHeight;
+    bool canReadNativeBands();
+    void resetBands();
+
     // error
     QImageReader::ImageReaderError imageReaderError;
     QString errorString;
@@ -508,6 +515,8 @@ QImageReaderPrivate::QImageReaderPrivate(QImageReader *qq)
     deleteDevice = false;
     handler = nullptr;
     quality = -1;
+    bandLine = -1;
+    bandImageHeight = 0;
     imageReaderError = QImageReader::UnknownError;
     autoTransform = UsePluginDefault;
 
@@ -785,6 +794,7 @@ void QImageReader::setDevice(QIODevice *device)
     delete d->handler;
     d->handler = nullptr;
     d->text.clear();
+    d->resetBands();
 }
 
 /*!
@@ -1328,6 +1338,124 @@ bool QImageReader::read(QImage *image)
     return true;
 }
 
+/*!
+    \internal
+
+    Returns \c true if the handler can decode the current image in bands
+    that are identical to what read() would return, that is, if no clipping,
+    scaling or transformation has to be applied afterwards.
+*/
+bool QImageReaderPrivate::canReadNativeBands()
+{
+    if (!handler->supportsOption(QImageIOHandler::BandedReading))
+        return false;
+    if (!clipRect.isNull() || scaledSize.isValid() || !scaledClipRect.isNull())
+        return false;
+    if (q->autoTransform() && q->transformation() != QImageIOHandler::TransformationNone)
+        return false;
+    return true;
+}
+
+/*!
+    \internal
+*/
+void QImageReaderPrivate::resetBands()
+{
+    bandImage = QImage();
+    bandLine = -1;
+    bandImageHeight = 0;
+}
+
+/*!
+    \since 6.0
+
+    Reads the next band of at most \a maximumHeight scan lines of the
+    current image and returns it. A null image is returned when all scan
+    lines of the image have been read, or if an error occurred.
+
+    \sa read()
+*/
+QImage QImageReader::readBand(int maximumHeight)
+{
+    QImage band;
+    return readBand(&band, maximumHeight) ? band : QImage();
+}
+
+/*!
+    \overload
+    \since 6.0
+
+    Reads the next band of at most \a maximumHeight scan lines of the
+    current image into \a band, which must point to a QImage. Returns
+    \c true on success; otherwise, returns \c false.
+
+    The bands of an image have its full width and are returned from top to
+    bottom, so the first scan line of a band follows the last scan line of the
+    previous one. When all scan lines of the current image have been read,
+    false is returned without setting an error; for image formats that support
+    animation, calling readBand() again starts on the next image.
+
+    The bands are identical to the corresponding part of the image read()
+    returns. If the image handler supports the QImageIOHandler::BandedReading
+    option, and no clip rect, scaled size or transformation has to be applied,
+    the image is decoded one band at a time, so that only the current band has
+    to be held in memory. Otherwise the whole image is read first.
+
+    Calls to readBand() and read() should not be mixed for the same image.
+
+    \sa read(), supportsOption(), QImageIOHandler::readBand()
+*/
+bool QImageReader::readBand(QImage *band, int maximumHeight)
+{
+    if (!band) {
+        qWarning("QImageReader::readBand: cannot read into null pointer");
+        return false;
+    }
+    if (maximumHeight <= 0) {
+        qWarning("QImageReader::readBand: invalid band height %d", maximumHeight);
+        return false;
+    }
+
+    if (!d->handler && !d->initHandler())
+        return false;
+
+    if (d->bandLine < 0) {
+        // starting on a new image
+        d->resetBands();
+        if (d->canReadNativeBands()) {
+            if (d->handler->supportsOption(QImageIOHandler::Quality))
+                d->handler->setOption(QImageIOHandler::Quality, d->quality);
+            d->bandImageHeight = d->handler->option(QImageIOHandler::Size).toSize().height();
+        }
+        if (d->bandImageHeight <= 0) {
+            if (!read(&d->bandImage))
+                return false;
+            d->bandImageHeight = d->bandImage.height();
+        }
+        d->bandLine = 0;
+    }
+
+    if (d->bandLine >= d->bandImageHeight) {
+        d->resetBands();
+        return false;
+    }
+
+    if (d->bandImage.isNull()) {
+        if (!d->handler->readBand(band, maximumHeight) || band->isNull()) {
+            d->resetBands();
+            d->imageReaderError = InvalidDataError;
+            d->errorString = QImageReader::tr("Unable to read image data");
+            return false;
+        }
+    } else {
+        const int height = qMin(maximumHeight, d->bandImageHeight - d->bandLine);
+        *band = d->bandImage.copy(0, d->bandLine, d->bandImage.width(), height);
+    }
+
+    d->bandLine += band->height();
+    return true;
+}
+
 /*!
    For image formats that support animation, this function steps over the
    current image, returning true if successful or false if there is no
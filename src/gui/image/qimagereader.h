@@ -123,6 +123,9 @@ public:
     QImage read();
     bool read(QImage *image);
 
+    QImage readBand(int maximumHeight);
+    bool readBand(QImage *band, int maximumHeight);
+
     bool jumpToNextImage();
     bool jumpToImage(int imageNumber);
     int loopCount() const;
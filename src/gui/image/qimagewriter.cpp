@@ -508,6 +508,10 @@ int QImageWriter::compression() const
     For example, saving an image in DDS format with A8R8G8R8 subtype:
 
     \snippet code/src_gui_image_qimagewriter.cpp 3
+
+    The "png" format supports the "fast" subtype, which saves the image
+    considerably faster, at the cost of a somewhat larger file for images
+    that are not screen content.
 */
 void QImageWriter::setSubType(const QByteArray &type)
 {
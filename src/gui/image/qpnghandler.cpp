@@ -55,6 +55,7 @@
 
 #include <png.h>
 #include <pngconf.h>
+#include <zlib.h>
 
 #if PNG_LIBPNG_VER >= 10400 && PNG_LIBPNG_VER <= 10502 \
         && defined(PNG_PEDANTIC_WARNINGS_SUPPORTED)
@@ -98,6 +99,7 @@ public:
     enum State {
         Ready,
         ReadHeader,
+        ReadingBands,
         ReadingEnd,
         Error
     };
@@ -110,7 +112,7 @@ public:
     };
 
     QPngHandlerPrivate(QPngHandler *qq)
-        : gamma(0.0), fileGamma(0.0), quality(50), compression(50), colorSpaceState(Undefined), png_ptr(nullptr), info_ptr(nullptr), end_info(nullptr), state(Ready), q(qq)
+        : gamma(0.0), fileGamma(0.0), quality(50), compression(50), colorSpaceState(Undefined), png_ptr(nullptr), info_ptr(nullptr), end_info(nullptr), bandRow(0), state(Ready), q(qq)
     { }
 
     float gamma;
@@ -119,6 +121,7 @@ public:
     int compression;
     QString description;
     QSize scaledSize;
+    QByteArray subType;
     QStringList readTexts;
     QColorSpace colorSpace;
     ColorSpaceState colorSpaceState;
@@ -129,7 +132,9 @@ public:
 
     bool readPngHeader();
     bool readPngImage(QImage *image);
+    bool readPngBand(QImage *band, int maximumHeight);
     void readPngTexts(png_info *info);
+    void setupGamma();
 
     QImage::Format readImageFormat();
 
@@ -157,6 +162,11 @@ public:
 
     AllocatedMemoryPointers amp;
 
+    // Banded reading: a single-line image with the format and color table of
+    // the bands, or the whole image if it is interlaced.
+    QImage bandImage;
+    int bandRow;
+
     State state;
 
     QPngHandler *q;
@@ -173,6 +183,7 @@ public:
     void setLooping(int loops=0); // 0 == infinity
     void setFrameDelay(int msecs);
     void setGamma(float);
+    void setFastFilters(bool);
 
     bool writeImage(const QImage& img, int x, int y);
     bool writeImage(const QImage& img, int compression_in, const QString &description, int x, int y);
@@ -190,6 +201,7 @@ private:
     int looping;
     int ms_delay;
     float gamma;
+    bool fastFilters;
 };
 
 extern "C" {
@@ -240,7 +252,8 @@ void qpiw_flush_fn(png_structp /* png_ptr */)
 }
 
 static
-bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scaledSize, bool *doScaledRead)
+bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scaledSize, bool *doScaledRead,
+              int bandHeight = 0)
 {
     png_uint_32 width = 0;
     png_uint_32 height = 0;
@@ -256,7 +269,17 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
     QSize size(width, height);
     png_set_interlace_handling(png_ptr);
 
-    if (color_type == PNG_COLOR_TYPE_GRAY) {
+    // Downscaling while reading is done on 32-bit rows, so 8-bit and
+    // smaller images are expanded to that instead of their native format.
+    const bool scaledRead = !scaledSize.isEmpty() && quint32(scaledSize.width()) <= width
+            && quint32(scaledSize.height()) <= height && scaledSize != size
+            && interlace_method == PNG_INTERLACE_NONE && bit_depth <= 8;
+
+    // When reading in bands, only allocate a single band.
+    if (bandHeight > 0)
+        size.setHeight(qMin(bandHeight, size.height()));
+
+    if (color_type == PNG_COLOR_TYPE_GRAY && !scaledRead) {
         // Black & White or grayscale
         if (bit_depth == 1 && png_get_channels(png_ptr, info_ptr) == 1) {
             png_set_invert_mono(png_ptr);
@@ -320,7 +343,7 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
                 }
             }
         }
-    } else if (color_type == PNG_COLOR_TYPE_PALETTE
+    } else if (color_type == PNG_COLOR_TYPE_PALETTE && !scaledRead
                && png_get_PLTE(png_ptr, info_ptr, &palette, &num_palette)
                && num_palette <= 256)
     {
@@ -329,7 +352,7 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
             png_set_packing(png_ptr);
         png_read_update_info(png_ptr, info_ptr);
         png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
-        size = QSize(width, height);
+        size = QSize(width, bandHeight > 0 ? qMin(bandHeight, int(height)) : int(height));
         QImage::Format format = bit_depth == 1 ? QImage::Format_Mono : QImage::Format_Indexed8;
         if (!QImageIOHandler::allocateImage(size, format, &image))
             return false;
@@ -382,7 +405,7 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
 
         png_set_expand(png_ptr);
 
-        if (color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+        if (!(color_type & PNG_COLOR_MASK_COLOR))
             png_set_gray_to_rgb(png_ptr);
 
         QImage::Format format = QImage::Format_ARGB32;
@@ -394,9 +417,8 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
             // We want 4 bytes, but it isn't an alpha channel
             format = QImage::Format_RGB32;
         }
-        QSize outSize(width,height);
-        if (!scaledSize.isEmpty() && quint32(scaledSize.width()) <= width &&
-            quint32(scaledSize.height()) <= height && scaledSize != outSize && interlace_method == PNG_INTERLACE_NONE) {
+        QSize outSize = size;
+        if (scaledRead) {
             // Do inline downscaling
             outSize = scaledSize;
             if (doScaledRead)
@@ -658,13 +680,7 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         return false;
     }
 
-    if (gamma != 0.0 && fileGamma != 0.0) {
-        // This configuration forces gamma correction and
-        // thus changes the output colorspace
-        png_set_gamma(png_ptr, 1.0f / gamma, fileGamma);
-        colorSpace.setTransferFunction(QColorSpace::TransferFunction::Gamma, 1.0f / gamma);
-        colorSpaceState = GammaChrm;
-    }
+    setupGamma();
 
     bool doScaledRead = false;
     if (!setup_qt(*outImage, png_ptr, info_ptr, scaledSize, &doScaledRead)) {
@@ -740,6 +756,126 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     return true;
 }
 
+bool QPngHandlerPrivate::readPngBand(QImage *band, int maximumHeight)
+{
+    if (state == Error)
+        return false;
+
+    if (state != ReadingBands && bandImage.isNull()) {
+        // Starting on a new image
+        if (state == Ready && !readPngHeader()) {
+            state = Error;
+            return false;
+        }
+        bandRow = 0;
+
+        if (png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE) {
+            // The rows of an interlaced image are spread over several
+            // passes, so it can only be decoded as a whole.
+            const QSize savedScaledSize = scaledSize;
+            scaledSize = QSize();
+            const bool result = readPngImage(&bandImage);
+            scaledSize = savedScaledSize;
+            if (!result)
+                return false;
+        } else {
+            if (setjmp(png_jmpbuf(png_ptr))) {
+                png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+                png_ptr = nullptr;
+                bandImage = QImage();
+                state = Error;
+                return false;
+            }
+
+            setupGamma();
+
+            if (!setup_qt(bandImage, png_ptr, info_ptr, QSize(), nullptr, 1)) {
+                png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+                png_ptr = nullptr;
+                bandImage = QImage();
+                state = Error;
+                return false;
+            }
+            state = ReadingBands;
+        }
+    }
+
+    if (state != ReadingBands) {
+        // Hand out the interlaced image one band at a time
+        const int lines = qMin(maximumHeight, bandImage.height() - bandRow);
+        *band = bandImage.copy(0, bandRow, bandImage.width(), lines);
+        bandRow += lines;
+        if (bandRow >= bandImage.height())
+            bandImage = QImage();
+        return true;
+    }
+
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        bandImage = QImage();
+        state = Error;
+        return false;
+    }
+
+    const int height = int(png_get_image_height(png_ptr, info_ptr));
+    const int lines = qMin(maximumHeight, height - bandRow);
+    if (!QImageIOHandler::allocateImage(QSize(bandImage.width(), lines), bandImage.format(), band)) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        bandImage = QImage();
+        state = Error;
+        return false;
+    }
+    band->setColorTable(bandImage.colorTable());
+
+    for (int y = 0; y < lines; ++y)
+        png_read_row(png_ptr, band->scanLine(y), nullptr);
+
+    // sanity check palette entries
+    if (png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE
+            && band->format() == QImage::Format_Indexed8) {
+        const int color_table_size = band->colorCount();
+        for (int y = 0; y < lines; ++y) {
+            uchar *p = band->scanLine(y);
+            uchar *end = p + band->width();
+            while (p < end) {
+                if (*p >= color_table_size)
+                    *p = 0;
+                ++p;
+            }
+        }
+    }
+
+    band->setDotsPerMeterX(png_get_x_pixels_per_meter(png_ptr, info_ptr));
+    band->setDotsPerMeterY(png_get_y_pixels_per_meter(png_ptr, info_ptr));
+    if (colorSpaceState > Undefined && colorSpace.isValid())
+        band->setColorSpace(colorSpace);
+
+    bandRow += lines;
+    if (bandRow >= height) {
+        state = ReadingEnd;
+        png_read_end(png_ptr, end_info);
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        bandImage = QImage();
+        state = Ready;
+    }
+
+    return true;
+}
+
+void QPngHandlerPrivate::setupGamma()
+{
+    if (gamma != 0.0 && fileGamma != 0.0) {
+        // This configuration forces gamma correction and
+        // thus changes the output colorspace
+        png_set_gamma(png_ptr, 1.0f / gamma, fileGamma);
+        colorSpace.setTransferFunction(QColorSpace::TransferFunction::Gamma, 1.0f / gamma);
+        colorSpaceState = GammaChrm;
+    }
+}
+
 QImage::Format QPngHandlerPrivate::readImageFormat()
 {
         QImage::Format format = QImage::Format_Invalid;
@@ -789,7 +925,8 @@ QPNGImageWriter::QPNGImageWriter(QIODevice* iod) :
     disposal(Unspecified),
     looping(-1),
     ms_delay(-1),
-    gamma(0.0)
+    gamma(0.0),
+    fastFilters(false)
 {
 }
 
@@ -817,6 +954,11 @@ void QPNGImageWriter::setGamma(float g)
     gamma = g;
 }
 
+void QPNGImageWriter::setFastFilters(bool fast)
+{
+    fastFilters = fast;
+}
+
 static void set_text(const QImage &image, png_structp png_ptr, png_infop info_ptr,
                      const QString &description)
 {
@@ -959,6 +1101,20 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
                  bpc, // per channel
                  color_type, 0, 0, 0);       // sets #channels
 
+    // libpng's default for 8 and 16 bit samples is to try all five row filters
+    // and keep the best one, which dominates the cost of the fast compression
+    // levels. The "fast" subtype skips the filters when nothing is deflated,
+    // and otherwise uses a single Paeth filter with run-length matching, which
+    // is about twice as fast and compresses screen content about as well.
+    if (fastFilters && bpc >= 8 && color_type != PNG_COLOR_TYPE_PALETTE) {
+        if (compression == 0) {
+            png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+        } else {
+            png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_PAETH);
+            png_set_compression_strategy(png_ptr, Z_RLE);
+        }
+    }
+
 #ifdef PNG_iCCP_SUPPORTED
     if (image.colorSpace().isValid()) {
         QColorSpace cs = image.colorSpace();
@@ -1162,7 +1318,8 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
 }
 
 static bool write_png_image(const QImage &image, QIODevice *device,
-                            int compression, int quality, float gamma, const QString &description)
+                            int compression, int quality, float gamma, const QString &description,
+                            bool fastFilters)
 {
     // quality is used for backward compatibility, maps to compression
 
@@ -1176,6 +1333,7 @@ static bool write_png_image(const QImage &image, QIODevice *device,
         compression = (compression * 9) / 91; // map [0,100] -> [0,9]
 
     writer.setGamma(gamma);
+    writer.setFastFilters(fastFilters);
     return writer.writeImage(image, compression, description);
 }
 
@@ -1221,9 +1379,18 @@ bool QPngHandler::read(QImage *image)
     return d->readPngImage(image);
 }
 
+bool QPngHandler::readBand(QImage *band, int maximumHeight)
+{
+    // The rest of an image that is being read in bands may already be decoded
+    if (d->bandImage.isNull() && !canRead())
+        return false;
+    return d->readPngBand(band, maximumHeight);
+}
+
 bool QPngHandler::write(const QImage &image)
 {
-    return write_png_image(image, device(), d->compression, d->quality, d->gamma, d->description);
+    return write_png_image(image, device(), d->compression, d->quality, d->gamma, d->description,
+                           d->subType == "fast");
 }
 
 bool QPngHandler::supportsOption(ImageOption option) const
@@ -1234,11 +1401,20 @@ bool QPngHandler::supportsOption(ImageOption option) const
         || option == Quality
         || option == CompressionRatio
         || option == Size
-        || option == ScaledSize;
+        || option == ScaledSize
+        || option == BandedReading
+        || option == SubType
+        || option == SupportedSubTypes;
 }
 
 QVariant QPngHandler::option(ImageOption option) const
 {
+    // write options, available without reading the header
+    if (option == SubType)
+        return d->subType;
+    else if (option == SupportedSubTypes)
+        return QVariant::fromValue(QList<QByteArray>() << "default" << "fast");
+
     if (d->state == QPngHandlerPrivate::Error)
         return QVariant();
     if (d->state == QPngHandlerPrivate::Ready && !d->readPngHeader())
@@ -1274,6 +1450,8 @@ void QPngHandler::setOption(ImageOption option, const QVariant &value)
         d->description = value.toString();
     else if (option == ScaledSize)
         d->scaledSize = value.toSize();
+    else if (option == SubType)
+        d->subType = value.toByteArray().toLower();
 }
 
 QT_END_NAMESPACE
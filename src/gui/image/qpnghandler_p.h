@@ -68,6 +68,7 @@ public:
     bool canRead() const override;
     bool read(QImage *image) override;
     bool write(const QImage &image) override;
+    bool readBand(QImage *band, int maximumHeight) override;
 
     QVariant option(ImageOption option) const override;
     void setOption(ImageOption option, const QVariant &value) override;
@@ -61,6 +61,7 @@ HEADERS += \
         painting/qrgba64_p.h \
         painting/qstroker_p.h \
         painting/qtextureglyphcache_p.h \
+        painting/qtiledpaintdevice_p.h \
         painting/qtransform.h \
         painting/qtriangulatingstroker_p.h \
         painting/qtriangulator_p.h \
@@ -108,6 +109,7 @@ SOURCES += \
         painting/qregion.cpp \
         painting/qstroker.cpp \
         painting/qtextureglyphcache.cpp \
+        painting/qtiledpaintdevice.cpp \
         painting/qtransform.cpp \
         painting/qtriangulatingstroker.cpp \
         painting/qtriangulator.cpp \
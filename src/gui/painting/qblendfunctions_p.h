@@ -44,6 +44,8 @@
 #include <qmath.h>
 #include "qdrawhelper_p.h"
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 //
@@ -78,6 +80,11 @@ void qt_scale_image_16bit(uchar *destPixels, int dbpl,
 //              << " - sx=" << sx << " sy=" << sy << " ix=" << ix << " iy=" << iy;
 
     QRect tr = targetRect.normalized().toRect();
+    // The source position is computed for the unclipped top-left pixel and
+    // then stepped to the clipped one, so that the result does not depend on
+    // the clip.
+    const int ux1 = tr.left();
+    const int uy1 = tr.top();
     tr = tr.intersected(clip);
     if (tr.isEmpty())
         return;
@@ -90,19 +97,21 @@ void qt_scale_image_16bit(uchar *destPixels, int dbpl,
     quint32 srcy;
 
     if (sx < 0) {
-        int dstx = qFloor((tx1 + qreal(0.5) - targetRect.right()) * sx * 65536) + 1;
+        int dstx = qFloor((ux1 + qreal(0.5) - targetRect.right()) * sx * 65536) + 1;
         basex = quint32(srcRect.right() * 65536) + dstx;
     } else {
-        int dstx = qCeil((tx1 + qreal(0.5) - targetRect.left()) * sx * 65536) - 1;
+        int dstx = qCeil((ux1 + qreal(0.5) - targetRect.left()) * sx * 65536) - 1;
         basex = quint32(srcRect.left() * 65536) + dstx;
     }
     if (sy < 0) {
-        int dsty = qFloor((ty1 + qreal(0.5) - targetRect.bottom()) * sy * 65536) + 1;
+        int dsty = qFloor((uy1 + qreal(0.5) - targetRect.bottom()) * sy * 65536) + 1;
         srcy = quint32(srcRect.bottom() * 65536) + dsty;
     } else {
-        int dsty = qCeil((ty1 + qreal(0.5) - targetRect.top()) * sy * 65536) - 1;
+        int dsty = qCeil((uy1 + qreal(0.5) - targetRect.top()) * sy * 65536) - 1;
         srcy = quint32(srcRect.top() * 65536) + dsty;
     }
+    basex += quint32(tx1 - ux1) * quint32(ix);
+    srcy += quint32(ty1 - uy1) * quint32(iy);
 
     quint16 *dst = ((quint16 *) (destPixels + ty1 * dbpl)) + tx1;
 
@@ -169,6 +178,11 @@ template <typename T> void qt_scale_image_32bit(uchar *destPixels, int dbpl,
 //              << " - sx=" << sx << " sy=" << sy << " ix=" << ix << " iy=" << iy;
 
     QRect tr = targetRect.normalized().toRect();
+    // The source position is computed for the unclipped top-left pixel and
+    // then stepped to the clipped one, so that the result does not depend on
+    // the clip.
+    const int ux1 = tr.left();
+    const int uy1 = tr.top();
     tr = tr.intersected(clip);
     if (tr.isEmpty())
         return;
@@ -181,19 +195,21 @@ template <typename T> void qt_scale_image_32bit(uchar *destPixels, int dbpl,
     quint32 srcy;
 
     if (sx < 0) {
-        int dstx = qFloor((tx1 + qreal(0.5) - targetRect.right()) * sx * 65536) + 1;
+        int dstx = qFloor((ux1 + qreal(0.5) - targetRect.right()) * sx * 65536) + 1;
         basex = quint32(srcRect.right() * 65536) + dstx;
     } else {
-        int dstx = qCeil((tx1 + qreal(0.5) - targetRect.left()) * sx * 65536) - 1;
+        int dstx = qCeil((ux1 + qreal(0.5) - targetRect.left()) * sx * 65536) - 1;
         basex = quint32(srcRect.left() * 65536) + dstx;
     }
     if (sy < 0) {
-        int dsty = qFloor((ty1 + qreal(0.5) - targetRect.bottom()) * sy * 65536) + 1;
+        int dsty = qFloor((uy1 + qreal(0.5) - targetRect.bottom()) * sy * 65536) + 1;
         srcy = quint32(srcRect.bottom() * 65536) + dsty;
     } else {
-        int dsty = qCeil((ty1 + qreal(0.5) - targetRect.top()) * sy * 65536) - 1;
+        int dsty = qCeil((uy1 + qreal(0.5) - targetRect.top()) * sy * 65536) - 1;
         srcy = quint32(srcRect.top() * 65536) + dsty;
     }
+    basex += quint32(tx1 - ux1) * quint32(ix);
+    srcy += quint32(ty1 - uy1) * quint32(iy);
 
     quint32 *dst = ((quint32 *) (destPixels + ty1 * dbpl)) + tx1;
 
@@ -246,7 +262,9 @@ void qt_transform_image_rasterize(DestT *destPixels, int dbpl,
                                   int dudx, int dvdx, int dudy, int dvdy, int u0, int v0,
                                   Blender blender)
 {
-    int fromY = qMax(qRound(topY), clip.top());
+    // The destination starts at row 0, edges are never evaluated above it.
+    const int unclippedFromY = qRound(qMax(topY, qreal(0)));
+    int fromY = qMax(unclippedFromY, clip.top());
     int toY = qMin(qRound(bottomY), clip.top() + clip.height());
     if (fromY >= toY)
         return;
@@ -255,8 +273,17 @@ void qt_transform_image_rasterize(DestT *destPixels, int dbpl,
     qreal rightSlope = (bottomRight.x - topRight.x) / (bottomRight.y - topRight.y);
     int dx_l = int(leftSlope * 0x10000);
     int dx_r = int(rightSlope * 0x10000);
-    int x_l = int((topLeft.x + (qreal(0.5) + fromY - topLeft.y) * leftSlope + qreal(0.5)) * 0x10000);
-    int x_r = int((topRight.x + (qreal(0.5) + fromY - topRight.y) * rightSlope + qreal(0.5)) * 0x10000);
+    // Start the edges at the first scan line inside the destination and step
+    // them down to the clipped one, so that the edges do not depend on the clip.
+    int x_l = int((topLeft.x + (qreal(0.5) + unclippedFromY - topLeft.y) * leftSlope + qreal(0.5)) * 0x10000);
+    int x_r = int((topRight.x + (qreal(0.5) + unclippedFromY - topRight.y) * rightSlope + qreal(0.5)) * 0x10000);
+    const auto stepEdge = [fromY, unclippedFromY](int x, int dx) {
+        const qint64 stepped = x + qint64(dx) * (fromY - unclippedFromY);
+        return int(qBound(qint64(std::numeric_limits<int>::min()), stepped,
+                          qint64(std::numeric_limits<int>::max())));
+    };
+    x_l = stepEdge(x_l, dx_l);
+    x_r = stepEdge(x_r, dx_r);
 
     int fromX, toX, x1, x2, u, v, i, ii;
     DestT *line;
@@ -5270,6 +5270,44 @@ static void qInitDrawhelperFunctions()
         qt_functionForMode_C[QPainter::CompositionMode_Source] = comp_func_Source_avx2;
         qt_functionForMode_C[QPainter::CompositionMode_SourceOver] = comp_func_SourceOver_avx2;
         qt_functionForModeSolid_C[QPainter::CompositionMode_SourceOver] = comp_func_solid_SourceOver_avx2;
+
+        extern void QT_FASTCALL comp_func_DestinationOver_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_SourceIn_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_DestinationIn_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_SourceOut_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_DestinationOut_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_SourceAtop_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_DestinationAtop_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_XOR_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_Plus_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationOver_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_SourceIn_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationIn_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_SourceOut_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationOut_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_SourceAtop_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationAtop_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_XOR_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_Plus_avx2(uint *destPixels, int length, uint color, uint const_alpha);
+        qt_functionForMode_C[QPainter::CompositionMode_DestinationOver] = comp_func_DestinationOver_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_SourceIn] = comp_func_SourceIn_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_DestinationIn] = comp_func_DestinationIn_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_SourceOut] = comp_func_SourceOut_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_DestinationOut] = comp_func_DestinationOut_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_SourceAtop] = comp_func_SourceAtop_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_DestinationAtop] = comp_func_DestinationAtop_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_Xor] = comp_func_XOR_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_Plus] = comp_func_Plus_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_DestinationOver] = comp_func_solid_DestinationOver_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_SourceIn] = comp_func_solid_SourceIn_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_DestinationIn] = comp_func_solid_DestinationIn_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_SourceOut] = comp_func_solid_SourceOut_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_DestinationOut] = comp_func_solid_DestinationOut_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_SourceAtop] = comp_func_solid_SourceAtop_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_DestinationAtop] = comp_func_solid_DestinationAtop_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_Xor] = comp_func_solid_XOR_avx2;
+        qt_functionForModeSolid_C[QPainter::CompositionMode_Plus] = comp_func_solid_Plus_avx2;
+
 #if QT_CONFIG(raster_64bit)
         extern void QT_FASTCALL comp_func_Source_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
         extern void QT_FASTCALL comp_func_SourceOver_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
@@ -5277,6 +5315,43 @@ static void qInitDrawhelperFunctions()
         qt_functionForMode64_C[QPainter::CompositionMode_Source] = comp_func_Source_rgb64_avx2;
         qt_functionForMode64_C[QPainter::CompositionMode_SourceOver] = comp_func_SourceOver_rgb64_avx2;
         qt_functionForModeSolid64_C[QPainter::CompositionMode_SourceOver] = comp_func_solid_SourceOver_rgb64_avx2;
+
+        extern void QT_FASTCALL comp_func_DestinationOver_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_SourceIn_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_DestinationIn_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_SourceOut_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_DestinationOut_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_SourceAtop_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_DestinationAtop_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_XOR_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_Plus_rgb64_avx2(QRgba64 *destPixels, const QRgba64 *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationOver_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_SourceIn_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationIn_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_SourceOut_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationOut_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_SourceAtop_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_DestinationAtop_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_XOR_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        extern void QT_FASTCALL comp_func_solid_Plus_rgb64_avx2(QRgba64 *destPixels, int length, QRgba64 color, uint const_alpha);
+        qt_functionForMode64_C[QPainter::CompositionMode_DestinationOver] = comp_func_DestinationOver_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_SourceIn] = comp_func_SourceIn_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_DestinationIn] = comp_func_DestinationIn_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_SourceOut] = comp_func_SourceOut_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_DestinationOut] = comp_func_DestinationOut_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_SourceAtop] = comp_func_SourceAtop_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_DestinationAtop] = comp_func_DestinationAtop_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_Xor] = comp_func_XOR_rgb64_avx2;
+        qt_functionForMode64_C[QPainter::CompositionMode_Plus] = comp_func_Plus_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_DestinationOver] = comp_func_solid_DestinationOver_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_SourceIn] = comp_func_solid_SourceIn_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_DestinationIn] = comp_func_solid_DestinationIn_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_SourceOut] = comp_func_solid_SourceOut_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_DestinationOut] = comp_func_solid_DestinationOut_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_SourceAtop] = comp_func_solid_SourceAtop_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_DestinationAtop] = comp_func_solid_DestinationAtop_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_Xor] = comp_func_solid_XOR_rgb64_avx2;
+        qt_functionForModeSolid64_C[QPainter::CompositionMode_Plus] = comp_func_solid_Plus_rgb64_avx2;
 #endif
 
         extern void QT_FASTCALL fetchTransformedBilinearARGB32PM_simple_scale_helper_avx2(uint *b, uint *end, const QTextureData &image,
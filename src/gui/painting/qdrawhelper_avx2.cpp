@@ -1229,6 +1229,529 @@ const QRgba64 *QT_FASTCALL fetchRGBA8888ToRGBA64PM_avx2(QRgba64 *buffer, const u
     return buffer;
 }
 
+// Composition modes without a dedicated AVX2 implementation above. These follow the
+// templates in qcompositionfunctions.cpp operation for operation, so the results
+// are identical to the generic code, just processing 8 (ARGB32) or 4 (RGBA64) pixels
+// per step, with a masked load/store for the remainder.
+
+struct Argb32OperationsAVX2
+{
+    typedef quint32 Type;
+    // one alpha value per 16-bit lane, matching the layout BYTE_MUL_AVX2 expects
+    typedef __m256i OptimalScalar;
+    enum { Size = 8 };
+
+    static __m256i tailMask(int count)
+    { return epilogueMaskFromCount(count); }
+    static __m256i load(const Type *ptr)
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+    static __m256i maskLoad(const Type *ptr, __m256i mask)
+    { return _mm256_maskload_epi32(reinterpret_cast<const int *>(ptr), mask); }
+    static void store(Type *ptr, __m256i value)
+    { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), value); }
+    static void maskStore(Type *ptr, __m256i mask, __m256i value)
+    { _mm256_maskstore_epi32(reinterpret_cast<int *>(ptr), mask, value); }
+    static __m256i convert(Type value)
+    { return _mm256_set1_epi32(value); }
+
+    static __m256i add(__m256i a, __m256i b)
+    { return _mm256_add_epi32(a, b); }
+    static OptimalScalar addScalar(OptimalScalar a, OptimalScalar b)
+    { return _mm256_add_epi16(a, b); }
+    static __m256i plus(__m256i a, __m256i b)
+    { return _mm256_adds_epu8(a, b); }
+    static OptimalScalar alpha(__m256i value)
+    {
+        const __m256i alphaShuffleMask = _mm256_set_epi8(char(0xff),15,char(0xff),15,char(0xff),11,char(0xff),11,char(0xff),7,char(0xff),7,char(0xff),3,char(0xff),3,
+                                                         char(0xff),15,char(0xff),15,char(0xff),11,char(0xff),11,char(0xff),7,char(0xff),7,char(0xff),3,char(0xff),3);
+        return _mm256_shuffle_epi8(value, alphaShuffleMask);
+    }
+    static OptimalScalar invAlphaScalar(OptimalScalar a)
+    { return _mm256_sub_epi16(_mm256_set1_epi16(0xff), a); }
+    static OptimalScalar invAlpha(__m256i value)
+    { return invAlphaScalar(alpha(value)); }
+    static OptimalScalar scalarFrom8bit(uint a)
+    { return _mm256_set1_epi16(a); }
+
+    static __m256i multiplyAlpha(__m256i value, OptimalScalar a)
+    {
+        BYTE_MUL_AVX2(value, a, _mm256_set1_epi32(0x00ff00ff), _mm256_set1_epi16(0x80));
+        return value;
+    }
+    static __m256i multiplyAlpha8bit(__m256i value, uint a)
+    { return multiplyAlpha(value, scalarFrom8bit(a)); }
+    static OptimalScalar multiplyAlphaScalar8bit(OptimalScalar value, uint a)
+    {
+        // qt_div_255(value * a) for each lane
+        __m256i t = _mm256_mullo_epi16(value, _mm256_set1_epi16(a));
+        t = _mm256_add_epi16(t, _mm256_srli_epi16(t, 8));
+        t = _mm256_add_epi16(t, _mm256_set1_epi16(0x80));
+        return _mm256_srli_epi16(t, 8);
+    }
+    static __m256i interpolate(__m256i x, OptimalScalar a1, __m256i y, OptimalScalar a2)
+    {
+        INTERPOLATE_PIXEL_255_AVX2(x, y, a1, a2, _mm256_set1_epi32(0x00ff00ff), _mm256_set1_epi16(0x80));
+        return y;
+    }
+    static __m256i interpolate8bit(__m256i x, uint a1, __m256i y, uint a2)
+    { return interpolate(x, scalarFrom8bit(a1), y, scalarFrom8bit(a2)); }
+};
+
+#if QT_CONFIG(raster_64bit)
+struct Rgba64OperationsAVX2
+{
+    typedef QRgba64 Type;
+    // the alpha value repeated in all four 16-bit lanes of each pixel
+    typedef __m256i OptimalScalar;
+    enum { Size = 4 };
+
+    static __m256i tailMask(int count)
+    { return epilogueMaskFromCount(count * 2); }
+    static __m256i load(const Type *ptr)
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+    static __m256i maskLoad(const Type *ptr, __m256i mask)
+    { return _mm256_maskload_epi32(reinterpret_cast<const int *>(ptr), mask); }
+    static void store(Type *ptr, __m256i value)
+    { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), value); }
+    static void maskStore(Type *ptr, __m256i mask, __m256i value)
+    { _mm256_maskstore_epi32(reinterpret_cast<int *>(ptr), mask, value); }
+    static __m256i convert(Type value)
+    { return _mm256_set1_epi64x(value); }
+
+    static __m256i add(__m256i a, __m256i b)
+    { return _mm256_add_epi16(a, b); }
+    static OptimalScalar addScalar(OptimalScalar a, OptimalScalar b)
+    { return _mm256_add_epi16(a, b); }
+    static __m256i plus(__m256i a, __m256i b)
+    { return _mm256_adds_epu16(a, b); }
+    static OptimalScalar alpha(__m256i value)
+    {
+        const __m256i alphaShuffleMask = _mm256_set_epi8(15,14,15,14,15,14,15,14,7,6,7,6,7,6,7,6,
+                                                         15,14,15,14,15,14,15,14,7,6,7,6,7,6,7,6);
+        return _mm256_shuffle_epi8(value, alphaShuffleMask);
+    }
+    static OptimalScalar invAlphaScalar(OptimalScalar a)
+    { return _mm256_xor_si256(_mm256_set1_epi16(-1), a); }
+    static OptimalScalar invAlpha(__m256i value)
+    { return invAlphaScalar(alpha(value)); }
+    static OptimalScalar scalarFrom8bit(uint a)
+    { return _mm256_set1_epi16(a * 257); }
+
+    // See multiplyAlpha65535 in qrgba64_p.h.
+    static __m256i multiplyAlpha(__m256i value, OptimalScalar a)
+    {
+        const __m256i lo16 = _mm256_mullo_epi16(value, a);
+        const __m256i hi16 = _mm256_mulhi_epu16(value, a);
+        __m256i lo = _mm256_unpacklo_epi16(lo16, hi16);
+        __m256i hi = _mm256_unpackhi_epi16(lo16, hi16);
+        lo = _mm256_add_epi32(lo, _mm256_srli_epi32(lo, 16));
+        hi = _mm256_add_epi32(hi, _mm256_srli_epi32(hi, 16));
+        lo = _mm256_add_epi32(lo, _mm256_set1_epi32(0x8000));
+        hi = _mm256_add_epi32(hi, _mm256_set1_epi32(0x8000));
+        lo = _mm256_srli_epi32(lo, 16);
+        hi = _mm256_srli_epi32(hi, 16);
+        return _mm256_packus_epi32(lo, hi);
+    }
+    static __m256i multiplyAlpha8bit(__m256i value, uint a)
+    { return multiplyAlpha(value, scalarFrom8bit(a)); }
+    static OptimalScalar multiplyAlphaScalar8bit(OptimalScalar value, uint a)
+    { return multiplyAlpha8bit(value, a); }
+    static __m256i interpolate(__m256i x, OptimalScalar a1, __m256i y, OptimalScalar a2)
+    { return _mm256_add_epi32(multiplyAlpha(x, a1), multiplyAlpha(y, a2)); }
+    static __m256i interpolate8bit(__m256i x, uint a1, __m256i y, uint a2)
+    { return interpolate(x, scalarFrom8bit(a1), y, scalarFrom8bit(a2)); }
+};
+#endif
+
+template<class Ops, typename Op>
+static inline void comp_func_avx2(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                  const typename Ops::Type *Q_DECL_RESTRICT src,
+                                  int length, Op op)
+{
+    int i = 0;
+    for (; i < length - (Ops::Size - 1); i += Ops::Size)
+        Ops::store(dest + i, op(Ops::load(src + i), Ops::load(dest + i)));
+    if (i < length) {
+        const __m256i mask = Ops::tailMask(length - i);
+        Ops::maskStore(dest + i, mask, op(Ops::maskLoad(src + i, mask), Ops::maskLoad(dest + i, mask)));
+    }
+}
+
+template<class Ops, typename Op>
+static inline void comp_func_solid_avx2(typename Ops::Type *dest, int length, Op op)
+{
+    int i = 0;
+    for (; i < length - (Ops::Size - 1); i += Ops::Size)
+        Ops::store(dest + i, op(Ops::load(dest + i)));
+    if (i < length) {
+        const __m256i mask = Ops::tailMask(length - i);
+        Ops::maskStore(dest + i, mask, op(Ops::maskLoad(dest + i, mask)));
+    }
+}
+
+/*
+  result = d + s * dia
+  dest = d + s * dia * ca
+*/
+template<class Ops>
+static void comp_func_solid_DestinationOver_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    auto c = Ops::convert(color);
+    if (const_alpha != 255)
+        c = Ops::multiplyAlpha8bit(c, const_alpha);
+    comp_func_solid_avx2<Ops>(dest, length, [c](__m256i d) {
+        return Ops::add(Ops::multiplyAlpha(c, Ops::invAlpha(d)), d);
+    });
+}
+
+template<class Ops>
+static void comp_func_DestinationOver_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                                    const typename Ops::Type *Q_DECL_RESTRICT src,
+                                                    int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::add(Ops::multiplyAlpha(s, Ops::invAlpha(d)), d);
+        });
+    } else {
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha](__m256i s, __m256i d) {
+            s = Ops::multiplyAlpha8bit(s, const_alpha);
+            return Ops::add(Ops::multiplyAlpha(s, Ops::invAlpha(d)), d);
+        });
+    }
+}
+
+/*
+  result = s * da
+  dest = s * da * ca + d * cia
+*/
+template<class Ops>
+static void comp_func_solid_SourceIn_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        const auto c = Ops::convert(color);
+        comp_func_solid_avx2<Ops>(dest, length, [c](__m256i d) {
+            return Ops::multiplyAlpha(c, Ops::alpha(d));
+        });
+    } else {
+        const auto c = Ops::multiplyAlpha8bit(Ops::convert(color), const_alpha);
+        const auto cia = Ops::scalarFrom8bit(255 - const_alpha);
+        comp_func_solid_avx2<Ops>(dest, length, [c, cia](__m256i d) {
+            return Ops::interpolate(c, Ops::alpha(d), d, cia);
+        });
+    }
+}
+
+template<class Ops>
+static void comp_func_SourceIn_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                             const typename Ops::Type *Q_DECL_RESTRICT src,
+                                             int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::multiplyAlpha(s, Ops::alpha(d));
+        });
+    } else {
+        const auto ca = Ops::scalarFrom8bit(const_alpha);
+        const auto cia = Ops::invAlphaScalar(ca);
+        comp_func_avx2<Ops>(dest, src, length, [ca, cia](__m256i s, __m256i d) {
+            s = Ops::multiplyAlpha(s, ca);
+            return Ops::interpolate(s, Ops::alpha(d), d, cia);
+        });
+    }
+}
+
+/*
+  result = d * sa
+  dest = d * (sa * ca + cia)
+*/
+template<class Ops>
+static void comp_func_solid_DestinationIn_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    auto sa = Ops::alpha(Ops::convert(color));
+    if (const_alpha != 255) {
+        sa = Ops::multiplyAlphaScalar8bit(sa, const_alpha);
+        sa = Ops::addScalar(sa, Ops::scalarFrom8bit(255 - const_alpha));
+    }
+    comp_func_solid_avx2<Ops>(dest, length, [sa](__m256i d) {
+        return Ops::multiplyAlpha(d, sa);
+    });
+}
+
+template<class Ops>
+static void comp_func_DestinationIn_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                                  const typename Ops::Type *Q_DECL_RESTRICT src,
+                                                  int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::multiplyAlpha(d, Ops::alpha(s));
+        });
+    } else {
+        const auto cia = Ops::scalarFrom8bit(255 - const_alpha);
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha, cia](__m256i s, __m256i d) {
+            const auto sa = Ops::addScalar(Ops::multiplyAlphaScalar8bit(Ops::alpha(s), const_alpha), cia);
+            return Ops::multiplyAlpha(d, sa);
+        });
+    }
+}
+
+/*
+  result = s * dia
+  dest = s * dia * ca + d * cia
+*/
+template<class Ops>
+static void comp_func_solid_SourceOut_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        const auto c = Ops::convert(color);
+        comp_func_solid_avx2<Ops>(dest, length, [c](__m256i d) {
+            return Ops::multiplyAlpha(c, Ops::invAlpha(d));
+        });
+    } else {
+        const auto c = Ops::multiplyAlpha8bit(Ops::convert(color), const_alpha);
+        const auto cia = Ops::scalarFrom8bit(255 - const_alpha);
+        comp_func_solid_avx2<Ops>(dest, length, [c, cia](__m256i d) {
+            return Ops::interpolate(c, Ops::invAlpha(d), d, cia);
+        });
+    }
+}
+
+template<class Ops>
+static void comp_func_SourceOut_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                              const typename Ops::Type *Q_DECL_RESTRICT src,
+                                              int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::multiplyAlpha(s, Ops::invAlpha(d));
+        });
+    } else {
+        const auto cia = Ops::scalarFrom8bit(255 - const_alpha);
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha, cia](__m256i s, __m256i d) {
+            s = Ops::multiplyAlpha8bit(s, const_alpha);
+            return Ops::interpolate(s, Ops::invAlpha(d), d, cia);
+        });
+    }
+}
+
+/*
+  result = d * sia
+  dest = d * (sia * ca + cia)
+*/
+template<class Ops>
+static void comp_func_solid_DestinationOut_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    auto sai = Ops::invAlpha(Ops::convert(color));
+    if (const_alpha != 255) {
+        sai = Ops::multiplyAlphaScalar8bit(sai, const_alpha);
+        sai = Ops::addScalar(sai, Ops::scalarFrom8bit(255 - const_alpha));
+    }
+    comp_func_solid_avx2<Ops>(dest, length, [sai](__m256i d) {
+        return Ops::multiplyAlpha(d, sai);
+    });
+}
+
+template<class Ops>
+static void comp_func_DestinationOut_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                                   const typename Ops::Type *Q_DECL_RESTRICT src,
+                                                   int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::multiplyAlpha(d, Ops::invAlpha(s));
+        });
+    } else {
+        const auto cia = Ops::scalarFrom8bit(255 - const_alpha);
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha, cia](__m256i s, __m256i d) {
+            const auto sia = Ops::addScalar(Ops::multiplyAlphaScalar8bit(Ops::invAlpha(s), const_alpha), cia);
+            return Ops::multiplyAlpha(d, sia);
+        });
+    }
+}
+
+/*
+  result = s*da + d*sia
+  dest = s*ca * da + d * (1 - sa*ca)
+*/
+template<class Ops>
+static void comp_func_solid_SourceAtop_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    auto c = Ops::convert(color);
+    if (const_alpha != 255)
+        c = Ops::multiplyAlpha8bit(c, const_alpha);
+    const auto sia = Ops::invAlpha(c);
+    comp_func_solid_avx2<Ops>(dest, length, [c, sia](__m256i d) {
+        return Ops::interpolate(c, Ops::alpha(d), d, sia);
+    });
+}
+
+template<class Ops>
+static void comp_func_SourceAtop_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                               const typename Ops::Type *Q_DECL_RESTRICT src,
+                                               int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::interpolate(s, Ops::alpha(d), d, Ops::invAlpha(s));
+        });
+    } else {
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha](__m256i s, __m256i d) {
+            s = Ops::multiplyAlpha8bit(s, const_alpha);
+            return Ops::interpolate(s, Ops::alpha(d), d, Ops::invAlpha(s));
+        });
+    }
+}
+
+/*
+  result = d*sa + s*dia
+  dest = s*ca * dia + d * (sa*ca + cia)
+*/
+template<class Ops>
+static void comp_func_solid_DestinationAtop_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    auto c = Ops::convert(color);
+    auto sa = Ops::alpha(c);
+    if (const_alpha != 255) {
+        c = Ops::multiplyAlpha8bit(c, const_alpha);
+        sa = Ops::addScalar(Ops::alpha(c), Ops::scalarFrom8bit(255 - const_alpha));
+    }
+    comp_func_solid_avx2<Ops>(dest, length, [c, sa](__m256i d) {
+        return Ops::interpolate(c, Ops::invAlpha(d), d, sa);
+    });
+}
+
+template<class Ops>
+static void comp_func_DestinationAtop_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                                    const typename Ops::Type *Q_DECL_RESTRICT src,
+                                                    int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::interpolate(s, Ops::invAlpha(d), d, Ops::alpha(s));
+        });
+    } else {
+        const auto cia = Ops::scalarFrom8bit(255 - const_alpha);
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha, cia](__m256i s, __m256i d) {
+            s = Ops::multiplyAlpha8bit(s, const_alpha);
+            return Ops::interpolate(s, Ops::invAlpha(d), d, Ops::addScalar(Ops::alpha(s), cia));
+        });
+    }
+}
+
+/*
+  result = d*sia + s*dia
+  dest = s*ca * dia + d * (1 - sa*ca)
+*/
+template<class Ops>
+static void comp_func_solid_XOR_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    auto c = Ops::convert(color);
+    if (const_alpha != 255)
+        c = Ops::multiplyAlpha8bit(c, const_alpha);
+    const auto sia = Ops::invAlpha(c);
+    comp_func_solid_avx2<Ops>(dest, length, [c, sia](__m256i d) {
+        return Ops::interpolate(c, Ops::invAlpha(d), d, sia);
+    });
+}
+
+template<class Ops>
+static void comp_func_XOR_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                        const typename Ops::Type *Q_DECL_RESTRICT src,
+                                        int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::interpolate(s, Ops::invAlpha(d), d, Ops::invAlpha(s));
+        });
+    } else {
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha](__m256i s, __m256i d) {
+            s = Ops::multiplyAlpha8bit(s, const_alpha);
+            return Ops::interpolate(s, Ops::invAlpha(d), d, Ops::invAlpha(s));
+        });
+    }
+}
+
+/*
+    Dca' = Sca + Dca
+*/
+template<class Ops>
+static void comp_func_solid_Plus_avx2_template(typename Ops::Type *dest, int length, typename Ops::Type color, uint const_alpha)
+{
+    const auto c = Ops::convert(color);
+    if (const_alpha == 255) {
+        comp_func_solid_avx2<Ops>(dest, length, [c](__m256i d) {
+            return Ops::plus(d, c);
+        });
+    } else {
+        comp_func_solid_avx2<Ops>(dest, length, [c, const_alpha](__m256i d) {
+            return Ops::interpolate8bit(Ops::plus(d, c), const_alpha, d, 255 - const_alpha);
+        });
+    }
+}
+
+template<class Ops>
+static void comp_func_Plus_avx2_template(typename Ops::Type *Q_DECL_RESTRICT dest,
+                                         const typename Ops::Type *Q_DECL_RESTRICT src,
+                                         int length, uint const_alpha)
+{
+    if (const_alpha == 255) {
+        comp_func_avx2<Ops>(dest, src, length, [](__m256i s, __m256i d) {
+            return Ops::plus(d, s);
+        });
+    } else {
+        comp_func_avx2<Ops>(dest, src, length, [const_alpha](__m256i s, __m256i d) {
+            return Ops::interpolate8bit(Ops::plus(d, s), const_alpha, d, 255 - const_alpha);
+        });
+    }
+}
+
+#define QT_DEFINE_COMP_FUNCS_AVX2(mode) \
+void QT_FASTCALL comp_func_solid_##mode##_avx2(uint *dest, int length, uint color, uint const_alpha) \
+{ \
+    comp_func_solid_##mode##_avx2_template<Argb32OperationsAVX2>(dest, length, color, const_alpha); \
+} \
+void QT_FASTCALL comp_func_##mode##_avx2(uint *Q_DECL_RESTRICT dest, const uint *Q_DECL_RESTRICT src, int length, uint const_alpha) \
+{ \
+    comp_func_##mode##_avx2_template<Argb32OperationsAVX2>(dest, src, length, const_alpha); \
+}
+
+QT_DEFINE_COMP_FUNCS_AVX2(DestinationOver)
+QT_DEFINE_COMP_FUNCS_AVX2(SourceIn)
+QT_DEFINE_COMP_FUNCS_AVX2(DestinationIn)
+QT_DEFINE_COMP_FUNCS_AVX2(SourceOut)
+QT_DEFINE_COMP_FUNCS_AVX2(DestinationOut)
+QT_DEFINE_COMP_FUNCS_AVX2(SourceAtop)
+QT_DEFINE_COMP_FUNCS_AVX2(DestinationAtop)
+QT_DEFINE_COMP_FUNCS_AVX2(XOR)
+QT_DEFINE_COMP_FUNCS_AVX2(Plus)
+
+#undef QT_DEFINE_COMP_FUNCS_AVX2
+
+#if QT_CONFIG(raster_64bit)
+#define QT_DEFINE_COMP_FUNCS_RGB64_AVX2(mode) \
+void QT_FASTCALL comp_func_solid_##mode##_rgb64_avx2(QRgba64 *dest, int length, QRgba64 color, uint const_alpha) \
+{ \
+    comp_func_solid_##mode##_avx2_template<Rgba64OperationsAVX2>(dest, length, color, const_alpha); \
+} \
+void QT_FASTCALL comp_func_##mode##_rgb64_avx2(QRgba64 *Q_DECL_RESTRICT dest, const QRgba64 *Q_DECL_RESTRICT src, int length, uint const_alpha) \
+{ \
+    comp_func_##mode##_avx2_template<Rgba64OperationsAVX2>(dest, src, length, const_alpha); \
+}
+
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(DestinationOver)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(SourceIn)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(DestinationIn)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(SourceOut)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(DestinationOut)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(SourceAtop)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(DestinationAtop)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(XOR)
+QT_DEFINE_COMP_FUNCS_RGB64_AVX2(Plus)
+
+#undef QT_DEFINE_COMP_FUNCS_RGB64_AVX2
+#endif
+
 QT_END_NAMESPACE
 
 #endif
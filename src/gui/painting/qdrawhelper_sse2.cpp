@@ -554,6 +554,10 @@ void qt_scale_image_argb32_on_argb32_sse2(uchar *destPixels, int dbpl,
     if (ty2 < ty1)
         qSwap(ty2, ty1);
 
+    // see qt_scale_image_32bit() for why the unclipped origin is kept
+    const int ux1 = tx1;
+    const int uy1 = ty1;
+
     if (tx1 < cx1)
         tx1 = cx1;
     if (tx2 >= cx2)
@@ -576,19 +580,21 @@ void qt_scale_image_argb32_on_argb32_sse2(uchar *destPixels, int dbpl,
     quint32 srcy;
 
     if (sx < 0) {
-        int dstx = qFloor((tx1 + qreal(0.5) - targetRect.right()) * ix) + 1;
+        int dstx = qFloor((ux1 + qreal(0.5) - targetRect.right()) * ix) + 1;
         basex = quint32(sourceRect.right() * 65536) + dstx;
     } else {
-        int dstx = qCeil((tx1 + qreal(0.5) - targetRect.left()) * ix) - 1;
+        int dstx = qCeil((ux1 + qreal(0.5) - targetRect.left()) * ix) - 1;
         basex = quint32(sourceRect.left() * 65536) + dstx;
     }
     if (sy < 0) {
-        int dsty = qFloor((ty1 + qreal(0.5) - targetRect.bottom()) * iy) + 1;
+        int dsty = qFloor((uy1 + qreal(0.5) - targetRect.bottom()) * iy) + 1;
         srcy = quint32(sourceRect.bottom() * 65536) + dsty;
     } else {
-        int dsty = qCeil((ty1 + qreal(0.5) - targetRect.top()) * iy) - 1;
+        int dsty = qCeil((uy1 + qreal(0.5) - targetRect.top()) * iy) - 1;
         srcy = quint32(sourceRect.top() * 65536) + dsty;
     }
+    basex += quint32(tx1 - ux1) * quint32(ix);
+    srcy += quint32(ty1 - uy1) * quint32(iy);
 
     quint32 *dst = ((quint32 *) (destPixels + ty1 * dbpl)) + tx1;
 
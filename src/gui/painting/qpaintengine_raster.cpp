@@ -463,6 +463,7 @@ bool QRasterPaintEngine::begin(QPaintDevice *device)
         d->outlineMapper->m_clip_rect.setHeight(QT_RASTER_COORD_LIMIT);
 
     d->rasterizer->setClipRect(d->deviceRect);
+    d->rasterizer->setDeviceRect(d->deviceRectUnclipped);
 
     s->penData.init(d->rasterBuffer.data(), this);
     s->penData.setup(s->pen.brush(), s->intOpacity, s->composition_mode);
@@ -717,11 +718,14 @@ void QRasterPaintEngine::updatePen(const QPen &pen)
     } else if (pen_style != Qt::NoPen) {
         if (!d->dashStroker)
             d->dashStroker.reset(new QDashStroker(&d->basicStroker));
+        // The dash pattern is advanced differently for culled segments, so
+        // cull against the unclipped device rect to get the same dashes
+        // regardless of the system clip.
         if (qt_pen_is_cosmetic(pen, s->renderHints)) {
-            d->dashStroker->setClipRect(d->deviceRect);
+            d->dashStroker->setClipRect(d->deviceRectUnclipped);
         } else {
             // ### I've seen this inverted devrect multiple places now...
-            QRectF clipRect = s->matrix.inverted().mapRect(QRectF(d->deviceRect));
+            QRectF clipRect = s->matrix.inverted().mapRect(QRectF(d->deviceRectUnclipped));
             d->dashStroker->setClipRect(clipRect);
         }
         d->dashStroker->setDashPattern(pen.dashPattern());
@@ -49,6 +49,7 @@
 #include <QtGui/qpainterpath.h>
 
 #include <algorithm>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -130,7 +131,7 @@ public:
     QScanConverter();
     ~QScanConverter();
 
-    void begin(int top, int bottom, int left, int right,
+    void begin(int top, int bottom, int left, int right, int deviceTop,
                Qt::FillRule fillRule, bool legacyRounding, QSpanBuffer *spanBuffer);
     void end();
 
@@ -174,6 +175,7 @@ private:
 
     int m_top;
     int m_bottom;
+    int m_deviceTop;
 
     Q16Dot16 m_leftFP;
     Q16Dot16 m_rightFP;
@@ -203,6 +205,7 @@ public:
     ProcessSpans blend;
     void *data;
     QRect clipRect;
+    QRect deviceRect;
 
     QScanConverter scanConverter;
 };
@@ -222,12 +225,13 @@ QScanConverter::~QScanConverter()
         free(m_intersections);
 }
 
-void QScanConverter::begin(int top, int bottom, int left, int right,
+void QScanConverter::begin(int top, int bottom, int left, int right, int deviceTop,
                            Qt::FillRule fillRule, bool legacyRounding,
                            QSpanBuffer *spanBuffer)
 {
     m_top = top;
     m_bottom = bottom;
+    m_deviceTop = deviceTop;
     m_leftFP = IntToQ16Dot16(left);
     m_rightFP = IntToQ16Dot16(right + 1);
 
@@ -599,7 +603,8 @@ void QScanConverter::mergeLine(QT_FT_Vector a, QT_FT_Vector b)
 
     int rounding = m_legacyRounding ? COORD_ROUNDING : 0;
 
-    int iTop = qMax(m_top, int((a.y + 32 - rounding) >> 6));
+    const int iUnclippedTop = qMax(m_deviceTop, int((a.y + 32 - rounding) >> 6));
+    int iTop = qMax(m_top, iUnclippedTop);
     int iBottom = qMin(m_bottom, int((b.y - 32 - rounding) >> 6));
 
     if (iTop <= iBottom) {
@@ -613,9 +618,15 @@ void QScanConverter::mergeLine(QT_FT_Vector a, QT_FT_Vector b)
 
             const Q16Dot16 slopeFP = FloatToQ16Dot16(slope);
 
+            // Evaluate the edge on its first scan line inside the device and
+            // step it to the clipped one, the same way the scan converter steps
+            // it further down, so that the edge does not depend on the clip.
             Q16Dot16 xFP = aFP + Q16Dot16Multiply(slopeFP,
-                                                  IntToQ16Dot16(iTop)
+                                                  IntToQ16Dot16(iUnclippedTop)
                                                   + Q16Dot16Factor/2 - (a.y * (1 << 10)));
+            const qint64 steppedXFP = xFP + qint64(slopeFP) * (iTop - iUnclippedTop);
+            xFP = Q16Dot16(qBound(qint64(std::numeric_limits<Q16Dot16>::min()), steppedXFP,
+                                  qint64(std::numeric_limits<Q16Dot16>::max())));
 
             if (clip(xFP, iTop, iBottom, slopeFP, m_leftFP, winding))
                 return;
@@ -658,6 +669,17 @@ void QRasterizer::setClipRect(const QRect &clipRect)
     d->clipRect = clipRect;
 }
 
+/*!
+    \internal
+    Sets the unclipped bounds of the device. When set, lines are
+    pre-clipped and stepped against these bounds instead of the clip rect,
+    so that the pixels produced inside the clip do not depend on the clip.
+*/
+void QRasterizer::setDeviceRect(const QRect &deviceRect)
+{
+    d->deviceRect = deviceRect;
+}
+
 void QRasterizer::setLegacyRoundingEnabled(bool legacyRoundingEnabled)
 {
     d->legacyRounding = legacyRoundingEnabled;
@@ -758,8 +780,10 @@ void QRasterizer::rasterizeLine(const QPointF &a, const QPointF &b, qreal width,
         pb += (0.5f * width) * delta;
     }
 
+    const QRect &bounds = d->deviceRect.isNull() ? d->clipRect : d->deviceRect;
+
     QPointF offs = QPointF(qAbs(b.y() - a.y()), qAbs(b.x() - a.x())) * width * 0.5;
-    const QRectF clip(d->clipRect.topLeft() - offs, d->clipRect.bottomRight() + QPoint(1, 1) + offs);
+    const QRectF clip(bounds.topLeft() - offs, bounds.bottomRight() + QPoint(1, 1) + offs);
 
     if (!clip.contains(pa) || !clip.contains(pb)) {
         qreal t1 = 0;
@@ -978,16 +1002,30 @@ void QRasterizer::rasterizeLine(const QPointF &a, const QPointF &b, qreal width,
             const Q16Dot16 iRightFP = IntToQ16Dot16(int(right.y()));
             const Q16Dot16 iBottomFP = IntToQ16Dot16(int(bottomBound));
 
-            Q16Dot16 leftIntersectAf = qSafeFloatToQ16Dot16(top.x() + (int(topBound) - top.y()) * topLeftSlope);
-            Q16Dot16 rightIntersectAf = qSafeFloatToQ16Dot16(top.x() + (int(topBound) - top.y()) * topRightSlope);
+            // The intersections are evaluated on the first row inside the
+            // device and stepped from there, which is what happens when
+            // nothing is clipped away at the top.
+            const int unclippedTop = int(qBound(qreal(bounds.top()), top.y(), qreal(bounds.bottom())));
+            const int clippedRows = int(topBound) - unclippedTop;
+
+            Q16Dot16 leftIntersectAf = qSafeFloatToQ16Dot16(top.x() + (unclippedTop - top.y()) * topLeftSlope)
+                                       + clippedRows * topLeftSlopeFP;
+            Q16Dot16 rightIntersectAf = qSafeFloatToQ16Dot16(top.x() + (unclippedTop - top.y()) * topRightSlope)
+                                        + clippedRows * topRightSlopeFP;
             Q16Dot16 leftIntersectBf = 0;
             Q16Dot16 rightIntersectBf = 0;
 
-            if (iLeftFP < iTopFP)
-                leftIntersectBf = qSafeFloatToQ16Dot16(left.x() + (int(topBound) - left.y()) * bottomLeftSlope);
+            if (iLeftFP < iTopFP) {
+                const int row = qMax(int(left.y()), unclippedTop);
+                leftIntersectBf = qSafeFloatToQ16Dot16(left.x() + (row - left.y()) * bottomLeftSlope)
+                                  + (int(topBound) - row) * bottomLeftSlopeFP;
+            }
 
-            if (iRightFP < iTopFP)
-                rightIntersectBf = qSafeFloatToQ16Dot16(right.x() + (int(topBound) - right.y()) * bottomRightSlope);
+            if (iRightFP < iTopFP) {
+                const int row = qMax(int(right.y()), unclippedTop);
+                rightIntersectBf = qSafeFloatToQ16Dot16(right.x() + (row - right.y()) * bottomRightSlope)
+                                   + (int(topBound) - row) * bottomRightSlopeFP;
+            }
 
             Q16Dot16 rowTop, rowBottomLeft, rowBottomRight, rowTopLeft, rowTopRight, rowBottom;
             Q16Dot16 topLeftIntersectAf, topLeftIntersectBf, topRightIntersectAf, topRightIntersectBf;
@@ -1201,12 +1239,13 @@ void QRasterizer::rasterize(const QT_FT_Outline *outline, Qt::FillRule fillRule)
     int rounding = d->legacyRounding ? COORD_OFFSET - COORD_ROUNDING : 0;
 
     int iTopBound = qMax(d->clipRect.top(), int((min_y + 32 + rounding) >> 6));
+    const int deviceTop = d->deviceRect.isNull() ? d->clipRect.top() : d->deviceRect.top();
     int iBottomBound = qMin(d->clipRect.bottom(), int((max_y - 32 + rounding) >> 6));
 
     if (iTopBound > iBottomBound)
         return;
 
-    d->scanConverter.begin(iTopBound, iBottomBound, d->clipRect.left(), d->clipRect.right(), fillRule, d->legacyRounding, &buffer);
+    d->scanConverter.begin(iTopBound, iBottomBound, d->clipRect.left(), d->clipRect.right(), deviceTop, fillRule, d->legacyRounding, &buffer);
 
     int first = 0;
     for (int i = 0; i < outline->n_contours; ++i) {
@@ -1239,12 +1278,13 @@ void QRasterizer::rasterize(const QPainterPath &path, Qt::FillRule fillRule)
     double rounding = d->legacyRounding ? (COORD_OFFSET - COORD_ROUNDING) / 64. : 0.0;
 
     int iTopBound = qMax(d->clipRect.top(), int(bounds.top() + 0.5 + rounding));
+    const int deviceTop = d->deviceRect.isNull() ? d->clipRect.top() : d->deviceRect.top();
     int iBottomBound = qMin(d->clipRect.bottom(), int(bounds.bottom() - 0.5 + rounding));
 
     if (iTopBound > iBottomBound)
         return;
 
-    d->scanConverter.begin(iTopBound, iBottomBound, d->clipRect.left(), d->clipRect.right(), fillRule, d->legacyRounding, &buffer);
+    d->scanConverter.begin(iTopBound, iBottomBound, d->clipRect.left(), d->clipRect.right(), deviceTop, fillRule, d->legacyRounding, &buffer);
 
     int subpathStart = 0;
     QT_FT_Vector last = { 0, 0 };
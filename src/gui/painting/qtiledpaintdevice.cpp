@@ -0,0 +1,999 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qtiledpaintdevice_p.h"
+
+#include <private/qfontengine_p.h>
+#include <private/qguiapplication_p.h>
+#include <private/qpainter_p.h>
+#include <private/qstatictext_p.h>
+#include <qpa/qplatformintegration.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <limits.h>
+#include <math.h>
+
+QT_BEGIN_NAMESPACE
+
+enum {
+    PenState             = 0x001,
+    BrushState           = 0x002,
+    BrushOriginState     = 0x004,
+    OpacityState         = 0x008,
+    CompositionModeState = 0x010,
+    RenderHintsState     = 0x020,
+    TransformState       = 0x040,
+    FontState            = 0x080,
+    ClipEnabledState     = 0x100
+};
+
+template <typename T, typename Item>
+static int appendItems(QList<T> &list, const Item *items, int count)
+{
+    static_assert(sizeof(Item) % sizeof(T) == 0, "Item must be made of T");
+    const int offset = list.size();
+    list.resize(offset + count * int(sizeof(Item) / sizeof(T)));
+    if (count > 0)
+        memcpy(static_cast<void *>(list.data() + offset), items, count * sizeof(Item));
+    return offset;
+}
+
+template <typename Item, typename T>
+static inline const Item *itemsAt(const QList<T> &list, int offset)
+{
+    return reinterpret_cast<const Item *>(list.constData() + offset);
+}
+
+template <typename Point>
+static QRectF pointBounds(const Point *points, int count)
+{
+    if (count <= 0)
+        return QRectF();
+    qreal x1 = points[0].x();
+    qreal y1 = points[0].y();
+    qreal x2 = x1;
+    qreal y2 = y1;
+    for (int i = 1; i < count; ++i) {
+        x1 = qMin(x1, qreal(points[i].x()));
+        y1 = qMin(y1, qreal(points[i].y()));
+        x2 = qMax(x2, qreal(points[i].x()));
+        y2 = qMax(y2, qreal(points[i].y()));
+    }
+    return QRectF(QPointF(x1, y1), QPointF(x2, y2));
+}
+
+template <typename Rect>
+static QRectF rectBounds(const Rect *rects, int count)
+{
+    if (count <= 0)
+        return QRectF();
+    QRectF bounds = QRectF(rects[0]).normalized();
+    for (int i = 1; i < count; ++i) {
+        // not QRectF::united(), which ignores empty rects that still get outlined
+        const QRectF r = QRectF(rects[i]).normalized();
+        bounds.setCoords(qMin(bounds.left(), r.left()), qMin(bounds.top(), r.top()),
+                         qMax(bounds.right(), r.right()), qMax(bounds.bottom(), r.bottom()));
+    }
+    return bounds;
+}
+
+static inline void prepareBrush(const QBrush &brush)
+{
+    // Texture images are converted lazily inside the shared brush data,
+    // which must happen before the bands are painted in parallel.
+    if (brush.style() == Qt::TexturePattern)
+        (void) brush.textureImage();
+}
+
+/*!
+    \class QTiledPaintDevice
+    \internal
+    \inmodule QtGui
+
+    \brief The QTiledPaintDevice class paints on a QImage using several threads.
+
+    Painting on a QTiledPaintDevice does not touch the image right away.
+    The paint engine records the commands and QPainter::end() replays
+    them into horizontal bands of the image, each band on its own
+    QRasterPaintEngine in a thread of threadPool(), with the band as the
+    system clip. A band only replays the commands whose device bounds
+    intersect it, besides state changes and clipping.
+
+    The result is identical to painting on the image directly. Bands
+    span the full width of the image, so the raster engine generates the
+    same spans as for the whole image, cut at the band's top and bottom.
+    Text is drawn by one band at a time, because the glyph caches are
+    shared between the engines.
+
+    Images and pixmaps are drawn when the painter ends, so images that
+    wrap a user supplied buffer must not change before that. The bands
+    are painted serially on the calling thread when it belongs to the
+    thread pool, or when the platform does not support threaded pixmaps.
+*/
+
+QTiledPaintDevice::QTiledPaintDevice(QImage *image)
+    : m_image(image)
+{
+}
+
+QTiledPaintDevice::~QTiledPaintDevice()
+{
+}
+
+/*!
+    \fn void QTiledPaintDevice::setThreadPool(QThreadPool *pool)
+
+    Sets the thread pool the bands are painted in to \a pool. The default
+    is \nullptr, which uses QThreadPool::globalInstance().
+*/
+
+/*!
+    \fn void QTiledPaintDevice::setTileHeight(int height)
+
+    Sets the height of the bands the image is split into to \a height.
+    The default, 0, chooses a height that gives each thread of the pool
+    a few bands.
+*/
+
+int QTiledPaintDevice::devType() const
+{
+    return QInternal::CustomRaster;
+}
+
+QPaintEngine *QTiledPaintDevice::paintEngine() const
+{
+    if (!m_engine)
+        m_engine.reset(new QTiledPaintEngine);
+    return m_engine.data();
+}
+
+int QTiledPaintDevice::metric(PaintDeviceMetric metric) const
+{
+    switch (metric) {
+    case PdmWidth:
+        return m_image->width();
+    case PdmHeight:
+        return m_image->height();
+    case PdmWidthMM:
+        return m_image->widthMM();
+    case PdmHeightMM:
+        return m_image->heightMM();
+    case PdmNumColors:
+        return m_image->colorCount();
+    case PdmDepth:
+        return m_image->depth();
+    case PdmDpiX:
+        return m_image->logicalDpiX();
+    case PdmDpiY:
+        return m_image->logicalDpiY();
+    case PdmPhysicalDpiX:
+        return m_image->physicalDpiX();
+    case PdmPhysicalDpiY:
+        return m_image->physicalDpiY();
+    case PdmDevicePixelRatio:
+        return m_image->devicePixelRatio();
+    case PdmDevicePixelRatioScaled:
+        return m_image->devicePixelRatio() * QPaintDevice::devicePixelRatioFScale();
+    default:
+        qWarning("QTiledPaintDevice::metric(): Unhandled metric type %d", metric);
+        break;
+    }
+    return 0;
+}
+
+/*!
+    \class QTiledPaintEngine
+    \internal
+    \inmodule QtGui
+
+    \brief The QTiledPaintEngine class records painting for QTiledPaintDevice.
+
+    Every QPaintEngineEx entry point that QRasterPaintEngine implements is
+    recorded as one command, together with a copy of its arguments. The
+    painter state is compared against the last recorded one before each
+    command, as QPainter changes some state without notifying the engine.
+    The replay sets the same state on the band's engine and calls the
+    same entry points, so each band's engine sees the calls the engine of
+    the image would have seen.
+*/
+
+QTiledPaintEngine::QTiledPaintEngine()
+{
+}
+
+QTiledPaintEngine::~QTiledPaintEngine()
+{
+}
+
+bool QTiledPaintEngine::begin(QPaintDevice *device)
+{
+    m_device = static_cast<QTiledPaintDevice *>(device);
+    m_image = m_device->image();
+
+    if (!m_image || m_image->isNull()) {
+        qWarning("QTiledPaintEngine::begin: Cannot paint on a null image");
+        return false;
+    } else if (m_image->format() == QImage::Format_Indexed8) {
+        qWarning("QTiledPaintEngine::begin: Cannot paint on an image with the QImage::Format_Indexed8 format");
+        return false;
+    }
+    m_image->detach();
+
+    // QPainter::begin() only does this for QImage devices
+    if (m_image->depth() == 1) {
+        state()->pen = QPen(Qt::color1);
+        state()->brush = QBrush(Qt::color0);
+    }
+
+    // Report what the image's engine reports, so that QPainter emulates
+    // the same operations for both.
+    if (m_image->paintEngine()->hasFeature(PorterDuff))
+        gccaps |= PorterDuff;
+    else
+        gccaps &= ~PorterDuff;
+
+    const QPainterState *s = state();
+    m_shadow = { s->pen, s->brush, s->brushOrigin, s->opacity, s->composition_mode,
+                 s->renderHints, s->matrix, s->font, bool(s->clipEnabled) };
+    m_shadowStack.clear();
+    m_stateStack = { state() };
+    return true;
+}
+
+bool QTiledPaintEngine::end()
+{
+    replay();
+
+    m_commands.clear();
+    m_reals.clear();
+    m_ints.clear();
+    m_elements.clear();
+    m_pens.clear();
+    m_brushes.clear();
+    m_colors.clear();
+    m_images.clear();
+    m_pixmaps.clear();
+    m_regions.clear();
+    m_states.clear();
+    m_textItems.clear();
+    m_staticTextItems.clear();
+    m_shadowStack.clear();
+    m_stateStack.clear();
+    return true;
+}
+
+void QTiledPaintEngine::setState(QPainterState *s)
+{
+    // QPainter::save() passes a new state, QPainter::restore() the saved one
+    if (isActive()) {
+        const int index = m_stateStack.lastIndexOf(s);
+        if (index < 0) {
+            syncState();
+            m_stateStack.append(s);
+            m_shadowStack.append(m_shadow);
+            appendCommand(QTiledPaintCommand::Save);
+        } else {
+            while (m_stateStack.size() > index + 1) {
+                m_stateStack.removeLast();
+                m_shadow = m_shadowStack.takeLast();
+                appendCommand(QTiledPaintCommand::Restore);
+            }
+        }
+    }
+    QPaintEngineEx::setState(s);
+}
+
+void QTiledPaintEngine::syncState()
+{
+    const QPainterState *s = state();
+    uint changed = 0;
+    if (s->pen != m_shadow.pen)
+        changed |= PenState;
+    if (s->brush != m_shadow.brush)
+        changed |= BrushState;
+    if (s->brushOrigin != m_shadow.brushOrigin)
+        changed |= BrushOriginState;
+    if (s->opacity != m_shadow.opacity)
+        changed |= OpacityState;
+    if (s->composition_mode != m_shadow.compositionMode)
+        changed |= CompositionModeState;
+    if (s->renderHints != m_shadow.renderHints)
+        changed |= RenderHintsState;
+    if (s->matrix != m_shadow.matrix)
+        changed |= TransformState;
+    if (s->font != m_shadow.font)
+        changed |= FontState;
+    if (bool(s->clipEnabled) != m_shadow.clipEnabled)
+        changed |= ClipEnabledState;
+    if (!changed)
+        return;
+
+    m_shadow = { s->pen, s->brush, s->brushOrigin, s->opacity, s->composition_mode,
+                 s->renderHints, s->matrix, s->font, bool(s->clipEnabled) };
+    prepareBrush(s->pen.brush());
+    prepareBrush(s->brush);
+
+    QTiledPaintCommand &cmd = appendCommand(QTiledPaintCommand::SetState);
+    cmd.object = m_states.size();
+    cmd.mode = changed;
+    m_states.append(m_shadow);
+}
+
+void QTiledPaintEngine::stateChanged(uint field)
+{
+    syncState();
+    appendCommand(QTiledPaintCommand::StateChanged).mode = field;
+}
+
+QTiledPaintCommand &QTiledPaintEngine::appendCommand(QTiledPaintCommand::Type type)
+{
+    m_commands.append({ type, INT_MIN, INT_MAX, -1, 0, -1, -1, 0, 0 });
+    return m_commands.last();
+}
+
+QTiledPaintCommand &QTiledPaintEngine::addCommand(QTiledPaintCommand::Type type)
+{
+    syncState();
+    return appendCommand(type);
+}
+
+QTiledPaintCommand &QTiledPaintEngine::addCommand(QTiledPaintCommand::Type type,
+                                                  const QRectF &deviceRect)
+{
+    QTiledPaintCommand &cmd = addCommand(type);
+    const qreal top = deviceRect.top();
+    const qreal bottom = deviceRect.bottom();
+    if (state()->matrix.type() < QTransform::TxProject && qIsFinite(top) && qIsFinite(bottom)) {
+        // The margin covers antialiasing and the rounding of aliased coordinates
+        cmd.top = int(qBound(qreal(INT_MIN / 2), qreal(floor(top)), qreal(INT_MAX / 2))) - 2;
+        cmd.bottom = int(qBound(qreal(INT_MIN / 2), qreal(ceil(bottom)), qreal(INT_MAX / 2))) + 2;
+    }
+    return cmd;
+}
+
+void QTiledPaintEngine::addPath(const QVectorPath &path, QTiledPaintCommand *cmd)
+{
+    cmd->size = path.elementCount();
+    cmd->hints = path.hints() & ~(QVectorPath::IsCachedHint
+                                  | QVectorPath::ShouldUseCacheHint
+                                  | QVectorPath::ControlPointRect);
+    if (!path.isEmpty())
+        cmd->offset = appendItems(m_reals, path.points(), 2 * path.elementCount());
+    if (path.elements())
+        cmd->elements = appendItems(m_elements, path.elements(), path.elementCount());
+}
+
+int QTiledPaintEngine::addPen(const QPen &pen)
+{
+    prepareBrush(pen.brush());
+    m_pens.append(pen);
+    return m_pens.size() - 1;
+}
+
+int QTiledPaintEngine::addBrush(const QBrush &brush)
+{
+    prepareBrush(brush);
+    m_brushes.append(brush);
+    return m_brushes.size() - 1;
+}
+
+QRectF QTiledPaintEngine::shapeBounds(const QRectF &rect) const
+{
+    return state()->matrix.mapRect(rect);
+}
+
+QRectF QTiledPaintEngine::strokeBounds(const QRectF &rect, const QPen &pen) const
+{
+    if (pen.style() == Qt::NoPen)
+        return shapeBounds(rect);
+
+    // Half the width, extended for square caps and miter joins
+    const qreal width = pen.widthF() > 0 ? pen.widthF() : 1;
+    const qreal pad = width / 2 * qMax(qreal(M_SQRT2), pen.miterLimit());
+    const QRectF r = rect.normalized();
+    if (qt_pen_is_cosmetic(pen, state()->renderHints))
+        return shapeBounds(r).adjusted(-pad, -pad, pad, pad);
+    return shapeBounds(r.adjusted(-pad, -pad, pad, pad));
+}
+
+void QTiledPaintEngine::penChanged()
+{
+    stateChanged(PenState);
+}
+
+void QTiledPaintEngine::brushChanged()
+{
+    stateChanged(BrushState);
+}
+
+void QTiledPaintEngine::brushOriginChanged()
+{
+    stateChanged(BrushOriginState);
+}
+
+void QTiledPaintEngine::opacityChanged()
+{
+    stateChanged(OpacityState);
+}
+
+void QTiledPaintEngine::compositionModeChanged()
+{
+    stateChanged(CompositionModeState);
+}
+
+void QTiledPaintEngine::renderHintsChanged()
+{
+    stateChanged(RenderHintsState);
+}
+
+void QTiledPaintEngine::transformChanged()
+{
+    stateChanged(TransformState);
+}
+
+void QTiledPaintEngine::clipEnabledChanged()
+{
+    stateChanged(ClipEnabledState);
+}
+
+void QTiledPaintEngine::fill(const QVectorPath &path, const QBrush &brush)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::Fill,
+                                         shapeBounds(path.controlPointRect()));
+    addPath(path, &cmd);
+    cmd.object = addBrush(brush);
+}
+
+void QTiledPaintEngine::stroke(const QVectorPath &path, const QPen &pen)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::Stroke,
+                                         strokeBounds(path.controlPointRect(), pen));
+    addPath(path, &cmd);
+    cmd.object = addPen(pen);
+}
+
+void QTiledPaintEngine::clip(const QVectorPath &path, Qt::ClipOperation op)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::ClipPath);
+    addPath(path, &cmd);
+    cmd.mode = op;
+}
+
+void QTiledPaintEngine::clip(const QRect &rect, Qt::ClipOperation op)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::ClipRect);
+    cmd.offset = appendItems(m_ints, &rect, 1);
+    cmd.mode = op;
+}
+
+void QTiledPaintEngine::clip(const QRegion &region, Qt::ClipOperation op)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::ClipRegion);
+    cmd.object = m_regions.size();
+    cmd.mode = op;
+    m_regions.append(region);
+}
+
+void QTiledPaintEngine::fillRect(const QRectF &rect, const QBrush &brush)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::FillRectBrush, shapeBounds(rect));
+    cmd.offset = appendItems(m_reals, &rect, 1);
+    cmd.object = addBrush(brush);
+}
+
+void QTiledPaintEngine::fillRect(const QRectF &rect, const QColor &color)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::FillRectColor, shapeBounds(rect));
+    cmd.offset = appendItems(m_reals, &rect, 1);
+    cmd.object = m_colors.size();
+    m_colors.append(color);
+}
+
+void QTiledPaintEngine::drawRects(const QRect *rects, int rectCount)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawRects,
+                                         strokeBounds(rectBounds(rects, rectCount), state()->pen));
+    cmd.offset = appendItems(m_ints, rects, rectCount);
+    cmd.size = rectCount;
+}
+
+void QTiledPaintEngine::drawRects(const QRectF *rects, int rectCount)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawRectsF,
+                                         strokeBounds(rectBounds(rects, rectCount), state()->pen));
+    cmd.offset = appendItems(m_reals, rects, rectCount);
+    cmd.size = rectCount;
+}
+
+void QTiledPaintEngine::drawLines(const QLine *lines, int lineCount)
+{
+    const QRectF bounds = pointBounds(reinterpret_cast<const QPoint *>(lines), 2 * lineCount);
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawLines,
+                                         strokeBounds(bounds, state()->pen));
+    cmd.offset = appendItems(m_ints, lines, lineCount);
+    cmd.size = lineCount;
+}
+
+void QTiledPaintEngine::drawLines(const QLineF *lines, int lineCount)
+{
+    const QRectF bounds = pointBounds(reinterpret_cast<const QPointF *>(lines), 2 * lineCount);
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawLinesF,
+                                         strokeBounds(bounds, state()->pen));
+    cmd.offset = appendItems(m_reals, lines, lineCount);
+    cmd.size = lineCount;
+}
+
+void QTiledPaintEngine::drawEllipse(const QRectF &rect)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawEllipseF,
+                                         strokeBounds(rect, state()->pen));
+    cmd.offset = appendItems(m_reals, &rect, 1);
+}
+
+void QTiledPaintEngine::drawPoints(const QPoint *points, int pointCount)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawPoints,
+                                         strokeBounds(pointBounds(points, pointCount), state()->pen));
+    cmd.offset = appendItems(m_ints, points, pointCount);
+    cmd.size = pointCount;
+}
+
+void QTiledPaintEngine::drawPoints(const QPointF *points, int pointCount)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawPointsF,
+                                         strokeBounds(pointBounds(points, pointCount), state()->pen));
+    cmd.offset = appendItems(m_reals, points, pointCount);
+    cmd.size = pointCount;
+}
+
+void QTiledPaintEngine::drawPolygon(const QPoint *points, int pointCount, PolygonDrawMode mode)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawPolygon,
+                                         strokeBounds(pointBounds(points, pointCount), state()->pen));
+    cmd.offset = appendItems(m_ints, points, pointCount);
+    cmd.size = pointCount;
+    cmd.mode = mode;
+}
+
+void QTiledPaintEngine::drawPolygon(const QPointF *points, int pointCount, PolygonDrawMode mode)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawPolygonF,
+                                         strokeBounds(pointBounds(points, pointCount), state()->pen));
+    cmd.offset = appendItems(m_reals, points, pointCount);
+    cmd.size = pointCount;
+    cmd.mode = mode;
+}
+
+void QTiledPaintEngine::drawPixmap(const QPointF &pos, const QPixmap &pixmap)
+{
+    // Device pixel ratios above 1 only make the drawn area smaller
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawPixmapPos,
+                                         shapeBounds(QRectF(pos, QSizeF(pixmap.size()))));
+    cmd.offset = appendItems(m_reals, &pos, 1);
+    cmd.object = m_pixmaps.size();
+    m_pixmaps.append(pixmap);
+}
+
+void QTiledPaintEngine::drawPixmap(const QRectF &r, const QPixmap &pixmap, const QRectF &sr)
+{
+    const QRectF rects[] = { r, sr };
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawPixmapRect, shapeBounds(r));
+    cmd.offset = appendItems(m_reals, rects, 2);
+    cmd.object = m_pixmaps.size();
+    m_pixmaps.append(pixmap);
+}
+
+void QTiledPaintEngine::drawImage(const QPointF &pos, const QImage &image)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawImagePos,
+                                         shapeBounds(QRectF(pos, QSizeF(image.size()))));
+    cmd.offset = appendItems(m_reals, &pos, 1);
+    cmd.object = m_images.size();
+    m_images.append(image);
+}
+
+void QTiledPaintEngine::drawImage(const QRectF &r, const QImage &image, const QRectF &sr,
+                                  Qt::ImageConversionFlags flags)
+{
+    const QRectF rects[] = { r, sr };
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawImageRect, shapeBounds(r));
+    cmd.offset = appendItems(m_reals, rects, 2);
+    cmd.object = m_images.size();
+    cmd.mode = int(flags);
+    m_images.append(image);
+}
+
+void QTiledPaintEngine::drawTiledPixmap(const QRectF &r, const QPixmap &pixmap, const QPointF &s)
+{
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawTiledPixmap, shapeBounds(r));
+    cmd.offset = appendItems(m_reals, &r, 1);
+    appendItems(m_reals, &s, 1);
+    cmd.object = m_pixmaps.size();
+    m_pixmaps.append(pixmap);
+}
+
+void QTiledPaintEngine::drawTextItem(const QPointF &p, const QTextItem &textItem)
+{
+    const QTextItemInt &ti = static_cast<const QTextItemInt &>(textItem);
+    const int numGlyphs = ti.glyphs.numGlyphs;
+    if (numGlyphs == 0)
+        return;
+
+    QFontEngine *fontEngine = ti.fontEngine;
+    const QFixed ascent = qMax(ti.ascent, fontEngine->ascent());
+    const QFixed descent = qMax(ti.descent, fontEngine->descent());
+    QFixed width = ti.width;
+    if (width <= 0) {
+        for (int i = 0; i < numGlyphs; ++i)
+            width += qAbs(ti.glyphs.effectiveAdvance(i));
+    }
+    // Glyphs may overhang their advance and the font's ascent and descent
+    const qreal margin = qMax(fontEngine->fontDef.pixelSize, (ascent + descent).toReal());
+    const QRectF rect(p.x() - margin, p.y() - ascent.toReal() - margin,
+                      width.toReal() + 2 * margin, (ascent + descent).toReal() + 2 * margin);
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawTextItem, shapeBounds(rect));
+    cmd.object = m_textItems.size();
+
+    TextItem item;
+    item.pos = p;
+    item.numGlyphs = numGlyphs;
+    item.glyphData.resize((numGlyphs * QGlyphLayout::SpaceNeeded) / sizeof(quint64) + 1);
+    QGlyphLayout glyphs(reinterpret_cast<char *>(item.glyphData.data()), numGlyphs);
+    memcpy(static_cast<void *>(glyphs.offsets), ti.glyphs.offsets, numGlyphs * sizeof(QFixedPoint));
+    memcpy(glyphs.glyphs, ti.glyphs.glyphs, numGlyphs * sizeof(glyph_t));
+    memcpy(static_cast<void *>(glyphs.advances), ti.glyphs.advances, numGlyphs * sizeof(QFixed));
+    memcpy(static_cast<void *>(glyphs.justifications), ti.glyphs.justifications,
+           numGlyphs * sizeof(QGlyphJustification));
+    memcpy(static_cast<void *>(glyphs.attributes), ti.glyphs.attributes,
+           numGlyphs * sizeof(QGlyphAttributes));
+    item.chars = QString(ti.chars, ti.num_chars);
+    if (ti.logClusters)
+        item.logClusters = QList<unsigned short>(ti.logClusters, ti.logClusters + ti.num_chars);
+    item.font = ti.font();
+    item.fontEngine = fontEngine;
+    item.ascent = ti.ascent;
+    item.descent = ti.descent;
+    item.width = ti.width;
+    item.flags = ti.flags;
+    item.justified = ti.justified;
+    item.underlineStyle = ti.underlineStyle;
+    item.charFormat = ti.charFormat;
+    m_textItems.append(item);
+}
+
+void QTiledPaintEngine::drawStaticTextItem(QStaticTextItem *textItem)
+{
+    const int numGlyphs = textItem->numGlyphs;
+    if (numGlyphs == 0)
+        return;
+
+    QFontEngine *fontEngine = textItem->fontEngine();
+    QVarLengthArray<QPointF> points(numGlyphs);
+    for (int i = 0; i < numGlyphs; ++i)
+        points[i] = textItem->glyphPositions[i].toPointF();
+    const QRectF positions = pointBounds(points.constData(), numGlyphs);
+
+    // The positions are in device space if they were pretransformed, so
+    // take both interpretations, with a margin for the glyphs themselves.
+    const QTransform &matrix = state()->matrix;
+    const qreal scale = qMax(qreal(1), qMax(qAbs(matrix.m11()) + qAbs(matrix.m21()),
+                                            qAbs(matrix.m12()) + qAbs(matrix.m22())));
+    const qreal margin = qMax(fontEngine->fontDef.pixelSize,
+                              (fontEngine->ascent() + fontEngine->descent()).toReal());
+    const QRectF user = positions.adjusted(-margin, -margin, margin, margin);
+    const QRectF device = positions.adjusted(-margin * scale, -margin * scale,
+                                             margin * scale, margin * scale);
+    QTiledPaintCommand &cmd = addCommand(QTiledPaintCommand::DrawStaticTextItem,
+                                         shapeBounds(user).united(device));
+    cmd.object = m_staticTextItems.size();
+
+    StaticTextItem item;
+    item.glyphs = QList<glyph_t>(textItem->glyphs, textItem->glyphs + numGlyphs);
+    item.positions = QList<QFixedPoint>(textItem->glyphPositions,
+                                        textItem->glyphPositions + numGlyphs);
+    item.font = textItem->font;
+    item.color = textItem->color;
+    item.fontEngine = fontEngine;
+    item.useBackendOptimizations = textItem->useBackendOptimizations;
+    item.usesRawFont = textItem->usesRawFont;
+    m_staticTextItems.append(item);
+}
+
+bool QTiledPaintEngine::requiresPretransformedGlyphPositions(QFontEngine *fontEngine,
+                                                             const QTransform &m) const
+{
+    return static_cast<QPaintEngineEx *>(m_image->paintEngine())
+            ->requiresPretransformedGlyphPositions(fontEngine, m);
+}
+
+bool QTiledPaintEngine::shouldDrawCachedGlyphs(QFontEngine *fontEngine, const QTransform &m) const
+{
+    return static_cast<QPaintEngineEx *>(m_image->paintEngine())
+            ->shouldDrawCachedGlyphs(fontEngine, m);
+}
+
+void QTiledPaintEngine::replay()
+{
+    if (m_commands.isEmpty())
+        return;
+
+    const int height = m_image->height();
+    uchar *bits = m_image->bits();
+
+    QThreadPool *threadPool = m_device->threadPool();
+    if (!threadPool)
+        threadPool = QThreadPool::globalInstance();
+    const QPlatformIntegration *integration = QGuiApplicationPrivate::platformIntegration();
+    const bool threaded = threadPool && !threadPool->contains(QThread::currentThread())
+            && integration
+            && integration->hasCapability(QPlatformIntegration::ThreadedPixmaps);
+
+    int bandHeight = m_device->tileHeight();
+    if (bandHeight <= 0) {
+        // A few bands per thread even out the load without replaying
+        // the commands that span several bands too often.
+        const int threads = threaded ? qMax(1, threadPool->maxThreadCount()) : 1;
+        bandHeight = qMax(32, (height + 4 * threads - 1) / (4 * threads));
+    }
+    const int bands = threaded ? (height + bandHeight - 1) / bandHeight : 1;
+
+    QMutex textMutex;
+    if (bands <= 1) {
+        replayBand(bits, 0, height, &textMutex);
+        return;
+    }
+
+    QAtomicInt nextBand;
+    QSemaphore semaphore;
+    const int tasks = qMin(bands, qMax(1, threadPool->maxThreadCount()));
+    for (int i = 0; i < tasks; ++i) {
+        threadPool->start([&]() {
+            int band;
+            while ((band = nextBand.fetchAndAddRelaxed(1)) < bands)
+                replayBand(bits, band * bandHeight, qMin(height, (band + 1) * bandHeight), &textMutex);
+            semaphore.release(1);
+        });
+    }
+    semaphore.acquire(tasks);
+}
+
+void QTiledPaintEngine::replayBand(uchar *bits, int y0, int y1, QMutex *textMutex) const
+{
+    QImage view(bits, m_image->width(), m_image->height(), m_image->bytesPerLine(),
+                 m_image->format());
+    if (m_image->colorCount() > 0)
+        view.setColorTable(m_image->colorTable());
+    view.setDevicePixelRatio(m_image->devicePixelRatio());
+    view.setDotsPerMeterX(m_image->dotsPerMeterX());
+    view.setDotsPerMeterY(m_image->dotsPerMeterY());
+    if (y0 > 0 || y1 < view.height())
+        view.paintEngine()->setSystemClip(QRegion(0, y0, view.width(), y1 - y0));
+
+    QPainter p(&view);
+    QPaintEngineEx *ex = static_cast<QPaintEngineEx *>(p.paintEngine());
+    for (const QTiledPaintCommand &cmd : m_commands) {
+        if (cmd.bottom >= y0 && cmd.top < y1)
+            replayCommand(ex, &p, cmd, textMutex);
+    }
+}
+
+QVectorPath QTiledPaintEngine::vectorPath(const QTiledPaintCommand &cmd) const
+{
+    return QVectorPath(cmd.offset < 0 ? nullptr : m_reals.constData() + cmd.offset,
+                       cmd.size,
+                       cmd.elements < 0 ? nullptr : m_elements.constData() + cmd.elements,
+                       cmd.hints);
+}
+
+void QTiledPaintEngine::replayCommand(QPaintEngineEx *ex, QPainter *p,
+                                      const QTiledPaintCommand &cmd, QMutex *textMutex) const
+{
+    switch (cmd.type) {
+    case QTiledPaintCommand::Fill:
+        ex->fill(vectorPath(cmd), m_brushes.at(cmd.object));
+        break;
+    case QTiledPaintCommand::Stroke:
+        ex->stroke(vectorPath(cmd), m_pens.at(cmd.object));
+        break;
+    case QTiledPaintCommand::ClipPath:
+        ex->clip(vectorPath(cmd), Qt::ClipOperation(cmd.mode));
+        break;
+    case QTiledPaintCommand::ClipRect:
+        ex->clip(*itemsAt<QRect>(m_ints, cmd.offset), Qt::ClipOperation(cmd.mode));
+        break;
+    case QTiledPaintCommand::ClipRegion:
+        ex->clip(m_regions.at(cmd.object), Qt::ClipOperation(cmd.mode));
+        break;
+    case QTiledPaintCommand::FillRectBrush:
+        ex->fillRect(*itemsAt<QRectF>(m_reals, cmd.offset), m_brushes.at(cmd.object));
+        break;
+    case QTiledPaintCommand::FillRectColor:
+        ex->fillRect(*itemsAt<QRectF>(m_reals, cmd.offset), m_colors.at(cmd.object));
+        break;
+    case QTiledPaintCommand::DrawRects:
+        ex->drawRects(itemsAt<QRect>(m_ints, cmd.offset), cmd.size);
+        break;
+    case QTiledPaintCommand::DrawRectsF:
+        ex->drawRects(itemsAt<QRectF>(m_reals, cmd.offset), cmd.size);
+        break;
+    case QTiledPaintCommand::DrawLines:
+        ex->drawLines(itemsAt<QLine>(m_ints, cmd.offset), cmd.size);
+        break;
+    case QTiledPaintCommand::DrawLinesF:
+        ex->drawLines(itemsAt<QLineF>(m_reals, cmd.offset), cmd.size);
+        break;
+    case QTiledPaintCommand::DrawEllipseF:
+        ex->drawEllipse(*itemsAt<QRectF>(m_reals, cmd.offset));
+        break;
+    case QTiledPaintCommand::DrawPoints:
+        ex->drawPoints(itemsAt<QPoint>(m_ints, cmd.offset), cmd.size);
+        break;
+    case QTiledPaintCommand::DrawPointsF:
+        ex->drawPoints(itemsAt<QPointF>(m_reals, cmd.offset), cmd.size);
+        break;
+    case QTiledPaintCommand::DrawPolygon:
+        ex->drawPolygon(itemsAt<QPoint>(m_ints, cmd.offset), cmd.size,
+                        QPaintEngine::PolygonDrawMode(cmd.mode));
+        break;
+    case QTiledPaintCommand::DrawPolygonF:
+        ex->drawPolygon(itemsAt<QPointF>(m_reals, cmd.offset), cmd.size,
+                        QPaintEngine::PolygonDrawMode(cmd.mode));
+        break;
+    case QTiledPaintCommand::DrawPixmapPos:
+        ex->drawPixmap(*itemsAt<QPointF>(m_reals, cmd.offset), m_pixmaps.at(cmd.object));
+        break;
+    case QTiledPaintCommand::DrawPixmapRect: {
+        const QRectF *rects = itemsAt<QRectF>(m_reals, cmd.offset);
+        ex->drawPixmap(rects[0], m_pixmaps.at(cmd.object), rects[1]);
+        break;
+    }
+    case QTiledPaintCommand::DrawImagePos:
+        ex->drawImage(*itemsAt<QPointF>(m_reals, cmd.offset), m_images.at(cmd.object));
+        break;
+    case QTiledPaintCommand::DrawImageRect: {
+        const QRectF *rects = itemsAt<QRectF>(m_reals, cmd.offset);
+        ex->drawImage(rects[0], m_images.at(cmd.object), rects[1],
+                      Qt::ImageConversionFlags(cmd.mode));
+        break;
+    }
+    case QTiledPaintCommand::DrawTiledPixmap:
+        ex->drawTiledPixmap(*itemsAt<QRectF>(m_reals, cmd.offset), m_pixmaps.at(cmd.object),
+                            *itemsAt<QPointF>(m_reals, cmd.offset + 4));
+        break;
+    case QTiledPaintCommand::DrawTextItem: {
+        const TextItem &item = m_textItems.at(cmd.object);
+        QGlyphLayout glyphs(reinterpret_cast<char *>(const_cast<quint64 *>(item.glyphData.constData())),
+                            item.numGlyphs);
+        QTextItemInt ti(glyphs, const_cast<QFont *>(&item.font), item.chars.constData(),
+                        item.chars.size(), item.fontEngine.data(), item.charFormat);
+        ti.ascent = item.ascent;
+        ti.descent = item.descent;
+        ti.width = item.width;
+        ti.flags = item.flags;
+        ti.justified = item.justified;
+        ti.underlineStyle = item.underlineStyle;
+        ti.logClusters = item.logClusters.isEmpty() ? nullptr : item.logClusters.constData();
+
+        QMutexLocker locker(textMutex);
+        ex->drawTextItem(item.pos, ti);
+        break;
+    }
+    case QTiledPaintCommand::DrawStaticTextItem: {
+        const StaticTextItem &item = m_staticTextItems.at(cmd.object);
+        QStaticTextItem ti;
+        ti.glyphs = const_cast<glyph_t *>(item.glyphs.constData());
+        ti.glyphPositions = const_cast<QFixedPoint *>(item.positions.constData());
+        ti.numGlyphs = item.glyphs.size();
+        ti.font = item.font;
+        ti.color = item.color;
+        ti.useBackendOptimizations = item.useBackendOptimizations;
+        ti.usesRawFont = item.usesRawFont;
+        ti.setFontEngine(item.fontEngine.data());
+
+        QMutexLocker locker(textMutex);
+        ex->drawStaticTextItem(&ti);
+        break;
+    }
+    case QTiledPaintCommand::SetState: {
+        const PaintState &recorded = m_states.at(cmd.object);
+        QPainterState *s = ex->state();
+        if (cmd.mode & PenState)
+            s->pen = recorded.pen;
+        if (cmd.mode & BrushState)
+            s->brush = recorded.brush;
+        if (cmd.mode & BrushOriginState)
+            s->brushOrigin = recorded.brushOrigin;
+        if (cmd.mode & OpacityState)
+            s->opacity = recorded.opacity;
+        if (cmd.mode & CompositionModeState)
+            s->composition_mode = recorded.compositionMode;
+        if (cmd.mode & RenderHintsState)
+            s->renderHints = recorded.renderHints;
+        if (cmd.mode & TransformState)
+            s->matrix = recorded.matrix;
+        if (cmd.mode & FontState)
+            s->font = recorded.font;
+        if (cmd.mode & ClipEnabledState)
+            s->clipEnabled = recorded.clipEnabled;
+        break;
+    }
+    case QTiledPaintCommand::StateChanged:
+        switch (cmd.mode) {
+        case PenState:
+            ex->penChanged();
+            break;
+        case BrushState:
+            ex->brushChanged();
+            break;
+        case BrushOriginState:
+            ex->brushOriginChanged();
+            break;
+        case OpacityState:
+            ex->opacityChanged();
+            break;
+        case CompositionModeState:
+            ex->compositionModeChanged();
+            break;
+        case RenderHintsState:
+            ex->renderHintsChanged();
+            break;
+        case TransformState:
+            ex->transformChanged();
+            break;
+        case ClipEnabledState:
+            ex->clipEnabledChanged();
+            break;
+        }
+        break;
+    case QTiledPaintCommand::Save:
+        p->save();
+        break;
+    case QTiledPaintCommand::Restore:
+        p->restore();
+        break;
+    }
+}
+
+QT_END_NAMESPACE
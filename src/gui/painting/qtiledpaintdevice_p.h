@@ -0,0 +1,282 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTILEDPAINTDEVICE_P_H
+#define QTILEDPAINTDEVICE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/qimage.h>
+#include <QtGui/qpaintdevice.h>
+#include "private/qpaintengineex_p.h"
+#include "private/qtextengine_p.h"
+
+#include <QtCore/qlist.h>
+#include <QtCore/qscopedpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMutex;
+class QThreadPool;
+class QTiledPaintEngine;
+
+class Q_GUI_EXPORT QTiledPaintDevice : public QPaintDevice
+{
+public:
+    explicit QTiledPaintDevice(QImage *image);
+    ~QTiledPaintDevice();
+
+    QImage *image() const { return m_image; }
+
+    void setThreadPool(QThreadPool *pool) { m_threadPool = pool; }
+    QThreadPool *threadPool() const { return m_threadPool; }
+
+    void setTileHeight(int height) { m_tileHeight = qMax(0, height); }
+    int tileHeight() const { return m_tileHeight; }
+
+    int devType() const override;
+    QPaintEngine *paintEngine() const override;
+
+protected:
+    int metric(PaintDeviceMetric metric) const override;
+
+private:
+    Q_DISABLE_COPY(QTiledPaintDevice)
+
+    QImage *m_image;
+    QThreadPool *m_threadPool = nullptr;
+    int m_tileHeight = 0;
+    mutable QScopedPointer<QTiledPaintEngine> m_engine;
+};
+
+struct QTiledPaintCommand
+{
+    enum Type {
+        Fill,
+        Stroke,
+        ClipPath,
+        ClipRect,
+        ClipRegion,
+        FillRectBrush,
+        FillRectColor,
+        DrawRects,
+        DrawRectsF,
+        DrawLines,
+        DrawLinesF,
+        DrawEllipseF,
+        DrawPoints,
+        DrawPointsF,
+        DrawPolygon,
+        DrawPolygonF,
+        DrawPixmapPos,
+        DrawPixmapRect,
+        DrawImagePos,
+        DrawImageRect,
+        DrawTiledPixmap,
+        DrawTextItem,
+        DrawStaticTextItem,
+        SetState,
+        StateChanged,
+        Save,
+        Restore
+    };
+
+    Type type;
+    int top;        // first and last device row touched by the command
+    int bottom;
+    int offset;     // index of the first point, rect, etc. in the data tables
+    int size;       // number of points, rects, etc.
+    int elements;   // index of the first path element, or -1
+    int object;     // index of the pen, brush, image, etc. in the object tables
+    int mode;       // clip operation, polygon mode, conversion flags or state fields
+    uint hints;     // QVectorPath hints
+};
+Q_DECLARE_TYPEINFO(QTiledPaintCommand, Q_PRIMITIVE_TYPE);
+
+class Q_GUI_EXPORT QTiledPaintEngine : public QPaintEngineEx
+{
+public:
+    QTiledPaintEngine();
+    ~QTiledPaintEngine();
+
+    bool begin(QPaintDevice *device) override;
+    bool end() override;
+
+    Type type() const override { return Raster; }
+
+    void setState(QPainterState *s) override;
+
+    void penChanged() override;
+    void brushChanged() override;
+    void brushOriginChanged() override;
+    void opacityChanged() override;
+    void compositionModeChanged() override;
+    void renderHintsChanged() override;
+    void transformChanged() override;
+    void clipEnabledChanged() override;
+
+    void fill(const QVectorPath &path, const QBrush &brush) override;
+    void stroke(const QVectorPath &path, const QPen &pen) override;
+
+    void clip(const QVectorPath &path, Qt::ClipOperation op) override;
+    void clip(const QRect &rect, Qt::ClipOperation op) override;
+    void clip(const QRegion &region, Qt::ClipOperation op) override;
+
+    void fillRect(const QRectF &rect, const QBrush &brush) override;
+    void fillRect(const QRectF &rect, const QColor &color) override;
+
+    void drawRects(const QRect *rects, int rectCount) override;
+    void drawRects(const QRectF *rects, int rectCount) override;
+    void drawLines(const QLine *lines, int lineCount) override;
+    void drawLines(const QLineF *lines, int lineCount) override;
+    void drawEllipse(const QRectF &rect) override;
+    void drawPoints(const QPoint *points, int pointCount) override;
+    void drawPoints(const QPointF *points, int pointCount) override;
+    void drawPolygon(const QPoint *points, int pointCount, PolygonDrawMode mode) override;
+    void drawPolygon(const QPointF *points, int pointCount, PolygonDrawMode mode) override;
+
+    void drawPixmap(const QPointF &pos, const QPixmap &pixmap) override;
+    void drawPixmap(const QRectF &r, const QPixmap &pixmap, const QRectF &sr) override;
+    void drawImage(const QPointF &pos, const QImage &image) override;
+    void drawImage(const QRectF &r, const QImage &image, const QRectF &sr,
+                   Qt::ImageConversionFlags flags = Qt::AutoColor) override;
+    void drawTiledPixmap(const QRectF &r, const QPixmap &pixmap, const QPointF &s) override;
+
+    void drawTextItem(const QPointF &p, const QTextItem &textItem) override;
+    void drawStaticTextItem(QStaticTextItem *textItem) override;
+
+    bool requiresPretransformedGlyphPositions(QFontEngine *fontEngine, const QTransform &m) const override;
+    bool shouldDrawCachedGlyphs(QFontEngine *fontEngine, const QTransform &m) const override;
+
+private:
+    struct PaintState
+    {
+        QPen pen;
+        QBrush brush;
+        QPointF brushOrigin;
+        qreal opacity;
+        QPainter::CompositionMode compositionMode;
+        QPainter::RenderHints renderHints;
+        QTransform matrix;
+        QFont font;
+        bool clipEnabled;
+    };
+
+    struct TextItem
+    {
+        QPointF pos;
+        QList<quint64> glyphData;
+        int numGlyphs;
+        QString chars;
+        QList<unsigned short> logClusters;
+        QFont font;
+        QExplicitlySharedDataPointer<QFontEngine> fontEngine;
+        QFixed ascent;
+        QFixed descent;
+        QFixed width;
+        QTextItem::RenderFlags flags;
+        bool justified;
+        QTextCharFormat::UnderlineStyle underlineStyle;
+        QTextCharFormat charFormat;
+    };
+
+    struct StaticTextItem
+    {
+        QList<glyph_t> glyphs;
+        QList<QFixedPoint> positions;
+        QFont font;
+        QColor color;
+        QExplicitlySharedDataPointer<QFontEngine> fontEngine;
+        bool useBackendOptimizations;
+        bool usesRawFont;
+    };
+
+    void replay();
+    void replayBand(uchar *bits, int y0, int y1, QMutex *textMutex) const;
+    void replayCommand(QPaintEngineEx *ex, QPainter *p, const QTiledPaintCommand &cmd,
+                       QMutex *textMutex) const;
+    QVectorPath vectorPath(const QTiledPaintCommand &cmd) const;
+
+    void syncState();
+    void stateChanged(uint field);
+    QTiledPaintCommand &appendCommand(QTiledPaintCommand::Type type);
+    QTiledPaintCommand &addCommand(QTiledPaintCommand::Type type);
+    QTiledPaintCommand &addCommand(QTiledPaintCommand::Type type, const QRectF &deviceRect);
+    void addPath(const QVectorPath &path, QTiledPaintCommand *cmd);
+    int addPen(const QPen &pen);
+    int addBrush(const QBrush &brush);
+    QRectF shapeBounds(const QRectF &rect) const;
+    QRectF strokeBounds(const QRectF &rect, const QPen &pen) const;
+
+    QTiledPaintDevice *m_device = nullptr;
+    QImage *m_image = nullptr;
+
+    QList<QTiledPaintCommand> m_commands;
+    QList<qreal> m_reals;
+    QList<int> m_ints;
+    QList<QPainterPath::ElementType> m_elements;
+    QList<QPen> m_pens;
+    QList<QBrush> m_brushes;
+    QList<QColor> m_colors;
+    QList<QImage> m_images;
+    QList<QPixmap> m_pixmaps;
+    QList<QRegion> m_regions;
+    QList<PaintState> m_states;
+    QList<TextItem> m_textItems;
+    QList<StaticTextItem> m_staticTextItems;
+
+    PaintState m_shadow;
+    QList<PaintState> m_shadowStack;
+    QList<QPainterState *> m_stateStack;
+};
+
+QT_END_NAMESPACE
+
+#endif // QTILEDPAINTDEVICE_P_H
@@ -108,29 +108,25 @@ void write_bit_pattern(const BitPattern &pattern, BitOStream &outputStream)
     outputStream.writeBits(pattern.value, pattern.bitLength);
 }
 
-bool read_bit_pattern(const BitPattern &pattern, BitIStream &inputStream)
-{
-    uchar chunk = 0;
-
-    const quint32 bitsRead = inputStream.peekBits(inputStream.streamOffset(),
-                                                  pattern.bitLength, &chunk);
-    if (bitsRead != pattern.bitLength)
-        return false;
-
-    // Since peekBits packs in the most significant bits, shift it!
-    chunk >>= (8 - bitsRead);
-    if (chunk != pattern.value)
-        return false;
-
-    inputStream.skipBits(pattern.bitLength);
-
-    return true;
+// Returns the type of the field whose representation starts with the
+// bits in 'prefix' (packed in the most significant bits).
+const BitPattern &field_type(uchar prefix)
+{
+    if (prefix & 0x80)
+        return Indexed;
+    if (prefix & 0x40)
+        return LiteralIncrementalIndexing;
+    if (prefix & 0x20)
+        return SizeUpdate;
+    if (prefix & 0x10)
+        return LiteralNeverIndexing;
+    return LiteralNoIndexing;
 }
 
 bool is_request_pseudo_header(const QByteArray &name)
 {
-    return name == ":method" || name == ":scheme" ||
-           name == ":authority" || name == ":path";
+    return name.startsWith(':') && (name == ":method" || name == ":scheme" ||
+                                    name == ":authority" || name == ":path");
 }
 
 } // unnamed namespace
@@ -415,23 +411,22 @@ bool Decoder::decodeHeaderFields(BitIStream &inputStream)
 {
     header.clear();
     while (true) {
-        if (read_bit_pattern(Indexed, inputStream)) {
+        // Peek the bits of all field type patterns at once:
+        uchar prefix = 0;
+        const quint32 bitsRead = inputStream.peekBits(inputStream.streamOffset(), 8, &prefix);
+        const BitPattern &fieldType = field_type(prefix);
+        if (bitsRead < fieldType.bitLength)
+            return inputStream.bitLength() == inputStream.streamOffset();
+
+        inputStream.skipBits(fieldType.bitLength);
+        if (fieldType == Indexed) {
             if (!decodeIndexedField(inputStream))
                 return false;
-        } else if (read_bit_pattern(LiteralIncrementalIndexing, inputStream)) {
-            if (!decodeLiteralField(LiteralIncrementalIndexing, inputStream))
-                return false;
-        } else if (read_bit_pattern(LiteralNoIndexing, inputStream)) {
-            if (!decodeLiteralField(LiteralNoIndexing, inputStream))
-                return false;
-        } else if (read_bit_pattern(LiteralNeverIndexing, inputStream)) {
-            if (!decodeLiteralField(LiteralNeverIndexing, inputStream))
-                return false;
-        } else if (read_bit_pattern(SizeUpdate, inputStream)) {
+        } else if (fieldType == SizeUpdate) {
             if (!decodeSizeUpdate(inputStream))
                 return false;
-        } else {
-            return inputStream.bitLength() == inputStream.streamOffset();
+        } else if (!decodeLiteralField(fieldType, inputStream)) {
+            return false;
         }
     }
 
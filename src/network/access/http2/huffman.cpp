@@ -352,30 +352,6 @@ const CodeEntry staticHuffmanCodeTable[]
     {256, 0xfffffffcul, 30}   // EOS 11111111|11111111|11111111|111111
 };
 
-void write_huffman_code(BitOStream &outputStream, const CodeEntry &code)
-{
-    // Append octet by octet.
-    auto bitLength = code.bitLength;
-    const auto hc = code.huffmanCode >> (32 - bitLength);
-
-    if (bitLength > 24) {
-        outputStream.writeBits(uchar(hc >> 24), bitLength - 24);
-        bitLength = 24;
-    }
-
-    if (bitLength > 16) {
-        outputStream.writeBits(uchar(hc >> 16), bitLength - 16);
-        bitLength = 16;
-    }
-
-    if (bitLength > 8) {
-        outputStream.writeBits(uchar(hc >> 8), bitLength - 8);
-        bitLength = 8;
-    }
-
-    outputStream.writeBits(uchar(hc), bitLength);
-}
-
 }
 
 // That's from HPACK's specs - we deal with octets.
@@ -392,11 +368,24 @@ quint64 huffman_encoded_bit_length(const QByteArray &inputData)
 
 void huffman_encode_string(const QByteArray &inputData, BitOStream &outputStream)
 {
+    // Codes are collected in 'bits' and written octet by octet, instead of
+    // writing every code in up to four pieces. At most 7 bits are left over
+    // between codes, so 30-bit codes still fit.
+    quint64 bits = 0;
+    quint32 bitCount = 0;
     for (int i = 0, e = inputData.size(); i < e; ++i) {
-        const auto value = uchar(inputData[i]);
-        write_huffman_code(outputStream, staticHuffmanCodeTable[value]);
+        const CodeEntry &code = staticHuffmanCodeTable[uchar(inputData[i])];
+        bits = (bits << code.bitLength) | (code.huffmanCode >> (32 - code.bitLength));
+        bitCount += code.bitLength;
+        while (bitCount >= 8) {
+            bitCount -= 8;
+            outputStream.writeBits(uchar(bits >> bitCount), 8);
+        }
     }
 
+    if (bitCount)
+        outputStream.writeBits(uchar(bits), quint8(bitCount));
+
     // Pad bits ...
     if (outputStream.bitLength() % 8)
         outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
@@ -494,15 +483,36 @@ HuffmanDecoder::HuffmanDecoder()
 
 bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
 {
+    // Every code is at least minCodeLength bits long, which limits the
+    // size of the output; we write into a buffer of that size instead of
+    // appending byte by byte.
+    const qsizetype oldSize = outputBuffer.size();
+    outputBuffer.resize(oldSize + qsizetype((inputStream.bitLength()
+                                             - inputStream.streamOffset()) / minCodeLength));
+    char *const begin = outputBuffer.data() + oldSize;
+    char *out = begin;
+    const auto finish = [&](bool result) {
+        outputBuffer.truncate(oldSize + (out - begin));
+        return result;
+    };
+
+    // 'window' holds the next 'windowBits' bits of the stream, starting
+    // from the most significant bit. It's refilled once it could hold less
+    // than a code of maximum length, rather than for every code.
+    quint64 window = 0;
+    quint32 windowBits = 0;
     while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
+        if (windowBits < 32)
+            windowBits = quint32(inputStream.peekBits(inputStream.streamOffset(), 64, &window));
+
+        const quint32 chunk = quint32(window >> 32);
+        const quint32 readBits = std::min<quint32>(windowBits, 32);
         if (!readBits)
-            return !inputStream.hasMoreBits();
+            return finish(!inputStream.hasMoreBits());
 
         if (readBits < minCodeLength) {
             inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            return finish(padding_is_valid(chunk, readBits));
         }
 
         quint32 tableIndex = 0;
@@ -522,20 +532,22 @@ bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuf
 
         if (entry.bitLength > readBits) {
             inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            return finish(padding_is_valid(chunk, readBits));
         }
 
         if (!entry.bitLength || entry.byteValue == 256) {
             //EOS (256) == compression error (HPACK).
             inputStream.skipBits(readBits);
-            return false;
+            return finish(false);
         }
 
-        outputBuffer.append(entry.byteValue);
+        *out++ = char(entry.byteValue);
         inputStream.skipBits(entry.bitLength);
+        window <<= entry.bitLength;
+        windowBits -= entry.bitLength;
     }
 
-    return false;
+    return finish(false);
 }
 
 quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
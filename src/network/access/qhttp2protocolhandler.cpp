@@ -73,16 +73,18 @@ HPack::HttpHeader build_headers(const QHttpNetworkRequest &request, quint32 maxH
 {
     using namespace HPack;
 
+    const auto requestHeader = request.header();
+
     HttpHeader header;
-    header.reserve(300);
+    header.reserve(4 + requestHeader.size());
 
     // 1. Before anything - mandatory fields, if they do not fit into maxHeaderList -
     // then stop immediately with error.
     const auto auth = request.url().authority(QUrl::FullyEncoded | QUrl::RemoveUserInfo).toLatin1();
-    header.push_back(HeaderField(":authority", auth));
-    header.push_back(HeaderField(":method", request.methodName()));
-    header.push_back(HeaderField(":path", request.uri(useProxy)));
-    header.push_back(HeaderField(":scheme", request.url().scheme().toLatin1()));
+    header.push_back(HeaderField(QByteArrayLiteral(":authority"), auth));
+    header.push_back(HeaderField(QByteArrayLiteral(":method"), request.methodName()));
+    header.push_back(HeaderField(QByteArrayLiteral(":path"), request.uri(useProxy)));
+    header.push_back(HeaderField(QByteArrayLiteral(":scheme"), request.url().scheme().toLatin1()));
 
     HeaderSize size = header_size(header);
     if (!size.first) // Ooops!
@@ -91,7 +93,6 @@ HPack::HttpHeader build_headers(const QHttpNetworkRequest &request, quint32 maxH
     if (size.second > maxHeaderListSize)
         return HttpHeader(); // Bad, we cannot send this request ...
 
-    const auto requestHeader = request.header();
     for (const auto &field : requestHeader) {
         const HeaderSize delta = entry_size(field.first, field.second);
         if (!delta.first) // Overflow???
@@ -113,7 +114,10 @@ HPack::HttpHeader build_headers(const QHttpNetworkRequest &request, quint32 maxH
         // to their encoding in HTTP/2.
         // A request or response containing uppercase header field names
         // MUST be treated as malformed (Section 8.1.2.6)".
-        header.push_back(HeaderField(field.first.toLower(), field.second));
+        const bool hasUpperCase = std::any_of(field.first.cbegin(), field.first.cend(),
+                                              [](char c) { return c >= 'A' && c <= 'Z'; });
+        header.push_back(HeaderField(hasUpperCase ? field.first.toLower() : field.first,
+                                     field.second));
     }
 
     return header;
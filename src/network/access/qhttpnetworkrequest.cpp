@@ -39,9 +39,19 @@
 
 #include "qhttpnetworkrequest_p.h"
 #include "private/qnoncontiguousbytedevice_p.h"
+#ifdef Q_OS_UNIX
+#include <private/qcore_unix_p.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
+QHttpNetworkUploadFile::~QHttpNetworkUploadFile()
+{
+#ifdef Q_OS_UNIX
+    qt_safe_close(int(descriptor));
+#endif
+}
+
 QHttpNetworkRequestPrivate::QHttpNetworkRequestPrivate(QHttpNetworkRequest::Operation op,
         QHttpNetworkRequest::Priority pri, const QUrl &newUrl)
     : QHttpNetworkHeaderPrivate(newUrl), operation(op), priority(pri), uploadByteDevice(nullptr),
@@ -57,6 +67,7 @@ QHttpNetworkRequestPrivate::QHttpNetworkRequestPrivate(const QHttpNetworkRequest
       customVerb(other.customVerb),
       priority(other.priority),
       uploadByteDevice(other.uploadByteDevice),
+      uploadFile(other.uploadFile),
       autoDecompress(other.autoDecompress),
       pipeliningAllowed(other.pipeliningAllowed),
       http2Allowed(other.http2Allowed),
@@ -81,6 +92,7 @@ bool QHttpNetworkRequestPrivate::operator==(const QHttpNetworkRequestPrivate &ot
         && (operation == other.operation)
         && (priority == other.priority)
         && (uploadByteDevice == other.uploadByteDevice)
+        && (uploadFile == other.uploadFile)
         && (autoDecompress == other.autoDecompress)
         && (pipeliningAllowed == other.pipeliningAllowed)
         && (http2Allowed == other.http2Allowed)
@@ -383,6 +395,16 @@ QNonContiguousByteDevice* QHttpNetworkRequest::uploadByteDevice() const
     return d->uploadByteDevice;
 }
 
+void QHttpNetworkRequest::setUploadFile(const QSharedPointer<QHttpNetworkUploadFile> &file)
+{
+    d->uploadFile = file;
+}
+
+QSharedPointer<QHttpNetworkUploadFile> QHttpNetworkRequest::uploadFile() const
+{
+    return d->uploadFile;
+}
+
 int QHttpNetworkRequest::majorVersion() const
 {
     return 1;
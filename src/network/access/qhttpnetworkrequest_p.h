@@ -55,6 +55,7 @@
 #include <private/qhttpnetworkheader_p.h>
 #include <QtNetwork/qnetworkrequest.h>
 #include <qmetatype.h>
+#include <qsharedpointer.h>
 
 #ifndef Q_OS_WASM
 QT_REQUIRE_CONFIG(http);
@@ -64,6 +65,23 @@ QT_BEGIN_NAMESPACE
 
 class QNonContiguousByteDevice;
 
+// The file a request body is read from. On plain TCP connections the
+// HTTP/1 protocol handler sends the body straight from this file, see
+// QAbstractSocketPrivate::writeFile(), and only advances the upload
+// device past the data to report the progress.
+class QHttpNetworkUploadFile
+{
+    Q_DISABLE_COPY_MOVE(QHttpNetworkUploadFile)
+public:
+    QHttpNetworkUploadFile(qintptr descriptor, qint64 offset)
+        : descriptor(descriptor), offset(offset)
+    {}
+    ~QHttpNetworkUploadFile();
+
+    const qintptr descriptor; // closed by the destructor
+    const qint64 offset;
+};
+
 class QHttpNetworkRequestPrivate;
 class Q_AUTOTEST_EXPORT QHttpNetworkRequest: public QHttpNetworkHeader
 {
@@ -144,6 +162,9 @@ public:
     void setUploadByteDevice(QNonContiguousByteDevice *bd);
     QNonContiguousByteDevice* uploadByteDevice() const;
 
+    void setUploadFile(const QSharedPointer<QHttpNetworkUploadFile> &file);
+    QSharedPointer<QHttpNetworkUploadFile> uploadFile() const;
+
     QByteArray methodName() const;
     QByteArray uri(bool throughProxy) const;
 
@@ -177,6 +198,7 @@ public:
     QByteArray customVerb;
     QHttpNetworkRequest::Priority priority;
     mutable QNonContiguousByteDevice* uploadByteDevice;
+    QSharedPointer<QHttpNetworkUploadFile> uploadFile;
     bool autoDecompress;
     bool pipeliningAllowed;
     bool http2Allowed;
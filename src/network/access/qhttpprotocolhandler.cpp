@@ -41,6 +41,7 @@
 #include <private/qhttpprotocolhandler_p.h>
 #include <private/qnoncontiguousbytedevice_p.h>
 #include <private/qhttpnetworkconnectionchannel_p.h>
+#include <private/qabstractsocket_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -284,6 +285,7 @@ bool QHttpProtocolHandler::sendRequest()
 
         m_channel->written = 0; // excluding the header
         m_channel->bytesTotal = 0;
+        m_sendingFile = false;
 
         QHttpNetworkReplyPrivate *replyPrivate = m_reply->d_func();
         replyPrivate->clear();
@@ -354,6 +356,35 @@ bool QHttpProtocolHandler::sendRequest()
             break;
         }
 
+        // On plain TCP connections a file-backed body goes from the file to
+        // the socket without being read into the process; the upload device
+        // is only advanced past the data that was sent.
+        const QHttpNetworkUploadFile *uploadFile = m_channel->request.d->uploadFile.data();
+        if (uploadFile && !m_channel->ssl) {
+            auto socketPrivate = static_cast<QAbstractSocketPrivate *>(QObjectPrivate::get(m_socket));
+            if (!m_sendingFile && m_channel->written == 0) {
+                if (!m_header.isEmpty())
+                    m_socket->write(qExchange(m_header, {}));
+                m_sendingFile = socketPrivate->writeFile(uploadFile->descriptor, uploadFile->offset,
+                                                         m_channel->bytesTotal);
+            }
+            if (m_sendingFile) {
+                const qint64 sent = m_channel->bytesTotal - socketPrivate->sendFileSize;
+                if (sent > m_channel->written) {
+                    uploadByteDevice->advanceReadPointer(sent - m_channel->written);
+                    m_channel->written = sent;
+                    emit m_reply->dataSendProgress(m_channel->written, m_channel->bytesTotal);
+                }
+                if (m_channel->written == m_channel->bytesTotal) {
+                    m_sendingFile = false;
+                    m_channel->state = QHttpNetworkConnectionChannel::WaitingState;
+                    sendRequest();
+                }
+                break;
+            }
+            // the socket cannot send files, fall back to reading the upload device
+        }
+
         // only feed the QTcpSocket buffer when there is less than 32 kB in it;
         // note that the headers do not count towards these limits.
         const qint64 socketBufferFill = 32*1024;
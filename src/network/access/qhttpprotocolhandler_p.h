@@ -71,6 +71,7 @@ private:
     virtual bool sendRequest() override;
 
     QByteArray m_header;
+    bool m_sendingFile = false;
 };
 
 QT_END_NAMESPACE
@@ -176,6 +176,114 @@ static QByteArray makeCacheKey(QUrl &url, QNetworkProxy *proxy, const QString &p
     return "http-connection:" + std::move(result).toLatin1();
 }
 
+// Requests from different managers use the connections of the shared HTTP
+// thread, so a connection can only be reused for a request that would have
+// set it up in the same way. The values that the connections alive in that
+// thread were set up with are numbered for the cache key, and forgotten when
+// the last connection using them is destroyed. This is only used in the shared
+// HTTP thread.
+template <typename T>
+class QSharedConnectionValues
+{
+public:
+    qint64 idOf(const T &value)
+    {
+        for (const Entry &entry : qAsConst(entries)) {
+            if (entry.value == value)
+                return entry.id;
+        }
+        // a new value makes a new cache key, so the caller creates a
+        // connection, which takes a reference
+        entries.append({ value, nextId, 0 });
+        return nextId++;
+    }
+
+    void ref(qint64 id)
+    {
+        ++find(id)->refCount;
+    }
+
+    void deref(qint64 id)
+    {
+        auto it = find(id);
+        if (--it->refCount == 0)
+            entries.erase(it);
+    }
+
+private:
+    struct Entry
+    {
+        T value;
+        qint64 id;
+        int refCount;
+    };
+
+    typename QList<Entry>::iterator find(qint64 id)
+    {
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [id](const Entry &entry) { return entry.id == id; });
+        Q_ASSERT(it != entries.end());
+        return it;
+    }
+
+    QList<Entry> entries;
+    qint64 nextId = 0;
+};
+
+typedef QSharedConnectionValues<QHttp2Configuration> QSharedHttp2Configurations;
+Q_GLOBAL_STATIC(QSharedHttp2Configurations, sharedHttp2Configurations)
+#if QT_CONFIG(ssl)
+typedef QSharedConnectionValues<QSslConfiguration> QSharedSslConfigurations;
+Q_GLOBAL_STATIC(QSharedSslConfigurations, sharedSslConfigurations)
+#endif
+// weak pointers compare equal only if they refer to the same manager, even
+// if a new manager is created at the address of a destroyed one
+typedef QSharedConnectionValues<QWeakPointer<QNetworkAccessAuthenticationManager>>
+        QSharedAuthenticationManagers;
+Q_GLOBAL_STATIC(QSharedAuthenticationManagers, sharedAuthenticationManagers)
+
+struct QSharedConnectionKey
+{
+    qint64 http2Configuration = -1;
+    qint64 sslConfiguration = -1;
+    qint64 authenticationManager = -1;
+
+    QByteArray toCacheKeySuffix() const
+    {
+        QByteArray result = ":shared:h2-" + QByteArray::number(http2Configuration);
+        if (sslConfiguration >= 0)
+            result += ":ssl-" + QByteArray::number(sslConfiguration);
+        if (authenticationManager >= 0)
+            result += ":auth-" + QByteArray::number(authenticationManager);
+        return result;
+    }
+
+    void ref() const
+    {
+        sharedHttp2Configurations()->ref(http2Configuration);
+#if QT_CONFIG(ssl)
+        if (sslConfiguration >= 0)
+            sharedSslConfigurations()->ref(sslConfiguration);
+#endif
+        if (authenticationManager >= 0)
+            sharedAuthenticationManagers()->ref(authenticationManager);
+    }
+
+    void deref() const
+    {
+        // connections still cached are destroyed when the shared HTTP
+        // thread ends, which can be after the lists on exit
+        if (http2Configuration >= 0 && !sharedHttp2Configurations.isDestroyed())
+            sharedHttp2Configurations()->deref(http2Configuration);
+#if QT_CONFIG(ssl)
+        if (sslConfiguration >= 0 && !sharedSslConfigurations.isDestroyed())
+            sharedSslConfigurations()->deref(sslConfiguration);
+#endif
+        if (authenticationManager >= 0 && !sharedAuthenticationManagers.isDestroyed())
+            sharedAuthenticationManagers()->deref(authenticationManager);
+    }
+};
+
 class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
                                       public QNetworkAccessCache::CacheableObject
 {
@@ -189,6 +297,11 @@ public:
         setShareable(true);
     }
 
+    ~QNetworkAccessCachedHttpConnection()
+    {
+        sharedKey.deref();
+    }
+
     virtual void dispose() override
     {
 #if 0  // sample code; do this right with the API
@@ -196,6 +309,11 @@ public:
 #endif
         delete this;
     }
+
+    // the manager whose request set up this connection
+    QWeakPointer<QNetworkAccessAuthenticationManager> authenticationManager;
+    // the values in the cache key of a connection in the shared HTTP thread
+    QSharedConnectionKey sharedKey;
 };
 
 
@@ -226,6 +344,7 @@ QHttpThreadDelegate::QHttpThreadDelegate(QObject *parent) :
     , pendingDownloadData()
     , pendingDownloadProgress()
     , synchronous(false)
+    , sharedConnection(false)
     , incomingStatusCode(0)
     , isPipeliningUsed(false)
     , isHttp2Used(false)
@@ -321,8 +440,36 @@ void QHttpThreadDelegate::startRequest()
 #endif
         cacheKey = makeCacheKey(urlCopy, nullptr, httpRequest.peerVerifyName());
 
+    QSharedConnectionKey sharedKey;
+    const QByteArray connectionKey = cacheKey;
+    if (sharedConnection) {
+        sharedKey.http2Configuration = sharedHttp2Configurations()->idOf(http2Parameters);
+#if QT_CONFIG(ssl)
+        if (ssl)
+            sharedKey.sslConfiguration = sharedSslConfigurations()->idOf(*incomingSslConfiguration);
+#endif
+        cacheKey = connectionKey + sharedKey.toCacheKeySuffix();
+    }
+
     // the http object is actually a QHttpNetworkConnection
     httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
+    if (httpConnection && sharedConnection
+        && httpConnection->authenticationManager != authenticationManager) {
+        // The channels of a connection keep the credentials used by its
+        // requests, and add them to the following HTTP/1.1 requests. So we
+        // only use another manager's connection once it has switched to
+        // HTTP/2, and otherwise use one of our own.
+        const auto type = httpConnection->connectionType();
+        const bool isHttp2 = type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
+                || (type == QHttpNetworkConnection::ConnectionTypeHTTP2
+                    && httpConnection->d_func()->channels[0].switchedToHttp2);
+        if (!isHttp2) {
+            connections.localData()->releaseEntry(cacheKey);
+            sharedKey.authenticationManager = sharedAuthenticationManagers()->idOf(authenticationManager);
+            cacheKey = connectionKey + sharedKey.toCacheKeySuffix();
+            httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
+        }
+    }
     if (!httpConnection) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
@@ -343,9 +490,15 @@ void QHttpThreadDelegate::startRequest()
         httpConnection->setCacheProxy(cacheProxy);
 #endif
         httpConnection->setPeerVerifyName(httpRequest.peerVerifyName());
+        httpConnection->authenticationManager = authenticationManager;
+        if (sharedConnection) {
+            httpConnection->sharedKey = sharedKey;
+            sharedKey.ref();
+        }
         // cache the QHttpNetworkConnection corresponding to this cache key
         connections.localData()->addEntry(cacheKey, httpConnection);
-    } else {
+    } else if (httpConnection->authenticationManager == authenticationManager) {
+        // don't hand our credentials to another manager's connection
         if (httpRequest.withCredentials()) {
             QNetworkAuthenticationCredential credential = authenticationManager->fetchCachedCredentials(httpRequest.url(), nullptr);
             if (!credential.user.isEmpty() && !credential.password.isEmpty()) {
@@ -105,6 +105,8 @@ public:
 #endif
     QSharedPointer<QNetworkAccessAuthenticationManager> authenticationManager;
     bool synchronous;
+    // the connection may be used by other managers' requests
+    bool sharedConnection;
 
     // outgoing, Retrieved in the synchronous HTTP case
     QByteArray synchronousDownloadData;
@@ -243,11 +245,18 @@ public:
 
     bool advanceReadPointer(qint64 a) override
     {
-        if (m_data == nullptr)
+        if (a > m_amount) {
+            // The data was sent straight from the file that the device in the
+            // user thread reads, see QHttpNetworkUploadFile.
+            m_amount = 0;
+            m_data = nullptr;
+            m_dataArray.clear();
+        } else if (m_data == nullptr) {
             return false;
-
-        m_amount -= a;
-        m_data += a;
+        } else {
+            m_amount -= a;
+            m_data += a;
+        }
         m_pos += a;
 
         // To main thread to inform about our state. The m_pos will be sent as a sanity check.
@@ -1636,6 +1636,33 @@ QThread * QNetworkAccessManagerPrivate::createThread()
     return thread;
 }
 
+namespace {
+// Runs the connections shared by all managers, see
+// QNetworkRequest::Http2SharedConnectionAttribute
+class QSharedHttpThread : public QThread
+{
+public:
+    QSharedHttpThread()
+    {
+        setObjectName(QStringLiteral("Qt shared HTTP thread"));
+        start();
+    }
+
+    ~QSharedHttpThread()
+    {
+        quit();
+        wait();
+    }
+};
+}
+
+Q_GLOBAL_STATIC(QSharedHttpThread, sharedHttpThreadInstance)
+
+QThread *QNetworkAccessManagerPrivate::sharedHttpThread()
+{
+    return sharedHttpThreadInstance();
+}
+
 void QNetworkAccessManagerPrivate::destroyThread()
 {
     if (thread) {
@@ -93,6 +93,7 @@ public:
 
     QThread * createThread();
     void destroyThread();
+    static QThread *sharedHttpThread();
 
     void _q_replyFinished(QNetworkReply *reply);
     void _q_replyEncrypted(QNetworkReply *reply);
@@ -49,19 +49,45 @@
 #include <qdatastream.h>
 #include <qdatetime.h>
 #include <qdiriterator.h>
+#include <qsavefile.h>
 #include <qurl.h>
 #include <qcryptographichash.h>
 #include <qdebug.h>
+#if QT_CONFIG(thread)
+#include <qthreadpool.h>
+#endif
+
+#include <algorithm>
+#include <tuple>
 
 #define CACHE_POSTFIX QLatin1String(".d")
 #define PREPARED_SLASH QLatin1String("prepared/")
 #define CACHE_VERSION 8
 #define DATA_DIR QLatin1String("data")
+#define INDEX_FILE QLatin1String("index")
 
 #define MAX_COMPRESSION_SIZE (1024 * 1024 * 3)
 
+// expire() deletes up to this many files itself, more are left to a pool thread
+#define MAX_FOREGROUND_REMOVALS 32
+
 QT_BEGIN_NAMESPACE
 
+// The index file is an IndexHeader followed by IndexRecords in host byte
+// order. They are applied in order, so that changes can be appended.
+struct IndexHeader
+{
+    quint32 magic;
+    quint32 version;
+};
+
+typedef QNetworkDiskCacheIndexRecord IndexRecord;
+
+enum { IndexMagic = 0x49434e51 }; // "QNCI"
+
+// the index is rewritten once it holds this many records more than entries
+#define INDEX_COMPACTION_SLACK 1024
+
 /*!
     \class QNetworkDiskCache
     \since 4.5
@@ -74,6 +100,13 @@ QT_BEGIN_NAMESPACE
     are compressed using qCompress.  Data is written to disk only in insert()
     and updateMetaData().
 
+    The size and the creation time of every cache file are kept in an
+    index in the cache directory. Every change is appended to the index
+    right away, so the next cache using the directory can read it back even
+    if the application did not exit cleanly. This way neither cacheSize()
+    nor expire() need to look at the cache files themselves. If the index
+    is missing, it is recreated from the files the first time it is needed.
+
     Currently you cannot share the same cache files with more than
     one disk cache.
 
@@ -112,6 +145,7 @@ QNetworkDiskCache::QNetworkDiskCache(QObject *parent)
 QNetworkDiskCache::~QNetworkDiskCache()
 {
     Q_D(QNetworkDiskCache);
+    d->saveIndex();
     qDeleteAll(d->inserting);
 }
 
@@ -142,6 +176,7 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
     Q_D(QNetworkDiskCache);
     if (cacheDir.isEmpty())
         return;
+    d->saveIndex();
     d->cacheDirectory = cacheDir;
     QDir dir(d->cacheDirectory);
     d->cacheDirectory = dir.absolutePath();
@@ -150,6 +185,7 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
 
     d->dataDirectory = d->cacheDirectory + DATA_DIR + QString::number(CACHE_VERSION) + QLatin1Char('/');
     d->prepareLayout();
+    d->loadIndex();
 }
 
 /*!
@@ -270,12 +306,23 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
     QString fileName = cacheFileName(cacheItem->metaData.url());
     Q_ASSERT(!fileName.isEmpty());
 
+    // an expiry still running in the background must not delete the new file
+    remover->cancel(fileName);
     if (QFile::exists(fileName)) {
         if (!QFile::remove(fileName)) {
             qWarning() << "QNetworkDiskCache: couldn't remove the cache file " << fileName;
             return;
         }
     }
+    const quint64 key = indexKey(fileName);
+    if (indexLoaded) {
+        const auto it = index.constFind(key);
+        if (it != index.cend()) {
+            if (currentCacheSize > 0)
+                currentCacheSize -= it->size;
+            index.erase(it);
+        }
+    }
 
     if (currentCacheSize > 0)
         currentCacheSize += 1024 + cacheItem->size();
@@ -293,11 +340,20 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         && cacheItem->file->isOpen()
         && cacheItem->file->error() == QFile::NoError) {
         cacheItem->file->setAutoRemove(false);
+        // Record the file before it exists, so that the index file never
+        // misses a cache file, even if the application does not exit cleanly.
+        const qint64 size = cacheItem->file->size();
+        const qint64 time = QDateTime::currentMSecsSinceEpoch();
+        appendToIndex(key, size, time);
         // ### use atomic rename rather then remove & rename
-        if (cacheItem->file->rename(fileName))
-            currentCacheSize += cacheItem->file->size();
-        else
+        if (cacheItem->file->rename(fileName)) {
+            currentCacheSize += size;
+            if (indexLoaded && key)
+                index.insert(key, { size, time });
+        } else {
             cacheItem->file->setAutoRemove(true);
+            appendToIndex(key, -1, 0);
+        }
     }
     if (cacheItem->metaData.url() == lastItem.metaData.url())
         lastItem.reset();
@@ -343,13 +399,310 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
     if (!fileName.endsWith(CACHE_POSTFIX))
         return false;
     qint64 size = info.size();
+    remover->cancel(file);
+    const quint64 key = indexKey(file);
+    if (indexLoaded)
+        index.remove(key);
     if (QFile::remove(file)) {
+        appendToIndex(key, -1, 0);
         currentCacheSize -= size;
         return true;
     }
     return false;
 }
 
+/*!
+    Returns the index key of the cache file \a file, or 0 if \a file is not
+    a cache file of the form created by uniqueFileName().
+ */
+quint64 QNetworkDiskCachePrivate::indexKey(const QString &file) const
+{
+    if (!file.startsWith(dataDirectory) || !file.endsWith(CACHE_POSTFIX))
+        return 0;
+    // <one-char subdir>/<at most 8-char id>.d
+    const QStringView name = QStringView(file).mid(dataDirectory.size());
+    const QStringView id = name.mid(2, name.size() - 2 - CACHE_POSTFIX.size());
+    if (name.size() < 4 || name.at(1) != QLatin1Char('/') || id.isEmpty() || id.size() > 8)
+        return 0;
+
+    char bytes[sizeof(quint64)] = {};
+    for (qsizetype i = 0; i < id.size(); ++i) {
+        const char16_t c = id.at(i).unicode();
+        if (c == 0 || c > 0x7f)
+            return 0;
+        bytes[i] = char(c);
+    }
+    if (name.at(0) != QString::number(uint(bytes[id.size() - 1]) % 16, 16).at(0))
+        return 0;
+
+    quint64 key;
+    memcpy(&key, bytes, sizeof key);
+    return key;
+}
+
+/*!
+    Returns the name of the cache file with the index key \a key.
+ */
+QString QNetworkDiskCachePrivate::indexedFileName(quint64 key) const
+{
+    char bytes[sizeof(quint64)];
+    memcpy(bytes, &key, sizeof key);
+    const QLatin1String id(bytes, int(qstrnlen(bytes, sizeof bytes)));
+    const uint code = uint(id.at(id.size() - 1).toLatin1()) % 16;
+    return dataDirectory + QString::number(code, 16) + QLatin1Char('/') + id + CACHE_POSTFIX;
+}
+
+QString QNetworkDiskCachePrivate::indexFileName() const
+{
+    return dataDirectory + INDEX_FILE;
+}
+
+/*!
+    Reads the index of the cache directory, and keeps it open for appending
+    the changes this cache makes.
+
+    Changes are recorded in the index before a cache file is created and
+    after one is deleted, so the index may list files that no longer exist,
+    but never misses one.
+ */
+void QNetworkDiskCachePrivate::loadIndex()
+{
+    // removals of the previous directory go to the index of that directory
+    remover->waitForDone();
+    remover->closeIndex();
+    index.clear();
+    indexLoaded = false;
+    currentCacheSize = -1;
+
+    QFile file(indexFileName());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QByteArray buffer;
+    qint64 size = file.size();
+    uchar *mapped = file.map(0, size);
+    const uchar *data = mapped;
+    if (!mapped) {
+        buffer = file.readAll();
+        data = reinterpret_cast<const uchar *>(buffer.constData());
+        size = buffer.size();
+    }
+
+    IndexHeader header;
+    qint64 recordCount = -1;
+    if (size >= qint64(sizeof header)) {
+        memcpy(&header, data, sizeof header);
+        if (header.magic == IndexMagic && header.version == CACHE_VERSION) {
+            // a record that was cut short by a crash is dropped
+            recordCount = (size - qint64(sizeof header)) / qint64(sizeof(IndexRecord));
+            const uchar *records = data + sizeof header;
+            for (qint64 i = 0; i < recordCount; ++i) {
+                IndexRecord record;
+                memcpy(&record, records + i * sizeof record, sizeof record);
+                if (record.size < 0)
+                    index.remove(record.key);
+                else
+                    index.insert(record.key, { record.size, record.time });
+            }
+        }
+    }
+    if (mapped)
+        file.unmap(mapped);
+    file.close();
+
+    if (recordCount < 0) {
+        index.clear();
+        file.remove();
+        return;
+    }
+
+    qint64 totalSize = 0;
+    for (const IndexEntry &entry : qAsConst(index))
+        totalSize += entry.size;
+    indexLoaded = true;
+    currentCacheSize = totalSize;
+
+    if (recordCount > 2 * index.size() + INDEX_COMPACTION_SLACK) {
+        saveIndex();
+        return;
+    }
+    const qint64 validSize = qint64(sizeof header) + recordCount * qint64(sizeof(IndexRecord));
+    if ((validSize == size || file.resize(validSize))
+        && remover->openIndex(indexFileName(), recordCount)) {
+        return;
+    }
+    // changes could not be recorded, so the index would go stale
+    file.remove();
+}
+
+/*!
+    Rewrites the index file with one record per cache file, dropping the
+    records of changes that were appended since.
+ */
+void QNetworkDiskCachePrivate::saveIndex()
+{
+    if (!indexLoaded || dataDirectory.isEmpty())
+        return;
+    // files still queued for removal are no longer in the index
+    remover->waitForDone();
+    const qint64 previousRecords = remover->indexRecords();
+    remover->closeIndex();
+
+    QSaveFile file(indexFileName());
+    bool saved = file.open(QIODevice::WriteOnly);
+    if (saved) {
+        const IndexHeader header = { IndexMagic, CACHE_VERSION };
+        file.write(reinterpret_cast<const char *>(&header), sizeof header);
+
+        IndexRecord records[1024];
+        int count = 0;
+        for (auto it = index.cbegin(), end = index.cend(); it != end; ++it) {
+            records[count++] = { it.key(), it->size, it->time };
+            if (count == int(std::size(records))) {
+                file.write(reinterpret_cast<const char *>(records), count * sizeof(IndexRecord));
+                count = 0;
+            }
+        }
+        file.write(reinterpret_cast<const char *>(records), count * sizeof(IndexRecord));
+        saved = file.commit();
+    }
+    // if saving failed, the previous index file is still up to date
+    if (!remover->openIndex(indexFileName(), saved ? index.size() : previousRecords))
+        QFile::remove(indexFileName());
+}
+
+/*!
+    Recreates the index from the cache files on disk and saves it.
+ */
+void QNetworkDiskCachePrivate::buildIndex()
+{
+    index.clear();
+
+    QDirIterator it(dataDirectory, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        const quint64 key = indexKey(path);
+        if (!key || remover->isPending(path))
+            continue;
+        const QFileInfo info = it.fileInfo();
+        const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+        const QDateTime time = birthTime.isValid() ? birthTime
+                               : info.fileTime(QFile::FileMetadataChangeTime);
+        index.insert(key, { info.size(), time.toMSecsSinceEpoch() });
+    }
+
+    indexLoaded = true;
+    saveIndex();
+}
+
+/*!
+    Records in the index file that the cache file with the index key \a key
+    now has the size \a size and was created at \a time, or was removed if
+    \a size is negative.
+ */
+void QNetworkDiskCachePrivate::appendToIndex(quint64 key, qint64 size, qint64 time)
+{
+    if (!indexLoaded || !key)
+        return;
+    const IndexRecord record = { key, size, time };
+    remover->appendToIndex(&record, 1);
+}
+
+void QNetworkDiskCacheRemover::remove(const QList<std::pair<QString, quint64>> &files)
+{
+    QMutexLocker locker(&mutex);
+    for (const auto &file : files) {
+        if (!pending.contains(file.first)) {
+            pending.insert(file.first);
+            queue.append(file);
+        }
+    }
+    if (running || queue.isEmpty())
+        return;
+    running = true;
+    locker.unlock();
+#if QT_CONFIG(thread)
+    QThreadPool::globalInstance()->start([self = sharedFromThis()]() { self->run(); });
+#else
+    run();
+#endif
+}
+
+bool QNetworkDiskCacheRemover::cancel(const QString &file)
+{
+    QMutexLocker locker(&mutex);
+    return pending.remove(file);
+}
+
+bool QNetworkDiskCacheRemover::isPending(const QString &file) const
+{
+    QMutexLocker locker(&mutex);
+    return pending.contains(file);
+}
+
+void QNetworkDiskCacheRemover::waitForDone()
+{
+    QMutexLocker locker(&mutex);
+    while (running)
+        done.wait(&mutex);
+}
+
+bool QNetworkDiskCacheRemover::openIndex(const QString &fileName, qint64 count)
+{
+    QMutexLocker locker(&mutex);
+    indexFile.close();
+    indexFile.setFileName(fileName);
+    records = count;
+    return indexFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered);
+}
+
+void QNetworkDiskCacheRemover::closeIndex()
+{
+    QMutexLocker locker(&mutex);
+    indexFile.close();
+}
+
+void QNetworkDiskCacheRemover::appendToIndex(const QNetworkDiskCacheIndexRecord *records,
+                                             qsizetype count)
+{
+    QMutexLocker locker(&mutex);
+    writeToIndex(records, count);
+}
+
+qint64 QNetworkDiskCacheRemover::indexRecords() const
+{
+    QMutexLocker locker(&mutex);
+    return records;
+}
+
+// must be called with the mutex locked
+void QNetworkDiskCacheRemover::writeToIndex(const QNetworkDiskCacheIndexRecord *data,
+                                            qsizetype count)
+{
+    if (!indexFile.isOpen())
+        return;
+    indexFile.write(reinterpret_cast<const char *>(data), count * sizeof(*data));
+    records += count;
+}
+
+void QNetworkDiskCacheRemover::run()
+{
+    QMutexLocker locker(&mutex);
+    while (!queue.isEmpty()) {
+        const auto file = queue.takeFirst();
+        // Delete with the lock held, so that a file is either deleted
+        // or, when cancel() returned true, left alone.
+        if (pending.remove(file.first) && QFile::remove(file.first) && file.second) {
+            const QNetworkDiskCacheIndexRecord record = { file.second, -1, 0 };
+            writeToIndex(&record, 1);
+        }
+        locker.unlock();
+        locker.relock();
+    }
+    running = false;
+    done.wakeAll();
+}
+
 /*!
     \reimp
 */
@@ -359,9 +712,12 @@ QNetworkCacheMetaData QNetworkDiskCache::metaData(const QUrl &url)
     qDebug() << "QNetworkDiskCache::metaData()" << url;
 #endif
     Q_D(QNetworkDiskCache);
+    const QString fileName = d->cacheFileName(url);
+    if (d->remover->isPending(fileName))
+        return QNetworkCacheMetaData();
     if (d->lastItem.metaData.url() == url)
         return d->lastItem.metaData;
-    return fileMetaData(d->cacheFileName(url));
+    return fileMetaData(fileName);
 }
 
 /*!
@@ -398,11 +754,14 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
     QScopedPointer<QBuffer> buffer;
     if (!url.isValid())
         return nullptr;
+    const QString fileName = d->cacheFileName(url);
+    if (d->remover->isPending(fileName))
+        return nullptr;
     if (d->lastItem.metaData.url() == url && d->lastItem.data.isOpen()) {
         buffer.reset(new QBuffer);
         buffer->setData(d->lastItem.data.data());
     } else {
-        QScopedPointer<QFile> file(new QFile(d->cacheFileName(url)));
+        QScopedPointer<QFile> file(new QFile(fileName));
         if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered))
             return nullptr;
 
@@ -504,6 +863,12 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
     maximumCacheSize() starting with the oldest ones first using the file
     creation date to determine how old a cache file is.
 
+    Sizes and creation dates come from the cache index, so no cache file
+    needs to be opened. Files that are still being written between
+    prepare() and insert() count towards the size of the cache, but are
+    not removed. When many files have to go, they are deleted on a
+    background thread; until then they are treated as no longer cached.
+
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
     knows about that QNetworkDiskCache does not, for example the number of times
@@ -527,53 +892,81 @@ qint64 QNetworkDiskCache::expire()
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
 
-    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
-
-    QMultiMap<QDateTime, QString> cacheItems;
+    if (!d->indexLoaded)
+        d->buildIndex();
+    else if (d->remover->indexRecords() > 2 * d->index.size() + INDEX_COMPACTION_SLACK)
+        d->saveIndex();
+
+    struct CacheItem
+    {
+        qint64 time;
+        quint64 key;       // 0 for files left in the prepared directory
+        QString fileName;  // only for files left in the prepared directory
+        qint64 size;
+        bool operator<(const CacheItem &other) const
+        { return std::tie(time, key) < std::tie(other.time, other.key); }
+    };
+    QList<CacheItem> cacheItems;
+    cacheItems.reserve(d->index.size());
     qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QString path = it.next();
-        QFileInfo info = it.fileInfo();
-        QString fileName = info.fileName();
-        if (fileName.endsWith(CACHE_POSTFIX)) {
-            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
-            cacheItems.insert(birthTime.isValid() ? birthTime
-                              : info.fileTime(QFile::FileMetadataChangeTime), path);
-            totalSize += info.size();
+    for (auto it = d->index.cbegin(), end = d->index.cend(); it != end; ++it) {
+        cacheItems.append({ it->time, it.key(), QString(), it->size });
+        totalSize += it->size;
+    }
+
+    // Files still being written are protected, files left behind by a
+    // cache that did not finish writing them are expired like the others.
+    QSet<QString> inUse;
+    for (QCacheItem *item : qAsConst(d->inserting)) {
+        if (item && item->file) {
+            inUse.insert(item->file->fileName());
+            totalSize += item->file->size();
         }
     }
+    QDirIterator prepared(d->cacheDirectory + PREPARED_SLASH, QDir::Files | QDir::NoDotAndDotDot);
+    while (prepared.hasNext()) {
+        const QString path = prepared.next();
+        if (!path.endsWith(CACHE_POSTFIX) || inUse.contains(path))
+            continue;
+        const QFileInfo info = prepared.fileInfo();
+        const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+        const QDateTime time = birthTime.isValid() ? birthTime
+                               : info.fileTime(QFile::FileMetadataChangeTime);
+        cacheItems.append({ time.toMSecsSinceEpoch(), 0, path, info.size() });
+        totalSize += info.size();
+    }
 
-    int removedFiles = 0;
+    QList<std::pair<QString, quint64>> removedFiles;
     qint64 goal = (maximumCacheSize() * 9) / 10;
-    QMultiMap<QDateTime, QString>::const_iterator i = cacheItems.constBegin();
-    while (i != cacheItems.constEnd()) {
-        if (totalSize < goal)
-            break;
-        QString name = i.value();
-        QFile file(name);
-
-        if (name.contains(PREPARED_SLASH)) {
-            for (QCacheItem *item : qAsConst(d->inserting)) {
-                if (item && item->file && item->file->fileName() == name) {
-                    delete item->file;
-                    item->file = nullptr;
-                    break;
-                }
+    if (totalSize >= goal) {
+        std::sort(cacheItems.begin(), cacheItems.end());
+        for (const CacheItem &item : qAsConst(cacheItems)) {
+            if (totalSize < goal)
+                break;
+            totalSize -= item.size;
+            if (item.key) {
+                d->index.remove(item.key);
+                removedFiles.append({ d->indexedFileName(item.key), item.key });
+            } else {
+                removedFiles.append({ item.fileName, 0 });
             }
         }
-
-        qint64 size = file.size();
-        file.remove();
-        totalSize -= size;
-        ++removedFiles;
-        ++i;
+    }
+    if (removedFiles.size() > MAX_FOREGROUND_REMOVALS) {
+        d->remover->remove(removedFiles);
+    } else {
+        QList<IndexRecord> records;
+        for (const auto &file : qAsConst(removedFiles)) {
+            if (QFile::remove(file.first) && file.second)
+                records.append({ file.second, -1, 0 });
+        }
+        d->remover->appendToIndex(records.constData(), records.size());
     }
 #if defined(QNETWORKDISKCACHE_DEBUG)
-    if (removedFiles > 0) {
+    if (!removedFiles.isEmpty()) {
         qDebug() << "QNetworkDiskCache::expire()"
-                << "Removed:" << removedFiles
-                << "Kept:" << cacheItems.count() - removedFiles;
+                << "Removed:" << removedFiles.size()
+                << "Kept:" << d->index.size();
     }
 #endif
     return totalSize;
@@ -592,6 +985,7 @@ void QNetworkDiskCache::clear()
     d->maximumCacheSize = 0;
     d->currentCacheSize = expire();
     d->maximumCacheSize = size;
+    d->remover->waitForDone();
 }
 
 /*!
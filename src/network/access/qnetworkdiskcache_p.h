@@ -55,15 +55,18 @@
 #include "private/qabstractnetworkcache_p.h"
 
 #include <qbuffer.h>
+#include <qfile.h>
 #include <qhash.h>
+#include <qmutex.h>
+#include <qset.h>
+#include <qsharedpointer.h>
 #include <qtemporaryfile.h>
+#include <qwaitcondition.h>
 
 QT_REQUIRE_CONFIG(networkdiskcache);
 
 QT_BEGIN_NAMESPACE
 
-class QFile;
-
 class QCacheItem
 {
 public:
@@ -94,6 +97,46 @@ public:
     bool canCompress() const;
 };
 
+// One record of the index file. A negative size records that the file
+// was removed.
+struct QNetworkDiskCacheIndexRecord
+{
+    quint64 key;
+    qint64 size;
+    qint64 time;
+};
+
+// Deletes expired cache files on a pool thread. Files stay pending until
+// they are deleted, and a file can be taken back before that, for instance
+// when a new item is stored under the same name.
+// Records are appended to the index file here as well, since both the
+// cache and the pool thread record changes in it.
+class QNetworkDiskCacheRemover : public QEnableSharedFromThis<QNetworkDiskCacheRemover>
+{
+public:
+    void remove(const QList<std::pair<QString, quint64>> &files);
+    bool cancel(const QString &file);
+    bool isPending(const QString &file) const;
+    void waitForDone();
+
+    bool openIndex(const QString &fileName, qint64 records);
+    void closeIndex();
+    void appendToIndex(const QNetworkDiskCacheIndexRecord *records, qsizetype count);
+    qint64 indexRecords() const;
+
+private:
+    void run();
+    void writeToIndex(const QNetworkDiskCacheIndexRecord *records, qsizetype count);
+
+    mutable QMutex mutex;
+    QWaitCondition done;
+    QList<std::pair<QString, quint64>> queue;
+    QSet<QString> pending;
+    bool running = false;
+    QFile indexFile;
+    qint64 records = 0;
+};
+
 class QNetworkDiskCachePrivate : public QAbstractNetworkCachePrivate
 {
 public:
@@ -101,8 +144,19 @@ public:
         : QAbstractNetworkCachePrivate()
         , maximumCacheSize(1024 * 1024 * 50)
         , currentCacheSize(-1)
+        , indexLoaded(false)
+        , remover(new QNetworkDiskCacheRemover)
         {}
 
+    // Size and insertion time of one cache file, keyed by the file's
+    // base name (at most eight characters, see uniqueFileName()) packed
+    // into an integer
+    struct IndexEntry
+    {
+        qint64 size;
+        qint64 time;
+    };
+
     static QString uniqueFileName(const QUrl &url);
     QString cacheFileName(const QUrl &url) const;
     QString tmpCacheFileName() const;
@@ -111,16 +165,30 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    quint64 indexKey(const QString &file) const;
+    QString indexedFileName(quint64 key) const;
+    QString indexFileName() const;
+    void loadIndex();
+    void saveIndex();
+    void buildIndex();
+    void appendToIndex(quint64 key, qint64 size, qint64 time);
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
     qint64 maximumCacheSize;
     qint64 currentCacheSize;
 
+    QHash<quint64, IndexEntry> index;
+    bool indexLoaded;
+    QSharedPointer<QNetworkDiskCacheRemover> remover;
+
     QHash<QIODevice*, QCacheItem*> inserting;
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
 
+Q_DECLARE_TYPEINFO(QNetworkDiskCachePrivate::IndexEntry, Q_PRIMITIVE_TYPE);
+
 QT_END_NAMESPACE
 
 #endif // QNETWORKDISKCACHE_P_H
@@ -57,6 +57,13 @@
 #include "QtCore/qcoreapplication.h"
 
 #include <QtCore/private/qthread_p.h>
+#ifdef Q_OS_UNIX
+#include <QtCore/private/qcore_unix_p.h>
+#endif
+#include "QtCore/qfile.h"
+#if QT_CONFIG(temporaryfile)
+#include "QtCore/qtemporaryfile.h"
+#endif
 
 #include "qnetworkcookiejar.h"
 #include "qnetconmonitor_p.h"
@@ -610,12 +617,19 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     Q_Q(QNetworkReplyHttpImpl);
 
     QThread *thread = nullptr;
+    bool sharedConnection = false;
     if (synchronous) {
         // A synchronous HTTP request uses its own thread
         thread = new QThread();
         thread->setObjectName(QStringLiteral("Qt HTTP synchronous thread"));
         QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
         thread->start();
+    } else if (newHttpRequest.attribute(QNetworkRequest::Http2SharedConnectionAttribute).toBool()
+               && (newHttpRequest.attribute(QNetworkRequest::Http2AllowedAttribute).toBool()
+                   || newHttpRequest.attribute(QNetworkRequest::Http2DirectAttribute).toBool())) {
+        // The connections of this thread are shared by all managers.
+        thread = QNetworkAccessManagerPrivate::sharedHttpThread();
+        sharedConnection = true;
     } else {
         // We use the manager-global thread.
         // At some point we could switch to having multiple threads if it makes sense.
@@ -788,6 +802,7 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     QHttpThreadDelegate *delegate = new QHttpThreadDelegate;
     // Propagate Http/2 settings:
     delegate->http2Parameters = request.http2Configuration();
+    delegate->sharedConnection = sharedConnection;
 
     // For the synchronous HTTP, this is the normal way the delegate gets deleted
     // For the asynchronous HTTP this is a safety measure, the delegate deletes itself when HTTP is finished
@@ -930,6 +945,28 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
         }
     }
 
+#ifdef Q_OS_UNIX
+    // A body read from a file can be sent straight from the file, without
+    // copying it through the upload device. The descriptor is duplicated
+    // so the HTTP thread never uses one the user may close meanwhile.
+    if (uploadByteDevice && !outgoingDataBuffer) {
+        // not for subclasses, which may provide other data than the file holds
+        const QMetaObject *metaObject = outgoingData ? outgoingData->metaObject() : nullptr;
+        const bool isPlainFile = metaObject == &QFile::staticMetaObject
+#if QT_CONFIG(temporaryfile)
+                || metaObject == &QTemporaryFile::staticMetaObject
+#endif
+                ;
+        QFile *file = isPlainFile ? static_cast<QFile *>(outgoingData) : nullptr;
+        if (file && !file->isSequential() && file->handle() != -1 && !file->bytesToWrite()) {
+            const int descriptor = qt_safe_dup(file->handle());
+            if (descriptor != -1) {
+                delegate->httpRequest.setUploadFile(
+                        QSharedPointer<QHttpNetworkUploadFile>::create(descriptor, file->pos()));
+            }
+        }
+    }
+#endif
 
     // Move the delegate to the http thread
     delegate->moveToThread(thread);
@@ -319,6 +319,23 @@ QT_BEGIN_NAMESPACE
         the QNetworkReply after having emitted "finished".
         (This value was introduced in 5.14.)
 
+    \value Http2SharedConnectionAttribute
+        Requests only, type: QMetaType::Bool (default: false)
+        If set together with Http2AllowedAttribute or Http2DirectAttribute,
+        the request is sent over a connection that is shared by all
+        QNetworkAccessManager instances in the application, instead of
+        over one owned by the manager that sends it. Requests to the same
+        host and port, through the same proxy, and with equal SSL and
+        HTTP/2 configurations are multiplexed over one HTTP/2 session, so
+        an application using many managers, for instance one per worker
+        thread, needs a single TLS handshake and socket per server.
+        A connection set up for another manager is only used once it has
+        switched to HTTP/2, since HTTP/1.1 connections add the credentials
+        of earlier requests to the following ones.
+        Shared connections are not affected by
+        QNetworkAccessManager::clearConnectionCache().
+        (This value was introduced in 6.0.)
+
     \value User
         Special type. Additional information can be passed in
         QVariants with types ranging from User to UserMax. The default
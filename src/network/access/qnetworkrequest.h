@@ -97,6 +97,7 @@ public:
         Http2DirectAttribute,
         ResourceTypeAttribute, // internal
         AutoDeleteReplyOnFinishAttribute,
+        Http2SharedConnectionAttribute,
 
         User = 1000,
         UserMax = 32767
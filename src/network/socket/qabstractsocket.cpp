@@ -480,6 +480,9 @@
 #include <qvarlengtharray.h>
 
 #include <private/qthread_p.h>
+#ifdef Q_OS_UNIX
+#include <private/qcore_unix_p.h>
+#endif
 
 #ifdef QABSTRACTSOCKET_DEBUG
 #include <qdebug.h>
@@ -500,6 +503,12 @@
 QT_BEGIN_NAMESPACE
 
 static const int DefaultConnectTimeout = 30000;
+// The most chunks of the write buffer that writeToSocket() hands to the
+// socket engine at once.
+static const int MaxWriteBlocks = 16;
+// Files queued with writeFile() go out in slices of at most this size, so
+// that bytesWritten() keeps coming while a large file is sent.
+static const qint64 MaxSendFileSlice = 256 * 1024;
 
 #if defined QABSTRACTSOCKET_DEBUG
 QT_BEGIN_INCLUDE_NAMESPACE
@@ -567,6 +576,10 @@ QAbstractSocketPrivate::QAbstractSocketPrivate()
       peerPort(0),
       socketEngine(nullptr),
       cachedSocketDescriptor(-1),
+      sendFileDescriptor(-1),
+      sendFileOffset(0),
+      sendFileSize(0),
+      sendFilePrecedingBytes(0),
       readBufferMaxSize(0),
       isBuffered(false),
       hasPendingData(false),
@@ -587,6 +600,7 @@ QAbstractSocketPrivate::QAbstractSocketPrivate()
 */
 QAbstractSocketPrivate::~QAbstractSocketPrivate()
 {
+    clearPendingFile();
 }
 
 /*! \internal
@@ -600,6 +614,7 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+    clearPendingFile();
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -826,7 +841,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (!hasPendingWrites()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -844,11 +859,32 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    const bool sendingFile = sendFileSize > 0 && sendFilePrecedingBytes == 0;
+    qint64 written;
+    if (sendingFile) {
+        written = socketEngine->sendFile(sendFileDescriptor, sendFileOffset,
+                                         qMin(sendFileSize, MaxSendFileSlice));
+    } else {
+        // Gather the chunks of the write buffer, so that several of them
+        // go out with one system call.
+        const qint64 size = sendFileSize > 0 ? sendFilePrecedingBytes : writeBuffer.size();
+        QVarLengthArray<QByteArrayView, MaxWriteBlocks> blocks;
+        for (qint64 pos = 0; pos < size && blocks.size() < MaxWriteBlocks;) {
+            qint64 length;
+            const char *ptr = writeBuffer.readPointerAtPosition(pos, length);
+            length = qMin(length, size - pos);
+            blocks.append(QByteArrayView(ptr, length));
+            pos += length;
+        }
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+        // Attempt to write it all in one chunk.
+        if (blocks.size() > 1)
+            written = socketEngine->writeBlocks(blocks.constData(), blocks.size());
+        else if (blocks.size() == 1)
+            written = socketEngine->write(blocks.first().data(), blocks.first().size());
+        else
+            written = 0;
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -866,14 +902,23 @@ bool QAbstractSocketPrivate::writeToSocket()
 #endif
 
     if (written > 0) {
-        // Remove what we wrote so far.
-        writeBuffer.free(written);
+        if (sendingFile) {
+            sendFileOffset += written;
+            sendFileSize -= written;
+            if (sendFileSize == 0)
+                clearPendingFile();
+        } else {
+            // Remove what we wrote so far.
+            writeBuffer.free(written);
+            if (sendFileSize > 0)
+                sendFilePrecedingBytes -= written;
+        }
 
         // Emit notifications.
         emitBytesWritten(written);
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -891,12 +936,63 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || sendFileSize > 0) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
 }
 
+/*! \internal
+
+    Queues \a size bytes of the file \a fileDescriptor, starting at
+    \a offset, to be sent after the data already written to the socket.
+    The socket engine sends them straight from the file, so they are
+    never copied into the write buffer. The descriptor is duplicated;
+    the caller can close its own one at any time.
+
+    Returns \c false, queuing nothing, if the socket engine cannot send
+    files or a file is queued already; the caller then has to write the
+    data itself.
+*/
+bool QAbstractSocketPrivate::writeFile(qintptr fileDescriptor, qint64 offset, qint64 size)
+{
+#ifdef Q_OS_UNIX
+    if (state != QAbstractSocket::ConnectedState || sendFileDescriptor != -1 || size <= 0
+        || !socketEngine || !socketEngine->supportsSendFile()) {
+        return false;
+    }
+    sendFileDescriptor = qt_safe_dup(int(fileDescriptor));
+    if (sendFileDescriptor == -1)
+        return false;
+    sendFileOffset = offset;
+    sendFileSize = size;
+    sendFilePrecedingBytes = writeBuffer.size();
+    socketEngine->setWriteNotificationEnabled(true);
+    return true;
+#else
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(size);
+    return false;
+#endif
+}
+
+/*! \internal
+
+    Drops the file data queued with writeFile() that was not sent yet.
+*/
+void QAbstractSocketPrivate::clearPendingFile()
+{
+#ifdef Q_OS_UNIX
+    if (sendFileDescriptor != -1)
+        qt_safe_close(int(sendFileDescriptor));
+#endif
+    sendFileDescriptor = -1;
+    sendFileOffset = 0;
+    sendFileSize = 0;
+    sendFilePrecedingBytes = 0;
+}
+
 #ifndef QT_NO_NETWORKPROXY
 /*! \internal
 
@@ -1774,7 +1870,8 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    Q_D(const QAbstractSocket);
+    const qint64 pendingBytes = QIODevice::bytesToWrite() + d->sendFileSize;
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -2200,7 +2297,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2252,7 +2349,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (!d->hasPendingWrites())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2269,7 +2366,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  d->hasPendingWrites(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2349,7 +2446,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2469,7 +2566,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     }
 
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && !d->hasPendingWrites()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2700,7 +2797,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
-            || d->socketEngine->bytesToWrite() > 0)) {
+            || d->sendFileSize > 0 || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined(QABSTRACTSOCKET_DEBUG)
@@ -118,6 +118,13 @@ public:
     QAbstractSocketEngine *socketEngine;
     qintptr cachedSocketDescriptor;
 
+    // File data queued with writeFile(), sent once the first
+    // sendFilePrecedingBytes bytes of the write buffer are out
+    qintptr sendFileDescriptor;
+    qint64 sendFileOffset;
+    qint64 sendFileSize;
+    qint64 sendFilePrecedingBytes;
+
 #ifndef QT_NO_NETWORKPROXY
     QNetworkProxy proxy;
     QNetworkProxy proxyInUse;
@@ -131,6 +138,10 @@ public:
     void resetSocketLayer();
     virtual bool flush();
 
+    bool writeFile(qintptr fileDescriptor, qint64 offset, qint64 size);
+    void clearPendingFile();
+    inline bool hasPendingWrites() const { return !writeBuffer.isEmpty() || sendFileSize > 0; }
+
     bool initSocketLayer(QAbstractSocket::NetworkLayerProtocol protocol);
     virtual void configureCreatedSocket();
     void startConnectingByName(const QString &host);
@@ -128,6 +128,120 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+/*!
+    Writes the \a count blocks of data in \a blocks, in order, as if they
+    were one contiguous block. Returns the number of bytes written, which
+    may be less than the total size of the blocks, or -1 if an error
+    occurred.
+
+    The default implementation writes the blocks one by one with write(),
+    stopping at the first one that is not written completely.
+    Reimplementations send all of them with one system call.
+*/
+qint64 QAbstractSocketEngine::writeBlocks(const QByteArrayView *blocks, int count)
+{
+    qint64 written = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 result = write(blocks[i].data(), blocks[i].size());
+        if (result < 0)
+            return written ? written : result;
+        written += result;
+        if (result < blocks[i].size())
+            break;
+    }
+    return written;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a count pending datagrams into \a datagrams, each
+    truncated to \a maxSize bytes, or read completely if \a maxSize is -1.
+    The IP header fields are stored according to the request in \a options.
+    Returns the number of datagrams read, which is 0 if none are pending,
+    or -1 if an error occurred before any datagram was read.
+
+    The default implementation reads one datagram at a time with
+    readDatagram(). Reimplementations receive several of them with one
+    system call.
+*/
+int QAbstractSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams, int count,
+                                         qint64 maxSize, PacketHeaderOptions options)
+{
+    for (int i = 0; i < count; ++i) {
+        if (!hasPendingDatagrams())
+            return i;
+        QNetworkDatagramPrivate *datagram = datagrams[i];
+        const qint64 size = maxSize < 0 ? pendingDatagramSize() : maxSize;
+        if (size < 0)
+            return i;
+        datagram->data.resize(size);
+        const qint64 result = readDatagram(datagram->data.data(), size, &datagram->header,
+                                           options);
+        if (result == -2)   // nothing to read after all
+            return i;
+        if (result < 0)
+            return i ? i : -1;
+        datagram->data.truncate(result);
+    }
+    return count;
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams, each to the destination
+    contained in its header. Returns the number of datagrams sent, which
+    may be less than \a count, or -1 if an error occurred before any
+    datagram was sent.
+
+    The default implementation sends one datagram at a time with
+    writeDatagram(). Reimplementations send several of them with one
+    system call.
+*/
+int QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                          int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const QNetworkDatagramPrivate *datagram = datagrams[i];
+        const qint64 result = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                            datagram->header);
+        if (result == -2)   // the socket cannot take more datagrams now
+            return i;
+        if (result < 0)
+            return i ? i : -1;
+    }
+    return count;
+}
+#endif // QT_NO_UDPSOCKET
+
+/*!
+    Returns \c true if this engine can send data straight from a file with
+    sendFile(). The default implementation returns \c false.
+*/
+bool QAbstractSocketEngine::supportsSendFile() const
+{
+    return false;
+}
+
+/*!
+    Sends up to \a maxSize bytes of the file \a fileDescriptor, starting
+    at \a offset, without copying them into the process first. Returns the
+    number of bytes sent, which is 0 if the socket cannot take more data
+    now, or -1 if an error occurred.
+
+    The default implementation fails with
+    QAbstractSocket::UnsupportedSocketOperationError.
+
+    \sa supportsSendFile()
+*/
+qint64 QAbstractSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize)
+{
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(maxSize);
+    setError(QAbstractSocket::UnsupportedSocketOperationError,
+             QLatin1String("Unsupported socket operation"));
+    return -1;
+}
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
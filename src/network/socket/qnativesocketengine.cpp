@@ -842,6 +842,42 @@ qint64 QNativeSocketEngine::pendingDatagramSize() const
 
     return d->nativePendingDatagramSize();
 }
+/*!
+    \reimp
+
+    On Linux, the datagrams are received with a single recvmmsg() call.
+*/
+int QNativeSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams, int count,
+                                       qint64 maxSize, PacketHeaderOptions options)
+{
+#ifdef Q_OS_LINUX
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    return d->nativeReceiveDatagrams(datagrams, count, maxSize, options);
+#else
+    return QAbstractSocketEngine::readDatagrams(datagrams, count, maxSize, options);
+#endif
+}
+
+/*!
+    \reimp
+
+    On Linux, the datagrams are sent with a single sendmmsg() call.
+*/
+int QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count)
+{
+#ifdef Q_OS_LINUX
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    return d->nativeSendDatagrams(datagrams, count);
+#else
+    return QAbstractSocketEngine::writeDatagrams(datagrams, count);
+#endif
+}
 #endif // QT_NO_UDPSOCKET
 
 /*!
@@ -918,12 +954,60 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    \reimp
+
+    On Unix, the blocks are sent with a single sendmsg() call.
+*/
+qint64 QNativeSocketEngine::writeBlocks(const QByteArrayView *blocks, int count)
+{
+#ifdef Q_OS_UNIX
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeBlocks(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeBlocks(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteBlocks(blocks, count);
+#else
+    return QAbstractSocketEngine::writeBlocks(blocks, count);
+#endif
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
     return 0;
 }
 
+/*!
+    \reimp
+
+    Returns \c true on Linux, where TCP sockets can send file data
+    with sendfile().
+*/
+bool QNativeSocketEngine::supportsSendFile() const
+{
+#ifdef Q_OS_LINUX
+    return socketType() == QAbstractSocket::TcpSocket;
+#else
+    return false;
+#endif
+}
+
+/*!
+    \reimp
+*/
+qint64 QNativeSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize)
+{
+#ifdef Q_OS_LINUX
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -1);
+    return d->nativeSendFile(fileDescriptor, offset, maxSize);
+#else
+    return QAbstractSocketEngine::sendFile(fileDescriptor, offset, maxSize);
+#endif
+}
+
 /*!
     Reads up to \a maxSize bytes into \a data from the socket.
     Returns the number of bytes read, or -1 if an error occurred.
@@ -146,6 +146,7 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 writeBlocks(const QByteArrayView *blocks, int count) override;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -159,6 +160,9 @@ public:
 
     bool hasPendingDatagrams() const override;
     qint64 pendingDatagramSize() const override;
+    int readDatagrams(QNetworkDatagramPrivate *const *datagrams, int count,
+                      qint64 maxSize, PacketHeaderOptions options = WantNone) override;
+    int writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count) override;
 #endif // QT_NO_UDPSOCKET
 
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
@@ -166,6 +170,9 @@ public:
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
     qint64 bytesToWrite() const override;
 
+    bool supportsSendFile() const override;
+    qint64 sendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize) override;
+
 #if 0   // currently unused
     qint64 receiveBufferSize() const;
     void setReceiveBufferSize(qint64 bufferSize);
@@ -279,6 +286,21 @@ public:
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifdef Q_OS_UNIX
+    qint64 nativeWriteBlocks(const QByteArrayView *blocks, int count);
+    void readDatagramHeader(msghdr *msg, const qt_sockaddr *aa, QIpPacketHeader *header) const;
+    void writeDatagramHeader(msghdr *msg, qt_sockaddr *aa, const QIpPacketHeader &header);
+#endif
+#ifdef Q_OS_LINUX
+    qint64 nativeSendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize);
+    int nativeReceiveDatagrams(QNetworkDatagramPrivate *const *datagrams, int count,
+                               qint64 maxSize, QAbstractSocketEngine::PacketHeaderOptions options);
+    int nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count);
+
+    // receive buffer shared by the datagrams of one nativeReceiveDatagrams()
+    // call; only kept between calls while it is small
+    QByteArray datagramBuffer;
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
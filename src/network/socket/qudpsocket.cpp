@@ -102,6 +102,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -431,6 +432,86 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.0
+
+    Sends the datagrams in \a datagrams, each to the host address and port
+    number contained in it, like writeDatagram() does. Where the operating
+    system supports it, several datagrams are passed to it at once, which is
+    considerably faster than calling writeDatagram() for each of them.
+
+    Returns the number of datagrams sent, which is less than the size of
+    \a datagrams if the socket's send buffer became full, or -1 if an error
+    occurred before any datagram was sent. The bytesWritten() signal is
+    emitted once, with the total size of the datagrams that were sent.
+
+    Sending also stops before the first datagram whose destination the
+    socket cannot reach, such as an IPv6 address if the socket is bound to
+    an IPv4 address. Passing that datagram first fails with
+    QAbstractSocket::UnsupportedSocketOperationError.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld)", qint64(datagrams.size()));
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.first().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    // the socket was set up for the first datagram; the others must be for
+    // the same network layer protocol, unless the socket handles both
+    const NetworkLayerProtocol protocol = d->socketEngine->protocol();
+    const bool checkProtocol = protocol == IPv4Protocol || protocol == IPv6Protocol;
+    qsizetype sendable = 0;
+    for (; sendable < datagrams.size(); ++sendable) {
+        const NetworkLayerProtocol destinationProtocol = datagrams.at(sendable).destinationAddress().protocol();
+        if (checkProtocol && destinationProtocol != UnknownNetworkLayerProtocol
+                && destinationProtocol != protocol) {
+            break;
+        }
+    }
+    if (!sendable) {
+        d->setErrorAndEmit(QAbstractSocket::UnsupportedSocketOperationError,
+                           tr("Unable to send a datagram"));
+        return -1;
+    }
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> batch(sendable);
+    for (qsizetype i = 0; i < sendable; ++i)
+        batch[i] = datagrams.at(i).d;
+
+    qsizetype sent = 0;
+    while (sent < sendable) {
+        const int count = int(qMin(sendable - sent, qsizetype(INT_MAX)));
+        const int result = d->socketEngine->writeDatagrams(batch.constData() + sent, count);
+        if (result < 0) {
+            if (!sent)
+                sent = -1;
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+            break;
+        }
+        sent += result;
+        if (result < count)
+            break;
+    }
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent > 0) {
+        qint64 bytes = 0;
+        for (qsizetype i = 0; i < sent; ++i)
+            bytes += batch[i]->data.size();
+        emit bytesWritten(bytes);
+    }
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -476,6 +557,62 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.0
+
+    Receives up to \a maxCount pending datagrams, each no larger than
+    \a maxSize bytes, and returns them along with their sender's host
+    address and port and, if possible, their destination address, port and
+    hop count, like receiveDatagram() does. Where the operating system
+    supports it, several datagrams are received at once, which is
+    considerably faster than calling receiveDatagram() for each of them.
+
+    Returns an empty list if no datagram is pending or if an error
+    occurred. If \a maxSize is too small, the rest of each datagram will be
+    lost. If \a maxSize is -1 (the default), this function will attempt to
+    read the entire datagrams.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(qsizetype maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%lld, %lld)", qint64(maxCount), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    // the datagrams are received in batches, so that a large maxCount does
+    // not allocate many datagrams that are then left empty
+    const int batchSize = 64;
+    QList<QNetworkDatagram> result;
+    QVarLengthArray<QNetworkDatagramPrivate *, batchSize> batch;
+    while (result.size() < maxCount) {
+        const qsizetype offset = result.size();
+        const int count = int(qMin(maxCount - offset, qsizetype(batchSize)));
+        result.resize(offset + count);
+        batch.resize(count);
+        for (int i = 0; i < count; ++i)
+            batch[i] = result[offset + i].d;
+
+        const int received = d->socketEngine->readDatagrams(batch.data(), count, maxSize,
+                                                            QAbstractSocketEngine::WantAll);
+        if (received < 0) {
+            result.resize(offset);
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+            break;
+        }
+        result.resize(offset + received);
+        if (received < count)
+            break;
+    }
+
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
@@ -42,6 +42,7 @@
 #include <qcoreapplication.h>
 #include <qvariant.h>
 #include <qdatetime.h>
+#include <qendian.h>
 #include <qregularexpression.h>
 #include <qsqlerror.h>
 #include <qsqlfield.h>
@@ -51,6 +52,7 @@
 #include <qsocketnotifier.h>
 #include <qstringlist.h>
 #include <qlocale.h>
+#include <QtSql/private/qsqlcolumnbatch_p.h>
 #include <QtSql/private/qsqlresult_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <QtCore/private/qlocale_tools_p.h>
@@ -82,6 +84,10 @@
 #define QREGPROCOID 24
 #define QXIDOID 28
 #define QCIDOID 29
+#define QNAMEOID 19
+#define QTEXTOID 25
+#define QBPCHAROID 1042
+#define QVARCHAROID 1043
 
 #define QBITOID 1560
 #define QVARBITOID 1562
@@ -134,6 +140,7 @@ protected:
     bool fetchLast() override;
     bool fetchNext() override;
     bool nextResult() override;
+    bool fetchBatch(QSqlColumnBatch *batch, int maxRows) override;
     QVariant data(int i) override;
     bool isNull(int field) override;
     bool reset(const QString &query) override;
@@ -143,6 +150,7 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind = false) override;
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -160,11 +168,21 @@ public:
     mutable bool pendingNotifyCheck = false;
     bool hasBackslashEscape = false;
     bool isUtf8 = false;
+    bool hasIntegerDatetimes = false;
+    bool binaryResultsEnabled = false;
+    bool pipelinedBatchEnabled = false;
 
     void appendTables(QStringList &tl, QSqlQuery &t, QChar type);
     PGresult *exec(const char *stmt);
     PGresult *exec(const QString &stmt);
-    StatementId sendQuery(const QString &stmt);
+    PGresult *prepare(const QString &stmtId, const QString &stmt, PGresult **description);
+    StatementId sendQuery(const QString &stmt, int resultFormat = 0);
+#if defined(LIBPQ_HAS_PIPELINING)
+    bool sendPipelined(const QString &stmt, int resultFormat = 0);
+    PGresult *getPipelineResult();
+    void syncPipeline();
+    void exitPipelineMode();
+#endif
     bool setSingleRowMode() const;
     PGresult *getResult(StatementId stmtId) const;
     void finishQuery(StatementId stmtId);
@@ -212,17 +230,91 @@ PGresult *QPSQLDriverPrivate::exec(const QString &stmt)
     return exec((isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit()).constData());
 }
 
-StatementId QPSQLDriverPrivate::sendQuery(const QString &stmt)
+PGresult *QPSQLDriverPrivate::prepare(const QString &stmtId, const QString &stmt,
+                                      PGresult **description)
+{
+    *description = nullptr;
+#if defined(LIBPQ_HAS_PIPELINING)
+    // Ask for the description of the new statement in the same round trip,
+    // so that exec() knows whether its results can be fetched in binary.
+    discardResults();
+    if (binaryResultsEnabled && PQenterPipelineMode(connection)) {
+        const bool sent = sendPipelined(stmt)
+                && PQsendDescribePrepared(connection, stmtId.toLatin1().constData());
+        syncPipeline();
+        PGresult *result = sent ? getPipelineResult() : nullptr;
+        if (result)
+            *description = getPipelineResult();
+        exitPipelineMode();
+        currentStmtId = result ? generateStatementId() : InvalidStatementId;
+        checkPendingNotifications();
+        if (result)
+            return result;
+    }
+#else
+    Q_UNUSED(stmtId);
+#endif
+    return exec(stmt);
+}
+
+StatementId QPSQLDriverPrivate::sendQuery(const QString &stmt, int resultFormat)
 {
     // Discard any prior query results that the application didn't eat.
     // This is required for PQsendQuery()
     discardResults();
-    const int result = PQsendQuery(connection,
-                                   (isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit()).constData());
+    const QByteArray query = isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit();
+    // Only the extended protocol can return binary results, but it is
+    // limited to a single statement per query.
+    const int result = resultFormat == 0
+            ? PQsendQuery(connection, query.constData())
+            : PQsendQueryParams(connection, query.constData(), 0, nullptr, nullptr,
+                                nullptr, nullptr, resultFormat);
     currentStmtId = result ? generateStatementId() : InvalidStatementId;
     return currentStmtId;
 }
 
+#if defined(LIBPQ_HAS_PIPELINING)
+// Queues 'stmt' on a connection in pipeline mode. Its result is read with
+// getPipelineResult() after the next syncPipeline().
+bool QPSQLDriverPrivate::sendPipelined(const QString &stmt, int resultFormat)
+{
+    const QByteArray query = isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit();
+    return PQsendQueryParams(connection, query.constData(), 0, nullptr, nullptr,
+                             nullptr, nullptr, resultFormat);
+}
+
+// Returns the result of the next query in the pipeline, in the order the
+// queries were sent. Queries following a failed one until the next sync
+// point report PGRES_PIPELINE_ABORTED.
+PGresult *QPSQLDriverPrivate::getPipelineResult()
+{
+    PGresult *result = PQgetResult(connection);
+    if (result && PQresultStatus(result) != PGRES_PIPELINE_SYNC) {
+        // Skip the end marker of this query
+        while (PGresult *next = PQgetResult(connection))
+            PQclear(next);
+    }
+    return result;
+}
+
+void QPSQLDriverPrivate::syncPipeline()
+{
+    PQpipelineSync(connection);
+}
+
+void QPSQLDriverPrivate::exitPipelineMode()
+{
+    // Consume whatever the caller didn't read, up to and including the last
+    // sync point; libpq refuses to leave pipeline mode before that.
+    while (!PQexitPipelineMode(connection)) {
+        PGresult *result = PQgetResult(connection);
+        if (!result && !(result = PQgetResult(connection)))
+            break;
+        PQclear(result);
+    }
+}
+#endif
+
 bool QPSQLDriverPrivate::setSingleRowMode() const
 {
     // Activates single-row mode for last sent query, see:
@@ -292,6 +384,11 @@ public:
 
     QString fieldSerial(int i) const override { return QLatin1Char('$') + QString::number(i + 1); }
     void deallocatePreparedStmt();
+    void appendRow(QSqlColumnBatchPrivate *batch, int row);
+    QVariant binaryValue(int row, int column) const;
+#if defined(LIBPQ_HAS_PIPELINING)
+    bool execBatchPipelined();
+#endif
 
     std::queue<PGresult*> nextResultSets;
     QString preparedStmtId;
@@ -299,9 +396,13 @@ public:
     StatementId stmtId = InvalidStatementId;
     int currentSize = -1;
     bool canFetchMoreRows = false;
+    // the result holds all rows of its result set, even in forward-only mode
+    bool allRowsFetched = false;
     bool preparedQueriesEnabled = false;
+    bool binaryResults = false;
 
     bool processResults();
+    int currentRow() const;
 };
 
 static QSqlError qMakeError(const QString &err, QSqlError::ErrorType type,
@@ -337,7 +438,7 @@ bool QPSQLResultPrivate::processResults()
     case PGRES_TUPLES_OK:
         q->setSelect(true);
         q->setActive(true);
-        currentSize = q->isForwardOnly() ? -1 : PQntuples(result);
+        currentSize = q->isForwardOnly() && !allRowsFetched ? -1 : PQntuples(result);
         canFetchMoreRows = false;
         return true;
     case PGRES_SINGLE_TUPLE:
@@ -364,6 +465,13 @@ bool QPSQLResultPrivate::processResults()
     return false;
 }
 
+// Returns the row of 'result' that holds the current row of the query
+int QPSQLResultPrivate::currentRow() const
+{
+    Q_Q(const QPSQLResult);
+    return q->isForwardOnly() && !allRowsFetched ? 0 : q->at();
+}
+
 static QVariant::Type qDecodePSQLType(int t)
 {
     QVariant::Type type = QVariant::Invalid;
@@ -410,6 +518,90 @@ static QVariant::Type qDecodePSQLType(int t)
     return type;
 }
 
+// Returns whether all columns of a statement described by 'description' can
+// be fetched in the binary result format, see QPSQLResultPrivate::binaryValue().
+static bool qCanFetchBinary(const PGresult *description, bool hasIntegerDatetimes)
+{
+    const int count = PQnfields(description);
+    for (int i = 0; i < count; ++i) {
+        switch (PQftype(description, i)) {
+        case QBOOLOID:
+        case QINT2OID:
+        case QINT4OID:
+        case QINT8OID:
+        case QFLOAT8OID:
+        case QNUMERICOID:
+        case QDATEOID:
+        case QBYTEAOID:
+        case QNAMEOID:
+        case QTEXTOID:
+        case QBPCHAROID:
+        case QVARCHAROID:
+            break;
+        case QTIMEOID:
+        case QTIMESTAMPOID:
+        case QTIMESTAMPTZOID:
+            // Servers built without integer datetimes send them as doubles
+            if (!hasIntegerDatetimes)
+                return false;
+            break;
+        default:
+            return false;
+        }
+    }
+    return count > 0;
+}
+
+static void qAppendNumericDigits(QByteArray *str, int digit, int count)
+{
+    const char digits[4] = { char('0' + digit / 1000), char('0' + digit / 100 % 10),
+                             char('0' + digit / 10 % 10), char('0' + digit % 10) };
+    str->append(digits, count);
+}
+
+// Converts a NUMERIC in the binary format of the server to the same text the
+// server sends in the text format. The value consists of base 10000 digits,
+// the first of them being multiplied by 10000^weight.
+static QByteArray qNumericToString(const char *val, int len)
+{
+    if (len < 8)
+        return QByteArray();
+    const int ndigits = qFromBigEndian<qint16>(val);
+    const int weight = qFromBigEndian<qint16>(val + 2);
+    const quint16 sign = qFromBigEndian<quint16>(val + 4);
+    const int dscale = qFromBigEndian<qint16>(val + 6);
+    if (ndigits < 0 || len < 8 + 2 * ndigits)
+        return QByteArray();
+
+    switch (sign) {
+    case 0xC000:
+        return QByteArrayLiteral("NaN");
+    case 0xD000:
+        return QByteArrayLiteral("Infinity");
+    case 0xF000:
+        return QByteArrayLiteral("-Infinity");
+    }
+
+    const auto digit = [&](int i) {
+        return i >= 0 && i < ndigits ? int(qFromBigEndian<qint16>(val + 8 + 2 * i)) : 0;
+    };
+    QByteArray str;
+    if (sign == 0x4000)
+        str += '-';
+    if (weight < 0)
+        str += '0';
+    else
+        str += QByteArray::number(digit(0));
+    for (int i = 1; i <= weight; ++i)
+        qAppendNumericDigits(&str, digit(i), 4);
+    if (dscale > 0) {
+        str += '.';
+        for (int i = weight + 1, scale = dscale; scale > 0; ++i, scale -= 4)
+            qAppendNumericDigits(&str, digit(i), qMin(scale, 4));
+    }
+    return str;
+}
+
 void QPSQLResultPrivate::deallocatePreparedStmt()
 {
     if (drv_d_func()) {
@@ -463,6 +655,7 @@ void QPSQLResult::cleanup()
     setAt(QSql::BeforeFirstRow);
     d->currentSize = -1;
     d->canFetchMoreRows = false;
+    d->allRowsFetched = false;
     setActive(false);
 }
 
@@ -548,7 +741,7 @@ bool QPSQLResult::fetchNext()
     if (currentRow == QSql::AfterLastRow)
         return false;
 
-    if (isForwardOnly()) {
+    if (isForwardOnly() && !d->allRowsFetched) {
         if (!d->canFetchMoreRows)
             return false;
         PQclear(d->result);
@@ -623,6 +816,23 @@ bool QPSQLResult::nextResult()
     return d->processResults();
 }
 
+static bool qConvertToDouble(const char *val, double *dbl)
+{
+    bool ok;
+    *dbl = qstrtod(val, nullptr, &ok);
+    if (!ok) {
+        if (qstricmp(val, "NaN") == 0)
+            *dbl = qQNaN();
+        else if (qstricmp(val, "Infinity") == 0)
+            *dbl = qInf();
+        else if (qstricmp(val, "-Infinity") == 0)
+            *dbl = -qInf();
+        else
+            return false;
+    }
+    return true;
+}
+
 QVariant QPSQLResult::data(int i)
 {
     Q_D(const QPSQLResult);
@@ -630,11 +840,13 @@ QVariant QPSQLResult::data(int i)
         qWarning("QPSQLResult::data: column %d out of range", i);
         return QVariant();
     }
-    const int currentRow = isForwardOnly() ? 0 : at();
+    const int currentRow = d->currentRow();
     int ptype = PQftype(d->result, i);
     QVariant::Type type = qDecodePSQLType(ptype);
     if (PQgetisnull(d->result, currentRow, i))
         return QVariant(QMetaType(type), nullptr);
+    if (PQfformat(d->result, i) == 1)
+        return d->binaryValue(currentRow, i);
     const char *val = PQgetvalue(d->result, currentRow, i);
     switch (type) {
     case QVariant::Bool:
@@ -653,18 +865,9 @@ QVariant QPSQLResult::data(int i)
             if (numericalPrecisionPolicy() == QSql::HighPrecision)
                 return QString::fromLatin1(val);
         }
-        bool ok;
-        double dbl = qstrtod(val, nullptr, &ok);
-        if (!ok) {
-            if (qstricmp(val, "NaN") == 0)
-                dbl = qQNaN();
-            else if (qstricmp(val, "Infinity") == 0)
-                dbl = qInf();
-            else if (qstricmp(val, "-Infinity") == 0)
-                dbl = -qInf();
-            else
-                return QVariant();
-        }
+        double dbl;
+        if (!qConvertToDouble(val, &dbl))
+            return QVariant();
         if (ptype == QNUMERICOID) {
             if (numericalPrecisionPolicy() == QSql::LowPrecisionInt64)
                 return QVariant((qlonglong)dbl);
@@ -708,10 +911,169 @@ QVariant QPSQLResult::data(int i)
     return QVariant();
 }
 
+// Decodes a field fetched in the binary result format into the same value
+// that data() returns for the text format.
+QVariant QPSQLResultPrivate::binaryValue(int row, int column) const
+{
+    const char *val = PQgetvalue(result, row, column);
+    const int len = PQgetlength(result, row, column);
+    const int ptype = PQftype(result, column);
+    switch (ptype) {
+    case QBOOLOID:
+        return QVariant(val[0] != 0);
+    case QINT2OID:
+        return int(qFromBigEndian<qint16>(val));
+    case QINT4OID:
+        return int(qFromBigEndian<qint32>(val));
+    case QINT8OID: {
+        // the text format is converted the same way, see QPSQLResult::data()
+        const qint64 value = qFromBigEndian<qint64>(val);
+        if (value < 0)
+            return qlonglong(value);
+        return qulonglong(value);
+    }
+    case QFLOAT8OID:
+        return qFromBigEndian<double>(val);
+    case QNUMERICOID: {
+        const QByteArray str = qNumericToString(val, len);
+        if (precisionPolicy == QSql::HighPrecision)
+            return QString::fromLatin1(str);
+        double dbl;
+        if (str.isEmpty() || !qConvertToDouble(str.constData(), &dbl))
+            return QVariant();
+        if (precisionPolicy == QSql::LowPrecisionInt64)
+            return QVariant((qlonglong)dbl);
+        else if (precisionPolicy == QSql::LowPrecisionInt32)
+            return QVariant((int)dbl);
+        return QVariant(dbl);
+    }
+    case QDATEOID: {
+        // Days since 2000-01-01; the extremes stand for -infinity and infinity
+        const qint32 days = qFromBigEndian<qint32>(val);
+        if (days == std::numeric_limits<qint32>::min() || days == std::numeric_limits<qint32>::max())
+            return QVariant(QDate());
+        return QVariant(QDate(2000, 1, 1).addDays(days));
+    }
+    case QTIMEOID: {
+        // Microseconds since midnight, rounded to milliseconds like QTime::fromString()
+        const qint64 msecs = (qFromBigEndian<qint64>(val) + 500) / 1000;
+        return QVariant(QTime::fromMSecsSinceStartOfDay(int(qMin(msecs, qint64(86399999)))));
+    }
+    case QTIMESTAMPOID:
+    case QTIMESTAMPTZOID: {
+        // Microseconds since 2000-01-01 00:00, UTC for TIMESTAMPTZ
+        const qint64 usecs = qFromBigEndian<qint64>(val);
+        if (usecs == std::numeric_limits<qint64>::min() || usecs == std::numeric_limits<qint64>::max())
+            return QVariant(QDateTime());
+        const qint64 msecsPerDay = 86400000;
+        qint64 msecs = (usecs + 500) / 1000;
+        if ((usecs + 500) % 1000 < 0)
+            --msecs;
+        qint64 days = msecs / msecsPerDay;
+        if (msecs % msecsPerDay < 0)
+            --days;
+        const QDate date = QDate(2000, 1, 1).addDays(days);
+        const QTime time = QTime::fromMSecsSinceStartOfDay(int(msecs - days * msecsPerDay));
+        if (ptype == QTIMESTAMPOID)
+            return QVariant(QDateTime(date, time));
+        return QVariant(QDateTime(date, time, Qt::UTC).toLocalTime());
+    }
+    case QBYTEAOID:
+        return QVariant(QByteArray(val, len));
+    default:
+        break;
+    }
+    // The text types are sent as is in both formats
+    return drv_d_func()->isUtf8 ? QString::fromUtf8(val, len) : QString::fromLatin1(val, len);
+}
+
+bool QPSQLResult::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    Q_D(QPSQLResult);
+    QSqlColumnBatchPrivate *b = QSqlColumnBatchPrivate::get(batch);
+    b->reset(record(), maxRows);
+    while (b->rowCount < maxRows) {
+        bool fetched = false;
+        if (at() == QSql::BeforeFirstRow)
+            fetched = fetchFirst();
+        else if (at() != QSql::AfterLastRow)
+            fetched = fetchNext();
+        if (!fetched) {
+            setAt(QSql::AfterLastRow);
+            break;
+        }
+        d->appendRow(b, d->currentRow());
+    }
+    return b->rowCount > 0;
+}
+
+// Converts the values of 'row' directly into the typed columns of 'batch'.
+// Values that the fast path can't convert exactly go through data(), so
+// that they are stored the same as value() returns them.
+void QPSQLResultPrivate::appendRow(QSqlColumnBatchPrivate *batch, int row)
+{
+    Q_Q(QPSQLResult);
+    for (int i = 0; i < batch->columns.count(); ++i) {
+        if (PQgetisnull(result, row, i)) {
+            batch->appendNull(i);
+            continue;
+        }
+        if (PQfformat(result, i) == 1) {
+            batch->appendValue(i, binaryValue(row, i));
+            continue;
+        }
+        const char *val = PQgetvalue(result, row, i);
+        switch (batch->columns.at(i).type) {
+        case QSqlColumnBatch::Int64Column: {
+            if (PQftype(result, i) == QBOOLOID) {
+                batch->appendInt64(i, val[0] == 't');
+                continue;
+            }
+            bool ok;
+            const qint64 value = QByteArray::fromRawData(val, qstrlen(val)).toLongLong(&ok);
+            if (!ok)
+                break;
+            batch->appendInt64(i, value);
+            continue;
+        }
+        case QSqlColumnBatch::DoubleColumn: {
+            // data() applies the numerical precision policy to NUMERIC
+            if (PQftype(result, i) == QNUMERICOID
+                && q->numericalPrecisionPolicy() != QSql::LowPrecisionDouble) {
+                break;
+            }
+            double dbl;
+            if (!qConvertToDouble(val, &dbl)) {
+                // keep the text rather than losing the value
+                batch->appendValue(i, QString::fromLatin1(val));
+                continue;
+            }
+            batch->appendDouble(i, dbl);
+            continue;
+        }
+        case QSqlColumnBatch::StringColumn:
+            batch->appendString(i, drv_d_func()->isUtf8 ? QString::fromUtf8(val)
+                                                        : QString::fromLatin1(val));
+            continue;
+        case QSqlColumnBatch::ByteArrayColumn: {
+            size_t len;
+            unsigned char *data = PQunescapeBytea(reinterpret_cast<const unsigned char *>(val), &len);
+            batch->appendByteArray(i, QByteArray(reinterpret_cast<const char *>(data), int(len)));
+            qPQfreemem(data);
+            continue;
+        }
+        case QSqlColumnBatch::VariantColumn:
+            break;
+        }
+        batch->appendValue(i, q->data(i));
+    }
+    batch->finishRow();
+}
+
 bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
-    const int currentRow = isForwardOnly() ? 0 : at();
+    const int currentRow = d->currentRow();
     return PQgetisnull(d->result, currentRow, field);
 }
 
@@ -882,6 +1244,7 @@ bool QPSQLResult::prepare(const QString &query)
         return QSqlResult::prepare(query);
 
     cleanup();
+    d->binaryResults = false;
 
     if (!d->preparedStmtId.isEmpty())
         d->deallocatePreparedStmt();
@@ -889,17 +1252,22 @@ bool QPSQLResult::prepare(const QString &query)
     const QString stmtId = qMakePreparedStmtId();
     const QString stmt = QStringLiteral("PREPARE %1 AS ").arg(stmtId).append(d->positionalToNamedBinding(query));
 
-    PGresult *result = d->drv_d_func()->exec(stmt);
+    PGresult *description;
+    PGresult *result = d->drv_d_func()->prepare(stmtId, stmt, &description);
 
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
                                 "Unable to prepare statement"), QSqlError::StatementError, d->drv_d_func(), result));
         PQclear(result);
+        PQclear(description);
         d->preparedStmtId.clear();
         return false;
     }
 
     PQclear(result);
+    d->binaryResults = description
+            && qCanFetchBinary(description, d->drv_d_func()->hasIntegerDatetimes);
+    PQclear(description);
     d->preparedStmtId = stmtId;
     return true;
 }
@@ -919,7 +1287,7 @@ bool QPSQLResult::exec()
     else
         stmt = QStringLiteral("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
 
-    d->stmtId = d->drv_d_func()->sendQuery(stmt);
+    d->stmtId = d->drv_d_func()->sendQuery(stmt, d->binaryResults ? 1 : 0);
     if (d->stmtId == InvalidStatementId) {
         setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
                                 "Unable to send query"), QSqlError::StatementError, d->drv_d_func()));
@@ -938,6 +1306,129 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+    Q_D(QPSQLResult);
+    if (d->drv_d_func()->pipelinedBatchEnabled && d->preparedQueriesEnabled
+            && !d->preparedStmtId.isEmpty() && !d->values.isEmpty()) {
+        return d->execBatchPipelined();
+    }
+#endif
+    return QSqlResult::execBatch(arrayBind);
+}
+
+#if defined(LIBPQ_HAS_PIPELINING)
+// Sends the rows of a batch in pipeline mode, without waiting for the result
+// of each of them. The pipeline is synchronized every PipelineBatchSize rows,
+// so that neither side blocks on a full socket buffer.
+bool QPSQLResultPrivate::execBatchPipelined()
+{
+    Q_Q(QPSQLResult);
+    static const int PipelineBatchSize = 256;
+    QPSQLDriverPrivate *driver = drv_d_func();
+
+    q->cleanup();
+    q->setLastError(QSqlError());
+
+    QList<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : qAsConst(values))
+        columns.append(value.toList());
+    const qsizetype rowCount = columns.constFirst().count();
+    for (const QVariantList &column : qAsConst(columns)) {
+        if (column.count() != rowCount) {
+            q->setLastError(QSqlError(QCoreApplication::translate("QPSQLResult",
+                            "Parameter count mismatch"), QString(), QSqlError::StatementError));
+            return false;
+        }
+    }
+
+    if (rowCount == 0)
+        return true;
+
+    // Statements between two sync points run in an implicit transaction of
+    // their own; run all of them in one, so a failing row never leaves part
+    // of the batch applied.
+    driver->discardResults();
+    const bool implicitTransaction = PQtransactionStatus(driver->connection) == PQTRANS_IDLE;
+    if (!PQenterPipelineMode(driver->connection))
+        return q->QSqlResult::execBatch();
+
+    QSqlError error;
+    QList<QVariant> rowValues(columns.count());
+    for (qsizetype first = 0; first < rowCount && !error.isValid(); first += PipelineBatchSize) {
+        const qsizetype last = qMin(first + PipelineBatchSize, rowCount);
+        qsizetype sent = 0;
+        bool ok = true;
+        if (first == 0 && implicitTransaction) {
+            ok = driver->sendPipelined(QStringLiteral("BEGIN"));
+            if (ok)
+                ++sent;
+        }
+        for (qsizetype row = first; ok && row < last; ++row) {
+            for (int i = 0; i < columns.count(); ++i)
+                rowValues[i] = columns.at(i).at(row);
+            const QString params = qCreateParamString(rowValues, q->driver());
+            const QString stmt = params.isEmpty()
+                    ? QStringLiteral("EXECUTE %1").arg(preparedStmtId)
+                    : QStringLiteral("EXECUTE %1 (%2)").arg(preparedStmtId, params);
+            ok = driver->sendPipelined(stmt, binaryResults ? 1 : 0);
+            if (ok)
+                ++sent;
+        }
+        if (!ok) {
+            error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                               "Unable to send query"), QSqlError::StatementError, driver);
+        }
+        driver->syncPipeline();
+
+        for (qsizetype i = 0; i < sent; ++i) {
+            PGresult *next = driver->getPipelineResult();
+            if (!next)
+                break;
+            const int status = PQresultStatus(next);
+            if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK) {
+                PQclear(result);
+                result = next;
+                continue;
+            }
+            if (!error.isValid()) {
+                error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                                   "Unable to execute batch"), QSqlError::StatementError, driver, next);
+            }
+            PQclear(next);
+        }
+        // Consume the sync point
+        PQclear(driver->getPipelineResult());
+    }
+
+    if (implicitTransaction) {
+        driver->sendPipelined(error.isValid() ? QStringLiteral("ROLLBACK") : QStringLiteral("COMMIT"));
+        driver->syncPipeline();
+        PGresult *end = driver->getPipelineResult();
+        if (!error.isValid() && PQresultStatus(end) != PGRES_COMMAND_OK) {
+            error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                               "Unable to commit transaction"), QSqlError::TransactionError, driver, end);
+        }
+        PQclear(end);
+    }
+    driver->exitPipelineMode();
+    driver->currentStmtId = driver->generateStatementId();
+
+    if (error.isValid()) {
+        PQclear(result);
+        result = nullptr;
+        q->setLastError(error);
+        return false;
+    }
+    // All rows of a result set have been read already, even if the query is
+    // forward-only; they are stepped through instead of read one by one
+    allRowsFetched = PQresultStatus(result) == PGRES_TUPLES_OK;
+    return processResults();
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -1212,11 +1703,19 @@ bool QPSQLDriver::open(const QString &db,
     if (port != -1)
         connectString.append(QLatin1String(" port=")).append(qQuote(QString::number(port)));
 
-    // add any connect options - the server will handle error detection
-    if (!connOpts.isEmpty()) {
-        QString opt = connOpts;
-        opt.replace(QLatin1Char(';'), QLatin1Char(' '), Qt::CaseInsensitive);
-        connectString.append(QLatin1Char(' ')).append(opt);
+    // add any connect options - the server will handle error detection,
+    // except for those that only concern the driver
+    d->binaryResultsEnabled = false;
+    d->pipelinedBatchEnabled = false;
+    const auto opts = QStringView{connOpts}.split(QLatin1Char(';'));
+    for (auto option : opts) {
+        option = option.trimmed();
+        if (option == QLatin1String("QPSQL_BINARY_RESULTS"))
+            d->binaryResultsEnabled = true;
+        else if (option == QLatin1String("QPSQL_PIPELINED_BATCH"))
+            d->pipelinedBatchEnabled = true;
+        else if (!option.isEmpty())
+            connectString.append(QLatin1Char(' ')).append(option);
     }
 
     d->connection = PQconnectdb(std::move(connectString).toLocal8Bit().constData());
@@ -1233,6 +1732,8 @@ bool QPSQLDriver::open(const QString &db,
     d->isUtf8 = d->setEncodingUtf8();
     d->setDatestyle();
     d->setByteaOutput();
+    const char *integerDatetimes = PQparameterStatus(d->connection, "integer_datetimes");
+    d->hasIntegerDatetimes = integerDatetimes && qstrcmp(integerDatetimes, "on") == 0;
 
     setOpen(true);
     setOpenError(false);
@@ -48,11 +48,12 @@
 #include <qsqlindex.h>
 #include <qsqlquery.h>
 #include <QtSql/private/qsqlcachedresult_p.h>
+#include <QtSql/private/qsqlcolumnbatch_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <qstringlist.h>
 #include <qvariant.h>
-#if QT_CONFIG(regularexpression)
 #include <qcache.h>
+#if QT_CONFIG(regularexpression)
 #include <qregularexpression.h>
 #endif
 #include <QScopedValueRollback>
@@ -113,6 +114,53 @@ static QSqlError qMakeError(sqlite3 *access, const QString &descr, QSqlError::Er
                      type, QString::number(errorCode));
 }
 
+// Binds 'value' to the parameter 'index' (1-based) of 'stmt'. Strings and
+// byte arrays are not copied; 'value' must outlive the execution.
+static int qBindValue(sqlite3_stmt *stmt, int index, const QVariant &value)
+{
+    if (value.isNull())
+        return sqlite3_bind_null(stmt, index);
+
+    switch (value.userType()) {
+    case QMetaType::QByteArray: {
+        const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
+        return sqlite3_bind_blob(stmt, index, ba->constData(), ba->size(), SQLITE_STATIC);
+    }
+    case QMetaType::Int:
+    case QMetaType::Bool:
+        return sqlite3_bind_int(stmt, index, value.toInt());
+    case QMetaType::Double:
+        return sqlite3_bind_double(stmt, index, value.toDouble());
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+        return sqlite3_bind_int64(stmt, index, value.toLongLong());
+    case QMetaType::QDateTime: {
+        const QDateTime dateTime = value.toDateTime();
+        const QString str = dateTime.toString(Qt::ISODateWithMs);
+        return sqlite3_bind_text16(stmt, index, str.utf16(),
+                                   str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+    }
+    case QMetaType::QTime: {
+        const QTime time = value.toTime();
+        const QString str = time.toString(u"hh:mm:ss.zzz");
+        return sqlite3_bind_text16(stmt, index, str.utf16(),
+                                   str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+    }
+    case QMetaType::QString: {
+        // lifetime of string == lifetime of its qvariant
+        const QString *str = static_cast<const QString*>(value.constData());
+        return sqlite3_bind_text16(stmt, index, str->utf16(),
+                                   (str->size()) * sizeof(QChar), SQLITE_STATIC);
+    }
+    default: {
+        QString str = value.toString();
+        // SQLITE_TRANSIENT makes sure that sqlite buffers the data
+        return sqlite3_bind_text16(stmt, index, str.utf16(),
+                                   (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
+    }
+    }
+}
+
 class QSQLiteResultPrivate;
 
 class QSQLiteResult : public QSqlCachedResult
@@ -127,6 +175,7 @@ public:
 
 protected:
     bool gotoNext(QSqlCachedResult::ValueCache& row, int idx) override;
+    bool fetchBatch(QSqlColumnBatch *batch, int maxRows) override;
     bool reset(const QString &query) override;
     bool prepare(const QString &query) override;
     bool execBatch(bool arrayBind) override;
@@ -139,17 +188,52 @@ protected:
     void virtual_hook(int id, void *data) override;
 };
 
+// A prepared statement that is currently not used by any result
+struct QSQLiteCachedStatement
+{
+    explicit QSQLiteCachedStatement(sqlite3_stmt *stmt) : stmt(stmt) {}
+    ~QSQLiteCachedStatement() { sqlite3_finalize(stmt); }
+    Q_DISABLE_COPY_MOVE(QSQLiteCachedStatement)
+
+    sqlite3_stmt *stmt;
+};
+
 class QSQLiteDriverPrivate : public QSqlDriverPrivate
 {
     Q_DECLARE_PUBLIC(QSQLiteDriver)
 
 public:
     inline QSQLiteDriverPrivate() : QSqlDriverPrivate(QSqlDriver::SQLite) {}
+    sqlite3_stmt *takeStatement(const QString &query);
+    void cacheStatement(const QString &query, sqlite3_stmt *stmt);
+
     sqlite3 *access = nullptr;
     QList<QSQLiteResult *> results;
     QStringList notificationid;
+    // statements of finished results, by SQL text, least recently used first
+    QCache<QString, QSQLiteCachedStatement> statementCache{32};
 };
 
+sqlite3_stmt *QSQLiteDriverPrivate::takeStatement(const QString &query)
+{
+    QSQLiteCachedStatement *cached = statementCache.take(query);
+    if (!cached)
+        return nullptr;
+    sqlite3_stmt *stmt = cached->stmt;
+    cached->stmt = nullptr;
+    delete cached;
+    return stmt;
+}
+
+void QSQLiteDriverPrivate::cacheStatement(const QString &query, sqlite3_stmt *stmt)
+{
+    // Don't keep any locks, nor pointers to the values bound by the result.
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    // takes ownership, even if the statement doesn't fit into the cache
+    statementCache.insert(query, new QSQLiteCachedStatement(stmt));
+}
+
 
 class QSQLiteResultPrivate : public QSqlCachedResultPrivate
 {
@@ -160,11 +244,16 @@ public:
     using QSqlCachedResultPrivate::QSqlCachedResultPrivate;
     void cleanup();
     bool fetchNext(QSqlCachedResult::ValueCache &values, int idx, bool initialFetch);
+    QVariant columnValue(int column) const;
+    void appendRow(QSqlColumnBatchPrivate *batch) const;
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
+    void releaseStatement();
+    bool execBatchNative();
 
     sqlite3_stmt *stmt = nullptr;
+    QString stmtQuery;
     QSqlRecord rInf;
     QList<QVariant> firstRow;
     bool skippedStatus = false; // the status of the fetchNext() that's skipped
@@ -174,7 +263,7 @@ public:
 void QSQLiteResultPrivate::cleanup()
 {
     Q_Q(QSQLiteResult);
-    finalize();
+    releaseStatement();
     rInf.clear();
     skippedStatus = false;
     skipRow = false;
@@ -192,6 +281,23 @@ void QSQLiteResultPrivate::finalize()
     stmt = 0;
 }
 
+// Hands the statement over to the driver, so that preparing the same query
+// again can reuse it instead of compiling it anew.
+void QSQLiteResultPrivate::releaseStatement()
+{
+    if (!stmt)
+        return;
+
+    QSQLiteDriverPrivate *driver = const_cast<QSQLiteDriverPrivate *>(drv_d_func());
+    if (!driver || !driver->access) {
+        finalize();
+        return;
+    }
+
+    driver->cacheStatement(stmtQuery, stmt);
+    stmt = nullptr;
+}
+
 void QSQLiteResultPrivate::initColumns(bool emptyResultset)
 {
     Q_Q(QSQLiteResult);
@@ -283,41 +389,8 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
             initColumns(false);
         if (idx < 0 && !initialFetch)
             return true;
-        for (i = 0; i < rInf.count(); ++i) {
-            switch (sqlite3_column_type(stmt, i)) {
-            case SQLITE_BLOB:
-                values[i + idx] = QByteArray(static_cast<const char *>(
-                            sqlite3_column_blob(stmt, i)),
-                            sqlite3_column_bytes(stmt, i));
-                break;
-            case SQLITE_INTEGER:
-                values[i + idx] = sqlite3_column_int64(stmt, i);
-                break;
-            case SQLITE_FLOAT:
-                switch(q->numericalPrecisionPolicy()) {
-                    case QSql::LowPrecisionInt32:
-                        values[i + idx] = sqlite3_column_int(stmt, i);
-                        break;
-                    case QSql::LowPrecisionInt64:
-                        values[i + idx] = sqlite3_column_int64(stmt, i);
-                        break;
-                    case QSql::LowPrecisionDouble:
-                    case QSql::HighPrecision:
-                    default:
-                        values[i + idx] = sqlite3_column_double(stmt, i);
-                        break;
-                };
-                break;
-            case SQLITE_NULL:
-                values[i + idx] = QVariant(QMetaType::fromType<QString>());
-                break;
-            default:
-                values[i + idx] = QString(reinterpret_cast<const QChar *>(
-                            sqlite3_column_text16(stmt, i)),
-                            sqlite3_column_bytes16(stmt, i) / sizeof(QChar));
-                break;
-            }
-        }
+        for (i = 0; i < rInf.count(); ++i)
+            values[i + idx] = columnValue(i);
         return true;
     case SQLITE_DONE:
         if (rInf.isEmpty())
@@ -348,6 +421,165 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
     return false;
 }
 
+// Executes the statement once for every row of the bound value lists,
+// binding the values directly and, unless a transaction was started
+// explicitly, within a single transaction.
+bool QSQLiteResultPrivate::execBatchNative()
+{
+    Q_Q(QSQLiteResult);
+    sqlite3 *access = drv_d_func()->access;
+
+    skippedStatus = false;
+    skipRow = false;
+    rInf.clear();
+    q->clearValues();
+    q->setLastError(QSqlError());
+    q->setSelect(false);
+    q->setActive(false);
+
+    QList<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : qAsConst(values))
+        columns.append(value.toList());
+    const qsizetype rowCount = columns.constFirst().count();
+    for (const QVariantList &column : qAsConst(columns)) {
+        if (column.count() != rowCount) {
+            q->setLastError(QSqlError(QCoreApplication::translate("QSQLiteResult",
+                            "Parameter count mismatch"), QString(), QSqlError::StatementError));
+            return false;
+        }
+    }
+
+    const bool implicitTransaction = sqlite3_get_autocommit(access);
+    int res = implicitTransaction ? sqlite3_exec(access, "BEGIN", nullptr, nullptr, nullptr)
+                                  : SQLITE_OK;
+    if (res != SQLITE_OK) {
+        q->setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteDriver",
+                        "Unable to begin transaction"), QSqlError::TransactionError, res));
+        return false;
+    }
+
+    const auto fail = [&](const QString &description, int errorCode) {
+        q->setLastError(qMakeError(access, description, QSqlError::StatementError, errorCode));
+        if (implicitTransaction)
+            sqlite3_exec(access, "ROLLBACK", nullptr, nullptr, nullptr);
+        return false;
+    };
+
+    for (qsizetype row = 0; row < rowCount; ++row) {
+        res = sqlite3_reset(stmt);
+        if (res != SQLITE_OK) {
+            return fail(QCoreApplication::translate("QSQLiteResult",
+                        "Unable to reset statement"), res);
+        }
+        for (int i = 0; i < columns.count(); ++i) {
+            res = qBindValue(stmt, i + 1, columns.at(i).at(row));
+            if (res != SQLITE_OK) {
+                sqlite3_reset(stmt);
+                return fail(QCoreApplication::translate("QSQLiteResult",
+                            "Unable to bind parameters"), res);
+            }
+        }
+        res = sqlite3_step(stmt);
+        if (res != SQLITE_DONE && res != SQLITE_ROW) {
+            // sqlite3_reset() returns the specific error code
+            res = sqlite3_reset(stmt);
+            return fail(QCoreApplication::translate("QSQLiteResult",
+                        "Unable to fetch row"), res);
+        }
+    }
+    sqlite3_reset(stmt);
+
+    if (implicitTransaction) {
+        res = sqlite3_exec(access, "COMMIT", nullptr, nullptr, nullptr);
+        if (res != SQLITE_OK) {
+            return fail(QCoreApplication::translate("QSQLiteDriver",
+                        "Unable to commit transaction"), res);
+        }
+    }
+
+    q->setActive(true);
+    return true;
+}
+
+QVariant QSQLiteResultPrivate::columnValue(int column) const
+{
+    Q_Q(const QSQLiteResult);
+    switch (sqlite3_column_type(stmt, column)) {
+    case SQLITE_BLOB:
+        return QByteArray(static_cast<const char *>(sqlite3_column_blob(stmt, column)),
+                          sqlite3_column_bytes(stmt, column));
+    case SQLITE_INTEGER:
+        return sqlite3_column_int64(stmt, column);
+    case SQLITE_FLOAT:
+        switch (q->numericalPrecisionPolicy()) {
+        case QSql::LowPrecisionInt32:
+            return sqlite3_column_int(stmt, column);
+        case QSql::LowPrecisionInt64:
+            return sqlite3_column_int64(stmt, column);
+        case QSql::LowPrecisionDouble:
+        case QSql::HighPrecision:
+        default:
+            return sqlite3_column_double(stmt, column);
+        }
+    case SQLITE_NULL:
+        return QVariant(QMetaType::fromType<QString>());
+    default:
+        return QString(reinterpret_cast<const QChar *>(sqlite3_column_text16(stmt, column)),
+                       sqlite3_column_bytes16(stmt, column) / sizeof(QChar));
+    }
+}
+
+// Reads the values of the current row into the typed columns of 'batch',
+// without going through a QVariant. SQLite columns can hold values of any
+// storage class, so only values stored with the class of the column take
+// the fast path; the others are converted by appendValue() like value().
+void QSQLiteResultPrivate::appendRow(QSqlColumnBatchPrivate *batch) const
+{
+    Q_Q(const QSQLiteResult);
+    const QSql::NumericalPrecisionPolicy policy = q->numericalPrecisionPolicy();
+    const bool doublesAsIs = policy == QSql::LowPrecisionDouble || policy == QSql::HighPrecision;
+    for (int i = 0; i < batch->columns.count(); ++i) {
+        const int storageClass = sqlite3_column_type(stmt, i);
+        if (storageClass == SQLITE_NULL) {
+            batch->appendNull(i);
+            continue;
+        }
+        switch (batch->columns.at(i).type) {
+        case QSqlColumnBatch::Int64Column:
+            if (storageClass != SQLITE_INTEGER)
+                break;
+            batch->appendInt64(i, sqlite3_column_int64(stmt, i));
+            continue;
+        case QSqlColumnBatch::DoubleColumn:
+            if (storageClass != SQLITE_FLOAT || !doublesAsIs)
+                break;
+            batch->appendDouble(i, sqlite3_column_double(stmt, i));
+            continue;
+        case QSqlColumnBatch::StringColumn:
+            if (storageClass != SQLITE_TEXT)
+                break;
+            // Databases store text as UTF-8 by default; decoding it ourselves
+            // is faster than letting SQLite convert it to UTF-16 first.
+            batch->appendString(i, QString::fromUtf8(reinterpret_cast<const char *>(
+                                    sqlite3_column_text(stmt, i)),
+                                    sqlite3_column_bytes(stmt, i)));
+            continue;
+        case QSqlColumnBatch::ByteArrayColumn:
+            if (storageClass != SQLITE_BLOB)
+                break;
+            batch->appendByteArray(i, QByteArray(static_cast<const char *>(
+                                          sqlite3_column_blob(stmt, i)),
+                                          sqlite3_column_bytes(stmt, i)));
+            continue;
+        case QSqlColumnBatch::VariantColumn:
+            break;
+        }
+        batch->appendValue(i, columnValue(i));
+    }
+    batch->finishRow();
+}
+
 QSQLiteResult::QSQLiteResult(const QSQLiteDriver* db)
     : QSqlCachedResult(*new QSQLiteResultPrivate(this, db))
 {
@@ -385,6 +617,11 @@ bool QSQLiteResult::prepare(const QString &query)
 
     setSelect(false);
 
+    d->stmtQuery = query;
+    d->stmt = const_cast<QSQLiteDriverPrivate *>(d->drv_d_func())->takeStatement(query);
+    if (d->stmt)
+        return true;
+
     const void *pzTail = NULL;
 
 #if (SQLITE_VERSION_NUMBER >= 3003011)
@@ -412,12 +649,17 @@ bool QSQLiteResult::prepare(const QString &query)
 bool QSQLiteResult::execBatch(bool arrayBind)
 {
     Q_UNUSED(arrayBind);
-    Q_D(QSqlResult);
-    QScopedValueRollback<QList<QVariant>> valuesScope(d->values);
-    QList<QVariant> values = d->values;
-    if (values.count() == 0)
+    Q_D(QSQLiteResult);
+    if (d->values.count() == 0)
         return false;
 
+    // Named placeholders that are used more than once need the generic
+    // handling of exec().
+    if (d->stmt && sqlite3_bind_parameter_count(d->stmt) == d->values.count())
+        return d->execBatchNative();
+
+    QScopedValueRollback<QList<QVariant>> valuesScope(d->values);
+    QList<QVariant> values = d->values;
     for (int i = 0; i < values.at(0).toList().count(); ++i) {
         d->values.clear();
         QScopedValueRollback<QHash<QString, QList<int>>> indexesScope(d->indexes);
@@ -495,57 +737,7 @@ bool QSQLiteResult::exec()
 
     if (paramCountIsValid) {
         for (int i = 0; i < paramCount; ++i) {
-            res = SQLITE_OK;
-            const QVariant value = values.at(i);
-
-            if (value.isNull()) {
-                res = sqlite3_bind_null(d->stmt, i + 1);
-            } else {
-                switch (value.userType()) {
-                case QMetaType::QByteArray: {
-                    const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
-                    res = sqlite3_bind_blob(d->stmt, i + 1, ba->constData(),
-                                            ba->size(), SQLITE_STATIC);
-                    break; }
-                case QMetaType::Int:
-                case QMetaType::Bool:
-                    res = sqlite3_bind_int(d->stmt, i + 1, value.toInt());
-                    break;
-                case QMetaType::Double:
-                    res = sqlite3_bind_double(d->stmt, i + 1, value.toDouble());
-                    break;
-                case QMetaType::UInt:
-                case QMetaType::LongLong:
-                    res = sqlite3_bind_int64(d->stmt, i + 1, value.toLongLong());
-                    break;
-                case QMetaType::QDateTime: {
-                    const QDateTime dateTime = value.toDateTime();
-                    const QString str = dateTime.toString(Qt::ISODateWithMs);
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QMetaType::QTime: {
-                    const QTime time = value.toTime();
-                    const QString str = time.toString(u"hh:mm:ss.zzz");
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QMetaType::QString: {
-                    // lifetime of string == lifetime of its qvariant
-                    const QString *str = static_cast<const QString*>(value.constData());
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str->utf16(),
-                                              (str->size()) * sizeof(QChar), SQLITE_STATIC);
-                    break; }
-                default: {
-                    QString str = value.toString();
-                    // SQLITE_TRANSIENT makes sure that sqlite buffers the data
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
-                    break; }
-                }
-            }
+            res = qBindValue(d->stmt, i + 1, values.at(i));
             if (res != SQLITE_OK) {
                 setLastError(qMakeError(d->drv_d_func()->access, QCoreApplication::translate("QSQLiteResult",
                              "Unable to bind parameters"), QSqlError::StatementError, res));
@@ -575,6 +767,34 @@ bool QSQLiteResult::gotoNext(QSqlCachedResult::ValueCache& row, int idx)
     return d->fetchNext(row, idx, false);
 }
 
+bool QSQLiteResult::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    Q_D(QSQLiteResult);
+    if (!isForwardOnly())
+        return QSqlCachedResult::fetchBatch(batch, maxRows);
+
+    QSqlColumnBatchPrivate *b = QSqlColumnBatchPrivate::get(batch);
+    b->reset(record(), maxRows);
+    if (at() == QSql::AfterLastRow)
+        return false;
+
+    // Step through the rows without filling the row cache, and read the
+    // values directly from the statement.
+    while (b->rowCount < maxRows) {
+        if (!d->fetchNext(d->cache, -1, false)) {
+            setAt(QSql::AfterLastRow);
+            return b->rowCount > 0;
+        }
+        setAt(at() + 1);
+        d->appendRow(b);
+    }
+
+    // the query is positioned on the last row, make value() work
+    for (int i = 0; i < d->rInf.count(); ++i)
+        d->cache[i] = d->columnValue(i);
+    return true;
+}
+
 int QSQLiteResult::size()
 {
     return -1;
@@ -719,6 +939,8 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
     bool sharedCache = false;
     bool openReadOnlyOption = false;
     bool openUriOption = false;
+    int statementCacheSize = 32;
+    static const QLatin1String statementCacheSizeConnectOption = QLatin1String("QSQLITE_STATEMENT_CACHE_SIZE");
 #if QT_CONFIG(regularexpression)
     static const QLatin1String regexpConnectOption = QLatin1String("QSQLITE_ENABLE_REGEXP");
     bool defineRegexp = false;
@@ -736,6 +958,14 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
                 if (ok)
                     timeOut = nt;
             }
+        } else if (option.startsWith(statementCacheSizeConnectOption)) {
+            option = option.mid(statementCacheSizeConnectOption.size()).trimmed();
+            if (option.startsWith(QLatin1Char('='))) {
+                bool ok;
+                const int size = option.mid(1).trimmed().toInt(&ok);
+                if (ok && size >= 0)
+                    statementCacheSize = size;
+            }
         } else if (option == QLatin1String("QSQLITE_OPEN_READONLY")) {
             openReadOnlyOption = true;
         } else if (option == QLatin1String("QSQLITE_OPEN_URI")) {
@@ -772,6 +1002,7 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
 
     if (res == SQLITE_OK) {
         sqlite3_busy_timeout(d->access, timeOut);
+        d->statementCache.setMaxCost(statementCacheSize);
         setOpen(true);
         setOpenError(false);
 #if QT_CONFIG(regularexpression)
@@ -802,6 +1033,7 @@ void QSQLiteDriver::close()
     if (isOpen()) {
         for (QSQLiteResult *result : qAsConst(d->results))
             result->d_func()->finalize();
+        d->statementCache.clear();
 
         if (d->access && (d->notificationid.count() > 0)) {
             d->notificationid.clear();
@@ -149,3 +149,11 @@ QString connectString = QStringLiteral(
 db.setDatabaseName(connectString);
 //! [39]
 }
+
+void setPsqlOptions()
+{
+//! [42]
+QSqlDatabase db = QSqlDatabase::addDatabase("QPSQL");
+db.setConnectOptions("QPSQL_PIPELINED_BATCH;QPSQL_BINARY_RESULTS;connect_timeout=10");
+//! [42]
+}
@@ -208,6 +208,30 @@ void QSqlQuery_snippets()
         cout << i << ": " << list.at(i).toString().toUtf8().data() << "\n";
 //! [14]
     }
+
+    {
+    // columnar fetch
+//! [49]
+    QSqlQuery query;
+    query.setForwardOnly(true);
+    query.exec("SELECT id, name FROM employee");
+
+    QSqlColumnBatch batch;
+    while (query.nextBatch(&batch, 1000)) {
+        if (batch.columnType(0) == QSqlColumnBatch::Int64Column
+                && batch.columnType(1) == QSqlColumnBatch::StringColumn) {
+            const QList<qint64> ids = batch.int64Column(0);
+            const QList<QString> names = batch.stringColumn(1);
+            for (int row = 0; row < batch.rowCount(); ++row)
+                doSomething(QString::number(ids.at(row)) + QLatin1Char(' ') + names.at(row));
+        } else {
+            for (int row = 0; row < batch.rowCount(); ++row)
+                doSomething(batch.value(row, 0).toString() + QLatin1Char(' ')
+                            + batch.value(row, 1).toString());
+        }
+    }
+//! [49]
+    }
 }
 
 void QSqlQueryModel_snippets()
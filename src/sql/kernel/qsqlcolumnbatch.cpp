@@ -0,0 +1,491 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsqlcolumnbatch.h"
+#include "qsqlcolumnbatch_p.h"
+
+#include "qsqlfield.h"
+#include "qsqlrecord.h"
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+// Integers with a larger magnitude can't be represented exactly by a double.
+static const qint64 maxExactDoubleInteger = Q_INT64_C(1) << std::numeric_limits<double>::digits;
+
+static bool convertToInt64(const QVariant &value, qint64 *result)
+{
+    switch (value.metaType().id()) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+        *result = value.toLongLong();
+        return true;
+    case QMetaType::ULong:
+    case QMetaType::ULongLong: {
+        const qulonglong u = value.toULongLong();
+        if (u > qulonglong(std::numeric_limits<qint64>::max()))
+            return false;
+        *result = qint64(u);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+static bool convertToDouble(const QVariant &value, double *result)
+{
+    switch (value.metaType().id()) {
+    case QMetaType::Float:
+    case QMetaType::Double:
+        *result = value.toDouble();
+        return true;
+    default:
+        break;
+    }
+    qint64 i;
+    if (!convertToInt64(value, &i) || i < -maxExactDoubleInteger || i > maxExactDoubleInteger)
+        return false;
+    *result = double(i);
+    return true;
+}
+
+QSqlColumnBatch::ColumnType QSqlColumnBatchPrivate::columnType(QMetaType type)
+{
+    switch (type.id()) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+        return QSqlColumnBatch::Int64Column;
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return QSqlColumnBatch::DoubleColumn;
+    case QMetaType::QString:
+        return QSqlColumnBatch::StringColumn;
+    case QMetaType::QByteArray:
+        return QSqlColumnBatch::ByteArrayColumn;
+    default:
+        return QSqlColumnBatch::VariantColumn;
+    }
+}
+
+void QSqlColumnBatchPrivate::reset(const QSqlRecord &record, int maxRows)
+{
+    // Clearing keeps the capacity of lists that aren't shared, so fetching
+    // several batches into the same object doesn't allocate again.
+    const int reservedRows = qMin(maxRows, 4096);
+    columns.resize(record.count());
+    for (int i = 0; i < columns.count(); ++i) {
+        Column &column = columns[i];
+        column.metaType = record.field(i).metaType();
+        column.type = columnType(column.metaType);
+        column.int64s.clear();
+        column.doubles.clear();
+        column.strings.clear();
+        column.byteArrays.clear();
+        column.variants.clear();
+        column.nulls.clear();
+        column.nulls.reserve(reservedRows);
+        switch (column.type) {
+        case QSqlColumnBatch::Int64Column:
+            column.int64s.reserve(reservedRows);
+            break;
+        case QSqlColumnBatch::DoubleColumn:
+            column.doubles.reserve(reservedRows);
+            break;
+        case QSqlColumnBatch::StringColumn:
+            column.strings.reserve(reservedRows);
+            break;
+        case QSqlColumnBatch::ByteArrayColumn:
+            column.byteArrays.reserve(reservedRows);
+            break;
+        case QSqlColumnBatch::VariantColumn:
+            column.variants.reserve(reservedRows);
+            break;
+        }
+    }
+    rowCount = 0;
+}
+
+void QSqlColumnBatchPrivate::appendValue(int column, const QVariant &value)
+{
+    if (value.isNull()) {
+        appendNull(column);
+        return;
+    }
+
+    // Values are only converted if that doesn't lose anything; otherwise the
+    // column falls back to storing variants for the rest of the batch.
+    switch (columns.at(column).type) {
+    case QSqlColumnBatch::Int64Column: {
+        qint64 i;
+        if (convertToInt64(value, &i)) {
+            appendInt64(column, i);
+            return;
+        }
+        break;
+    }
+    case QSqlColumnBatch::DoubleColumn: {
+        double d;
+        if (convertToDouble(value, &d)) {
+            appendDouble(column, d);
+            return;
+        }
+        break;
+    }
+    case QSqlColumnBatch::StringColumn:
+        if (value.metaType().id() == QMetaType::QString) {
+            appendString(column, value.toString());
+            return;
+        }
+        break;
+    case QSqlColumnBatch::ByteArrayColumn:
+        if (value.metaType().id() == QMetaType::QByteArray) {
+            appendByteArray(column, value.toByteArray());
+            return;
+        }
+        break;
+    case QSqlColumnBatch::VariantColumn:
+        break;
+    }
+
+    Column &c = columns[column];
+    if (c.type != QSqlColumnBatch::VariantColumn)
+        convertToVariants(column);
+    c.variants.append(value);
+    c.nulls.append(false);
+}
+
+// Moves the values already appended to 'column' into its variant list, the
+// same as QSqlColumnBatch::value() returns them, and makes it a variant
+// column until the next reset().
+void QSqlColumnBatchPrivate::convertToVariants(int column)
+{
+    Column &c = columns[column];
+    QList<QVariant> variants;
+    variants.reserve(c.nulls.capacity());
+    for (int row = 0; row < c.nulls.count(); ++row) {
+        if (c.nulls.at(row)) {
+            variants.append(QVariant(c.metaType, nullptr));
+            continue;
+        }
+        switch (c.type) {
+        case QSqlColumnBatch::Int64Column:
+            variants.append(c.int64s.at(row));
+            break;
+        case QSqlColumnBatch::DoubleColumn:
+            variants.append(c.doubles.at(row));
+            break;
+        case QSqlColumnBatch::StringColumn:
+            variants.append(c.strings.at(row));
+            break;
+        case QSqlColumnBatch::ByteArrayColumn:
+            variants.append(c.byteArrays.at(row));
+            break;
+        case QSqlColumnBatch::VariantColumn:
+            return;
+        }
+    }
+    c.int64s.clear();
+    c.doubles.clear();
+    c.strings.clear();
+    c.byteArrays.clear();
+    c.variants = std::move(variants);
+    c.type = QSqlColumnBatch::VariantColumn;
+}
+
+void QSqlColumnBatchPrivate::appendNull(int column)
+{
+    Column &c = columns[column];
+    switch (c.type) {
+    case QSqlColumnBatch::Int64Column:
+        c.int64s.append(0);
+        break;
+    case QSqlColumnBatch::DoubleColumn:
+        c.doubles.append(0);
+        break;
+    case QSqlColumnBatch::StringColumn:
+        c.strings.append(QString());
+        break;
+    case QSqlColumnBatch::ByteArrayColumn:
+        c.byteArrays.append(QByteArray());
+        break;
+    case QSqlColumnBatch::VariantColumn:
+        c.variants.append(QVariant(c.metaType, nullptr));
+        break;
+    }
+    c.nulls.append(true);
+}
+
+/*!
+    \class QSqlColumnBatch
+    \brief The QSqlColumnBatch class holds the values of several records
+    column by column.
+
+    \ingroup database
+    \inmodule QtSql
+    \since 6.0
+    \reentrant
+
+    QSqlColumnBatch is filled by QSqlQuery::nextBatch(), which retrieves
+    many records at once. The values of each column are stored in a typed
+    list, rather than as one QVariant per field. This makes scanning large
+    results considerably cheaper than calling QSqlQuery::next() and
+    QSqlQuery::value() for every field.
+
+    The type of each column is derived from the type of the corresponding
+    field of QSqlQuery::record(), see columnType(). Integer and boolean
+    fields are stored in int64Column(), floating point fields in
+    doubleColumn(), text in stringColumn() and binary data in
+    byteArrayColumn(). All other fields, for example dates and unsigned
+    64-bit integers, are stored in variantColumn().
+
+    The values are the ones QSqlQuery::value() returns, including the
+    effect of the
+    \l{QSqlQuery::setNumericalPrecisionPolicy()}{numerical precision policy}.
+    A value is only stored in a typed list if it can be converted to that
+    type without loss. Otherwise, for example if an SQLite column declared
+    as \c INTEGER contains text, or if a fixed point value is retrieved as
+    a string because of QSql::HighPrecision, the whole column is stored in
+    variantColumn() for that batch. Always check columnType() before
+    accessing the typed lists of a batch.
+
+    A NULL field is stored as a default constructed value of the column's
+    type; use isNull() to tell it apart from other values.
+
+    \snippet sqldatabase/sqldatabase.cpp 49
+
+    The same batch object can be passed to QSqlQuery::nextBatch() again,
+    which reuses its memory when the lists retrieved from the previous batch
+    aren't referenced any more.
+
+    \sa QSqlQuery::nextBatch(), QSqlQuery::setForwardOnly()
+*/
+
+/*!
+    \enum QSqlColumnBatch::ColumnType
+
+    This enum describes how the values of a column are stored.
+
+    \value VariantColumn    The values are stored in variantColumn().
+    \value Int64Column      The values are stored in int64Column().
+    \value DoubleColumn     The values are stored in doubleColumn().
+    \value StringColumn     The values are stored in stringColumn().
+    \value ByteArrayColumn  The values are stored in byteArrayColumn().
+*/
+
+/*!
+    Constructs an empty batch.
+*/
+QSqlColumnBatch::QSqlColumnBatch()
+    : d(new QSqlColumnBatchPrivate)
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QSqlColumnBatch::QSqlColumnBatch(const QSqlColumnBatch &other) = default;
+
+/*!
+    Assigns \a other to this batch and returns a reference to it.
+*/
+QSqlColumnBatch &QSqlColumnBatch::operator=(const QSqlColumnBatch &other) = default;
+
+/*!
+    \fn QSqlColumnBatch &QSqlColumnBatch::operator=(QSqlColumnBatch &&other)
+
+    Move-assigns \a other to this batch and returns a reference to it.
+*/
+
+/*!
+    Destroys the batch.
+*/
+QSqlColumnBatch::~QSqlColumnBatch() = default;
+
+/*!
+    \fn void QSqlColumnBatch::swap(QSqlColumnBatch &other)
+
+    Swaps this batch with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Returns \c true if the batch contains no rows; otherwise returns
+    \c false.
+*/
+bool QSqlColumnBatch::isEmpty() const
+{
+    return d->rowCount == 0;
+}
+
+/*!
+    Removes all rows and columns from the batch.
+*/
+void QSqlColumnBatch::clear()
+{
+    d->columns.clear();
+    d->rowCount = 0;
+}
+
+/*!
+    Returns the number of columns in the batch.
+*/
+int QSqlColumnBatch::columnCount() const
+{
+    return d->columns.count();
+}
+
+/*!
+    Returns the number of rows in the batch.
+*/
+int QSqlColumnBatch::rowCount() const
+{
+    return d->rowCount;
+}
+
+/*!
+    Returns how the values of \a column are stored.
+
+    A column is stored as VariantColumn if one of its values in this batch
+    couldn't be converted to the type of the column without loss, so the
+    type can differ between batches of the same query.
+*/
+QSqlColumnBatch::ColumnType QSqlColumnBatch::columnType(int column) const
+{
+    return d->columns.at(column).type;
+}
+
+/*!
+    Returns \c true if the field \a column of \a row is NULL; otherwise
+    returns \c false.
+*/
+bool QSqlColumnBatch::isNull(int row, int column) const
+{
+    return d->columns.at(column).nulls.at(row);
+}
+
+/*!
+    Returns the value of the field \a column of \a row as a QVariant.
+
+    This is a convenience function; accessing the typed lists directly is
+    more efficient.
+*/
+QVariant QSqlColumnBatch::value(int row, int column) const
+{
+    const QSqlColumnBatchPrivate::Column &c = d->columns.at(column);
+    if (c.nulls.at(row))
+        return QVariant(c.metaType, nullptr);
+    switch (c.type) {
+    case Int64Column:
+        return QVariant(c.int64s.at(row));
+    case DoubleColumn:
+        return QVariant(c.doubles.at(row));
+    case StringColumn:
+        return QVariant(c.strings.at(row));
+    case ByteArrayColumn:
+        return QVariant(c.byteArrays.at(row));
+    case VariantColumn:
+        break;
+    }
+    return c.variants.at(row);
+}
+
+/*!
+    Returns the values of \a column, which must be of type Int64Column.
+    Otherwise an empty list is returned.
+*/
+QList<qint64> QSqlColumnBatch::int64Column(int column) const
+{
+    return d->columns.at(column).int64s;
+}
+
+/*!
+    Returns the values of \a column, which must be of type DoubleColumn.
+    Otherwise an empty list is returned.
+*/
+QList<double> QSqlColumnBatch::doubleColumn(int column) const
+{
+    return d->columns.at(column).doubles;
+}
+
+/*!
+    Returns the values of \a column, which must be of type StringColumn.
+    Otherwise an empty list is returned.
+*/
+QList<QString> QSqlColumnBatch::stringColumn(int column) const
+{
+    return d->columns.at(column).strings;
+}
+
+/*!
+    Returns the values of \a column, which must be of type ByteArrayColumn.
+    Otherwise an empty list is returned.
+*/
+QList<QByteArray> QSqlColumnBatch::byteArrayColumn(int column) const
+{
+    return d->columns.at(column).byteArrays;
+}
+
+/*!
+    Returns the values of \a column, which must be of type VariantColumn.
+    Otherwise an empty list is returned.
+*/
+QList<QVariant> QSqlColumnBatch::variantColumn(int column) const
+{
+    return d->columns.at(column).variants;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSQLCOLUMNBATCH_P_H
+#define QSQLCOLUMNBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the database drivers.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSql/private/qtsqlglobal_p.h>
+#include "QtSql/qsqlcolumnbatch.h"
+
+QT_BEGIN_NAMESPACE
+
+class QSqlRecord;
+
+class Q_SQL_EXPORT QSqlColumnBatchPrivate : public QSharedData
+{
+public:
+    struct Column
+    {
+        QSqlColumnBatch::ColumnType type = QSqlColumnBatch::VariantColumn;
+        QMetaType metaType;
+        // only the list matching 'type' is used
+        QList<qint64> int64s;
+        QList<double> doubles;
+        QList<QString> strings;
+        QList<QByteArray> byteArrays;
+        QList<QVariant> variants;
+        QList<bool> nulls;
+    };
+
+    static QSqlColumnBatchPrivate *get(QSqlColumnBatch *batch) { return batch->d.data(); }
+    static QSqlColumnBatch::ColumnType columnType(QMetaType type);
+
+    // Drivers call reset() before filling the batch, then append exactly
+    // one value to each column per row and call finishRow(). The typed
+    // append functions may only be used while the column still has that
+    // type; appendValue() turns the column into a variant column if the
+    // value doesn't fit.
+    void reset(const QSqlRecord &record, int maxRows);
+    void appendValue(int column, const QVariant &value);
+    void appendNull(int column);
+    void convertToVariants(int column);
+    void appendInt64(int column, qint64 value)
+    {
+        columns[column].int64s.append(value);
+        columns[column].nulls.append(false);
+    }
+    void appendDouble(int column, double value)
+    {
+        columns[column].doubles.append(value);
+        columns[column].nulls.append(false);
+    }
+    void appendString(int column, const QString &value)
+    {
+        columns[column].strings.append(value);
+        columns[column].nulls.append(false);
+    }
+    void appendByteArray(int column, const QByteArray &value)
+    {
+        columns[column].byteArrays.append(value);
+        columns[column].nulls.append(false);
+    }
+    void finishRow() { ++rowCount; }
+
+    QList<Column> columns;
+    int rowCount = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSQLCOLUMNBATCH_P_H
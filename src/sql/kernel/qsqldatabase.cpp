@@ -1181,6 +1181,8 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li tty
     \li requiressl
     \li service
+    \li QPSQL_BINARY_RESULTS
+    \li QPSQL_PIPELINED_BATCH
     \endlist
 
     \header \li DB2 \li OCI
@@ -1208,6 +1210,7 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li QSQLITE_OPEN_URI
     \li QSQLITE_ENABLE_SHARED_CACHE
     \li QSQLITE_ENABLE_REGEXP
+    \li QSQLITE_STATEMENT_CACHE_SIZE
     \endlist
 
     \li
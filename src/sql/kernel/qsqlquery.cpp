@@ -45,6 +45,7 @@
 #include "qdebug.h"
 #include "qelapsedtimer.h"
 #include "qmap.h"
+#include "qsqlcolumnbatch.h"
 #include "qsqlrecord.h"
 #include "qsqlresult.h"
 #include "qsqldriver.h"
@@ -666,6 +667,42 @@ bool QSqlQuery::next()
     }
 }
 
+/*!
+  \since 6.0
+
+  Retrieves up to \a maxRows records following the current one into
+  \a batch, which stores their values column by column. Returns \c true
+  if at least one record was retrieved; \a batch then holds the records
+  and the query is positioned on the last of them. If fewer than
+  \a maxRows records are left, the query is positioned after the last
+  record.
+
+  This is equivalent to calling next() up to \a maxRows times and
+  value() for every field, but drivers can fill the typed columns of
+  \a batch without creating a QVariant for each field. This makes it
+  the fastest way to scan large results. The PostgreSQL driver does so,
+  and the SQLite driver for forward-only queries; otherwise the values
+  are read with value().
+
+  Set the query to \l{setForwardOnly()}{forward only} mode before
+  executing it, so that the records don't have to be cached; together
+  with nextBatch() this streams the result with constant memory use.
+
+  \snippet sqldatabase/sqldatabase.cpp 49
+
+  \sa next(), QSqlColumnBatch
+*/
+bool QSqlQuery::nextBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    if (!batch)
+        return false;
+    if (!isSelect() || !isActive() || maxRows <= 0) {
+        batch->clear();
+        return false;
+    }
+    return d->sqlResult->fetchBatch(batch, maxRows);
+}
+
 /*!
 
   Retrieves the previous record in the result, if available, and
@@ -48,6 +48,7 @@
 QT_BEGIN_NAMESPACE
 
 
+class QSqlColumnBatch;
 class QSqlDriver;
 class QSqlError;
 class QSqlResult;
@@ -90,6 +91,7 @@ public:
 
     bool seek(int i, bool relative = false);
     bool next();
+    bool nextBatch(QSqlColumnBatch *batch, int maxRows);
     bool previous();
     bool first();
     bool last();
@@ -42,6 +42,7 @@
 #include "qhash.h"
 #include "qlist.h"
 #include "qpointer.h"
+#include "qsqlcolumnbatch_p.h"
 #include "qsqldriver.h"
 #include "qsqlerror.h"
 #include "qsqlfield.h"
@@ -991,6 +992,43 @@ bool QSqlResult::nextResult()
     return false;
 }
 
+/*! \internal
+
+    Retrieves up to \a maxRows records following the current one into
+    \a batch and positions the result on the last retrieved record, or
+    after the last record if there are no more records. Returns \c true
+    if at least one record was retrieved.
+
+    The default implementation calls fetchFirst() or fetchNext() and
+    data() for each record. Drivers can reimplement it to fill the batch
+    without creating a QVariant for each field.
+*/
+bool QSqlResult::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    QSqlColumnBatchPrivate *b = QSqlColumnBatchPrivate::get(batch);
+    b->reset(record(), maxRows);
+    const int columnCount = b->columns.count();
+    while (b->rowCount < maxRows) {
+        bool fetched = false;
+        if (at() == QSql::BeforeFirstRow)
+            fetched = fetchFirst();
+        else if (at() != QSql::AfterLastRow)
+            fetched = fetchNext();
+        if (!fetched) {
+            setAt(QSql::AfterLastRow);
+            break;
+        }
+        for (int i = 0; i < columnCount; ++i) {
+            if (isNull(i))
+                b->appendNull(i);
+            else
+                b->appendValue(i, data(i));
+        }
+        b->finishRow();
+    }
+    return b->rowCount > 0;
+}
+
 /*!
     Returns the low-level database handle for this result set
     wrapped in a QVariant or an invalid QVariant if there is no handle.
@@ -51,6 +51,7 @@ QT_BEGIN_NAMESPACE
 
 
 class QString;
+class QSqlColumnBatch;
 class QSqlRecord;
 class QVariant;
 class QSqlDriver;
@@ -133,6 +134,7 @@ protected:
     virtual void setNumericalPrecisionPolicy(QSql::NumericalPrecisionPolicy policy);
     QSql::NumericalPrecisionPolicy numericalPrecisionPolicy() const;
     virtual bool nextResult();
+    virtual bool fetchBatch(QSqlColumnBatch *batch, int maxRows);
     void resetBindCount(); // HACK
 
     QSqlResultPrivate *d_ptr;
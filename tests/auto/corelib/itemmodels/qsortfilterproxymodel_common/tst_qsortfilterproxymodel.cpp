@@ -5093,4 +5093,127 @@ void tst_QSortFilterProxyModel::invalidateColumnsOrRowsFilter()
     QCOMPARE(proxy.rowFiltered, 20);
 }
 
+class NumberListModel : public QAbstractListModel
+{
+public:
+    explicit NumberListModel(int count)
+    {
+        values.reserve(count);
+        for (int i = 0; i < count; ++i)
+            values.append(i * 7919 % 5003);
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : values.size();
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role != Qt::DisplayRole)
+            return QVariant();
+        return QString::number(values.at(index.row()));
+    }
+
+    // Changes every step-th value and reports it with a single dataChanged()
+    void changeValues(int step, int delta)
+    {
+        for (int i = 0; i < values.size(); i += step)
+            values[i] = (values.at(i) + delta) % 5003;
+        emit dataChanged(index(0), index(values.size() - 1));
+    }
+
+    QList<int> values;
+};
+
+static QList<int> proxySourceRows(const QSortFilterProxyModel &proxy)
+{
+    QList<int> rows;
+    rows.reserve(proxy.rowCount());
+    for (int row = 0; row < proxy.rowCount(); ++row)
+        rows.append(proxy.mapToSource(proxy.index(row, 0)).row());
+    return rows;
+}
+
+void tst_QSortFilterProxyModel::parallelSortFilter()
+{
+    // Large enough for the parallel code paths to kick in; the values
+    // repeat, so this also checks that sorting stays stable
+    NumberListModel model(20000);
+
+    QSortFilterProxyModel serial;
+    QSortFilterProxyModel parallel;
+    QCOMPARE(parallel.isParallelSortFilterEnabled(), false);
+    QSignalSpy spy(&parallel, &QSortFilterProxyModel::parallelSortFilterEnabledChanged);
+    parallel.setParallelSortFilterEnabled(true);
+    QVERIFY(parallel.isParallelSortFilterEnabled());
+    QCOMPARE(spy.count(), 1);
+    parallel.setParallelSortFilterEnabled(true);
+    QCOMPARE(spy.count(), 1);
+
+    for (QSortFilterProxyModel *proxy : {&serial, &parallel}) {
+        proxy->setSourceModel(&model);
+        setupFilter(proxy, QLatin1String("[1-6]$"));
+        proxy->sort(0);
+    }
+    QVERIFY(serial.rowCount() > 10000);
+    QCOMPARE(proxySourceRows(parallel), proxySourceRows(serial));
+
+    for (QSortFilterProxyModel *proxy : {&serial, &parallel})
+        proxy->sort(0, Qt::DescendingOrder);
+    QCOMPARE(proxySourceRows(parallel), proxySourceRows(serial));
+
+    for (QSortFilterProxyModel *proxy : {&serial, &parallel})
+        setupFilter(proxy, QLatin1String("[2-8]$"));
+    QCOMPARE(proxySourceRows(parallel), proxySourceRows(serial));
+
+    // filtering and re-sorting of a dataChanged() covering all rows
+    model.changeValues(3, 17);
+    QCOMPARE(proxySourceRows(parallel), proxySourceRows(serial));
+    model.changeValues(1, 4999);
+    QCOMPARE(proxySourceRows(parallel), proxySourceRows(serial));
+
+    for (int row = 1; row < parallel.rowCount(); ++row) {
+        QVERIFY(parallel.index(row, 0).data().toString()
+                <= parallel.index(row - 1, 0).data().toString());
+    }
+}
+
+void tst_QSortFilterProxyModel::resortOnlyChangedRows()
+{
+    class CountingProxy : public QSortFilterProxyModel
+    {
+    public:
+        bool lessThan(const QModelIndex &left, const QModelIndex &right) const override
+        {
+            ++comparisons;
+            return QSortFilterProxyModel::lessThan(left, right);
+        }
+
+        mutable int comparisons = 0;
+    };
+
+    QStringList strings;
+    for (int i = 0; i < 10000; ++i)
+        strings.append(QString::asprintf("%05d", i));
+    QStringListModel model(strings);
+    CountingProxy proxy;
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+    QCOMPARE(proxy.index(0, 0).data().toString(), QLatin1String("00000"));
+
+    // Moving a single row must not compare all the others again
+    QSignalSpy layoutSpy(&proxy, &QSortFilterProxyModel::layoutChanged);
+    proxy.comparisons = 0;
+    model.setData(model.index(0, 0), QLatin1String("05000x"));
+    QCOMPARE(layoutSpy.count(), 1);
+    QVERIFY2(proxy.comparisons < 100, QByteArray::number(proxy.comparisons));
+    QCOMPARE(proxy.index(0, 0).data().toString(), QLatin1String("00001"));
+    QCOMPARE(proxy.index(4999, 0).data().toString(), QLatin1String("05000"));
+    QCOMPARE(proxy.index(5000, 0).data().toString(), QLatin1String("05000x"));
+    QCOMPARE(proxy.index(5001, 0).data().toString(), QLatin1String("05001"));
+    QCOMPARE(proxy.mapToSource(proxy.index(5000, 0)).row(), 0);
+    QCOMPARE(proxy.mapFromSource(model.index(5001, 0)).row(), 5001);
+}
+
 #include "tst_qsortfilterproxymodel.moc"
@@ -5,6 +5,7 @@ SUBDIRS=\
     qelapsedtimer \
     qeventdispatcher \
     qeventloop \
+    qeventpool \
     qmath \
     qmetacontainer \
     qmetaobject \
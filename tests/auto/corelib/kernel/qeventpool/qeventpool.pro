@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qeventpool
+QT = core core-private testlib
+SOURCES = tst_qeventpool.cpp
@@ -0,0 +1,182 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qthread.h>
+#include <QtCore/private/qeventpool_p.h>
+
+class tst_QEventPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void reuseInSameThread();
+    void releaseFromOtherThread();
+    void oversized();
+    void releaseAfterOwnerExit();
+    void exitedThreadsReleasePools();
+    void pooledEvents();
+};
+
+// a size no event of the test harness uses, so that the free list it maps
+// to only ever contains what the tests put there
+static constexpr size_t TestSize = 200;
+
+void tst_QEventPool::reuseInSameThread()
+{
+    const QEventPool::Statistics before = QEventPool::statistics();
+
+    void *first = QEventPool::allocate(TestSize);
+    QVERIFY(first);
+    QCOMPARE(quintptr(first) % alignof(std::max_align_t), quintptr(0));
+    memset(first, 0xff, TestSize);
+    QEventPool::deallocate(first);
+
+    void *second = QEventPool::allocate(TestSize);
+    QCOMPARE(second, first);
+    QEventPool::deallocate(second);
+
+    const QEventPool::Statistics after = QEventPool::statistics();
+    QCOMPARE(after.allocations - before.allocations, quint64(2));
+    QCOMPARE(after.reused - before.reused, quint64(1));
+
+    QEventPool::deallocate(nullptr);
+}
+
+void tst_QEventPool::releaseFromOtherThread()
+{
+    // drain the local free list of the test size first
+    void *local = QEventPool::allocate(TestSize);
+
+    QList<void *> blocks;
+    for (int i = 0; i < 10; ++i)
+        blocks << QEventPool::allocate(TestSize);
+
+    QScopedPointer<QThread> thread(QThread::create([&blocks] {
+        for (void *block : qAsConst(blocks))
+            QEventPool::deallocate(block);
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    const QEventPool::Statistics before = QEventPool::statistics();
+    QList<void *> again;
+    for (int i = 0; i < 10; ++i) {
+        again << QEventPool::allocate(TestSize);
+        QVERIFY(blocks.contains(again.last()));
+    }
+    const QEventPool::Statistics after = QEventPool::statistics();
+    QCOMPARE(after.remoteReturns - before.remoteReturns, quint64(10));
+    QCOMPARE(after.reused - before.reused, quint64(10));
+
+    for (void *block : qAsConst(again))
+        QEventPool::deallocate(block);
+    QEventPool::deallocate(local);
+}
+
+void tst_QEventPool::oversized()
+{
+    const QEventPool::Statistics before = QEventPool::statistics();
+    void *block = QEventPool::allocate(4096);
+    QVERIFY(block);
+    memset(block, 0, 4096);
+    QEventPool::deallocate(block);
+    QCOMPARE(QEventPool::statistics().allocations, before.allocations);
+}
+
+void tst_QEventPool::releaseAfterOwnerExit()
+{
+    QList<void *> blocks;
+    QScopedPointer<QThread> owner(QThread::create([&blocks] {
+        for (int i = 0; i < 10; ++i)
+            blocks << QEventPool::allocate(TestSize);
+        QEventPool::deallocate(blocks.takeLast());
+    }));
+    const int poolsBefore = QEventPool::statistics().pools;
+    owner->start();
+    QVERIFY(owner->wait());
+    QCOMPARE(blocks.size(), 9);
+
+    // the owner's pool outlives the thread for as long as its blocks do;
+    // wait() may return before the thread has released it, and whatever the
+    // thread posted on its way out was allocated from it, too
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(QEventPool::statistics().pools, poolsBefore + 1);
+    for (void *block : qAsConst(blocks))
+        QEventPool::deallocate(block);
+    QTRY_COMPARE(QEventPool::statistics().pools, poolsBefore);
+}
+
+void tst_QEventPool::exitedThreadsReleasePools()
+{
+    const QEventPool::Statistics before = QEventPool::statistics();
+
+    for (int i = 0; i < 16; ++i) {
+        void *block = nullptr;
+        QScopedPointer<QThread> thread(QThread::create([&block] {
+            for (int j = 0; j < 4; ++j)
+                QEventPool::deallocate(QEventPool::allocate(TestSize));
+            block = QEventPool::allocate(TestSize);
+            QEventPool::deallocate(QEventPool::allocate(TestSize));
+        }));
+        thread->start();
+        QVERIFY(thread->wait());
+        QEventPool::deallocate(block);
+    }
+
+    QTRY_COMPARE(QEventPool::statistics().pools, before.pools);
+    const QEventPool::Statistics after = QEventPool::statistics();
+    // the counters of destroyed pools are kept
+    QCOMPARE(after.allocations - before.allocations, quint64(16 * 6));
+}
+
+void tst_QEventPool::pooledEvents()
+{
+    QObject receiver;
+    int calls = 0;
+
+    const QEventPool::Statistics before = QEventPool::statistics();
+    for (int i = 0; i < 2; ++i) {
+        QMetaObject::invokeMethod(&receiver, [&calls] { ++calls; }, Qt::QueuedConnection);
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    }
+    QCOMPARE(calls, 2);
+
+    QObject *deleted = new QObject;
+    QPointer<QObject> guard(deleted);
+    deleted->deleteLater();
+    QCoreApplication::sendPostedEvents(deleted, QEvent::DeferredDelete);
+    QVERIFY(guard.isNull());
+
+    const QEventPool::Statistics after = QEventPool::statistics();
+    QCOMPARE(after.allocations - before.allocations, quint64(3));
+    QVERIFY(after.reused - before.reused >= 1);
+}
+
+QTEST_MAIN(tst_QEventPool)
+#include "tst_qeventpool.moc"
@@ -33,6 +33,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QThread>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
@@ -40,6 +41,7 @@
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
+#include <private/qeventdispatcher_unix_p.h>
 #include <sys/select.h>
 #endif
 #include <limits>
@@ -58,6 +60,9 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+#endif
+#if defined(Q_OS_UNIX) && QT_CONFIG(epoll)
+    void epollDispatcher();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -316,6 +321,58 @@ void tst_QSocketNotifier::posixSockets()
 }
 #endif
 
+#if defined(Q_OS_UNIX) && QT_CONFIG(epoll)
+void tst_QSocketNotifier::epollDispatcher()
+{
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    QEventDispatcherUNIX *dispatcher = new QEventDispatcherUNIX;
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+    auto d = static_cast<QEventDispatcherUNIXPrivate *>(QObjectPrivate::get(dispatcher));
+    QVERIFY(d->epollFd >= 0);
+
+    int fds[2];
+    QCOMPARE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    QThread thread;
+    thread.setEventDispatcher(dispatcher);
+    thread.start();
+
+    QAtomicInt reads;
+    QAtomicInt writes;
+    QSocketNotifier *rn = new QSocketNotifier(fds[0], QSocketNotifier::Read);
+    QSocketNotifier *wn = new QSocketNotifier(fds[0], QSocketNotifier::Write);
+    connect(rn, &QSocketNotifier::activated, rn, [&reads](QSocketDescriptor fd) {
+        char buffer[16];
+        if (qt_safe_read(fd, buffer, sizeof(buffer)) > 0)
+            reads.ref();
+    });
+    // the socket is writable right away; disabling the notifier from its
+    // own activation exercises modifying an existing registration
+    connect(wn, &QSocketNotifier::activated, wn, [&writes, wn]() {
+        writes.ref();
+        wn->setEnabled(false);
+    });
+    rn->moveToThread(&thread);
+    wn->moveToThread(&thread);
+
+    QTRY_COMPARE(writes.loadRelaxed(), 1);
+
+    QCOMPARE(qt_safe_write(fds[1], "hello", 5), 5);
+    QTRY_COMPARE(reads.loadRelaxed(), 1);
+    QCOMPARE(qt_safe_write(fds[1], "again", 5), 5);
+    QTRY_COMPARE(reads.loadRelaxed(), 2);
+    QCOMPARE(writes.loadRelaxed(), 1);
+
+    rn->deleteLater();
+    wn->deleteLater();
+    thread.quit();
+    QVERIFY(thread.wait());
+
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+}
+#endif
+
 void tst_QSocketNotifier::async_readDatagramSlot()
 {
     char buf[1];
@@ -106,6 +106,7 @@ private Q_SLOTS:
     void fromJsonErrors();
     void parseNumbers();
     void parseStrings();
+    void parseStringsAcrossBlocks();
     void parseDuplicateKeys();
     void testParser();
 
@@ -2251,6 +2252,49 @@ void tst_QtJson::parseStrings()
 
 }
 
+void tst_QtJson::parseStringsAcrossBlocks()
+{
+    // the string scanner checks several bytes at a time; make sure escape
+    // sequences, non-ASCII characters and the closing quote are found at
+    // every position within and across such blocks
+    struct Pairs {
+        const char *in;
+        QString out;
+    };
+    const Pairs specials[] = {
+        { "", QString() },
+        { "\\n", QStringLiteral("\n") },
+        { "\\\"", QStringLiteral("\"") },
+        { "\\u0402", QStringLiteral(u"\u0402") },
+        { UNICODE_DJE, QStringLiteral(u"\u0402") },
+        { UNICODE_DJE "\\t", QStringLiteral(u"\u0402\t") },
+    };
+
+    for (const Pairs &special : specials) {
+        for (int prefix = 0; prefix < 40; ++prefix) {
+            for (int suffix : { 0, 1, 15, 16, 17, 33 }) {
+                QByteArray json = "[\"";
+                json += QByteArray(prefix, 'a');
+                json += special.in;
+                json += QByteArray(suffix, 'b');
+                json += "\"]";
+
+                QJsonParseError error;
+                QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+                QCOMPARE(error.error, QJsonParseError::NoError);
+                const QString expected = QString(prefix, u'a') + special.out
+                        + QString(suffix, u'b');
+                QCOMPARE(doc.array().at(0).toString(), expected);
+
+                // unterminated
+                json.chop(2);
+                doc = QJsonDocument::fromJson(json, &error);
+                QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+            }
+        }
+    }
+}
+
 void tst_QtJson::parseDuplicateKeys()
 {
     const char *json = "{ \"B\": true, \"A\": null, \"B\": false }";
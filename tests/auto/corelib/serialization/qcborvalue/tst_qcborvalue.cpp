@@ -106,6 +106,10 @@ private slots:
     void fromCborStreamReaderByteArray();
     void fromCborStreamReaderIODevice_data() { fromCbor_data(); }
     void fromCborStreamReaderIODevice();
+    void fromRawCbor_data() { fromCbor_data(); }
+    void fromRawCbor();
+    void fromRawCborLifetime();
+    void fromRawCborReadOnly();
     void validation_data();
     void validation();
     void extendedTypeValidation_data();
@@ -1988,6 +1992,100 @@ void tst_QCborValue::fromCborStreamReaderIODevice()
     fromCbor_common(doCheck);
 }
 
+void tst_QCborValue::fromRawCbor()
+{
+    auto doCheck = [](const QCborValue &expected, const QByteArray &data) {
+        QCborParserError error;
+        QCborValue decoded = QCborValue::fromRawCbor(QByteArray::fromRawData(data.constData(), data.size()),
+                                                     &error);
+        QVERIFY2(error.error == QCborError(), qPrintable(error.errorString()));
+        QCOMPARE(error.offset, data.size());
+        QVERIFY(decoded == expected);
+        QVERIFY(expected == decoded);
+    };
+
+    fromCbor_common(doCheck);
+}
+
+void tst_QCborValue::fromRawCborReadOnly()
+{
+    // modifying the decoded values never writes to the source buffer
+    QCborMap source;
+    source[QLatin1String("blob")] = QByteArray(100, 'b');
+    source[QLatin1String("text")] = QLatin1String("some text");
+    source[QLatin1String("nested")] = QCborArray{ QLatin1String("nested text"),
+                                                  QByteArray(100, 'n') };
+    const QByteArray encoded = source.toCborValue().toCbor();
+    QByteArray storage = encoded;
+    const QByteArray raw = QByteArray::fromRawData(storage.constData(), storage.size());
+
+    QCborValue decoded = QCborValue::fromRawCbor(raw);
+    QCOMPARE(decoded, source.toCborValue());
+    QCborMap map = decoded.toMap();
+    map[QLatin1String("text")] = QLatin1String("SOME TEXT");
+    map[QLatin1String("blob")] = QByteArray(100, 'B');
+    QCborArray nested = map.value(QLatin1String("nested")).toArray();
+    nested[0] = QLatin1String("NESTED TEXT");
+    nested.append(nested.at(1));
+    nested.removeAt(1);
+    map[QLatin1String("nested")] = nested;
+    decoded[QLatin1String("text")] = QCborValue(QCborKnownTags::Signature, QByteArray(9, 'X'));
+    QCOMPARE(storage, encoded);
+
+    QCOMPARE(map.value(QLatin1String("text")).toString(), QLatin1String("SOME TEXT"));
+    QCOMPARE(map.value(QLatin1String("nested")).toArray().at(1).toByteArray(), QByteArray(100, 'n'));
+    QCOMPARE(decoded.toMap().value(QLatin1String("blob")).toByteArray(), QByteArray(100, 'b'));
+}
+
+void tst_QCborValue::fromRawCborLifetime()
+{
+    const QByteArray blob(1000, 'b');
+    QCborMap source;
+    source[QLatin1String("blob")] = blob;
+    source[QLatin1String("text")] = QLatin1String("some text");
+    source[QLatin1String("utf8")] = QString::fromUtf8("\xc3\xa9t\xc3\xa9");
+    source[QLatin1String("empty")] = QByteArray("");
+    source[QLatin1String("nested")] = QCborArray{ blob, QLatin1String("nested text"),
+                                                  QCborValue(QCborKnownTags::Signature, blob) };
+    source[QLatin1String("url")] = QCborValue(QUrl("https://example.com/"));
+    const QCborValue expected = source.toCborValue();
+
+    QCborValue decoded;
+    {
+        // the decoded value must keep the data alive
+        QByteArray encoded = expected.toCbor();
+        QCborParserError error;
+        decoded = QCborValue::fromRawCbor(encoded, &error);
+        QCOMPARE(error.error, QCborError());
+        QCOMPARE(error.offset, encoded.size());
+    }
+    QCOMPARE(decoded, expected);
+
+    QCborMap map = decoded.toMap();
+    QCOMPARE(map.value(QLatin1String("blob")).toByteArray(), blob);
+    QCOMPARE(map.value(QLatin1String("utf8")).toString(), QString::fromUtf8("\xc3\xa9t\xc3\xa9"));
+    QCOMPARE(map.value(QLatin1String("nested")).toArray().at(1).toString(), QLatin1String("nested text"));
+    QCOMPARE(map.value(QLatin1String("url")).toUrl(), QUrl("https://example.com/"));
+
+    // values taken out of and copied into other containers stay valid
+    QCborValue taken = map.take(QLatin1String("blob"));
+    QCborArray other;
+    other.append(map.value(QLatin1String("text")));
+    other.append(taken);
+    map.insert(QLatin1String("more"), QLatin1String("inline text"));
+    decoded = QCborValue();
+    QCOMPARE(taken.toByteArray(), blob);
+    QCOMPARE(other.at(0).toString(), QLatin1String("some text"));
+    QCOMPARE(other.at(1).toByteArray(), blob);
+    QCOMPARE(map.value(QLatin1String("more")).toString(), QLatin1String("inline text"));
+    QCOMPARE(map.value(QLatin1String("nested")).toArray().at(0).toByteArray(), blob);
+
+    // strings with invalid UTF-8 are still rejected
+    QCborParserError error;
+    QCborValue::fromRawCbor(QByteArray("\x62\xc3\x28"), &error);
+    QCOMPARE(error.error, QCborError::InvalidUtf8String);
+}
+
 #include "../cborlargedatavalidation.cpp"
 
 void tst_QCborValue::validation_data()
@@ -2044,6 +2142,11 @@ void tst_QCborValue::validation()
     QCborValue decoded = QCborValue::fromCbor(data, &parserError);
     QCOMPARE(parserError.error, error);
 
+    // referencing the data instead of copying it skips some allocation
+    // limits, so the exact error may differ
+    QCborValue::fromRawCbor(data, &parserError);
+    QCOMPARE(parserError.error == QCborError::NoError, error == QCborError::NoError);
+
     if (data.startsWith('\x81')) {
         // decode without the array prefix
         char *ptr = const_cast<char *>(data.constData());
@@ -0,0 +1,525 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qjsonstreamreader.h>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tokens_data();
+    void tokens();
+    void tokensIncremental_data() { tokens_data(); }
+    void tokensIncremental();
+    void readValue_data();
+    void readValue();
+    void readValueIncomplete();
+    void readArrayElements();
+    void newlineDelimited();
+    void skipValue();
+    void skipValueIncomplete();
+    void finishInput();
+    void sequentialDevice();
+    void nestingLimit();
+    void maximumValueSize();
+    void errors_data();
+    void errors();
+};
+
+// A device that is read like a pipe or a socket
+class SequentialDevice : public QIODevice
+{
+public:
+    explicit SequentialDevice(const QByteArray &data) : data(data) { open(ReadOnly); }
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    { return data.size() + QIODevice::bytesAvailable(); }
+    void appendData(const QByteArray &more) { data += more; emit readyRead(); }
+
+protected:
+    qint64 readData(char *out, qint64 maxSize) override
+    {
+        maxSize = qMin(maxSize, qint64(data.size()));
+        memcpy(out, data.constData(), size_t(maxSize));
+        data.remove(0, maxSize);
+        return maxSize;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray data;
+};
+
+static QString dumpTokens(QJsonStreamReader &reader, bool incremental = false,
+                          const QByteArray &data = QByteArray())
+{
+    QStringList result;
+    qsizetype fed = 0;
+    while (true) {
+        QJsonStreamReader::TokenType token = reader.readNext();
+        if (token == QJsonStreamReader::NoToken && incremental && fed < data.size()) {
+            reader.addData(data.mid(fed++, 1));
+            continue;
+        }
+        switch (token) {
+        case QJsonStreamReader::StartObject:    result << "{"; break;
+        case QJsonStreamReader::EndObject:      result << "}"; break;
+        case QJsonStreamReader::StartArray:     result << "["; break;
+        case QJsonStreamReader::EndArray:       result << "]"; break;
+        case QJsonStreamReader::Name:           result << reader.name() + ':'; break;
+        case QJsonStreamReader::String:         result << '"' + reader.value().toString() + '"'; break;
+        case QJsonStreamReader::Number:         result << QString::number(reader.value().toDouble()); break;
+        case QJsonStreamReader::Bool:           result << (reader.value().toBool() ? "true" : "false"); break;
+        case QJsonStreamReader::Null:           result << "null"; break;
+        case QJsonStreamReader::EndDocument:
+            if (incremental && fed < data.size()) {
+                reader.addData(data.mid(fed++, 1));
+                continue;
+            }
+            return result.join(' ');
+        case QJsonStreamReader::NoToken:
+            return result.join(' ') + " <incomplete>";
+        case QJsonStreamReader::Invalid:
+            return result.join(' ') + " <" + reader.errorString() + '>';
+        }
+    }
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty-object") << QByteArray("{}\n") << "{ }";
+    QTest::newRow("empty-array") << QByteArray(" [ ] ") << "[ ]";
+    QTest::newRow("object")
+            << QByteArray("{\"a\": 1, \"b\" : \"text\", \"c\":true,\"d\":null}\n")
+            << "{ a: 1 b: \"text\" c: true d: null }";
+    QTest::newRow("nested")
+            << QByteArray("[1, [2, {\"x\": [false]}], {}, -2.5e1]\n")
+            << "[ 1 [ 2 { x: [ false ] } ] { } -25 ]";
+    QTest::newRow("escapes")
+            << QByteArray("[\"a\\\"b\\\\c\\u0041\\n\"]")
+            << "[ \"a\"b\\cA\n\" ]";
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbf[true]") << "[ true ]";
+    QTest::newRow("sequence")
+            << QByteArray("{\"n\":1}\n{\"n\":2}\n[3]\n\"four\"\n")
+            << "{ n: 1 } { n: 2 } [ 3 ] \"four\"";
+    QTest::newRow("utf8") << QByteArray("[\"\xd0\x82\"]") << QString::fromUtf8("[ \"\xd0\x82\" ]");
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(dumpTokens(reader), expected);
+    QVERIFY(!reader.hasError());
+    QVERIFY(reader.atEnd());
+
+    QBuffer buffer(&json);
+    buffer.open(QIODevice::ReadOnly);
+    QJsonStreamReader deviceReader(&buffer);
+    QCOMPARE(dumpTokens(deviceReader), expected);
+}
+
+void tst_QJsonStreamReader::tokensIncremental()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader;
+    QCOMPARE(dumpTokens(reader, true, json), expected);
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QJsonStreamReader::readValue_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("object") << QByteArray("{\"a\": 1, \"b\": [true, null, \"x\"], \"c\": {}}");
+    QTest::newRow("array") << QByteArray("[1, 2.5, \"three\", {\"four\": [4]}]");
+    QTest::newRow("strings-with-brackets") << QByteArray("{\"a\": \"}]\\\"[{\"}");
+    QTest::newRow("duplicate-keys") << QByteArray("{\"a\": 1, \"a\": 2}");
+}
+
+void tst_QJsonStreamReader::readValue()
+{
+    QFETCH(QByteArray, json);
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    QVERIFY(!doc.isNull());
+    const QJsonValue expected = doc.isObject() ? QJsonValue(doc.object())
+                                               : QJsonValue(doc.array());
+
+    QJsonStreamReader reader(json + '\n');
+    QCOMPARE(reader.readValue(), expected);
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.tokenType(), doc.isObject() ? QJsonStreamReader::EndObject
+                                                : QJsonStreamReader::EndArray);
+    QCOMPARE(reader.depth(), 0);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // the same, nested in another array; readValue() reads the container
+    // that the current token opens
+    QByteArray nested = "[" + json + ", " + json + "]";
+    QBuffer buffer(&nested);
+    buffer.open(QIODevice::ReadOnly);
+    QJsonStreamReader deviceReader(&buffer);
+    const QJsonStreamReader::TokenType start = doc.isObject() ? QJsonStreamReader::StartObject
+                                                              : QJsonStreamReader::StartArray;
+    QCOMPARE(deviceReader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(deviceReader.readNext(), start);
+    QCOMPARE(deviceReader.readValue(), expected);
+    QCOMPARE(deviceReader.readNext(), start);
+    QCOMPARE(deviceReader.readValue(), expected);
+    QCOMPARE(deviceReader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(deviceReader.readNext(), QJsonStreamReader::EndDocument);
+
+    buffer.seek(0);
+    deviceReader.setDevice(&buffer);
+    QCOMPARE(deviceReader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(deviceReader.readValue(), QJsonValue(QJsonArray({ expected, expected })));
+}
+
+void tst_QJsonStreamReader::readValueIncomplete()
+{
+    const QByteArray json = "{\"key\": [1, 2, 3], \"other\": \"value\"}\n";
+    for (int split = 1; split < json.size() - 1; ++split) {
+        QJsonStreamReader reader(json.left(split));
+        QJsonValue value = reader.readValue();
+        QVERIFY2(value.isUndefined(), qPrintable(QString::number(split)));
+        QVERIFY(!reader.hasError());
+        QVERIFY(reader.atEnd());
+
+        reader.addData(json.mid(split));
+        QVERIFY(!reader.atEnd());
+        value = reader.readValue();
+        QVERIFY(!reader.hasError());
+        QCOMPARE(value.toObject().value("other").toString(), QLatin1String("value"));
+        QCOMPARE(value.toObject().value("key").toArray().size(), 3);
+    }
+}
+
+void tst_QJsonStreamReader::readArrayElements()
+{
+    const QByteArray json = "[1, {\"a\": [2]}, [3, [4]], \"five\", null, {}]";
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QJsonArray elements;
+    while (reader.readNext() != QJsonStreamReader::EndArray && !reader.hasError()) {
+        const QJsonValue element = reader.value().isUndefined() ? reader.readValue()
+                                                                 : reader.value();
+        elements.append(element);
+        QCOMPARE(reader.depth(), 1);
+    }
+    QVERIFY(!reader.hasError());
+    QCOMPARE(elements, QJsonDocument::fromJson(json).array());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::newlineDelimited()
+{
+    QByteArray data;
+    for (int i = 0; i < 10000; ++i)
+        data += "{\"id\":" + QByteArray::number(i) + ",\"text\":\"line " + QByteArray::number(i) + "\"}\n";
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QJsonStreamReader reader(&buffer);
+    int count = 0;
+    while (!reader.atEnd()) {
+        const QJsonValue record = reader.readValue();
+        QVERIFY(!reader.hasError());
+        if (record.isUndefined())
+            continue;
+        QCOMPARE(record.toObject().value("id").toInt(), count);
+        ++count;
+    }
+    QCOMPARE(count, 10000);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::skipValue()
+{
+    QJsonStreamReader reader(QByteArray("{\"skip\": {\"a\": [1, {\"b\": 2}]}, \"keep\": 42}"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.name(), QLatin1String("skip"));
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.name(), QLatin1String("keep"));
+    QCOMPARE(reader.readValue(), QJsonValue(42));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+
+    // skips the container that the current token opens
+    QJsonStreamReader current(QByteArray("[[1, [2]], 3]"));
+    QCOMPARE(current.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(current.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(current.skipValue());
+    QCOMPARE(current.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(current.depth(), 1);
+    QCOMPARE(current.readValue(), QJsonValue(3));
+}
+
+void tst_QJsonStreamReader::skipValueIncomplete()
+{
+    const QByteArray json = "{\"a\": [1, {\"b\": 2}], \"c\": \"}]\"}\n[3]\n";
+    const qsizetype firstEnd = json.indexOf('\n');
+    for (int split = 1; split < json.size(); ++split) {
+        QJsonStreamReader reader(json.left(split));
+        const bool skipped = reader.skipValue();
+        QCOMPARE(skipped, split >= firstEnd);
+        QVERIFY(!reader.hasError());
+        QCOMPARE(reader.depth(), 0);
+        if (!skipped) {
+            // back in front of the value
+            QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+            QCOMPARE(reader.offset(), 0);
+            QVERIFY(reader.atEnd());
+        }
+
+        reader.addData(json.mid(split));
+        if (!skipped)
+            QVERIFY(reader.skipValue());
+        QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+        QCOMPARE(reader.readValue(), QJsonValue(QJsonArray({ 3 })));
+    }
+}
+
+void tst_QJsonStreamReader::finishInput()
+{
+    // a number can only end once the input does
+    QJsonStreamReader reader(QByteArray("1 22"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+    QVERIFY(reader.atEnd());
+    reader.finishInput();
+    QVERIFY(!reader.atEnd());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.value(), QJsonValue(22));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QVERIFY(reader.atEnd());
+
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamReader: addData() after finishInput()");
+    reader.addData("3");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // incomplete input becomes an error
+    QJsonStreamReader incomplete(QByteArray("[1, 2"));
+    QVERIFY(incomplete.readValue().isUndefined());
+    QVERIFY(!incomplete.hasError());
+    incomplete.finishInput();
+    QVERIFY(incomplete.readValue().isUndefined());
+    QCOMPARE(incomplete.error(), QJsonParseError::UnterminatedArray);
+
+    QJsonStreamReader skipped(QByteArray("{\"a\": 1"));
+    QVERIFY(!skipped.skipValue());
+    QVERIFY(!skipped.hasError());
+    skipped.finishInput();
+    QVERIFY(!skipped.skipValue());
+    QCOMPARE(skipped.error(), QJsonParseError::UnterminatedObject);
+
+    // clear() starts over
+    reader.clear();
+    reader.addData("4");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+}
+
+void tst_QJsonStreamReader::sequentialDevice()
+{
+    SequentialDevice device("[1, 2] 3");
+    QJsonStreamReader reader(&device);
+    QCOMPARE(reader.readValue(), QJsonValue(QJsonArray({ 1, 2 })));
+    // more data may still arrive
+    QVERIFY(reader.readValue().isUndefined());
+    QVERIFY(!reader.hasError());
+    QVERIFY(reader.atEnd());
+    device.appendData("4 5");
+    QCOMPARE(reader.readValue(), QJsonValue(34));
+    QVERIFY(reader.readValue().isUndefined());
+    QVERIFY(!reader.hasError());
+
+    emit device.readChannelFinished();
+    QCOMPARE(reader.readValue(), QJsonValue(5));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QVERIFY(reader.atEnd());
+
+    // incomplete input is an error once the read channel is closed
+    const QByteArray truncated = "{\"a\": [1";
+    SequentialDevice truncatedDevice(truncated);
+    reader.setDevice(&truncatedDevice);
+    QVERIFY(reader.readValue().isUndefined());
+    QVERIFY(!reader.hasError());
+    emit truncatedDevice.readChannelFinished();
+    QVERIFY(reader.readValue().isUndefined());
+    QCOMPARE(reader.error(), QJsonParseError::UnterminatedArray);
+
+    // or once finishInput() was called
+    SequentialDevice unfinishedDevice(truncated);
+    reader.setDevice(&unfinishedDevice);
+    QVERIFY(!reader.skipValue());
+    QVERIFY(!reader.hasError());
+    reader.finishInput();
+    QVERIFY(!reader.skipValue());
+    QCOMPARE(reader.error(), QJsonParseError::UnterminatedArray);
+}
+
+void tst_QJsonStreamReader::nestingLimit()
+{
+    // the limit counts the containers the value is nested in
+    const auto nested = [](int depth) {
+        return QByteArray(depth, '[') + QByteArray(depth, ']');
+    };
+    const QByteArray atLimit = nested(1024);
+    const QByteArray aboveLimit = nested(1025);
+    for (int outer : { 1, 1000 }) {
+        for (bool skip : { false, true }) {
+            QJsonStreamReader reader(atLimit);
+            for (int i = 0; i < outer; ++i)
+                QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+            if (skip)
+                QVERIFY(reader.skipValue());
+            else
+                QVERIFY(reader.readValue().isArray());
+            QVERIFY(!reader.hasError());
+
+            reader.clear();
+            reader.addData(aboveLimit);
+            for (int i = 0; i < outer; ++i)
+                QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+            if (skip)
+                QVERIFY(!reader.skipValue());
+            else
+                QVERIFY(reader.readValue().isUndefined());
+            QCOMPARE(reader.error(), QJsonParseError::DeepNesting);
+        }
+    }
+}
+
+void tst_QJsonStreamReader::maximumValueSize()
+{
+    const qsizetype limit = 64 * 1024;
+    const QByteArray longString = '"' + QByteArray(2 * limit, 'x') + '"';
+    const QByteArray shortString = '"' + QByteArray(limit / 2, 'x') + '"';
+    const auto arrayOf = [](const QByteArray &element, int count) {
+        QByteArray array = "[" + element;
+        for (int i = 1; i < count; ++i)
+            array += "," + element;
+        return array + "]";
+    };
+
+    QJsonStreamReader reader;
+    QCOMPARE(reader.maximumValueSize(), qsizetype(128 * 1024 * 1024));
+
+    // read from a device in chunks
+    QByteArray data = shortString + longString;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    reader.setDevice(&buffer);
+    reader.setMaximumValueSize(limit);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.value().toString().size(), shortString.size() - 2);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonParseError::DocumentTooLarge);
+    QCOMPARE(reader.offset(), qint64(shortString.size()));
+
+    // added in chunks
+    for (int mode = 0; mode < 3; ++mode) {
+        reader.clear();
+        reader.setMaximumValueSize(limit);
+        const QByteArray json = mode ? arrayOf("1234567", limit / 8) : longString;
+        bool failed = false;
+        for (qsizetype fed = 0; fed < json.size() && !failed; fed += 4096) {
+            reader.addData(json.mid(fed, 4096));
+            if (mode == 2)
+                failed = !reader.skipValue() && reader.hasError();
+            else if (mode == 1)
+                failed = reader.readValue().isUndefined() && reader.hasError();
+            else
+                failed = reader.readNext() == QJsonStreamReader::Invalid;
+        }
+        QVERIFY(failed);
+        QCOMPARE(reader.error(), QJsonParseError::DocumentTooLarge);
+    }
+
+    // smaller values are read
+    reader.clear();
+    reader.setMaximumValueSize(limit);
+    reader.addData(arrayOf("1234567", limit / 16) + shortString);
+    QCOMPARE(reader.readValue().toArray().size(), limit / 16);
+    QVERIFY(reader.skipValue());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    QTest::newRow("missing-object") << QByteArray("[1,]") << QJsonParseError::MissingObject;
+    QTest::newRow("missing-name-sep") << QByteArray("{\"a\" 1}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("missing-value-sep") << QByteArray("[1 2]") << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("unterminated-object") << QByteArray("{\"a\":1") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("unterminated-array") << QByteArray("[1, 2") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("unterminated-string") << QByteArray("[\"abc") << QJsonParseError::UnterminatedString;
+    QTest::newRow("illegal-value") << QByteArray("[tru]") << QJsonParseError::IllegalValue;
+    QTest::newRow("illegal-number") << QByteArray("[1e]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("illegal-escape") << QByteArray("[\"\\u12\"]") << QJsonParseError::IllegalEscapeSequence;
+    QTest::newRow("illegal-utf8") << QByteArray("[\"\xff\"]") << QJsonParseError::IllegalUTF8String;
+    QTest::newRow("deep-nesting") << QByteArray(2000, '[') << QJsonParseError::DeepNesting;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    // the device is read to its end, so incomplete input is an error
+    QBuffer buffer(&json);
+    buffer.open(QIODevice::ReadOnly);
+    QJsonStreamReader reader(&buffer);
+    while (!reader.atEnd())
+        reader.readNext();
+    QVERIFY(reader.hasError());
+    QCOMPARE(reader.error(), error);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QVERIFY(!reader.errorString().isEmpty());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
@@ -0,0 +1,5 @@
+QT = core testlib
+TARGET = tst_qjsonstreamwriter
+CONFIG += testcase
+SOURCES += \
+    tst_qjsonstreamwriter.cpp
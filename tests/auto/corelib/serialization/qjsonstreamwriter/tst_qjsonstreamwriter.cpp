@@ -0,0 +1,225 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qjsonstreamreader.h>
+#include <QtCore/qjsonstreamwriter.h>
+#include <QtCore/qregularexpression.h>
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesDocument_data();
+    void matchesDocument();
+    void writeValue_data() { matchesDocument_data(); }
+    void writeValue();
+    void scalars();
+    void newlineDelimited();
+    void device();
+};
+
+static const char documentJson[] =
+        "{\"name\": \"text with \\\"quotes\\\" and \\u0001 control\","
+        " \"numbers\": [0, -1, 1.5, 1e100, 9007199254740992],"
+        " \"empty\": {}, \"emptyArray\": [],"
+        " \"nested\": {\"flags\": [true, false, null], \"deeper\": [[{}], {\"x\": \"\xc3\xa9\"}]}}";
+
+void tst_QJsonStreamWriter::matchesDocument_data()
+{
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+
+    QTest::newRow("compact") << QJsonDocument::Compact;
+    QTest::newRow("indented") << QJsonDocument::Indented;
+}
+
+static void writeExpected(QJsonStreamWriter &writer)
+{
+    writer.writeStartObject();
+    writer.writeName(u"empty");
+    writer.writeStartObject();
+    writer.writeEndObject();
+    writer.writeName(u"emptyArray");
+    writer.writeStartArray();
+    writer.writeEndArray();
+    writer.writeName(u"name");
+    writer.writeString(u"text with \"quotes\" and \u0001 control");
+    writer.writeName(u"nested");
+    writer.writeStartObject();
+    writer.writeName(u"deeper");
+    writer.writeStartArray();
+    writer.writeStartArray();
+    writer.writeStartObject();
+    writer.writeEndObject();
+    writer.writeEndArray();
+    writer.writeStartObject();
+    writer.writeName(u"x");
+    writer.writeString(QString::fromUtf8("\xc3\xa9"));
+    writer.writeEndObject();
+    writer.writeEndArray();
+    writer.writeName(u"flags");
+    writer.writeStartArray();
+    writer.writeBool(true);
+    writer.writeBool(false);
+    writer.writeNull();
+    writer.writeEndArray();
+    writer.writeEndObject();
+    writer.writeName(u"numbers");
+    writer.writeStartArray();
+    writer.writeInteger(0);
+    writer.writeInteger(-1);
+    writer.writeDouble(1.5);
+    writer.writeDouble(1e100);
+    writer.writeDouble(9007199254740992.);
+    writer.writeEndArray();
+    writer.writeEndObject();
+}
+
+// QJsonObject sorts its keys; the stream writer keeps the order they are
+// written in, so the expected output is built in the same (sorted) order.
+void tst_QJsonStreamWriter::matchesDocument()
+{
+    QFETCH(QJsonDocument::JsonFormat, format);
+    const QJsonDocument doc = QJsonDocument::fromJson(documentJson);
+    QVERIFY(doc.isObject());
+    QByteArray expected = doc.toJson(format);
+    if (format == QJsonDocument::Compact)
+        expected += '\n';
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    QCOMPARE(writer.format(), format);
+    writeExpected(writer);
+    writer.flush();
+    QVERIFY(!writer.hasError());
+    QCOMPARE(output, expected);
+}
+
+void tst_QJsonStreamWriter::writeValue()
+{
+    QFETCH(QJsonDocument::JsonFormat, format);
+    const QJsonDocument doc = QJsonDocument::fromJson(documentJson);
+    const QJsonObject object = doc.object();
+
+    // whole value at top level
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    writer.writeValue(object);
+    writer.flush();
+    QByteArray expected = doc.toJson(format);
+    if (format == QJsonDocument::Compact)
+        expected += '\n';
+    QCOMPARE(output, expected);
+
+    // member values written one at a time
+    output.clear();
+    writer.writeStartObject();
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        writer.writeName(it.key());
+        writer.writeValue(it.value());
+    }
+    writer.writeEndObject();
+    writer.flush();
+    QCOMPARE(output, expected);
+}
+
+void tst_QJsonStreamWriter::scalars()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.writeStartArray();
+    writer.writeString(u"\t\n\\/");
+    writer.writeInteger(std::numeric_limits<qint64>::min());
+    writer.writeDouble(-0.25);
+    writer.writeDouble(qQNaN());
+    writer.writeValue(QJsonValue(QJsonValue::Undefined));
+    writer.writeEndArray();
+    writer.flush();
+    QCOMPARE(output, QByteArray("[\"\\t\\n\\\\/\",-9223372036854775808,-0.25,null,null]\n"));
+}
+
+void tst_QJsonStreamWriter::newlineDelimited()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    for (int i = 0; i < 3; ++i) {
+        writer.writeStartObject();
+        writer.writeName(u"id");
+        writer.writeInteger(i);
+        writer.writeEndObject();
+    }
+    writer.writeString(u"last");
+    writer.flush();
+    QCOMPARE(output, QByteArray("{\"id\":0}\n{\"id\":1}\n{\"id\":2}\n\"last\"\n"));
+
+    QJsonStreamReader reader(output);
+    for (int i = 0; i < 3; ++i)
+        QCOMPARE(reader.readValue().toObject().value("id").toInt(), i);
+    QCOMPARE(reader.readValue(), QJsonValue("last"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    {
+        QJsonStreamWriter writer(&buffer);
+        QCOMPARE(writer.device(), &buffer);
+        writer.writeStartArray();
+        // enough to go through more than one internal flush
+        for (int i = 0; i < 10000; ++i)
+            writer.writeString(QString::number(i).repeated(4));
+        writer.writeEndArray();
+        QVERIFY(!writer.hasError());
+    }
+    buffer.close();
+
+    const QJsonDocument doc = QJsonDocument::fromJson(buffer.data());
+    QVERIFY(doc.isArray());
+    QCOMPARE(doc.array().size(), 10000);
+    QCOMPARE(doc.array().at(9999).toString(), QLatin1String("9999999999999999"));
+
+    QBuffer readOnly;
+    readOnly.open(QIODevice::ReadOnly);
+    QJsonStreamWriter failing(&readOnly);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("ReadOnly device"));
+    failing.writeNull();
+    failing.flush();
+    QVERIFY(failing.hasError());
+}
+
+QTEST_MAIN(tst_QJsonStreamWriter)
+#include "tst_qjsonstreamwriter.moc"
@@ -57,6 +57,9 @@ private slots:
     void utf8stateful_data();
     void utf8stateful();
 
+    void utf8Runs_data();
+    void utf8Runs();
+
     void utfHeaders_data();
     void utfHeaders();
 
@@ -1420,6 +1423,79 @@ void tst_QStringConverter::utf8stateful()
     }
 }
 
+void tst_QStringConverter::utf8Runs_data()
+{
+    QTest::addColumn<QString>("text");
+
+    // long enough runs of two- and three-byte sequences for the vectorized
+    // conversions, interrupted by ASCII, sequences of other lengths and the
+    // boundaries of the ranges
+    const QString cyrillic = QString::fromUtf8("\xd0\xa1\xd1\x8a\xd0\xb5\xd1\x88\xd1\x8c\xd0\xb6\xd0\xb5"
+                                               "\xd0\xb5\xd1\x89\xd1\x91\xd1\x8d\xd1\x82\xd0\xb8\xd1\x85");
+    const QString cjk = QString::fromUtf8("\xe6\x95\x8f\xe6\x8d\xb7\xe7\x9a\x84\xe6\xa3\x95\xe8\x89\xb2"
+                                          "\xe7\x8b\x90\xe7\x8b\xb8\xe8\xb7\xb3\xe8\xbf\x87");
+    const QString boundaries = QString::fromUtf16(u"\u0080\u07ff\u0800\ud7ff\ue000\ufffd\uffff");
+    const QString supplementary = QString::fromUtf16(u"\U00010437\U0001F600");
+
+    QTest::newRow("cyrillic") << cyrillic.repeated(8);
+    QTest::newRow("cyrillic-words") << (cyrillic + QLatin1Char(' ')).repeated(8);
+    QTest::newRow("cjk") << cjk.repeated(8);
+    QTest::newRow("cjk-punctuated") << (cjk + QLatin1String(", ")).repeated(8);
+    QTest::newRow("mixed") << (cyrillic + cjk + QLatin1String("abc") + boundaries + supplementary).repeated(4);
+    QTest::newRow("alternating") << (cyrillic.left(3) + cjk.left(3)).repeated(16);
+}
+
+void tst_QStringConverter::utf8Runs()
+{
+    QFETCH(QString, text);
+
+    // one character at a time never reaches the vectorized code
+    QByteArray expected;
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    for (QChar c : qAsConst(text))
+        expected += encoder(QStringView(&c, 1));
+    QVERIFY(!encoder.hasError());
+
+    const QByteArray utf8 = text.toUtf8();
+    QCOMPARE(utf8, expected);
+    QCOMPARE(QString::fromUtf8(utf8), text);
+
+    for (qsizetype chunk : { 7, 13, 64 }) {
+        QStringEncoder chunkEncoder(QStringEncoder::Utf8);
+        QByteArray encoded;
+        for (qsizetype i = 0; i < text.size(); i += chunk)
+            encoded += chunkEncoder(QStringView(text).mid(i, chunk));
+        QCOMPARE(encoded, utf8);
+
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QString decoded;
+        for (qsizetype i = 0; i < utf8.size(); i += chunk)
+            decoded += decoder(utf8.mid(i, chunk));
+        QVERIFY(!decoder.hasError());
+        QCOMPARE(decoded, text);
+    }
+
+    // replacing the first byte of a sequence with 0xff makes each of its
+    // bytes decode to one replacement character
+    qsizetype offset = 0;
+    for (qsizetype i = 0; i < qMin(text.size(), qsizetype(64)); ++i) {
+        const QChar c = text.at(i);
+        if (c.isSurrogate())
+            break;
+        const qsizetype length = c.unicode() < 0x80 ? 1 : c.unicode() < 0x800 ? 2 : 3;
+        QByteArray corrupt = utf8;
+        corrupt[offset] = char(0xff);
+        const QString result = text.left(i) + QString(length, QChar::ReplacementCharacter)
+                + text.mid(i + 1);
+        QCOMPARE(QString::fromUtf8(corrupt), result);
+
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QCOMPARE(QString(decoder(corrupt)), result);
+        QVERIFY(decoder.hasError());
+        offset += length;
+    }
+}
+
 void tst_QStringConverter::utfHeaders_data()
 {
     QTest::addColumn<QStringConverter::Encoding>("encoding");
@@ -51,10 +51,13 @@ private slots:
     void resultAt();
     void contains();
     void filterMode();
+    void filterModeDuplicates();
     void addCanceledResult();
     void count();
     void pendingResultsDoNotLeak_data();
     void pendingResultsDoNotLeak();
+    void outOfOrder_data();
+    void outOfOrder();
 private:
     int int0;
     int int1;
@@ -342,6 +345,34 @@ void tst_QtConcurrentResultStore::filterMode()
     QCOMPARE(store.contains(8), false);
 }
 
+void tst_QtConcurrentResultStore::filterModeDuplicates()
+{
+    ResultStoreInt store;
+    store.setFilterMode(true);
+
+    // 2 and 1 are pending until 0 arrives and makes all of them visible
+    QCOMPARE(store.addResult(2, &int2), 2);
+    QCOMPARE(store.addResult(1, &int1), 1);
+    QCOMPARE(store.addResult(0, &int0), 0);
+    QCOMPARE(store.count(), 3);
+
+    // results that were pending before are rejected like any other
+    // duplicate, instead of becoming pending again and holding back all
+    // the results after them
+    QCOMPARE(store.addResult(2, &int0), -1);
+    QCOMPARE(store.addResult(1, &int0), -1);
+    QCOMPARE(store.resultAt(2).value<int>(), int2);
+
+    QCOMPARE(store.addResult(3, &int0), 3);
+    QCOMPARE(store.count(), 4);
+    QVERIFY(store.contains(3));
+
+    // results without an index go after them
+    QCOMPARE(store.addResult(-1, &int1), 4);
+    QCOMPARE(store.count(), 5);
+    QCOMPARE(store.resultAt(4).value<int>(), int1);
+}
+
 void tst_QtConcurrentResultStore::addCanceledResult()
 {
     // test canceled results
@@ -552,5 +583,58 @@ void tst_QtConcurrentResultStore::pendingResultsDoNotLeak()
     store.addResults(44, &lvalueListOfObj);
 }
 
+void tst_QtConcurrentResultStore::outOfOrder_data()
+{
+    QTest::addColumn<bool>("filterMode");
+
+    QTest::addRow("filter-mode-off") << false;
+    QTest::addRow("filter-mode-on") << true;
+}
+
+void tst_QtConcurrentResultStore::outOfOrder()
+{
+    QFETCH(bool, filterMode);
+
+    // Blocks of results arriving the way several threads report them:
+    // block b holds results [4 * b, 4 * b + 4), and every odd block is
+    // reported after the even block following it.
+    ResultStoreInt store;
+    store.setFilterMode(filterMode);
+    const int blockCount = 250;
+    for (int b = 0; b <= blockCount; ++b) {
+        const int block = (b % 2) ? b + 1 : (b ? b - 1 : 0);
+        if (block >= blockCount)
+            continue;
+        if (block % 3 == 0) {
+            QList<int> results;
+            for (int i = 0; i < 4; ++i)
+                results.append(4 * block + i);
+            QCOMPARE(store.addResults(4 * block, &results), 4 * block);
+        } else {
+            for (int i = 0; i < 4; ++i) {
+                const int value = 4 * block + i;
+                QCOMPARE(store.addResult(value, &value), value);
+            }
+        }
+        QVERIFY(store.count() % 4 == 0);
+    }
+    QCOMPARE(store.count(), 4 * blockCount);
+
+    // duplicates are rejected, also within vectors
+    QCOMPARE(store.addResult(5, &int0), -1);
+    QCOMPARE(store.addResult(4 * blockCount - 1, &int0), -1);
+
+    int expected = 0;
+    for (ResultIteratorBase it = store.begin(); it != store.end(); ++it) {
+        QCOMPARE(it.resultIndex(), expected);
+        QCOMPARE(it.value<int>(), expected);
+        ++expected;
+    }
+    QCOMPARE(expected, 4 * blockCount);
+    for (int i = 0; i < 4 * blockCount; ++i)
+        QCOMPARE(store.resultAt(i).value<int>(), i);
+    QCOMPARE(store.resultAt(4 * blockCount), store.end());
+}
+
 QTEST_MAIN(tst_QtConcurrentResultStore)
 #include "tst_qresultstore.moc"
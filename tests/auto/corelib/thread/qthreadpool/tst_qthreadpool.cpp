@@ -101,6 +101,7 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing();
 
 private:
     QMutex m_functionTestMutex;
@@ -844,9 +845,13 @@ void tst_QThreadPool::tryStartCount()
 void tst_QThreadPool::priorityStart_data()
 {
     QTest::addColumn<int>("otherCount");
-    QTest::newRow("0") << 0;
-    QTest::newRow("1") << 1;
-    QTest::newRow("2") << 2;
+    QTest::addColumn<bool>("workStealing");
+    QTest::newRow("0") << 0 << false;
+    QTest::newRow("1") << 1 << false;
+    QTest::newRow("2") << 2 << false;
+    QTest::newRow("0-work-stealing") << 0 << true;
+    QTest::newRow("1-work-stealing") << 1 << true;
+    QTest::newRow("2-work-stealing") << 2 << true;
 }
 
 void tst_QThreadPool::priorityStart()
@@ -873,10 +878,14 @@ void tst_QThreadPool::priorityStart()
     };
 
     QFETCH(int, otherCount);
+    QFETCH(bool, workStealing);
     QSemaphore sem;
     QAtomicPointer<QRunnable> firstStarted;
     QRunnable *expected;
+    if (workStealing)
+        qputenv("QT_THREADPOOL_WORK_STEALING", "1");
     QThreadPool threadPool;
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
     threadPool.setMaxThreadCount(1); // start only one thread at a time
 
     // queue the holder first
@@ -1310,5 +1319,51 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing()
+{
+    qputenv("QT_THREADPOOL_WORK_STEALING", "1");
+    QThreadPool threadPool;
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
+    threadPool.setMaxThreadCount(4);
+
+    // tasks started from pool threads go to their own work queue and can
+    // be stolen by the other threads
+    QAtomicInt count;
+    constexpr int TopLevel = 200;
+    constexpr int Nested = 50;
+    for (int i = 0; i < TopLevel; ++i) {
+        threadPool.start([&threadPool, &count]() {
+            for (int j = 0; j < Nested; ++j)
+                threadPool.start([&count]() { count.ref(); });
+            count.ref();
+        });
+    }
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(count.loadRelaxed(), TopLevel * (Nested + 1));
+
+    // waitForDone() must not return while tasks are left on the work queues
+    for (int round = 0; round < 20; ++round) {
+        count.storeRelaxed(0);
+        for (int i = 0; i < TopLevel; ++i)
+            threadPool.start([&count]() { count.ref(); });
+        QVERIFY(threadPool.waitForDone());
+        QCOMPARE(count.loadRelaxed(), TopLevel);
+    }
+    count.storeRelaxed(TopLevel * (Nested + 1));
+
+    // queued tasks can still be taken back
+    QSemaphore sem;
+    threadPool.setMaxThreadCount(1);
+    threadPool.start([&sem]() { sem.acquire(); });
+    QRunnable *task = QRunnable::create([&count]() { count.ref(); });
+    task->setAutoDelete(false);
+    threadPool.start(task);
+    QVERIFY(threadPool.tryTake(task));
+    delete task;
+    sem.release();
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(count.loadRelaxed(), TopLevel * (Nested + 1));
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -94,6 +94,12 @@ private slots:
     void setScaledClipRect_data();
     void setScaledClipRect();
 
+    void scaledReadPng_data();
+    void scaledReadPng();
+
+    void readBand_data();
+    void readBand();
+
     void imageFormat_data();
     void imageFormat();
 
@@ -513,6 +519,100 @@ void tst_QImageReader::setScaledClipRect()
     QCOMPARE(originalImage.copy(newRect), image);
 }
 
+void tst_QImageReader::scaledReadPng_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+
+    QTest::newRow("Mono") << QImage::Format_Mono;
+    QTest::newRow("Indexed8") << QImage::Format_Indexed8;
+    QTest::newRow("Grayscale8") << QImage::Format_Grayscale8;
+    QTest::newRow("RGB32") << QImage::Format_RGB32;
+    QTest::newRow("ARGB32") << QImage::Format_ARGB32;
+}
+
+void tst_QImageReader::scaledReadPng()
+{
+    QFETCH(QImage::Format, format);
+
+    // Blocks of 3x3 identical pixels, so downscaling by three gives back
+    // the original pixels whatever the filter.
+    QImage small(40, 30, QImage::Format_ARGB32);
+    for (int y = 0; y < small.height(); ++y) {
+        for (int x = 0; x < small.width(); ++x)
+            small.setPixel(x, y, qRgba(x * 6, y * 8, (x ^ y) * 4, (x + y) % 3 ? 255 : 0));
+    }
+    small = small.convertToFormat(format);
+    QImage source(small.size() * 3, format);
+    source.setColorTable(small.colorTable());
+    const bool indexed = format == QImage::Format_Mono || format == QImage::Format_Indexed8;
+    for (int y = 0; y < source.height(); ++y) {
+        for (int x = 0; x < source.width(); ++x) {
+            if (indexed)
+                source.setPixel(x, y, small.pixelIndex(x / 3, y / 3));
+            else
+                source.setPixel(x, y, small.pixel(x / 3, y / 3));
+        }
+    }
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(source.save(&buffer, "png"));
+    buffer.close();
+
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QImageReader reader(&buffer, "png");
+    reader.setScaledSize(small.size());
+    QImage image = reader.read();
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.size(), small.size());
+    QCOMPARE(image.convertToFormat(QImage::Format_ARGB32_Premultiplied),
+             small.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+}
+
+void tst_QImageReader::readBand_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QByteArray>("format");
+    QTest::addColumn<int>("bandHeight");
+
+    QTest::newRow("PNG: kollada") << "kollada.png" << QByteArray("png") << 16;
+    QTest::newRow("PNG: kollada, uneven bands") << "kollada.png" << QByteArray("png") << 7;
+    QTest::newRow("PNG: kollada, single band") << "kollada.png" << QByteArray("png") << 1000;
+    QTest::newRow("PNG: kollada-16bpc") << "kollada-16bpc.png" << QByteArray("png") << 10;
+    QTest::newRow("PNG: basn0g16") << "basn0g16.png" << QByteArray("png") << 5;
+    QTest::newRow("PNG: indexed8") << "indexed8.png" << QByteArray("png") << 10;
+    QTest::newRow("PNG: txts (interlaced)") << "txts.png" << QByteArray("png") << 8;
+    QTest::newRow("BMP: colorful") << "colorful.bmp" << QByteArray("bmp") << 16;
+    QTest::newRow("GIF: earth") << "earth.gif" << QByteArray("gif") << 16;
+    QTest::newRow("JPEG: beavis") << "beavis.jpg" << QByteArray("jpeg") << 16;
+}
+
+void tst_QImageReader::readBand()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QByteArray, format);
+    QFETCH(int, bandHeight);
+
+    SKIP_IF_UNSUPPORTED(format);
+
+    const QImage expected = QImageReader(prefix + fileName).read();
+    QVERIFY(!expected.isNull());
+
+    QImageReader reader(prefix + fileName);
+    QImage band;
+    int y = 0;
+    while (reader.readBand(&band, bandHeight)) {
+        QVERIFY(band.height() <= bandHeight);
+        QVERIFY(y + band.height() <= expected.height());
+        QCOMPARE(band.format(), expected.format());
+        QCOMPARE(band, expected.copy(0, y, expected.width(), band.height()));
+        y += band.height();
+    }
+    QCOMPARE(y, expected.height());
+    QCOMPARE(reader.error(), QImageReader::UnknownError);
+}
+
 void tst_QImageReader::imageFormat_data()
 {
     QTest::addColumn<QString>("fileName");
@@ -1622,7 +1722,9 @@ void tst_QImageReader::supportsOption_data()
                               << QImageIOHandler::Quality
                               << QImageIOHandler::CompressionRatio
                               << QImageIOHandler::Size
-                              << QImageIOHandler::ScaledSize);
+                              << QImageIOHandler::ScaledSize
+                              << QImageIOHandler::BandedReading
+                              << QImageIOHandler::SubType);
 }
 
 void tst_QImageReader::supportsOption()
@@ -1644,7 +1746,8 @@ void tst_QImageReader::supportsOption()
                << QImageIOHandler::IncrementalReading
                << QImageIOHandler::Endianness
                << QImageIOHandler::Animation
-               << QImageIOHandler::BackgroundColor;
+               << QImageIOHandler::BackgroundColor
+               << QImageIOHandler::BandedReading;
 
     QImageReader reader(prefix + fileName);
     for (int i = 0; i < options.size(); ++i) {
@@ -80,6 +80,9 @@ private slots:
 
     void writeEmpty();
 
+    void pngCompressionLevels_data();
+    void pngCompressionLevels();
+
 private:
     QTemporaryDir m_temporaryDir;
     QString prefix;
@@ -403,7 +406,8 @@ void tst_QImageWriter::supportsOption_data()
                               << QImageIOHandler::Quality
                               << QImageIOHandler::CompressionRatio
                               << QImageIOHandler::Size
-                              << QImageIOHandler::ScaledSize);
+                              << QImageIOHandler::ScaledSize
+                              << QImageIOHandler::SubType);
 }
 
 void tst_QImageWriter::supportsOption()
@@ -539,5 +543,57 @@ void tst_QImageWriter::writeEmpty()
     QVERIFY(!QFileInfo(fileName).exists());
 }
 
+void tst_QImageWriter::pngCompressionLevels_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+
+    QTest::newRow("Mono") << QImage::Format_Mono;
+    QTest::newRow("Indexed8") << QImage::Format_Indexed8;
+    QTest::newRow("Grayscale8") << QImage::Format_Grayscale8;
+    QTest::newRow("Grayscale16") << QImage::Format_Grayscale16;
+    QTest::newRow("RGB32") << QImage::Format_RGB32;
+    QTest::newRow("ARGB32") << QImage::Format_ARGB32;
+    QTest::newRow("RGBA64") << QImage::Format_RGBA64;
+}
+
+void tst_QImageWriter::pngCompressionLevels()
+{
+    // the "fast" subtype chooses its own filters; all levels must be lossless
+    QFETCH(QImage::Format, format);
+
+    QImage source(131, 67, QImage::Format_ARGB32);
+    source.fill(Qt::transparent);
+    QPainter painter(&source);
+    painter.setRenderHint(QPainter::Antialiasing);
+    QLinearGradient gradient(0, 0, 131, 67);
+    gradient.setColorAt(0, QColor(255, 0, 0, 100));
+    gradient.setColorAt(1, QColor(0, 64, 255, 255));
+    painter.setBrush(gradient);
+    painter.setPen(Qt::black);
+    painter.drawEllipse(5, 5, 120, 55);
+    painter.fillRect(40, 20, 20, 30, Qt::green);
+    painter.end();
+    QImage image = source.convertToFormat(format);
+
+    for (const QByteArray subType : { QByteArray(), QByteArray("fast") }) {
+        for (int compression : { 0, 10, 20, 30, 50, 100 }) {
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly);
+            QImageWriter writer(&buffer, "png");
+            QVERIFY(writer.supportedSubTypes().contains("fast"));
+            writer.setCompression(compression);
+            writer.setSubType(subType);
+            QVERIFY(writer.write(image));
+            buffer.close();
+
+            QImage result = QImage::fromData(data, "png");
+            QVERIFY(!result.isNull());
+            QCOMPARE(result.convertToFormat(QImage::Format_RGBA64),
+                     image.convertToFormat(QImage::Format_RGBA64));
+        }
+    }
+}
+
 QTEST_MAIN(tst_QImageWriter)
 #include "tst_qimagewriter.moc"
@@ -16,8 +16,10 @@ SUBDIRS=\
    qrangecollection \
    qtransform \
    qpolygon \
+   qtiledpaintdevice \
 
 !qtConfig(private_tests): SUBDIRS -= \
     qpathclipper \
+    qtiledpaintdevice \
 
 
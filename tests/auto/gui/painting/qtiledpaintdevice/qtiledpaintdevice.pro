@@ -0,0 +1,6 @@
+CONFIG += testcase
+TARGET = tst_qtiledpaintdevice
+SOURCES += tst_qtiledpaintdevice.cpp
+QT += gui-private testlib
+
+requires(qtConfig(private_tests))
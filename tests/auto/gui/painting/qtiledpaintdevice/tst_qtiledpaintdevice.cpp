@@ -0,0 +1,410 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <QtTest/QtTest>
+
+#include <qimage.h>
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qpixmap.h>
+#include <qstatictext.h>
+#include <qthreadpool.h>
+#include <private/qtiledpaintdevice_p.h>
+
+class tst_QTiledPaintDevice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void sameAsDirectPainting_data();
+    void sameAsDirectPainting();
+    void tileHeights_data();
+    void tileHeights();
+    void saveRestore();
+    void nullImage();
+
+private:
+    QThreadPool m_pool;
+};
+
+enum Scene {
+    AliasedShapes,
+    AntialiasedShapes,
+    Dashes,
+    Gradients,
+    TransformedImages,
+    Clipping,
+    Text,
+    CompositionModes,
+    Pixmaps
+};
+Q_DECLARE_METATYPE(Scene)
+
+static void paintScene(QPainter *p, Scene scene, const QSize &size)
+{
+    const int w = size.width();
+    const int h = size.height();
+    switch (scene) {
+    case AliasedShapes:
+        p->fillRect(0, 0, w, h, Qt::white);
+        p->setPen(QPen(Qt::blue, 3));
+        p->setBrush(Qt::yellow);
+        p->drawRect(5, 7, w - 13, h / 3);
+        p->drawEllipse(QRectF(10.3, 20.6, w * 0.7, h * 0.8));
+        for (int i = 0; i < 20; ++i)
+            p->drawLine(i * 7, 0, w - i * 3, h - 1);
+        p->setPen(QPen(Qt::red, 0));
+        p->drawPolygon(QPolygon({ QPoint(3, h - 3), QPoint(w / 2, 2), QPoint(w - 3, h - 10) }));
+        // edges starting far above the device, stepped over many rows
+        p->drawPolygon(QPolygon({ QPoint(-32000, -15000), QPoint(32000, 10600), QPoint(w / 2, h / 2) }));
+        p->drawPoints(QPolygon({ QPoint(1, 1), QPoint(w / 2, h / 2), QPoint(w - 2, h - 2) }));
+        break;
+    case AntialiasedShapes:
+        p->setRenderHint(QPainter::Antialiasing);
+        p->fillRect(QRectF(0.5, 0.5, w - 1.3, h - 1.7), QColor(200, 220, 240));
+        p->setPen(QPen(QColor(0, 0, 0, 160), 2.5, Qt::SolidLine, Qt::RoundCap, Qt::MiterJoin));
+        p->setBrush(QColor(255, 0, 0, 120));
+        p->drawEllipse(QRectF(3.3, 4.7, w - 9.1, h - 7.9));
+        p->drawRoundedRect(QRectF(w / 4.1, h / 3.3, w / 2.2, h / 2.7), 7.5, 9.2);
+        for (int i = 0; i < 30; ++i)
+            p->drawLine(QLineF(i * 3.7, 0.3, w - i * 2.9, h - 0.6));
+        p->setPen(QPen(Qt::darkGreen, 0));
+        p->drawPolygon(QPolygonF({ QPointF(1.2, h - 2.5), QPointF(w / 2.5, 1.7),
+                                   QPointF(w - 1.6, h - 9.4), QPointF(w / 3.3, h / 2.1) }),
+                       Qt::WindingFill);
+        break;
+    case Dashes: {
+        p->fillRect(0, 0, w, h, Qt::white);
+        QPen pen(Qt::black, 3, Qt::DashDotLine, Qt::FlatCap);
+        p->setPen(pen);
+        p->drawEllipse(QRectF(5, 5, w - 10, h - 10));
+        p->setRenderHint(QPainter::Antialiasing);
+        pen.setDashPattern({ 3, 2.5, 1, 4 });
+        pen.setWidthF(1.5);
+        p->setPen(pen);
+        QPainterPath path;
+        path.moveTo(2, 2);
+        path.cubicTo(w, 0, 0, h, w - 2, h - 2);
+        p->drawPath(path);
+        pen.setCosmetic(true);
+        pen.setWidth(0);
+        p->setPen(pen);
+        p->scale(1.5, 1.2);
+        p->drawLine(QLineF(0, h / 1.2, w / 1.5, 0));
+        break;
+    }
+    case Gradients: {
+        QLinearGradient linear(0, 0, w, h);
+        linear.setColorAt(0, Qt::red);
+        linear.setColorAt(0.5, QColor(0, 255, 0, 128));
+        linear.setColorAt(1, Qt::blue);
+        p->fillRect(0, 0, w, h, linear);
+        QRadialGradient radial(w / 2, h / 2, h / 2, w / 3, h / 3);
+        radial.setColorAt(0, Qt::white);
+        radial.setColorAt(1, Qt::transparent);
+        radial.setSpread(QGradient::ReflectSpread);
+        p->setBrushOrigin(3, 5);
+        p->setRenderHint(QPainter::Antialiasing);
+        p->setPen(Qt::NoPen);
+        p->setBrush(radial);
+        p->drawEllipse(QRectF(2.5, 2.5, w - 5, h - 5));
+        QConicalGradient conical(w / 2, h / 2, 30);
+        conical.setColorAt(0, Qt::cyan);
+        conical.setColorAt(1, Qt::magenta);
+        p->setBrush(conical);
+        p->rotate(10);
+        p->drawRect(QRectF(w / 4, h / 4, w / 3, h / 3));
+        break;
+    }
+    case TransformedImages: {
+        QImage source(37, 23, QImage::Format_ARGB32_Premultiplied);
+        for (int y = 0; y < source.height(); ++y)
+            for (int x = 0; x < source.width(); ++x)
+                source.setPixel(x, y, qPremultiply(qRgba(x * 7, y * 11, (x * y) & 0xff, 64 + x * 5)));
+        p->fillRect(0, 0, w, h, Qt::gray);
+        p->drawImage(QPoint(3, 4), source);
+        p->drawImage(QRectF(10.5, 5.25, w - 20.3, h - 12.1), source);
+        p->setRenderHint(QPainter::SmoothPixmapTransform);
+        p->drawImage(QRectF(w / 2, 0, w / 2.3, h * 0.9), source, QRectF(2, 3, 30, 17));
+        p->translate(w / 2, h / 2);
+        p->rotate(33);
+        p->scale(2.3, 1.7);
+        p->drawImage(QPointF(-18.5, -11.5), source);
+        // an edge starting far above the device, stepped over many rows
+        p->resetTransform();
+        p->setRenderHint(QPainter::SmoothPixmapTransform, false);
+        p->translate(w / 2 - 2309.5, h / 2 - 4000.25);
+        p->rotate(60);
+        p->scale(180, 180);
+        p->drawImage(QPointF(0, 0), source);
+        break;
+    }
+    case Clipping: {
+        p->fillRect(0, 0, w, h, Qt::white);
+        p->setClipRect(QRect(4, 6, w - 11, h - 15));
+        p->save();
+        QPainterPath clip;
+        clip.addEllipse(QRectF(2.5, 3.5, w - 7, h - 5));
+        p->setRenderHint(QPainter::Antialiasing);
+        p->setClipPath(clip, Qt::IntersectClip);
+        p->fillRect(0, 0, w, h, Qt::red);
+        p->setClipRegion(QRegion(w / 3, h / 4, w / 2, h / 2, QRegion::Ellipse), Qt::IntersectClip);
+        p->fillRect(0, 0, w, h, Qt::blue);
+        p->restore();
+        p->drawLine(0, 0, w, h);
+        p->setClipping(false);
+        p->drawLine(w, 0, 0, h);
+        p->setClipping(true);
+        p->drawEllipse(0, 0, w, h);
+        break;
+    }
+    case Text: {
+        p->fillRect(0, 0, w, h, Qt::white);
+        QFont font;
+        font.setPixelSize(13);
+        p->setFont(font);
+        for (int i = 0; i < h; i += 15)
+            p->drawText(2, i, QString::fromLatin1("The quick brown fox %1").arg(i));
+        p->setRenderHint(QPainter::Antialiasing);
+        p->translate(w / 2, h / 2);
+        p->rotate(-20);
+        p->setPen(Qt::blue);
+        p->drawText(QRectF(-w / 2, -20, w, 40), Qt::AlignCenter, QStringLiteral("Rotated\ntext"));
+        p->resetTransform();
+        p->setBackgroundMode(Qt::OpaqueMode);
+        p->setBackground(Qt::yellow);
+        font.setUnderline(true);
+        p->setFont(font);
+        QStaticText staticText(QStringLiteral("Static text"));
+        p->drawStaticText(QPointF(w / 3.2, h / 1.6), staticText);
+        break;
+    }
+    case CompositionModes: {
+        p->fillRect(0, 0, w, h, QColor(10, 200, 30, 200));
+        p->setCompositionMode(QPainter::CompositionMode_Source);
+        p->fillRect(QRect(w / 4, 0, w / 4, h), QColor(255, 0, 0, 100));
+        p->setCompositionMode(QPainter::CompositionMode_Multiply);
+        p->setOpacity(0.6);
+        p->setRenderHint(QPainter::Antialiasing);
+        p->setBrush(Qt::blue);
+        p->drawEllipse(QRectF(1.5, 1.5, w - 3, h - 3));
+        p->setCompositionMode(QPainter::CompositionMode_SourceOver);
+        p->setBrush(Qt::Dense4Pattern);
+        p->drawRect(QRectF(3, h / 2.5, w - 6, h / 3));
+        break;
+    }
+    case Pixmaps: {
+        QPixmap pixmap(13, 9);
+        pixmap.fill(Qt::transparent);
+        {
+            QPainter pp(&pixmap);
+            pp.setBrush(Qt::darkCyan);
+            pp.drawEllipse(0, 0, 12, 8);
+        }
+        p->fillRect(0, 0, w, h, Qt::white);
+        p->drawTiledPixmap(QRectF(0, 0, w / 2, h), pixmap, QPointF(2, 3));
+        p->drawPixmap(w / 2, 5, pixmap);
+        p->drawPixmap(QRectF(w / 2, h / 3, w / 2.5, h / 2.2), pixmap, QRectF(1, 1, 10, 7));
+        QBrush brush(pixmap);
+        brush.setTransform(QTransform::fromScale(1.5, 2));
+        p->setBrush(brush);
+        p->drawRect(QRect(w / 2, h / 2, w / 3, h / 3));
+        break;
+    }
+    }
+}
+
+void tst_QTiledPaintDevice::initTestCase()
+{
+    m_pool.setMaxThreadCount(4);
+}
+
+void tst_QTiledPaintDevice::sameAsDirectPainting_data()
+{
+    QTest::addColumn<Scene>("scene");
+    QTest::addColumn<QImage::Format>("format");
+
+    const struct {
+        const char *name;
+        Scene scene;
+    } scenes[] = {
+        { "aliased shapes", AliasedShapes },
+        { "antialiased shapes", AntialiasedShapes },
+        { "dashes", Dashes },
+        { "gradients", Gradients },
+        { "transformed images", TransformedImages },
+        { "clipping", Clipping },
+        { "text", Text },
+        { "composition modes", CompositionModes },
+        { "pixmaps", Pixmaps }
+    };
+    const struct {
+        const char *name;
+        QImage::Format format;
+    } formats[] = {
+        { "ARGB32_Premultiplied", QImage::Format_ARGB32_Premultiplied },
+        { "RGB32", QImage::Format_RGB32 },
+        { "RGB16", QImage::Format_RGB16 },
+        { "RGBA64", QImage::Format_RGBA64 }
+    };
+    for (const auto &scene : scenes) {
+        for (const auto &format : formats)
+            QTest::addRow("%s, %s", scene.name, format.name) << scene.scene << format.format;
+    }
+    QTest::addRow("aliased shapes, Mono") << AliasedShapes << QImage::Format_Mono;
+}
+
+void tst_QTiledPaintDevice::sameAsDirectPainting()
+{
+    QFETCH(Scene, scene);
+    QFETCH(QImage::Format, format);
+
+    QImage direct(157, 131, format);
+    direct.fill(0);
+    if (format == QImage::Format_Mono)
+        direct.setColorTable({ qRgb(255, 255, 255), qRgb(0, 0, 0) });
+    QImage tiled = direct.copy();
+
+    {
+        QPainter p(&direct);
+        paintScene(&p, scene, direct.size());
+    }
+    {
+        QTiledPaintDevice device(&tiled);
+        device.setThreadPool(&m_pool);
+        device.setTileHeight(11);
+        QPainter p(&device);
+        paintScene(&p, scene, tiled.size());
+    }
+    QCOMPARE(tiled, direct);
+}
+
+void tst_QTiledPaintDevice::tileHeights_data()
+{
+    QTest::addColumn<int>("tileHeight");
+
+    QTest::newRow("default") << 0;
+    QTest::newRow("1") << 1;
+    QTest::newRow("7") << 7;
+    QTest::newRow("64") << 64;
+    QTest::newRow("taller than image") << 1000;
+}
+
+void tst_QTiledPaintDevice::tileHeights()
+{
+    QFETCH(int, tileHeight);
+
+    QImage direct(120, 97, QImage::Format_ARGB32_Premultiplied);
+    direct.fill(Qt::transparent);
+    QImage tiled = direct.copy();
+
+    {
+        QPainter p(&direct);
+        paintScene(&p, AntialiasedShapes, direct.size());
+    }
+    {
+        QTiledPaintDevice device(&tiled);
+        device.setThreadPool(&m_pool);
+        device.setTileHeight(tileHeight);
+        QPainter p(&device);
+        paintScene(&p, AntialiasedShapes, tiled.size());
+    }
+    QCOMPARE(tiled, direct);
+}
+
+void tst_QTiledPaintDevice::saveRestore()
+{
+    QImage direct(64, 64, QImage::Format_RGB32);
+    direct.fill(Qt::white);
+    QImage tiled = direct.copy();
+
+    auto paint = [](QPainter *p) {
+        p->setPen(Qt::red);
+        p->save();
+        p->translate(10, 10);
+        p->setPen(QPen(Qt::green, 3));
+        p->save();
+        p->rotate(45);
+        p->setBrush(Qt::blue);
+        p->drawRect(0, 0, 20, 10);
+        p->restore();
+        p->drawRect(0, 0, 20, 10);
+        p->save();
+        p->save();
+        p->scale(2, 2);
+        p->restore();
+        p->restore();
+        p->restore();
+        p->drawRect(0, 0, 20, 10);
+    };
+
+    {
+        QPainter p(&direct);
+        paint(&p);
+    }
+    {
+        QTiledPaintDevice device(&tiled);
+        device.setThreadPool(&m_pool);
+        device.setTileHeight(5);
+        QPainter p(&device);
+        paint(&p);
+        // nothing is painted before the painter ends
+        QCOMPARE(tiled.pixel(10, 10), qRgb(255, 255, 255));
+    }
+    QCOMPARE(tiled, direct);
+
+    // the device can be painted on again
+    {
+        QPainter p(&direct);
+        p.fillRect(20, 20, 20, 20, Qt::black);
+    }
+    {
+        QTiledPaintDevice device(&tiled);
+        device.setThreadPool(&m_pool);
+        QPainter p(&device);
+        p.fillRect(20, 20, 20, 20, Qt::black);
+    }
+    QCOMPARE(tiled, direct);
+}
+
+void tst_QTiledPaintDevice::nullImage()
+{
+    QImage image;
+    QTiledPaintDevice device(&image);
+    QPainter p;
+    QTest::ignoreMessage(QtWarningMsg, "QTiledPaintEngine::begin: Cannot paint on a null image");
+    QTest::ignoreMessage(QtWarningMsg, "QPainter::begin(): Returned false");
+    QVERIFY(!p.begin(&device));
+}
+
+QTEST_MAIN(tst_QTiledPaintDevice)
+
+#include "tst_qtiledpaintdevice.moc"
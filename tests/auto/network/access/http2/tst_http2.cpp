@@ -110,6 +110,7 @@ private slots:
     void connectToHost_data();
     void connectToHost();
     void maxFrameSize();
+    void sharedConnection();
 
     void contentEncoding_data();
     void contentEncoding();
@@ -770,6 +771,47 @@ void tst_Http2::maxFrameSize()
     QVERIFY(serverGotSettingsACK);
 }
 
+void tst_Http2::sharedConnection()
+{
+    // Requests from two managers share one connection; our test
+    // server stops listening after the first connection, so a second
+    // connection would be refused.
+    clearHTTP2State();
+
+    serverPort = 0;
+    nRequests = 2;
+
+    ServerPtr srv(newServer(defaultServerSettings, H2Type::h2cDirect));
+
+    QMetaObject::invokeMethod(srv.data(), "startServer", Qt::QueuedConnection);
+    runEventLoop();
+
+    QVERIFY(serverPort != 0);
+
+    auto url = requestUrl(H2Type::h2cDirect);
+    url.setPath("/index.html");
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::Http2DirectAttribute, QVariant(true));
+    request.setAttribute(QNetworkRequest::Http2SharedConnectionAttribute, QVariant(true));
+
+    QNetworkAccessManager otherManager;
+    auto reply = manager->get(request);
+    connect(reply, &QNetworkReply::finished, this, &tst_Http2::replyFinished);
+    auto otherReply = otherManager.get(request);
+    connect(otherReply, &QNetworkReply::finished, this, &tst_Http2::replyFinished);
+
+    runEventLoop();
+    STOP_ON_FAILURE
+
+    QCOMPARE(nRequests, 0);
+    QVERIFY(prefaceOK);
+    QVERIFY(serverGotSettingsACK);
+
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(otherReply->error(), QNetworkReply::NoError);
+}
+
 void tst_Http2::contentEncoding_data()
 {
     QTest::addColumn<QByteArray>("encoding");
@@ -331,6 +331,9 @@ private Q_SLOTS:
     void ioPostToHttpFromMiddleOfQBufferFiveBytes();
     void ioPostToHttpNoBufferFlag();
     void ioPostToHttpUploadProgress();
+    void ioPutToHttpFromFileAtOffset();
+    void ioPutToHttpFromFileWithoutUserThread();
+    void ioPutToHttpFromFileSubclass();
     void emitAllUploadProgressSignals();
     void ioPostToHttpEmptyUploadProgress();
 
@@ -382,6 +385,7 @@ private Q_SLOTS:
     void httpReUsingConnectionSequential();
     void httpReUsingConnectionFromFinishedSlot_data();
     void httpReUsingConnectionFromFinishedSlot();
+    void httpSharedConnectionAttributeOverHttp1();
 
     void httpRecursiveCreation();
 
@@ -5295,6 +5299,211 @@ void tst_QNetworkReply::ioPostToHttpUploadProgress()
     server.close();
 }
 
+void tst_QNetworkReply::ioPutToHttpFromFileAtOffset()
+{
+    // file-backed uploads may be sent straight from the file descriptor;
+    // the body must still start at the file's current position
+    QTemporaryFile sourceFile(QDir::currentPath() + "/temp-XXXXXX");
+    QVERIFY(sourceFile.open());
+    QByteArray content;
+    for (int i = 0; i < 256 * 1024; ++i)
+        content += char('a' + i % 26);
+    QCOMPARE(sourceFile.write(content), qint64(content.size()));
+    const qint64 offset = 1000;
+    QVERIFY(sourceFile.seek(offset));
+    const QByteArray expected = content.mid(offset);
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress(QHostAddress::LocalHost), 0));
+
+    QUrl url = QUrl(QString("http://127.0.0.1:%1/").arg(server.serverPort()));
+    QNetworkRequest request(url);
+    request.setRawHeader("Content-Type", "application/octet-stream");
+    QNetworkReplyPtr reply(manager.put(request, &sourceFile));
+    QSignalSpy spy(reply.data(), SIGNAL(uploadProgress(qint64,qint64)));
+    connect(&server, SIGNAL(newConnection()), &QTestEventLoop::instance(), SLOT(exitLoop()));
+
+    QTestEventLoop::instance().enterLoop(10);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QTcpSocket *incomingSocket = server.nextPendingConnection();
+    QVERIFY(incomingSocket);
+
+    disconnect(&server, SIGNAL(newConnection()), &QTestEventLoop::instance(), SLOT(exitLoop()));
+
+    // keep the event loop running: the upload data may come from this thread
+    connect(incomingSocket, SIGNAL(readyRead()), &QTestEventLoop::instance(), SLOT(exitLoop()));
+    QByteArray received;
+    int headerEnd = -1;
+    while (headerEnd < 0 || received.size() - headerEnd < expected.size()) {
+        if (!incomingSocket->bytesAvailable()) {
+            QTestEventLoop::instance().enterLoop(10);
+            QVERIFY(!QTestEventLoop::instance().timeout());
+        }
+        received += incomingSocket->readAll();
+        if (headerEnd < 0) {
+            headerEnd = received.indexOf("\r\n\r\n");
+            if (headerEnd >= 0)
+                headerEnd += 4;
+        }
+    }
+    QCOMPARE(received.size() - headerEnd, expected.size());
+    QVERIFY(received.mid(headerEnd) == expected);
+    disconnect(incomingSocket, SIGNAL(readyRead()), &QTestEventLoop::instance(), SLOT(exitLoop()));
+    QTRY_VERIFY(!spy.isEmpty() && spy.last().at(0).toLongLong() == expected.size());
+    QCOMPARE(spy.last().at(1).toLongLong(), qint64(expected.size()));
+
+    connect(reply, SIGNAL(finished()), &QTestEventLoop::instance(), SLOT(exitLoop()));
+    incomingSocket->write("HTTP/1.0 200 OK\r\n");
+    incomingSocket->write("Content-Length: 0\r\n");
+    incomingSocket->write("\r\n");
+    QTestEventLoop::instance().enterLoop(10);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+}
+
+// Receives one request with a body of a given size in a thread of its own,
+// with blocking calls, so that it makes progress while the main thread is
+// blocked.
+class UploadReceiverThread : public QThread
+{
+public:
+    explicit UploadReceiverThread(qint64 bodySize) : bodySize(bodySize) {}
+
+    QSemaphore listening;
+    QSemaphore headerReceived;
+    QSemaphore readBody;
+    QSemaphore bodyReceived;
+    quint16 port = 0;
+    QByteArray body;
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        if (server.listen(QHostAddress::LocalHost))
+            port = server.serverPort();
+        listening.release();
+        if (!port || !server.waitForNewConnection(10000))
+            return;
+        QScopedPointer<QTcpSocket> socket(server.nextPendingConnection());
+        QByteArray data;
+        qsizetype headerEnd = -1;
+        while (headerEnd < 0 || data.size() - headerEnd < bodySize) {
+            if (!socket->bytesAvailable() && !socket->waitForReadyRead(10000))
+                return;
+            data += socket->readAll();
+            if (headerEnd < 0 && (headerEnd = data.indexOf("\r\n\r\n")) >= 0) {
+                headerEnd += 4;
+                headerReceived.release();
+                readBody.acquire();
+            }
+        }
+        body = data.mid(headerEnd);
+        bodyReceived.release();
+        socket->write("HTTP/1.0 200 OK\r\nContent-Length: 0\r\n\r\n");
+        socket->waitForBytesWritten(10000);
+        socket->disconnectFromHost();
+        if (socket->state() != QAbstractSocket::UnconnectedState)
+            socket->waitForDisconnected(10000);
+    }
+
+private:
+    const qint64 bodySize;
+};
+
+void tst_QNetworkReply::ioPutToHttpFromFileWithoutUserThread()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("Uploads are only sent straight from the file on Linux");
+#else
+    // A body that is read from the upload device needs the event loop of
+    // this thread for every chunk, and one that is sent straight from the
+    // file descriptor does not. The upload must complete while this thread
+    // is blocked; it is much larger than what the socket buffers can hold.
+    QTemporaryFile sourceFile(QDir::currentPath() + "/temp-XXXXXX");
+    QVERIFY(sourceFile.open());
+    QByteArray block(1024 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < block.size(); ++i)
+        block[i] = char('a' + i % 26);
+    const int blockCount = 32;
+    for (int i = 0; i < blockCount; ++i)
+        QCOMPARE(sourceFile.write(block), qint64(block.size()));
+    QVERIFY(sourceFile.seek(0));
+
+    UploadReceiverThread receiver(blockCount * block.size());
+    receiver.start();
+    receiver.listening.acquire();
+    QVERIFY(receiver.port);
+
+    QNetworkRequest request(QUrl(QString("http://127.0.0.1:%1/").arg(receiver.port)));
+    request.setRawHeader("Content-Type", "application/octet-stream");
+    QNetworkReplyPtr reply(manager.put(request, &sourceFile));
+
+    // starting the request needs this thread, sending the body must not
+    QTRY_COMPARE(receiver.headerReceived.available(), 1);
+    receiver.readBody.release();
+    const bool received = receiver.bodyReceived.tryAcquire(1, 20000);
+    QVERIFY2(received, "the upload did not progress without the event loop of its thread");
+    QCOMPARE(receiver.body.size(), qsizetype(blockCount * block.size()));
+    for (int i = 0; i < blockCount; ++i)
+        QVERIFY(receiver.body.mid(i * block.size(), block.size()) == block);
+
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QVERIFY(receiver.wait(10000));
+#endif
+}
+
+// A file that uploads other data than it contains
+class UpperCaseFile : public QFile
+{
+    Q_OBJECT
+public:
+    using QFile::QFile;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 result = QFile::readData(data, maxSize);
+        for (qint64 i = 0; i < result; ++i)
+            data[i] = QChar::toUpper(uchar(data[i]));
+        return result;
+    }
+};
+
+void tst_QNetworkReply::ioPutToHttpFromFileSubclass()
+{
+    // only plain files are sent straight from their descriptor
+    QTemporaryFile tempFile(QDir::currentPath() + "/temp-XXXXXX");
+    QVERIFY(tempFile.open());
+    QByteArray content;
+    for (int i = 0; i < 256 * 1024; ++i)
+        content += char('a' + i % 26);
+    QCOMPARE(tempFile.write(content), qint64(content.size()));
+    tempFile.close();
+
+    UpperCaseFile sourceFile(tempFile.fileName());
+    QVERIFY(sourceFile.open(QIODevice::ReadOnly));
+
+    UploadReceiverThread receiver(content.size());
+    receiver.start();
+    receiver.listening.acquire();
+    QVERIFY(receiver.port);
+
+    QNetworkRequest request(QUrl(QString("http://127.0.0.1:%1/").arg(receiver.port)));
+    request.setRawHeader("Content-Type", "application/octet-stream");
+    QNetworkReplyPtr reply(manager.put(request, &sourceFile));
+
+    QTRY_COMPARE(receiver.headerReceived.available(), 1);
+    receiver.readBody.release();
+    QTRY_COMPARE(receiver.bodyReceived.available(), 1);
+    QVERIFY(receiver.body == content.toUpper());
+
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QVERIFY(receiver.wait(10000));
+}
+
 void tst_QNetworkReply::emitAllUploadProgressSignals()
 {
     QFile sourceFile(testDataDir + "/image1.jpg");
@@ -6309,6 +6518,48 @@ void tst_QNetworkReply::httpReUsingConnectionFromFinishedSlot()
     QCOMPARE(server.totalConnections, 1);
 }
 
+void tst_QNetworkReply::httpSharedConnectionAttributeOverHttp1()
+{
+    // The server does not upgrade to HTTP/2, so the connections stay
+    // HTTP/1.1 and must not be shared between managers.
+    QByteArray response("HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n");
+    MiniHttpServer server(response);
+    server.multiple = true;
+    server.doClose = false;
+
+    QUrl url;
+    url.setScheme("http");
+    url.setPort(server.serverPort());
+    url.setHost("127.0.0.1");
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    request.setAttribute(QNetworkRequest::Http2SharedConnectionAttribute, true);
+
+    QNetworkAccessManager firstManager;
+    QNetworkAccessManager secondManager;
+
+    QNetworkReplyPtr reply1(firstManager.get(request));
+    QVERIFY2(waitForFinish(reply1) == Success, msgWaitForFinished(reply1));
+    QCOMPARE(reply1->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool(), false);
+    const int reply1port = server.client->peerPort();
+    QCOMPARE(server.totalConnections, 1);
+
+    QNetworkReplyPtr reply2(secondManager.get(request));
+    QVERIFY2(waitForFinish(reply2) == Success, msgWaitForFinished(reply2));
+    const int reply2port = server.client->peerPort();
+    QCOMPARE(server.totalConnections, 2);
+    QVERIFY(reply2port != reply1port);
+
+    // each manager keeps reusing its own connection
+    QNetworkReplyPtr reply3(firstManager.get(request));
+    QVERIFY2(waitForFinish(reply3) == Success, msgWaitForFinished(reply3));
+    QCOMPARE(server.client->peerPort(), reply1port);
+    QNetworkReplyPtr reply4(secondManager.get(request));
+    QVERIFY2(waitForFinish(reply4) == Success, msgWaitForFinished(reply4));
+    QCOMPARE(server.client->peerPort(), reply2port);
+    QCOMPARE(server.totalConnections, 2);
+}
+
 class HttpRecursiveCreationHelper : public QObject
 {
     Q_OBJECT
@@ -202,6 +202,7 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void partiallyWrittenChunks();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3217,5 +3218,67 @@ void tst_QTcpSocket::readNotificationsAfterBind()
     QCOMPARE(spyReadyRead.count(), 0);
 }
 
+// Test that chunks the kernel accepted only partly are resent in order
+void tst_QTcpSocket::partiallyWrittenChunks()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTcpServer tcpServer;
+    QTcpSocket *socket = newSocket();
+
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    QTcpSocket *newConnection = tcpServer.nextPendingConnection();
+    QVERIFY(newConnection != nullptr);
+
+    // Small kernel buffers make a write of several chunks stop in the middle
+    socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, 8192);
+    newConnection->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 8192);
+
+    // Each frame is large enough to become a chunk of the write buffer of
+    // its own, and all of them differ in size and content.
+    QByteArray expected;
+    QList<qint64> frameEnds;
+    for (int i = 0; i < 256; ++i) {
+        QByteArray frame(4096 + (i * 523) % 4096, Qt::Uninitialized);
+        for (int j = 0; j < frame.size(); ++j)
+            frame[j] = char(i + j / 251);
+        QCOMPARE(socket->write(frame), qint64(frame.size()));
+        expected += frame;
+        frameEnds.append(expected.size());
+    }
+
+    QSignalSpy spyBytesWritten(socket, SIGNAL(bytesWritten(qint64)));
+    QVERIFY(socket->flush());
+    const qint64 accepted = expected.size() - socket->bytesToWrite();
+    QVERIFY(accepted > 0);
+    QVERIFY(socket->bytesToWrite() > 0);
+    // the last write ended inside a chunk
+    QVERIFY(!frameEnds.contains(accepted));
+
+    QByteArray received;
+    while (received.size() < expected.size()) {
+        socket->flush();
+        if (!newConnection->bytesAvailable())
+            QVERIFY(newConnection->waitForReadyRead(5000));
+        received += newConnection->read(4096);
+    }
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+    QCOMPARE(socket->bytesToWrite(), Q_INT64_C(0));
+
+    qint64 bytesWritten = 0;
+    for (const QList<QVariant> &arguments : qAsConst(spyBytesWritten))
+        bytesWritten += arguments.at(0).toLongLong();
+    QCOMPARE(bytesWritten, qint64(expected.size()));
+
+    delete newConnection;
+    delete socket;
+}
+
 QTEST_MAIN(tst_QTcpSocket)
 #include "tst_qtcpsocket.moc"
@@ -119,6 +119,7 @@ private slots:
     void readyReadForEmptyDatagram();
     void asyncReadDatagram();
     void writeInHostLookupState();
+    void batchedDatagrams();
 
 protected slots:
     void empty_readyReadSlot();
@@ -1926,5 +1927,77 @@ void tst_QUdpSocket::writeInHostLookupState()
     QVERIFY(!socket.putChar('0'));
 }
 
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket sender, receiver;
+    QVERIFY2(receiver.bind(QHostAddress(QHostAddress::AnyIPv4), 0), receiver.errorString().toLatin1().constData());
+    const QHostAddress receiverAddress = makeNonAny(receiver.localAddress());
+    const quint16 port = receiver.localPort();
+
+    // more than one batch of the native engine, with different sizes
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < 100; ++i)
+        datagrams.append(QNetworkDatagram(QByteArray(i * 7, char('a' + i % 26)), receiverAddress, port));
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    QCOMPARE(sender.writeDatagrams(datagrams), datagrams.size());
+    QCOMPARE(bytesWrittenSpy.count(), 1);
+    qint64 totalSize = 0;
+    for (const QNetworkDatagram &datagram : qAsConst(datagrams))
+        totalSize += datagram.data().size();
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), totalSize);
+
+    QList<QNetworkDatagram> received;
+    QDeadlineTimer deadline(5000);
+    while (received.size() < datagrams.size() && !deadline.hasExpired()) {
+        if (!receiver.waitForReadyRead(100))
+            continue;
+        const QList<QNetworkDatagram> batch = receiver.receiveDatagrams(10);
+        QVERIFY(batch.size() <= 10);
+        received += batch;
+    }
+    QCOMPARE(received.size(), datagrams.size());
+    QVERIFY(!receiver.hasPendingDatagrams());
+    QVERIFY(receiver.receiveDatagrams(10).isEmpty());
+
+    for (int i = 0; i < datagrams.size(); ++i) {
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data());
+        QCOMPARE(received.at(i).senderPort(), int(sender.localPort()));
+        QCOMPARE(received.at(i).destinationAddress(), receiverAddress);
+        QCOMPARE(received.at(i).destinationPort(), int(port));
+    }
+
+    // truncating to maxSize
+    QCOMPARE(sender.writeDatagrams(datagrams.mid(50, 3)), 3);
+    received.clear();
+    while (received.size() < 3 && receiver.waitForReadyRead(5000))
+        received += receiver.receiveDatagrams(3, 16);
+    QCOMPARE(received.size(), 3);
+    for (int i = 0; i < 3; ++i)
+        QCOMPARE(received.at(i).data(), datagrams.at(50 + i).data().left(16));
+
+    // every destination is checked against the protocol of the socket
+    QUdpSocket ipv4Sender;
+    QVERIFY2(ipv4Sender.bind(QHostAddress(QHostAddress::AnyIPv4), 0), ipv4Sender.errorString().toLatin1().constData());
+    const QList<QNetworkDatagram> mixed = {
+        QNetworkDatagram("first", receiverAddress, port),
+        QNetworkDatagram("second", QHostAddress(QHostAddress::LocalHostIPv6), port),
+        QNetworkDatagram("third", receiverAddress, port)
+    };
+    QCOMPARE(ipv4Sender.writeDatagrams(mixed), 1);
+    QCOMPARE(ipv4Sender.writeDatagrams(mixed.mid(1)), -1);
+    QCOMPARE(ipv4Sender.error(), QAbstractSocket::UnsupportedSocketOperationError);
+    QCOMPARE(ipv4Sender.writeDatagrams(mixed.mid(2)), 1);
+    received.clear();
+    while (received.size() < 2 && receiver.waitForReadyRead(5000))
+        received += receiver.receiveDatagrams(2);
+    QCOMPARE(received.size(), 2);
+    QCOMPARE(received.at(0).data(), QByteArray("first"));
+    QCOMPARE(received.at(1).data(), QByteArray("third"));
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
@@ -29,6 +29,7 @@
 #include <QtTest/QtTest>
 #include <QtSql/QtSql>
 
+#include <limits>
 #include <numeric>
 
 #include "../qsqldatabase/tst_databases.h"
@@ -72,6 +73,8 @@ private slots:
     void first();
     void next_data() { generic_data(); }
     void next();
+    void nextBatch_data() { generic_data(); }
+    void nextBatch();
     void prev_data() { generic_data(); }
     void prev();
     void last_data() { generic_data(); }
@@ -88,6 +91,12 @@ private slots:
     void finish();
     void sqlite_finish_data() { generic_data("QSQLITE"); }
     void sqlite_finish();
+    void sqlite_statementCache_data() { generic_data("QSQLITE"); }
+    void sqlite_statementCache();
+    void sqlite_execBatchRollback_data() { generic_data("QSQLITE"); }
+    void sqlite_execBatchRollback();
+    void sqlite_nextBatchStorageClasses_data() { generic_data("QSQLITE"); }
+    void sqlite_nextBatchStorageClasses();
     void nextResult_data() { generic_data(); }
     void nextResult();
 
@@ -166,6 +175,12 @@ private slots:
     void psql_bindWithDoubleColonCastOperator();
     void psql_specialFloatValues_data() { generic_data("QPSQL"); }
     void psql_specialFloatValues();
+    void psql_execBatchPipelined_data() { generic_data("QPSQL"); }
+    void psql_execBatchPipelined();
+    void psql_binaryResults_data() { generic_data("QPSQL"); }
+    void psql_binaryResults();
+    void psql_nextBatch_data() { generic_data("QPSQL"); }
+    void psql_nextBatch();
     void queryOnInvalidDatabase_data() { generic_data(); }
     void queryOnInvalidDatabase();
     void createQueryOnClosedDatabase_data() { generic_data(); }
@@ -420,7 +435,7 @@ void tst_QSqlQuery::createTestTables( QSqlDatabase db )
         QVERIFY_SQL( q, exec("set client_min_messages='warning'"));
 
     if (dbType == QSqlDriver::PostgreSQL)
-        QVERIFY_SQL( q, exec( "create table " + qtest + " (id serial NOT NULL, t_varchar varchar(20), t_char char(20), primary key(id)) WITH OIDS" ) );
+        QVERIFY_SQL( q, exec( "create table " + qtest + " (id serial NOT NULL, t_varchar varchar(20), t_char char(20), primary key(id))" ) );
     else
         QVERIFY_SQL( q, exec( "create table " + qtest + " (id int "+tst_Databases::autoFieldName(db) +" NOT NULL, t_varchar varchar(20), t_char char(20), primary key(id))" ) );
 
@@ -1295,6 +1310,57 @@ void tst_QSqlQuery::next()
     QVERIFY( q.at() == 1 );
 }
 
+void tst_QSqlQuery::nextBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString qtest_null(qTableName("qtest_null", __FILE__, db));
+
+    for (bool forwardOnly : {false, true}) {
+        QSqlQuery q(db);
+        q.setForwardOnly(forwardOnly);
+        QSqlColumnBatch batch;
+        QVERIFY(!q.nextBatch(&batch, 2));
+
+        QVERIFY_SQL(q, exec("select id, t_varchar from " + qtest + " order by id"));
+        QVERIFY(q.nextBatch(&batch, 2));
+        QCOMPARE(batch.columnCount(), 2);
+        QCOMPARE(batch.rowCount(), 2);
+        QCOMPARE(batch.columnType(0), QSqlColumnBatch::Int64Column);
+        QCOMPARE(batch.columnType(1), QSqlColumnBatch::StringColumn);
+        QCOMPARE(batch.int64Column(0), QList<qint64>({1, 2}));
+        QCOMPARE(batch.stringColumn(1), QStringList({"VarChar1", "VarChar2"}));
+        QCOMPARE(batch.value(1, 1).toString(), QString("VarChar2"));
+        // positioned on the last record of the batch
+        QCOMPARE(q.at(), 1);
+        QCOMPARE(q.value(0).toInt(), 2);
+
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), 3);
+
+        // fewer records left than requested
+        QVERIFY(q.nextBatch(&batch, 10));
+        QCOMPARE(batch.rowCount(), 2);
+        QCOMPARE(batch.int64Column(0), QList<qint64>({4, 5}));
+        QCOMPARE(q.at(), int(QSql::AfterLastRow));
+        QVERIFY(!q.nextBatch(&batch, 10));
+        QVERIFY(batch.isEmpty());
+        QVERIFY(!q.next());
+
+        QVERIFY_SQL(q, exec("select id, t_varchar from " + qtest_null + " order by id"));
+        QVERIFY(q.nextBatch(&batch, 10));
+        QCOMPARE(batch.rowCount(), 4);
+        QCOMPARE(batch.int64Column(0), QList<qint64>({0, 1, 2, 3}));
+        QVERIFY(batch.isNull(0, 1));
+        QVERIFY(!batch.isNull(1, 1));
+        QVERIFY(!batch.isNull(2, 1));
+        QVERIFY(batch.isNull(3, 1));
+        QCOMPARE(batch.stringColumn(1), QStringList({QString(), "n", "i", QString()}));
+        QVERIFY(batch.value(0, 1).isNull());
+    }
+}
+
 void tst_QSqlQuery::prev()
 {
     QFETCH( QString, dbName );
@@ -2903,6 +2969,262 @@ void tst_QSqlQuery::psql_specialFloatValues()
     QVERIFY_SQL( query, exec("drop table " + tableName) );
 }
 
+// Opens a second connection to the database of 'db', with 'options' added
+// to its connect options; remove it with QSqlDatabase::removeDatabase().
+static QSqlDatabase cloneWithOptions(const QSqlDatabase &db, const QString &connectionName,
+                                     const QString &options)
+{
+    QSqlDatabase clone = QSqlDatabase::cloneDatabase(db, connectionName);
+    const QString connectOptions = db.connectOptions();
+    clone.setConnectOptions(connectOptions.isEmpty() ? options
+                                                     : connectOptions + QLatin1Char(';') + options);
+    clone.open();
+    return clone;
+}
+
+void tst_QSqlQuery::psql_execBatchPipelined()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("batchpipeline", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    {
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id integer PRIMARY KEY, txt varchar(20))"));
+
+        // Without the option, rows are executed one by one and those before
+        // a failing one stay applied
+        if (!db.connectOptions().contains(QLatin1String("QPSQL_PIPELINED_BATCH"))) {
+            QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " (id, txt) VALUES (?, ?)"));
+            q.addBindValue(QVariantList{-2, -1, -1});
+            q.addBindValue(QVariantList{"-2", "-1", "-1"});
+            QVERIFY(!q.execBatch());
+            QVERIFY_SQL(q, exec("DELETE FROM " + tableName + " WHERE id < 0"));
+            QCOMPARE(q.numRowsAffected(), 2);
+        }
+    }
+
+    {
+        QSqlDatabase pipelined = cloneWithOptions(db, QLatin1String("pipelinedBatch"),
+                                                  QLatin1String("QPSQL_PIPELINED_BATCH"));
+        QVERIFY2(pipelined.isOpen(), qPrintable(pipelined.lastError().text()));
+        QSqlQuery q(pipelined);
+        QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " (id, txt) VALUES (?, ?)"));
+
+        // More rows than are sent between two sync points of the pipeline
+        QVariantList ids;
+        QVariantList texts;
+        for (int i = 0; i < 1000; ++i) {
+            ids << i;
+            texts << QString::number(i);
+        }
+        q.addBindValue(ids);
+        q.addBindValue(texts);
+        QVERIFY_SQL(q, execBatch());
+        QCOMPARE(q.numRowsAffected(), 1);
+
+        // The primary key of the last row collides, none of the rows is inserted
+        q.addBindValue(QVariantList{1000, 1001, 0});
+        q.addBindValue(QVariantList{"1000", "1001", "0"});
+        QVERIFY(!q.execBatch());
+        QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+
+        // A batch inside a transaction of the application is part of it
+        QVERIFY(pipelined.transaction());
+        q.addBindValue(QVariantList{1000, 1001});
+        q.addBindValue(QVariantList{"1000", "1001"});
+        QVERIFY_SQL(q, execBatch());
+        QVERIFY(pipelined.rollback());
+
+        QVERIFY_SQL(q, exec("SELECT COUNT(*), MAX(id) FROM " + tableName));
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), 1000);
+        QCOMPARE(q.value(1).toInt(), 999);
+    }
+    QSqlDatabase::removeDatabase(QLatin1String("pipelinedBatch"));
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::psql_binaryResults()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("binaryresults", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id integer, big bigint, "
+                        "num numeric(20, 5), dbl double precision, flag boolean, d date, "
+                        "t time, ts timestamp, tstz timestamptz, bin bytea, txt varchar(20))"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (1, -9000000000, "
+                        "-12345678.0125, 0.1, true, '1999-12-31', '23:59:59.123456', "
+                        "'1970-01-01 00:00:00.5', '2020-02-29 12:34:56.789+02', "
+                        "'\\x00ff10', 'text')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (2, 9000000000, 'NaN', "
+                        "'Infinity', false, 'infinity', '23:59:59.9996', 'infinity', "
+                        "'-infinity', '', '')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (3, NULL, NULL, '-Infinity', "
+                        "NULL, '1900-02-28', '00:00:00.0005', '1969-12-31 23:59:59.9995', "
+                        "'1901-01-01 00:00:00.0004+00', NULL, NULL)"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (4, 0, 0, 'NaN', NULL, "
+                        "'-infinity', '23:59:59.999999', '1899-12-31 23:59:59.9994', "
+                        "NULL, NULL, NULL)"));
+
+    // Only the connection with the option fetches prepared queries in binary
+    QSqlDatabase binaryDb = cloneWithOptions(db, QLatin1String("binaryResults"),
+                                             QLatin1String("QPSQL_BINARY_RESULTS"));
+    QVERIFY2(binaryDb.isOpen(), qPrintable(binaryDb.lastError().text()));
+
+    const QString select("SELECT * FROM " + tableName + " WHERE id = ?");
+    for (const QSql::NumericalPrecisionPolicy policy : { QSql::HighPrecision, QSql::LowPrecisionDouble }) {
+        QSqlQuery text(db);
+        QSqlQuery binary(binaryDb);
+        text.setNumericalPrecisionPolicy(policy);
+        binary.setNumericalPrecisionPolicy(policy);
+        QVERIFY_SQL(text, prepare(select));
+        QVERIFY_SQL(binary, prepare(select));
+        for (int id = 1; id <= 4; ++id) {
+            text.addBindValue(id);
+            QVERIFY_SQL(text, exec());
+            binary.addBindValue(id);
+            QVERIFY_SQL(binary, exec());
+            QVERIFY(text.next());
+            QVERIFY(binary.next());
+            for (int i = 0; i < text.record().count(); ++i) {
+                QCOMPARE(binary.isNull(i), text.isNull(i));
+                const QVariant expected = text.value(i);
+                const QVariant actual = binary.value(i);
+                if (expected.userType() == QMetaType::Double && qIsNaN(expected.toDouble())) {
+                    QCOMPARE(actual.userType(), expected.userType());
+                    QVERIFY(qIsNaN(actual.toDouble()));
+                } else {
+                    QCOMPARE(actual, expected);
+                }
+            }
+        }
+    }
+
+    q.clear();
+    binaryDb = QSqlDatabase();
+    QSqlDatabase::removeDatabase(QLatin1String("binaryResults"));
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::psql_nextBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("nextbatch", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id integer, big bigint, "
+                        "num numeric(20, 5), dbl double precision, flag boolean, d date, "
+                        "bin bytea, txt varchar(20))"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (1, -9000000000, "
+                        "-12345678.0125, 0.1, true, '1999-12-31', '\\x00ff10', 'text')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (2, 9223372036854775807, "
+                        "'NaN', 'Infinity', false, '2020-02-29', '', '')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (3, NULL, NULL, '-Infinity', "
+                        "NULL, NULL, NULL, NULL)"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (4, -9223372036854775808, "
+                        "0.5, 'NaN', true, '1900-02-28', '\\x41', 'x')"));
+
+    // Prepared queries are fetched in binary if the connection has the option
+    QSqlDatabase binaryDb = cloneWithOptions(db, QLatin1String("nextBatchBinary"),
+                                             QLatin1String("QPSQL_BINARY_RESULTS"));
+    QVERIFY2(binaryDb.isOpen(), qPrintable(binaryDb.lastError().text()));
+
+    const QString select("SELECT id, big, num, dbl, flag, d, bin, txt FROM " + tableName
+                         + " WHERE id > ? ORDER BY id");
+    for (const QSqlDatabase &connection : { db, binaryDb }) {
+        for (const QSql::NumericalPrecisionPolicy policy : { QSql::HighPrecision, QSql::LowPrecisionDouble }) {
+            QSqlQuery expected(connection);
+            QSqlQuery batchQuery(connection);
+            expected.setNumericalPrecisionPolicy(policy);
+            batchQuery.setNumericalPrecisionPolicy(policy);
+            for (QSqlQuery *query : { &expected, &batchQuery }) {
+                QVERIFY_SQL(*query, prepare(select));
+                query->addBindValue(0);
+                QVERIFY_SQL(*query, exec());
+            }
+
+            QSqlColumnBatch batch;
+            QVERIFY(batchQuery.nextBatch(&batch, 10));
+            QCOMPARE(batch.rowCount(), 4);
+            QCOMPARE(batch.columnType(0), QSqlColumnBatch::Int64Column);
+            QCOMPARE(batch.columnType(1), QSqlColumnBatch::Int64Column);
+            // NUMERIC is retrieved as a string with high precision
+            QCOMPARE(batch.columnType(2), policy == QSql::HighPrecision
+                     ? QSqlColumnBatch::VariantColumn : QSqlColumnBatch::DoubleColumn);
+            QCOMPARE(batch.columnType(3), QSqlColumnBatch::DoubleColumn);
+            QCOMPARE(batch.columnType(4), QSqlColumnBatch::Int64Column);
+            QCOMPARE(batch.columnType(5), QSqlColumnBatch::VariantColumn);
+            QCOMPARE(batch.columnType(6), QSqlColumnBatch::ByteArrayColumn);
+            QCOMPARE(batch.columnType(7), QSqlColumnBatch::StringColumn);
+            QCOMPARE(batch.int64Column(1), QList<qint64>({ Q_INT64_C(-9000000000),
+                                                           std::numeric_limits<qint64>::max(), 0,
+                                                           std::numeric_limits<qint64>::min() }));
+            QCOMPARE(batch.int64Column(4), QList<qint64>({ 1, 0, 0, 1 }));
+            QCOMPARE(batch.byteArrayColumn(6), QList<QByteArray>({ QByteArray("\x00\xff\x10", 3),
+                                                                   "", QByteArray(), "A" }));
+            if (policy == QSql::HighPrecision)
+                QCOMPARE(batch.value(0, 2), QVariant(QString("-12345678.01250")));
+            const QList<double> doubles = batch.doubleColumn(3);
+            QCOMPARE(doubles.mid(0, 3), QList<double>({ 0.1, qInf(), -qInf() }));
+            QVERIFY(qIsNaN(doubles.at(3)));
+
+            // Every field holds what value() returns, converted to the type
+            // of its column
+            for (int row = 0; row < batch.rowCount(); ++row) {
+                QVERIFY(expected.next());
+                for (int column = 0; column < batch.columnCount(); ++column) {
+                    const QVariant value = expected.value(column);
+                    QCOMPARE(batch.isNull(row, column), value.isNull());
+                    if (value.isNull())
+                        continue;
+                    switch (batch.columnType(column)) {
+                    case QSqlColumnBatch::Int64Column:
+                        QCOMPARE(batch.int64Column(column).at(row), value.toLongLong());
+                        break;
+                    case QSqlColumnBatch::DoubleColumn: {
+                        const double dbl = batch.doubleColumn(column).at(row);
+                        if (qIsNaN(value.toDouble()))
+                            QVERIFY(qIsNaN(dbl));
+                        else
+                            QCOMPARE(dbl, value.toDouble());
+                        break;
+                    }
+                    case QSqlColumnBatch::StringColumn:
+                        QCOMPARE(batch.stringColumn(column).at(row), value.toString());
+                        break;
+                    case QSqlColumnBatch::ByteArrayColumn:
+                        QCOMPARE(batch.byteArrayColumn(column).at(row), value.toByteArray());
+                        break;
+                    case QSqlColumnBatch::VariantColumn:
+                        QCOMPARE(batch.variantColumn(column).at(row), value);
+                        break;
+                    }
+                }
+            }
+            QVERIFY(!expected.next());
+            QVERIFY(!batchQuery.nextBatch(&batch, 10));
+        }
+    }
+
+    binaryDb = QSqlDatabase();
+    QSqlDatabase::removeDatabase(QLatin1String("nextBatchBinary"));
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 /* For task 157397: Using QSqlQuery with an invalid QSqlDatabase
    does not set the last error of the query.
    This test function will output some warnings, that's ok.
@@ -3068,6 +3390,160 @@ void tst_QSqlQuery::sqlite_finish()
     QSqlDatabase::removeDatabase( "sqlite_finish_sqlite" );
 }
 
+void tst_QSqlQuery::sqlite_statementCache()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("stmtcache", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id INTEGER, txt TEXT)"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (1, 'one')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (2, 'two')"));
+
+    const QString select = "SELECT id FROM " + tableName + " WHERE id >= ? ORDER BY id";
+    {
+        QSqlQuery q1(db);
+        QVERIFY_SQL(q1, prepare(select));
+        q1.addBindValue(1);
+        QVERIFY_SQL(q1, exec());
+        QVERIFY(q1.next());
+
+        // The same query may be used by two results at the same time
+        QSqlQuery q2(db);
+        QVERIFY_SQL(q2, prepare(select));
+        q2.addBindValue(2);
+        QVERIFY_SQL(q2, exec());
+        QVERIFY(q2.next());
+        QCOMPARE(q2.value(0).toInt(), 2);
+        QVERIFY(!q2.next());
+
+        QCOMPARE(q1.value(0).toInt(), 1);
+        QVERIFY(q1.next());
+        QCOMPARE(q1.value(0).toInt(), 2);
+    }
+
+    // A statement reused from the cache starts without any bound values
+    // and reflects changes of the schema
+    QVERIFY_SQL(q, exec("ALTER TABLE " + tableName + " ADD COLUMN extra INTEGER"));
+    QVERIFY_SQL(q, prepare("SELECT * FROM " + tableName + " WHERE id >= ? ORDER BY id"));
+    q.addBindValue(2);
+    QVERIFY_SQL(q, exec());
+    QVERIFY(q.next());
+    QCOMPARE(q.record().count(), 3);
+    QCOMPARE(q.value(0).toInt(), 2);
+
+    QVERIFY_SQL(q, prepare(select));
+    QVERIFY(!q.exec());
+    q.addBindValue(1);
+    QVERIFY_SQL(q, exec());
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 1);
+
+    q.clear();
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::sqlite_nextBatchStorageClasses()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("batchstorage", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    // SQLite keeps values that don't match the declared type as they are
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id INTEGER, num INTEGER, "
+                        "dbl REAL, txt TEXT, bin BLOB)"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (1, 7, 0.5, 'one', x'0102')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (2, NULL, 2, 'two', x'')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (3, 'abc', 'n/a', x'33', 'text')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (4, 1.5, 4.5, 'four', x'ff')"));
+
+    QVERIFY_SQL(q, exec("SELECT id, num, dbl, txt, bin FROM " + tableName + " ORDER BY id"));
+    QSqlColumnBatch batch;
+    QVERIFY(q.nextBatch(&batch, 2));
+    QCOMPARE(batch.columnType(1), QSqlColumnBatch::Int64Column);
+    QCOMPARE(batch.columnType(2), QSqlColumnBatch::DoubleColumn);
+    QCOMPARE(batch.columnType(3), QSqlColumnBatch::StringColumn);
+    QCOMPARE(batch.columnType(4), QSqlColumnBatch::ByteArrayColumn);
+    QCOMPARE(batch.int64Column(1), QList<qint64>({ 7, 0 }));
+    QVERIFY(batch.isNull(1, 1));
+    QCOMPARE(batch.doubleColumn(2), QList<double>({ 0.5, 2.0 }));
+    QCOMPARE(batch.byteArrayColumn(4), QList<QByteArray>({ "\x01\x02", "" }));
+
+    // The mismatched values aren't converted, the columns hold variants
+    QVERIFY(q.nextBatch(&batch, 2));
+    QCOMPARE(batch.rowCount(), 2);
+    QCOMPARE(batch.columnType(0), QSqlColumnBatch::Int64Column);
+    QCOMPARE(batch.int64Column(0), QList<qint64>({ 3, 4 }));
+    QCOMPARE(batch.columnType(1), QSqlColumnBatch::VariantColumn);
+    QCOMPARE(batch.variantColumn(1), QVariantList({ QString("abc"), 1.5 }));
+    QCOMPARE(batch.columnType(2), QSqlColumnBatch::VariantColumn);
+    QCOMPARE(batch.variantColumn(2), QVariantList({ QString("n/a"), 4.5 }));
+    QCOMPARE(batch.columnType(3), QSqlColumnBatch::VariantColumn);
+    QCOMPARE(batch.variantColumn(3), QVariantList({ QByteArray("3"), QString("four") }));
+    QCOMPARE(batch.columnType(4), QSqlColumnBatch::VariantColumn);
+    QCOMPARE(batch.variantColumn(4), QVariantList({ QString("text"), QByteArray("\xff") }));
+    QVERIFY(!q.nextBatch(&batch, 2));
+
+    q.clear();
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::sqlite_execBatchRollback()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("batchrollback", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id INTEGER PRIMARY KEY, txt TEXT)"));
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " (id, txt) VALUES (?, ?)"));
+    q.addBindValue(QVariantList{1, 2, 3});
+    q.addBindValue(QVariantList{"one", QVariant(QMetaType::fromType<QString>()), "three"});
+    QVERIFY_SQL(q, execBatch());
+
+    // The primary key of the last row collides, none of the rows is inserted
+    q.addBindValue(QVariantList{4, 5, 1});
+    q.addBindValue(QVariantList{"four", "five", "six"});
+    QVERIFY(!q.execBatch());
+    QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+
+    QVERIFY_SQL(q, exec("SELECT id, txt FROM " + tableName + " ORDER BY id"));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 1);
+    QCOMPARE(q.value(1).toString(), QString("one"));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 2);
+    QVERIFY(q.isNull(1));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 3);
+    QVERIFY(!q.next());
+
+    // Within an explicit transaction the batch doesn't commit on its own
+    QVERIFY_SQL(db, transaction());
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " (id, txt) VALUES (?, ?)"));
+    q.addBindValue(QVariantList{4, 5});
+    q.addBindValue(QVariantList{"four", "five"});
+    QVERIFY_SQL(q, execBatch());
+    QVERIFY_SQL(db, rollback());
+    QVERIFY_SQL(q, exec("SELECT COUNT(*) FROM " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 3);
+
+    q.clear();
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 void tst_QSqlQuery::nextResult()
 {
     QFETCH( QString, dbName );
@@ -31,6 +31,41 @@
 
 #include "testsqldriver.h"
 
+#include <limits>
+
+// Serves a fixed list of rows through the default implementations of
+// QSqlResult, for example QSqlResult::fetchBatch().
+class RowsResult : public TestSqlDriverResult
+{
+public:
+    RowsResult(const QSqlDriver *driver, const QSqlRecord &record, const QList<QVariantList> &rows)
+        : TestSqlDriverResult(driver), rec(record), rows(rows)
+    {
+        setActive(true);
+        setSelect(true);
+    }
+
+    using TestSqlDriverResult::fetchBatch;
+
+protected:
+    QVariant data(int index) override { return rows.at(at()).at(index); }
+    bool isNull(int index) override { return rows.at(at()).at(index).isNull(); }
+    bool fetch(int index) override
+    {
+        if (index < 0 || index >= rows.count())
+            return false;
+        setAt(index);
+        return true;
+    }
+    bool fetchFirst() override { return fetch(0); }
+    bool fetchLast() override { return fetch(rows.count() - 1); }
+    QSqlRecord record() const override { return rec; }
+
+private:
+    QSqlRecord rec;
+    QList<QVariantList> rows;
+};
+
 class tst_QSqlResult : public QObject
 {
     Q_OBJECT
@@ -41,6 +76,7 @@ public:
 private slots:
     void positionalToNamedBinding();
     void parseOfBoundValues();
+    void fetchBatchConversions();
 
 };
 
@@ -101,5 +137,63 @@ void tst_QSqlResult::parseOfBoundValues()
     QCOMPARE(result.boundValues().count(), 1);
 }
 
+void tst_QSqlResult::fetchBatchConversions()
+{
+    const qulonglong aboveInt64 = qulonglong(std::numeric_limits<qint64>::max()) + 1;
+    const qlonglong aboveExactDouble = (Q_INT64_C(1) << 53) + 1;
+
+    QSqlRecord record;
+    record.append(QSqlField("id", QMetaType::fromType<qlonglong>()));
+    record.append(QSqlField("big", QMetaType::fromType<qulonglong>()));
+    record.append(QSqlField("amount", QMetaType::fromType<double>()));
+    record.append(QSqlField("name", QMetaType::fromType<QString>()));
+    const QList<QVariantList> rows = {
+        { qlonglong(1), qulonglong(1), 0.5, QString("one") },
+        { qulonglong(2), std::numeric_limits<qulonglong>::max(), qlonglong(1) << 53, QString("two") },
+        { qlonglong(3), aboveInt64, QVariant(QMetaType::fromType<double>()), QString("three") },
+        { aboveInt64, qulonglong(4), aboveExactDouble, QByteArray("four") },
+    };
+
+    TestSqlDriver testDriver;
+    RowsResult result(&testDriver, record, rows);
+    QSqlColumnBatch batch;
+
+    // Values that can be converted exactly are stored in the typed lists,
+    // unsigned 64-bit fields are never
+    QVERIFY(result.fetchBatch(&batch, 2));
+    QCOMPARE(batch.rowCount(), 2);
+    QCOMPARE(batch.columnType(0), QSqlColumnBatch::Int64Column);
+    QCOMPARE(batch.columnType(1), QSqlColumnBatch::VariantColumn);
+    QCOMPARE(batch.columnType(2), QSqlColumnBatch::DoubleColumn);
+    QCOMPARE(batch.columnType(3), QSqlColumnBatch::StringColumn);
+    QCOMPARE(batch.int64Column(0), QList<qint64>({ 1, 2 }));
+    QCOMPARE(batch.variantColumn(1), QVariantList({ qulonglong(1), std::numeric_limits<qulonglong>::max() }));
+    QCOMPARE(batch.doubleColumn(2), QList<double>({ 0.5, double(Q_INT64_C(1) << 53) }));
+    QCOMPARE(batch.stringColumn(3), QStringList({ "one", "two" }));
+
+    // A value that doesn't fit turns the column into a variant column for
+    // this batch, keeping the values and NULLs appended before it
+    QVERIFY(result.fetchBatch(&batch, 2));
+    QCOMPARE(batch.rowCount(), 2);
+    QCOMPARE(batch.columnType(0), QSqlColumnBatch::VariantColumn);
+    QCOMPARE(batch.columnType(2), QSqlColumnBatch::VariantColumn);
+    QCOMPARE(batch.columnType(3), QSqlColumnBatch::VariantColumn);
+    QVERIFY(batch.int64Column(0).isEmpty());
+    QCOMPARE(batch.variantColumn(0), QVariantList({ qint64(3), aboveInt64 }));
+    QCOMPARE(batch.value(1, 0).toULongLong(), aboveInt64);
+    QVERIFY(batch.isNull(0, 2));
+    QVERIFY(batch.value(0, 2).isNull());
+    QCOMPARE(batch.value(0, 2).metaType(), QMetaType::fromType<double>());
+    QCOMPARE(batch.value(1, 2), QVariant(aboveExactDouble));
+    QCOMPARE(batch.variantColumn(3), QVariantList({ QString("three"), QByteArray("four") }));
+    QVERIFY(!result.fetchBatch(&batch, 2));
+
+    // The column types are derived from the record again for every batch
+    RowsResult again(&testDriver, record, rows.mid(0, 1));
+    QVERIFY(again.fetchBatch(&batch, 2));
+    QCOMPARE(batch.columnType(0), QSqlColumnBatch::Int64Column);
+    QCOMPARE(batch.columnType(2), QSqlColumnBatch::DoubleColumn);
+}
+
 QTEST_MAIN( tst_QSqlResult )
 #include "tst_qsqlresult.moc"
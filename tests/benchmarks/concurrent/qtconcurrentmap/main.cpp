@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtConcurrent>
+
+static int addOne(int value)
+{
+    return value + 1;
+}
+
+static QList<int> makeInput(int count)
+{
+    QList<int> input;
+    input.reserve(count);
+    for (int i = 0; i < count; ++i)
+        input.append(i);
+    return input;
+}
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void mapped_data();
+    void mapped();
+    void resultsIteration_data() { mapped_data(); }
+    void resultsIteration();
+    void blockingMapped_data() { mapped_data(); }
+    void blockingMapped();
+};
+
+void tst_QtConcurrentMap::mapped_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+
+// Time until all results are stored, with almost no work per item,
+// so that reporting and storing the results dominates
+void tst_QtConcurrentMap::mapped()
+{
+    QFETCH(int, count);
+    const QList<int> input = makeInput(count);
+
+    QBENCHMARK {
+        QFuture<int> future = QtConcurrent::mapped(input, addOne);
+        future.waitForFinished();
+        QCOMPARE(future.resultCount(), count);
+    }
+}
+
+// Reading back the results one by one, as QFuture::const_iterator does
+void tst_QtConcurrentMap::resultsIteration()
+{
+    QFETCH(int, count);
+    const QList<int> input = makeInput(count);
+    QFuture<int> future = QtConcurrent::mapped(input, addOne);
+    future.waitForFinished();
+
+    QBENCHMARK {
+        qint64 sum = 0;
+        for (int result : future)
+            sum += result;
+        QCOMPARE(sum, qint64(count) * (count + 1) / 2);
+    }
+}
+
+void tst_QtConcurrentMap::blockingMapped()
+{
+    QFETCH(int, count);
+    const QList<int> input = makeInput(count);
+
+    QBENCHMARK {
+        const QList<int> results = QtConcurrent::blockingMapped(input, addOne);
+        QCOMPARE(results.size(), count);
+    }
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+
+#include "main.moc"
@@ -0,0 +1,5 @@
+CONFIG += benchmark
+QT = core concurrent testlib
+
+TARGET = tst_bench_qtconcurrentmap
+SOURCES += main.cpp
@@ -1,6 +1,7 @@
 TEMPLATE = subdirs
 SUBDIRS = \
         io \
+        itemmodels \
         json \
         mimetypes \
         kernel \
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QAbstractListModel>
+#include <QRegularExpression>
+#include <QSortFilterProxyModel>
+
+class NumberModel : public QAbstractListModel
+{
+public:
+    explicit NumberModel(int count)
+    {
+        values.reserve(count);
+        for (int i = 0; i < count; ++i)
+            values.append(QString::number(quint32(i) * 2654435761u % 1000003u));
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : values.size();
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role != Qt::DisplayRole)
+            return QVariant();
+        return values.at(index.row());
+    }
+
+    // Rewrites every step-th value and reports it with a single dataChanged()
+    void touch(int step)
+    {
+        for (int i = 0; i < values.size(); i += step)
+            values[i].prepend(QLatin1Char('1'));
+        emit dataChanged(index(0), index(values.size() - 1));
+    }
+
+    QStringList values;
+};
+
+class tst_QSortFilterProxyModel : public QObject
+{
+    Q_OBJECT
+private slots:
+    void filter_data();
+    void filter();
+    void sort_data() { filter_data(); }
+    void sort();
+    void resort_data() { filter_data(); }
+    void resort();
+};
+
+void tst_QSortFilterProxyModel::filter_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<bool>("parallel");
+
+    for (int rows : {10000, 100000, 1000000}) {
+        QTest::addRow("%d-serial", rows) << rows << false;
+        QTest::addRow("%d-parallel", rows) << rows << true;
+    }
+}
+
+void tst_QSortFilterProxyModel::filter()
+{
+    QFETCH(int, rows);
+    QFETCH(bool, parallel);
+
+    NumberModel model(rows);
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortFilterEnabled(parallel);
+    proxy.setSourceModel(&model);
+    proxy.rowCount();
+
+    const QRegularExpression patterns[] = {
+        QRegularExpression(QStringLiteral("^[1-5].*7")),
+        QRegularExpression(QStringLiteral("3.*[02468]$"))
+    };
+    int i = 0;
+    QBENCHMARK {
+        proxy.setFilterRegularExpression(patterns[i++ % 2]);
+        proxy.rowCount();
+    }
+}
+
+void tst_QSortFilterProxyModel::sort()
+{
+    QFETCH(int, rows);
+    QFETCH(bool, parallel);
+
+    NumberModel model(rows);
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortFilterEnabled(parallel);
+    proxy.setSourceModel(&model);
+
+    int i = 0;
+    QBENCHMARK {
+        proxy.sort(0, i++ % 2 ? Qt::DescendingOrder : Qt::AscendingOrder);
+    }
+}
+
+void tst_QSortFilterProxyModel::resort()
+{
+    QFETCH(int, rows);
+    QFETCH(bool, parallel);
+
+    NumberModel model(rows);
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortFilterEnabled(parallel);
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+
+    // one changed row in a hundred, all reported by one dataChanged()
+    QBENCHMARK {
+        model.touch(100);
+    }
+}
+
+QTEST_MAIN(tst_QSortFilterProxyModel)
+
+#include "main.moc"
@@ -0,0 +1,5 @@
+CONFIG += benchmark
+QT = core testlib
+
+TARGET = tst_bench_qsortfilterproxymodel
+SOURCES += main.cpp
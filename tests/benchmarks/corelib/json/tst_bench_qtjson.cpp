@@ -27,8 +27,12 @@
 ****************************************************************************/
 
 #include <QtTest>
+#include <qcborarray.h>
+#include <qcbormap.h>
+#include <qcborvalue.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qtemporaryfile.h>
 
 class BenchmarkQtJson: public QObject
 {
@@ -45,6 +49,10 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseStrings_data();
+    void parseStrings();
+    void parseCborBlobs_data();
+    void parseCborBlobs();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -117,6 +125,77 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtJson::parseStrings_data()
+{
+    QTest::addColumn<QByteArray>("value");
+
+    QTest::newRow("ascii") << QByteArray("The quick brown fox jumps over the lazy dog");
+    QTest::newRow("cyrillic") << QByteArray("\xd0\xa1\xd1\x8a\xd0\xb5\xd1\x88\xd1\x8c "
+                                            "\xd0\xb6\xd0\xb5 \xd0\xb5\xd1\x89\xd1\x91 "
+                                            "\xd1\x8d\xd1\x82\xd0\xb8\xd1\x85 "
+                                            "\xd0\xbc\xd1\x8f\xd0\xb3\xd0\xba\xd0\xb8\xd1\x85");
+    QTest::newRow("escaped") << QByteArray("The quick brown fox\\njumps over the \\\"lazy\\\" dog");
+    QTest::newRow("long ascii") << QByteArray(1024, 'x');
+}
+
+void BenchmarkQtJson::parseStrings()
+{
+    QFETCH(QByteArray, value);
+
+    // an array of 10000 records with string keys and values, as found in logs
+    QByteArray json = "[";
+    for (int i = 0; i < 10000; ++i) {
+        if (i)
+            json += ',';
+        json += "{\"id\":" + QByteArray::number(i)
+                + ",\"message\":\"" + value
+                + "\",\"source\":\"" + value + "\"}";
+    }
+    json += ']';
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        QVERIFY(doc.isArray());
+    }
+}
+
+void BenchmarkQtJson::parseCborBlobs_data()
+{
+    QTest::addColumn<bool>("raw");
+
+    QTest::newRow("copy") << false;
+    QTest::newRow("raw") << true;
+}
+
+void BenchmarkQtJson::parseCborBlobs()
+{
+    QFETCH(bool, raw);
+
+    // 1000 records with a 16K byte array each, decoded from a mapped file
+    QCborArray records;
+    for (int i = 0; i < 1000; ++i) {
+        QCborMap record;
+        record[QLatin1String("id")] = i;
+        record[QLatin1String("name")] = QLatin1String("record ") + QString::number(i);
+        record[QLatin1String("payload")] = QByteArray(16 * 1024, char('a' + i % 26));
+        records.append(record);
+    }
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(records.toCborValue().toCbor());
+    file.flush();
+    const uchar *map = file.map(0, file.size());
+    QVERIFY(map);
+    const QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char *>(map),
+                                                    file.size());
+
+    QBENCHMARK {
+        const QCborValue value = raw ? QCborValue::fromRawCbor(data) : QCborValue::fromCbor(data);
+        QCOMPARE(value.toArray().size(), 1000);
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -83,6 +83,46 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class Producer : public QObject
+{
+    Q_OBJECT
+public:
+    void produce(int count, bool withString)
+    {
+        const QString payload = QStringLiteral("payload");
+        for (int i = 0; i < count; ++i) {
+            if (withString)
+                emit stringMessage(i, payload);
+            else
+                emit intMessage(i);
+        }
+    }
+
+signals:
+    void intMessage(int);
+    void stringMessage(int, const QString &);
+};
+
+class Consumer : public QObject
+{
+    Q_OBJECT
+public:
+    void expect(int count) { m_remaining = count; }
+
+public slots:
+    void intMessage(int) { received(); }
+    void stringMessage(int, const QString &) { received(); }
+
+private:
+    void received()
+    {
+        if (--m_remaining == 0)
+            QTestEventLoop::instance().exitLoop();
+    }
+
+    int m_remaining = 0;
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -96,6 +136,8 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void queuedSignalThroughput_data();
+    void queuedSignalThroughput();
 };
 
 void EventsBench::initTestCase()
@@ -169,6 +211,54 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::queuedSignalThroughput_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::addColumn<bool>("withString");
+    QTest::newRow("1 producer, int") << 1 << false;
+    QTest::newRow("1 producer, int+QString") << 1 << true;
+    QTest::newRow("4 producers, int") << 4 << false;
+    QTest::newRow("4 producers, int+QString") << 4 << true;
+}
+
+void EventsBench::queuedSignalThroughput()
+{
+    QFETCH(int, producers);
+    QFETCH(bool, withString);
+    const int messagesPerProducer = 100000;
+
+    // Each producer emits from its own thread into a consumer living in the
+    // main thread, so every emission is a cross-thread queued call.
+    Consumer consumer;
+    QList<Producer *> sources;
+    for (int i = 0; i < producers; ++i) {
+        Producer *producer = new Producer;
+        connect(producer, &Producer::intMessage, &consumer, &Consumer::intMessage,
+                Qt::QueuedConnection);
+        connect(producer, &Producer::stringMessage, &consumer, &Consumer::stringMessage,
+                Qt::QueuedConnection);
+        sources << producer;
+    }
+
+    QBENCHMARK {
+        consumer.expect(producers * messagesPerProducer);
+        QList<QThread *> threads;
+        for (Producer *producer : qAsConst(sources)) {
+            threads << QThread::create([=] {
+                producer->produce(messagesPerProducer, withString);
+            });
+            threads.last()->start();
+        }
+        QTestEventLoop::instance().enterLoop(120);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+        for (QThread *thread : qAsConst(threads)) {
+            thread->wait();
+            delete thread;
+        }
+    }
+    qDeleteAll(sources);
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
@@ -8,6 +8,8 @@ SUBDIRS = \
         qcoreapplication \
         qtimer_vs_qmetaobject
 
+unix: SUBDIRS += qeventdispatcher
+
 !qtHaveModule(widgets): SUBDIRS -= \
     qmetaobject \
     qobject
@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSocketNotifier>
+#include <QtTest/QtTest>
+
+#include <private/qeventdispatcher_unix_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include <memory>
+#include <vector>
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void wakeUp_data();
+    void wakeUp();
+    void armAndCancelTimers_data();
+    void armAndCancelTimers();
+};
+
+void tst_QEventDispatcher::initTestCase()
+{
+    // 10k notifiers need more descriptors than the usual soft limit
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QEventDispatcher::wakeUp_data()
+{
+    QTest::addColumn<bool>("epoll");
+    QTest::addColumn<int>("notifierCount");
+
+    for (int count : { 100, 1000, 10000 }) {
+        QTest::addRow("poll-%d", count) << false << count;
+#if QT_CONFIG(epoll)
+        QTest::addRow("epoll-%d", count) << true << count;
+#endif
+    }
+}
+
+// Measures the cost of one processEvents() round when a single one of
+// notifierCount registered descriptors is ready.
+void tst_QEventDispatcher::wakeUp()
+{
+    QFETCH(bool, epoll);
+    QFETCH(int, notifierCount);
+
+    if (epoll)
+        qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    QEventDispatcherUNIX dispatcher;
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+
+    int fds[2];
+    QCOMPARE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    // idle descriptors refer to the same socket, which is never readable
+    std::vector<int> idle;
+    idle.reserve(notifierCount - 1);
+    for (int i = 0; i < notifierCount - 1; ++i) {
+        const int fd = qt_safe_dup(fds[1]);
+        if (fd == -1) {
+            for (int d : idle)
+                qt_safe_close(d);
+            QSKIP("Not enough file descriptors available");
+        }
+        idle.push_back(fd);
+    }
+
+    std::vector<std::unique_ptr<QSocketNotifier>> notifiers;
+    notifiers.reserve(notifierCount);
+    auto addNotifier = [&](int fd) {
+        auto notifier = std::make_unique<QSocketNotifier>(fd, QSocketNotifier::Read);
+        // move it from the thread's dispatcher to ours
+        notifier->setEnabled(false);
+        dispatcher.registerSocketNotifier(notifier.get());
+        notifiers.push_back(std::move(notifier));
+    };
+    for (int fd : idle)
+        addNotifier(fd);
+    addNotifier(fds[0]);
+
+    // level-triggered: the unread byte keeps fds[0] ready for every round
+    QCOMPARE(qt_safe_write(fds[1], "x", 1), 1);
+    QVERIFY(dispatcher.processEvents(QEventLoop::AllEvents));
+
+    QBENCHMARK {
+        dispatcher.processEvents(QEventLoop::AllEvents);
+    }
+
+    for (const auto &notifier : notifiers)
+        dispatcher.unregisterSocketNotifier(notifier.get());
+    notifiers.clear();
+    for (int fd : idle)
+        qt_safe_close(fd);
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+}
+
+void tst_QEventDispatcher::armAndCancelTimers_data()
+{
+    QTest::addColumn<Qt::TimerType>("timerType");
+
+    QTest::newRow("precise") << Qt::PreciseTimer;
+    QTest::newRow("coarse") << Qt::CoarseTimer;
+    QTest::newRow("very-coarse") << Qt::VeryCoarseTimer;
+}
+
+// Arms 100k per-object timeouts, then cancels them in an order unrelated
+// to their expiry.
+void tst_QEventDispatcher::armAndCancelTimers()
+{
+    QFETCH(Qt::TimerType, timerType);
+    constexpr int TimerCount = 100000;
+
+    std::vector<std::unique_ptr<QObject>> objects;
+    objects.reserve(TimerCount);
+    for (int i = 0; i < TimerCount; ++i)
+        objects.push_back(std::make_unique<QObject>());
+
+    std::vector<int> ids(TimerCount);
+    QBENCHMARK {
+        for (int i = 0; i < TimerCount; ++i)
+            ids[i] = objects[i]->startTimer(30000 + (i * 7919) % 60000, timerType);
+        for (int i = 0; i < TimerCount; i += 2)
+            objects[i]->killTimer(ids[i]);
+        for (int i = 1; i < TimerCount; i += 2)
+            objects[i]->killTimer(ids[i]);
+    }
+}
+
+QTEST_MAIN(tst_QEventDispatcher)
+
+#include "tst_qeventdispatcher.moc"
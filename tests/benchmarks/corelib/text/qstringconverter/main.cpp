@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QStringConverter>
+
+class tst_QStringConverter: public QObject
+{
+    Q_OBJECT
+private slots:
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data() { fromUtf8_data(); }
+    void toUtf8();
+    void decoder_data() { fromUtf8_data(); }
+    void decoder();
+    void encoder_data() { fromUtf8_data(); }
+    void encoder();
+};
+
+// Samples of running text, repeated to about 64K of UTF-8
+void tst_QStringConverter::fromUtf8_data()
+{
+    QTest::addColumn<QString>("text");
+
+    const auto corpus = [](const char *sample) {
+        const QString text = QString::fromUtf8(sample);
+        return text.repeated(64 * 1024 / qstrlen(sample) + 1);
+    };
+
+    QTest::newRow("english") << corpus("The quick brown fox jumps over the lazy dog. ");
+    QTest::newRow("russian") << corpus("\xd0\xa1\xd1\x8a\xd0\xb5\xd1\x88\xd1\x8c \xd0\xb6\xd0\xb5 "
+                                       "\xd0\xb5\xd1\x89\xd1\x91 \xd1\x8d\xd1\x82\xd0\xb8\xd1\x85 "
+                                       "\xd0\xbc\xd1\x8f\xd0\xb3\xd0\xba\xd0\xb8\xd1\x85 "
+                                       "\xd1\x84\xd1\x80\xd0\xb0\xd0\xbd\xd1\x86\xd1\x83\xd0\xb7"
+                                       "\xd1\x81\xd0\xba\xd0\xb8\xd1\x85 \xd0\xb1\xd1\x83\xd0\xbb"
+                                       "\xd0\xbe\xd0\xba. ");
+    QTest::newRow("greek") << corpus("\xce\x93\xce\xb1\xce\xb6\xce\xad\xce\xb5\xcf\x82 "
+                                     "\xce\xba\xce\xb1\xe1\xbd\xb6 \xce\xbc\xcf\x85\xcf\x81\xcf\x84"
+                                     "\xce\xb9\xe1\xbd\xb2\xcf\x82 \xce\xb4\xe1\xbd\xb2\xce\xbd "
+                                     "\xce\xb8\xe1\xbd\xb0 \xce\xb2\xcf\x81\xe1\xbf\xb6 \xcf\x80"
+                                     "\xce\xb9\xe1\xbd\xb0. ");
+    QTest::newRow("chinese") << corpus("\xe6\x95\x8f\xe6\x8d\xb7\xe7\x9a\x84\xe6\xa3\x95\xe8\x89"
+                                       "\xb2\xe7\x8b\x90\xe7\x8b\xb8\xe8\xb7\xb3\xe8\xbf\x87\xe4\xba"
+                                       "\x86\xe6\x87\x92\xe7\x8b\x97\xe3\x80\x82");
+    QTest::newRow("japanese") << corpus("\xe3\x81\x84\xe3\x82\x8d\xe3\x81\xaf\xe3\x81\xab\xe3\x81"
+                                        "\xbb\xe3\x81\xb8\xe3\x81\xa8 \xe3\x81\xa1\xe3\x82\x8a\xe3"
+                                        "\x81\xac\xe3\x82\x8b\xe3\x82\x92\xe3\x80\x81\xe6\x97\xa5"
+                                        "\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe3\x83\x86\xe3\x82"
+                                        "\xad\xe3\x82\xb9\xe3\x83\x88\xe3\x80\x82");
+    QTest::newRow("mixed") << corpus("Qt 6 \xd0\xbf\xd0\xbe\xd0\xb4\xd0\xb4\xd0\xb5\xd1\x80\xd0\xb6"
+                                     "\xd0\xb8\xd0\xb2\xd0\xb0\xd0\xb5\xd1\x82 Unicode: \xe6\x96\x87"
+                                     "\xe5\xad\x97\xe5\x88\x97, \xce\xb1\xce\xbb\xcf\x86\xce\xac"
+                                     "\xce\xb2\xce\xb7\xcf\x84\xce\xbf, \xf0\x9f\x98\x80. ");
+}
+
+void tst_QStringConverter::fromUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    QBENCHMARK {
+        const QString result = QString::fromUtf8(utf8);
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QStringConverter::toUtf8()
+{
+    QFETCH(QString, text);
+
+    QBENCHMARK {
+        const QByteArray result = text.toUtf8();
+        Q_UNUSED(result);
+    }
+}
+
+// Decodes in 4K blocks, as QTextStream does when reading
+void tst_QStringConverter::decoder()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    QBENCHMARK {
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QString result;
+        for (qsizetype i = 0; i < utf8.size(); i += 4096)
+            result += decoder(QByteArrayView(utf8).mid(i, 4096));
+    }
+}
+
+void tst_QStringConverter::encoder()
+{
+    QFETCH(QString, text);
+
+    QBENCHMARK {
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        QByteArray result;
+        for (qsizetype i = 0; i < text.size(); i += 4096)
+            result += encoder(QStringView(text).mid(i, 4096));
+    }
+}
+
+QTEST_MAIN(tst_QStringConverter)
+
+#include "main.moc"
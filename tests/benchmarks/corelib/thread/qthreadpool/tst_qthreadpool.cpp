@@ -29,6 +29,9 @@
 #include <qtest.h>
 #include <QtCore>
 
+#include <memory>
+#include <vector>
+
 class tst_QThreadPool : public QObject
 {
     Q_OBJECT
@@ -40,6 +43,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void contendedStart_data();
+    void contendedStart();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +80,46 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::contendedStart_data()
+{
+    QTest::addColumn<bool>("workStealing");
+    QTest::addColumn<int>("submitters");
+
+    for (int submitters : { 1, 4, 16 }) {
+        QTest::addRow("locked-%d", submitters) << false << submitters;
+        QTest::addRow("work-stealing-%d", submitters) << true << submitters;
+    }
+}
+
+// Many tiny tasks started from several threads at once, similar to what
+// QtConcurrent::map() produces.
+void tst_QThreadPool::contendedStart()
+{
+    QFETCH(bool, workStealing);
+    QFETCH(int, submitters);
+    constexpr int TasksPerSubmitter = 20000;
+
+    if (workStealing)
+        qputenv("QT_THREADPOOL_WORK_STEALING", "1");
+    QThreadPool threadPool;
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
+
+    QAtomicInt count;
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < submitters; ++i) {
+            threads.emplace_back(QThread::create([&threadPool, &count]() {
+                for (int j = 0; j < TasksPerSubmitter; ++j)
+                    threadPool.start([&count]() { count.ref(); });
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            thread->wait();
+        threadPool.waitForDone();
+    }
+    QVERIFY(count.loadRelaxed() % (submitters * TasksPerSubmitter) == 0);
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
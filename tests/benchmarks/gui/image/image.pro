@@ -5,4 +5,5 @@ SUBDIRS = \
         qimagereader \
         qimagescale \
         qpixmap \
-        qpixmapcache
+        qpixmapcache \
+        qpnghandler
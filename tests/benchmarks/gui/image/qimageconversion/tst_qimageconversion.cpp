@@ -50,6 +50,9 @@ private slots:
     void convertRgb32_data();
     void convertRgb32();
 
+    void convertRgba64_data();
+    void convertRgba64();
+
     void convertGeneric_data();
     void convertGeneric();
 
@@ -232,6 +235,39 @@ void tst_QImageConversion::convertRgb32()
     }
 }
 
+void tst_QImageConversion::convertRgba64_data()
+{
+    QTest::addColumn<QImage>("inputImage");
+    QTest::addColumn<QImage::Format>("outputFormat");
+    QImage argb32 = generateImageArgb32(1000, 1000);
+    QImage rgba64 = argb32.convertToFormat(QImage::Format_RGBA64);
+    QImage rgba64pm = argb32.convertToFormat(QImage::Format_RGBA64_Premultiplied);
+    QImage gray16 = argb32.convertToFormat(QImage::Format_Grayscale16);
+
+    QTest::newRow("rgba64 -> rgbx64") << rgba64 << QImage::Format_RGBX64;
+    QTest::newRow("rgba64 -> rgba64pm") << rgba64 << QImage::Format_RGBA64_Premultiplied;
+    QTest::newRow("rgba64 -> argb32") << rgba64 << QImage::Format_ARGB32;
+    QTest::newRow("rgba64 -> rgba8888") << rgba64 << QImage::Format_RGBA8888;
+    QTest::newRow("rgba64 -> gray16") << rgba64 << QImage::Format_Grayscale16;
+
+    QTest::newRow("rgba64pm -> rgba64") << rgba64pm << QImage::Format_RGBA64;
+    QTest::newRow("rgba64pm -> rgbx64") << rgba64pm << QImage::Format_RGBX64;
+    QTest::newRow("rgba64pm -> argb32pm") << rgba64pm << QImage::Format_ARGB32_Premultiplied;
+
+    QTest::newRow("gray16 -> rgba64") << gray16 << QImage::Format_RGBA64;
+}
+
+void tst_QImageConversion::convertRgba64()
+{
+    QFETCH(QImage, inputImage);
+    QFETCH(QImage::Format, outputFormat);
+
+    QBENCHMARK {
+        QImage output = inputImage.convertToFormat(outputFormat);
+        output.constBits();
+    }
+}
+
 void tst_QImageConversion::convertGeneric_data()
 {
     QTest::addColumn<QImage>("inputImage");
@@ -344,6 +380,7 @@ void tst_QImageConversion::convertGenericInplace_data()
     QImage rgb16 = argb32.convertToFormat(QImage::Format_RGB16);
     QImage rgb30 = argb32.convertToFormat(QImage::Format_RGB30);
     QImage rgb888 = argb32.convertToFormat(QImage::Format_RGB888);
+    QImage rgba64 = argb32.convertToFormat(QImage::Format_RGBA64);
 
     QTest::newRow("argb32 -> argb32pm -> argb32") << argb32 << QImage::Format_ARGB32_Premultiplied;
     QTest::newRow("argb32 -> rgb32 -> argb32") << argb32 << QImage::Format_RGB32;
@@ -373,6 +410,9 @@ void tst_QImageConversion::convertGenericInplace_data()
 
     QTest::newRow("rgb30 -> bgr30 -> rgb30") << rgb30 << QImage::Format_BGR30;
     QTest::newRow("rgb888 -> bgr888 -> rgb888") << rgb888 << QImage::Format_BGR888;
+
+    QTest::newRow("argb32 -> a2rgb30 -> argb32") << argb32 << QImage::Format_A2RGB30_Premultiplied;
+    QTest::newRow("rgba64 -> rgba64pm -> rgba64") << rgba64 << QImage::Format_RGBA64_Premultiplied;
 }
 
 void tst_QImageConversion::convertGenericInplace()
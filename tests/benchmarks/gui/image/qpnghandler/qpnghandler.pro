@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qpnghandler
+QT += testlib
+SOURCES += tst_qpnghandler.cpp
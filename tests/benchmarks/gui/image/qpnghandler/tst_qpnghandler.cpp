@@ -0,0 +1,183 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QBuffer>
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QPainter>
+#include <QRandomGenerator>
+
+class tst_QPngHandler : public QObject
+{
+    Q_OBJECT
+private slots:
+    void decode_data();
+    void decode();
+
+    void encode_data();
+    void encode();
+
+private:
+    static QImage generateScreenshot(const QSize &size, QImage::Format format);
+    static QByteArray encodePng(const QImage &image, int compression,
+                                const QByteArray &subType = QByteArray());
+};
+
+// Something with the statistics of a desktop screenshot: flat areas, gradients,
+// antialiased edges and lots of small glyph-like features.
+QImage tst_QPngHandler::generateScreenshot(const QSize &size, QImage::Format format)
+{
+    const int w = size.width();
+    const int h = size.height();
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(QColor(0xf0, 0xf0, 0xf0));
+
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+
+    QLinearGradient titleBar(0, 0, 0, 60);
+    titleBar.setColorAt(0, QColor(0x40, 0x60, 0xa0));
+    titleBar.setColorAt(1, QColor(0x20, 0x30, 0x60));
+    p.fillRect(0, 0, w, 60, titleBar);
+
+    QRandomGenerator rng(42);
+    for (int i = 0; i < 200; ++i) {
+        const QRect rect(rng.bounded(w), 60 + rng.bounded(h), 50 + rng.bounded(w / 4),
+                         20 + rng.bounded(h / 4));
+        p.setPen(QColor::fromRgb(rng.generate()));
+        p.setBrush(QColor::fromRgba(rng.generate() | 0xff000000));
+        if (i % 3 == 0)
+            p.drawRoundedRect(rect, 8, 8);
+        else if (i % 3 == 1)
+            p.drawEllipse(rect);
+        else
+            p.drawRect(rect);
+    }
+    for (int y = 80; y < h; y += 18) {
+        for (int x = 20; x < w - 100; x += 9 + rng.bounded(30))
+            p.fillRect(x, y, 6, 10, QColor(0x20, 0x20, 0x20));
+    }
+
+    QRadialGradient highlight(w / 2, h / 2, h / 3);
+    highlight.setColorAt(0, QColor(255, 255, 255, 200));
+    highlight.setColorAt(1, Qt::transparent);
+    p.setPen(Qt::NoPen);
+    p.setBrush(highlight);
+    p.drawEllipse(QPoint(w / 2, h / 2), h / 3, h / 3);
+    p.end();
+
+    return image.convertToFormat(format);
+}
+
+QByteArray tst_QPngHandler::encodePng(const QImage &image, int compression,
+                                      const QByteArray &subType)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, "png");
+    writer.setCompression(compression);
+    writer.setSubType(subType);
+    if (!writer.write(image))
+        return QByteArray();
+    return data;
+}
+
+void tst_QPngHandler::decode_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    const QSize sizes[] = { QSize(1920, 1080), QSize(3840, 2160) };
+    for (const QSize &size : sizes) {
+        const QByteArray name = QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height());
+        const QImage rgb = generateScreenshot(size, QImage::Format_RGB32);
+        const QImage argb = generateScreenshot(size, QImage::Format_ARGB32);
+        QTest::newRow(name + " rgb") << encodePng(rgb, 50);
+        QTest::newRow(name + " rgb, fast") << encodePng(rgb, 20, "fast");
+        QTest::newRow(name + " argb") << encodePng(argb, 50);
+        QTest::newRow(name + " argb, fast") << encodePng(argb, 20, "fast");
+    }
+}
+
+void tst_QPngHandler::decode()
+{
+    QFETCH(QByteArray, data);
+    QVERIFY(!data.isEmpty());
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QImage image;
+    QBENCHMARK {
+        buffer.seek(0);
+        QImageReader reader(&buffer, "png");
+        image = reader.read();
+    }
+    QVERIFY(!image.isNull());
+}
+
+void tst_QPngHandler::encode_data()
+{
+    QTest::addColumn<QImage>("image");
+    QTest::addColumn<int>("compression");
+    QTest::addColumn<QByteArray>("subType");
+
+    const QSize sizes[] = { QSize(1920, 1080), QSize(3840, 2160) };
+    for (const QSize &size : sizes) {
+        const QByteArray name = QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height());
+        const QImage rgb = generateScreenshot(size, QImage::Format_RGB32);
+        const QImage argb = generateScreenshot(size, QImage::Format_ARGB32);
+        for (int compression : { 0, 20, 50, 90 }) {
+            for (const QByteArray subType : { QByteArray(), QByteArray("fast") }) {
+                const QByteArray level = ", compression " + QByteArray::number(compression)
+                        + (subType.isEmpty() ? QByteArray() : ", " + subType);
+                QTest::newRow(name + " rgb" + level) << rgb << compression << subType;
+                QTest::newRow(name + " argb" + level) << argb << compression << subType;
+            }
+        }
+    }
+}
+
+void tst_QPngHandler::encode()
+{
+    QFETCH(QImage, image);
+    QFETCH(int, compression);
+    QFETCH(QByteArray, subType);
+
+    QByteArray data;
+    QBENCHMARK {
+        data = encodePng(image, compression, subType);
+    }
+    QVERIFY(!data.isEmpty());
+}
+
+QTEST_MAIN(tst_QPngHandler)
+
+#include "tst_qpnghandler.moc"
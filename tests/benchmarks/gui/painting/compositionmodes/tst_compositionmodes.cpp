@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QPainter>
+#include <QImage>
+
+Q_DECLARE_METATYPE(QImage::Format)
+Q_DECLARE_METATYPE(QPainter::CompositionMode)
+
+#define SIZE 512
+
+class tst_CompositionModes : public QObject
+{
+    Q_OBJECT
+
+    void addRows();
+
+private slots:
+    void drawImage_data();
+    void drawImage();
+    void fillRect_data();
+    void fillRect();
+};
+
+void tst_CompositionModes::addRows()
+{
+    QTest::addColumn<QPainter::CompositionMode>("mode");
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<qreal>("opacity");
+
+    const struct {
+        QPainter::CompositionMode mode;
+        const char *name;
+    } modes[] = {
+        { QPainter::CompositionMode_SourceOver, "SourceOver" },
+        { QPainter::CompositionMode_DestinationOver, "DestinationOver" },
+        { QPainter::CompositionMode_Clear, "Clear" },
+        { QPainter::CompositionMode_Source, "Source" },
+        { QPainter::CompositionMode_SourceIn, "SourceIn" },
+        { QPainter::CompositionMode_DestinationIn, "DestinationIn" },
+        { QPainter::CompositionMode_SourceOut, "SourceOut" },
+        { QPainter::CompositionMode_DestinationOut, "DestinationOut" },
+        { QPainter::CompositionMode_SourceAtop, "SourceAtop" },
+        { QPainter::CompositionMode_DestinationAtop, "DestinationAtop" },
+        { QPainter::CompositionMode_Xor, "Xor" },
+        { QPainter::CompositionMode_Plus, "Plus" },
+    };
+
+    const struct {
+        QImage::Format format;
+        const char *name;
+    } formats[] = {
+        { QImage::Format_ARGB32_Premultiplied, "argb32pm" },
+        { QImage::Format_RGBA64_Premultiplied, "rgba64pm" },
+    };
+
+    for (const auto &format : formats) {
+        for (const auto &mode : modes) {
+            QTest::addRow("%s-%s", format.name, mode.name) << mode.mode << format.format << qreal(1);
+            QTest::addRow("%s-%s-opacity", format.name, mode.name) << mode.mode << format.format << qreal(0.5);
+        }
+    }
+}
+
+static QImage createImage(QImage::Format format, int alphaOffset)
+{
+    QImage image(SIZE, SIZE, format);
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x)
+            image.setPixelColor(x, y, QColor::fromRgb(x & 0xff, y & 0xff, (x ^ y) & 0xff, (x + y + alphaOffset) & 0xff));
+    }
+    return image;
+}
+
+void tst_CompositionModes::drawImage_data()
+{
+    addRows();
+}
+
+void tst_CompositionModes::drawImage()
+{
+    QFETCH(QPainter::CompositionMode, mode);
+    QFETCH(QImage::Format, format);
+    QFETCH(qreal, opacity);
+
+    const QImage source = createImage(format, 0);
+    const QImage background = createImage(format, 128);
+    QImage target = background;
+
+    QPainter p(&target);
+    p.setCompositionMode(mode);
+    p.setOpacity(opacity);
+    QBENCHMARK {
+        p.drawImage(0, 0, source);
+    }
+}
+
+void tst_CompositionModes::fillRect_data()
+{
+    addRows();
+}
+
+void tst_CompositionModes::fillRect()
+{
+    QFETCH(QPainter::CompositionMode, mode);
+    QFETCH(QImage::Format, format);
+    QFETCH(qreal, opacity);
+
+    const QImage background = createImage(format, 128);
+    QImage target = background;
+    const QColor color(64, 128, 192, 160);
+
+    QPainter p(&target);
+    p.setCompositionMode(mode);
+    p.setOpacity(opacity);
+    QBENCHMARK {
+        p.fillRect(target.rect(), color);
+    }
+}
+
+QTEST_MAIN(tst_CompositionModes)
+
+#include "tst_compositionmodes.moc"
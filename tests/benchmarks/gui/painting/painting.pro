@@ -1,9 +1,11 @@
 TEMPLATE = subdirs
 SUBDIRS = \
+        compositionmodes \
         drawtexture \
         qcolor \
         qpainter \
         qregion \
+        qtiledpaintdevice \
         qtransform \
         qtbench \
         lancebench
@@ -0,0 +1,6 @@
+QT += testlib gui-private
+
+TEMPLATE = app
+TARGET = tst_bench_qtiledpaintdevice
+
+SOURCES += tst_qtiledpaintdevice.cpp
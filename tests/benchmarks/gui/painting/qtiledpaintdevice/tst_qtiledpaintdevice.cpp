@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qimage.h>
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <private/qtiledpaintdevice_p.h>
+
+class tst_QTiledPaintDevice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void paint_data();
+    void paint();
+};
+
+enum Workload {
+    AntialiasedPaths,
+    SmoothImages,
+    Gradients
+};
+Q_DECLARE_METATYPE(Workload)
+
+static void paintWorkload(QPainter *p, Workload workload, const QImage &source)
+{
+    const int w = p->device()->width();
+    const int h = p->device()->height();
+    switch (workload) {
+    case AntialiasedPaths:
+        p->setRenderHint(QPainter::Antialiasing);
+        p->setPen(QPen(QColor(0, 0, 0, 128), 2.5));
+        for (int i = 0; i < 200; ++i) {
+            QPainterPath path;
+            path.moveTo((i * 37) % w, (i * 53) % h);
+            path.cubicTo((i * 71) % w, (i * 13) % h, (i * 29) % w, (i * 97) % h,
+                         (i * 43) % w, (i * 61) % h);
+            path.closeSubpath();
+            p->setBrush(QColor::fromHsv((i * 11) % 360, 200, 220, 160));
+            p->drawPath(path);
+        }
+        break;
+    case SmoothImages:
+        p->setRenderHint(QPainter::SmoothPixmapTransform);
+        for (int i = 0; i < 20; ++i) {
+            p->resetTransform();
+            p->translate(w / 2, h / 2);
+            p->rotate(i * 17);
+            p->drawImage(QRectF(-w / 2.5, -h / 2.5, w / 1.25, h / 1.25), source);
+        }
+        break;
+    case Gradients:
+        for (int i = 0; i < 20; ++i) {
+            QRadialGradient gradient(w / 2, h / 2, w / 2, (i * 37) % w, (i * 53) % h);
+            gradient.setColorAt(0, QColor(255, 255, 255, 128));
+            gradient.setColorAt(1, QColor::fromHsv((i * 31) % 360, 255, 255, 128));
+            p->fillRect(0, 0, w, h, gradient);
+        }
+        break;
+    }
+}
+
+void tst_QTiledPaintDevice::paint_data()
+{
+    QTest::addColumn<Workload>("workload");
+    QTest::addColumn<bool>("tiled");
+
+    QTest::newRow("antialiased paths, direct") << AntialiasedPaths << false;
+    QTest::newRow("antialiased paths, tiled") << AntialiasedPaths << true;
+    QTest::newRow("smooth images, direct") << SmoothImages << false;
+    QTest::newRow("smooth images, tiled") << SmoothImages << true;
+    QTest::newRow("gradients, direct") << Gradients << false;
+    QTest::newRow("gradients, tiled") << Gradients << true;
+}
+
+void tst_QTiledPaintDevice::paint()
+{
+    QFETCH(Workload, workload);
+    QFETCH(bool, tiled);
+
+    QImage source(256, 256, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < source.height(); ++y) {
+        for (int x = 0; x < source.width(); ++x)
+            source.setPixel(x, y, qRgb(x, y, x ^ y));
+    }
+
+    QImage image(1920, 1080, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QTiledPaintDevice device(&image);
+
+    QBENCHMARK {
+        QPainter p;
+        if (tiled)
+            p.begin(&device);
+        else
+            p.begin(&image);
+        paintWorkload(&p, workload, source);
+        p.end();
+    }
+}
+
+QTEST_MAIN(tst_QTiledPaintDevice)
+
+#include "tst_qtiledpaintdevice.moc"
@@ -8,4 +8,5 @@ SUBDIRS = \
 qtConfig(private_tests): \
     SUBDIRS += \
         qdecompresshelper \
+        hpack \
 
@@ -0,0 +1,7 @@
+requires(qtConfig(private_tests))
+TEMPLATE = app
+TARGET = tst_bench_hpack
+QT = network-private testlib
+
+SOURCES += tst_bench_hpack.cpp
+CONFIG += release
@@ -77,6 +77,9 @@ private slots:
 
     void timeExpiration_data();
     void timeExpiration();
+
+    void timeCacheSize_data();
+    void timeCacheSize();
 };
 
 
@@ -323,6 +326,59 @@ void tst_qnetworkdiskcache::timeExpiration()
     cleanRecursive(cacheDir);
 
 }
+void tst_qnetworkdiskcache::timeCacheSize_data()
+{
+    QTest::addColumn<QString>("cacheRootDirectory");
+
+    QString cacheLoc = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QTest::newRow("QStandardPaths Cache Location") << cacheLoc;
+}
+
+//Times opening a populated cache directory and querying its size,
+//as an application does on start-up.
+void tst_qnetworkdiskcache::timeCacheSize()
+{
+
+    QFETCH(QString, cacheRootDirectory);
+
+    cacheDir = QString( cacheRootDirectory + QDir::separator() + "man_qndc");
+    QDir d;
+    qDebug() << "Setting cache directory to = " << d.absoluteFilePath(cacheDir);
+
+    //Housekeeping
+    initCacheObject();
+    cleanRecursive(cacheDir); // slow op.
+    cache->setCacheDirectory(cacheDir);
+    cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+    cache->clear();
+
+    //populate some fake data to simulate partially full cache
+    injectFakeData();
+    cleanupCacheObject();
+
+    //cacheSize() also counts the estimates made before each insertion,
+    //the reopened cache reports what ended up on disk
+    qint64 expectedSize = 0;
+    QDirIterator it(cacheDir, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        if (it.fileName() != QLatin1String("index"))
+            expectedSize += it.fileInfo().size();
+    }
+
+    QBENCHMARK_ONCE {
+        initCacheObject();
+        cache->setCacheDirectory(cacheDir);
+        cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+        QCOMPARE(cache->cacheSize(), expectedSize);
+    }
+
+    //Cleanup (slow)
+    cleanupCacheObject();
+    cleanRecursive(cacheDir);
+
+}
+
 // This function simulates a partially or fully occupied disk cache
 // like a normal user of a cache might encounter is real-life browsing.
 // The point of this is to trigger degradation in file-system and media performance
@@ -463,6 +463,7 @@ private slots:
     void uploadPerformance();
     void performanceControlRate();
     void httpUploadPerformance();
+    void httpFileUploadPerformance();
     void httpDownloadPerformance_data();
     void httpDownloadPerformance();
     void httpDownloadPerformanceDownloadBuffer_data();
@@ -670,6 +671,42 @@ void tst_qnetworkreply::httpUploadPerformance()
               << ((UploadSize/1024.0)/(elapsed/1000.0)) << " kB/sec";
 }
 
+// Same as httpUploadPerformance(), but uploading a file, which plain HTTP
+// connections can send without reading it into the process
+void tst_qnetworkreply::httpFileUploadPerformance()
+{
+      enum {UploadSize = 128*1024*1024}; // 128 MB
+
+      QTemporaryFile file;
+      QVERIFY(file.open());
+      const QByteArray block(1024*1024, '@');
+      for (int i = 0; i < UploadSize / block.size(); ++i)
+          QCOMPARE(file.write(block), qint64(block.size()));
+      QVERIFY(file.flush());
+      QVERIFY(file.seek(0));
+
+      ThreadedDataReaderHttpServer reader;
+
+      QNetworkRequest request(QUrl("http://127.0.0.1:" + QString::number(reader.serverPort()) + "/?bare=1"));
+      request.setHeader(QNetworkRequest::ContentLengthHeader,UploadSize);
+
+      QNetworkReplyPtr reply(manager.put(request, &file));
+
+      connect(reply, SIGNAL(finished()), &QTestEventLoop::instance(), SLOT(exitLoop()));
+
+      QElapsedTimer time;
+      time.start();
+      QTestEventLoop::instance().enterLoop(40);
+      qint64 elapsed = time.elapsed();
+      reader.exit();
+      reader.wait();
+      QVERIFY(reply->isFinished());
+      QCOMPARE(reply->error(), QNetworkReply::NoError);
+      QVERIFY(!QTestEventLoop::instance().timeout());
+
+      qDebug() << "tst_QNetworkReply::httpFileUploadPerformance" << elapsed << "msec, "
+              << ((UploadSize/1024.0)/(elapsed/1000.0)) << " kB/sec";
+}
 
 void tst_qnetworkreply::performanceControlRate()
 {
@@ -57,6 +57,7 @@ public slots:
     void cleanup();
 private slots:
     void ipv4LoopbackPerformanceTest();
+    void ipv4LoopbackFramedWritesTest();
     void ipv6LoopbackPerformanceTest();
     void ipv4PerformanceTest();
 };
@@ -161,6 +162,54 @@ void tst_QTcpServer::ipv4LoopbackPerformanceTest()
     delete clientB;
 }
 
+//----------------------------------------------------------------------------------
+void tst_QTcpServer::ipv4LoopbackFramedWritesTest()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QTcpSocket clientA;
+    clientA.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    QVERIFY(clientA.waitForConnected(5000));
+
+    QVERIFY(server.waitForNewConnection());
+    QTcpSocket *clientB = server.nextPendingConnection();
+    QVERIFY(clientB);
+
+    // frames written as a small header followed by the payload, the way
+    // the HTTP/2 protocol handler writes them
+    const QByteArray header(9, 'h');
+    const QByteArray payload(16384, 'p');
+    const int frameCount = 64;
+    const qint64 total = frameCount * (header.size() + payload.size());
+    QByteArray buffer(total, Qt::Uninitialized);
+
+    QBENCHMARK {
+        for (int i = 0; i < frameCount; ++i) {
+            clientA.write(header);
+            clientA.write(payload);
+        }
+        clientA.flush();
+
+        qint64 received = 0;
+        while (received < total) {
+            if (clientA.bytesToWrite())
+                clientA.waitForBytesWritten(10);
+            if (!clientB->bytesAvailable())
+                clientB->waitForReadyRead(10);
+            const qint64 bytesRead = clientB->read(buffer.data() + received, total - received);
+            QVERIFY(bytesRead >= 0);
+            received += bytesRead;
+        }
+    }
+
+    delete clientB;
+}
+
 //----------------------------------------------------------------------------------
 void tst_QTcpServer::ipv6LoopbackPerformanceTest()
 {
@@ -41,6 +41,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void loopbackThroughput_data();
+    void loopbackThroughput();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -76,5 +78,56 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::loopbackThroughput_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("size");
+    for (int value : {64, 512, 1200}) {
+        QTest::addRow("single-%d", value) << false << value;
+        QTest::addRow("batched-%d", value) << true << value;
+    }
+}
+
+void tst_QUdpSocket::loopbackThroughput()
+{
+    QFETCH(bool, batched);
+    QFETCH(int, size);
+    // few enough to fit into the default receive buffer
+    const int count = 64;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost, 0));
+
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < count; ++i)
+        datagrams.append(QNetworkDatagram(QByteArray(size, 'a'), receiver.localAddress(),
+                                          receiver.localPort()));
+
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(sender.writeDatagrams(datagrams), count);
+        } else {
+            for (const QNetworkDatagram &datagram : qAsConst(datagrams))
+                QCOMPARE(sender.writeDatagram(datagram), qint64(size));
+        }
+
+        int received = 0;
+        while (received < count) {
+            if (!receiver.hasPendingDatagrams())
+                QVERIFY(receiver.waitForReadyRead(5000));
+            if (batched) {
+                received += receiver.receiveDatagrams(count - received).size();
+            } else {
+                while (receiver.hasPendingDatagrams()) {
+                    receiver.receiveDatagram();
+                    ++received;
+                }
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
@@ -52,6 +52,14 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkRepeatedPrepare_data() { generic_data(); }
+    void benchmarkRepeatedPrepare();
+    void benchmarkExecBatch_data() { generic_data(); }
+    void benchmarkExecBatch();
+    void benchmarkScanValues_data() { generic_data(); }
+    void benchmarkScanValues();
+    void benchmarkScanBatch_data() { generic_data(); }
+    void benchmarkScanBatch();
 
 private:
     // returns all database connections
@@ -59,6 +67,7 @@ private:
     void dropTestTables( QSqlDatabase db );
     void createTestTables( QSqlDatabase db );
     void populateTestTables( QSqlDatabase db );
+    void createScanTable(QSqlDatabase db, const QString &tableName);
 
     tst_Databases dbs;
 };
@@ -293,4 +302,144 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     tst_Databases::safeDropTable(db, tableName);
 }
 
+void tst_QSqlQuery::benchmarkRepeatedPrepare()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(20))"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName + " VALUES (1, 'one')"));
+
+    const QString select = "SELECT name FROM " + tableName + " WHERE id = ?";
+    QBENCHMARK {
+        for (int i = 0; i < 100; ++i) {
+            // a new query every time, like a short-lived QSqlQuery in a loop
+            QSqlQuery q2(db);
+            QVERIFY_SQL(q2, prepare(select));
+            q2.addBindValue(1);
+            QVERIFY_SQL(q2, exec());
+            QVERIFY(q2.next());
+        }
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkExecBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(20))"));
+
+    const int NUM_ROWS = 1000;
+    QVariantList ids;
+    QVariantList names;
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        ids << i;
+        names << QString("Value" + QString::number(i));
+    }
+
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?)"));
+    QBENCHMARK {
+        q.addBindValue(ids);
+        q.addBindValue(names);
+        QVERIFY_SQL(q, execBatch());
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+static const int SCAN_ROWS = 100000;
+
+void tst_QSqlQuery::createScanTable(QSqlDatabase db, const QString &tableName)
+{
+    QSqlQuery q(db);
+    tst_Databases::safeDropTable(db, tableName);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName
+                        + "(id INT NOT NULL, amount REAL, name VARCHAR(20))"));
+
+    QVariantList ids;
+    QVariantList amounts;
+    QVariantList names;
+    for (int i = 0; i < SCAN_ROWS; ++i) {
+        ids << i;
+        amounts << i * 0.5;
+        names << QString("Name" + QString::number(i));
+    }
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    q.addBindValue(ids);
+    q.addBindValue(amounts);
+    q.addBindValue(names);
+    QVERIFY_SQL(q, execBatch());
+}
+
+void tst_QSqlQuery::benchmarkScanValues()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+    createScanTable(db, tableName);
+    if (QTest::currentTestFailed())
+        return;
+
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
+    QBENCHMARK {
+        QVERIFY_SQL(q, exec("SELECT id, amount, name FROM " + tableName));
+        qint64 sum = 0;
+        qsizetype length = 0;
+        while (q.next()) {
+            sum += q.value(0).toLongLong() + qint64(q.value(1).toDouble());
+            length += q.value(2).toString().size();
+        }
+        QVERIFY(sum > 0 && length > 0);
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkScanBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+    createScanTable(db, tableName);
+    if (QTest::currentTestFailed())
+        return;
+
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
+    QSqlColumnBatch batch;
+    QBENCHMARK {
+        QVERIFY_SQL(q, exec("SELECT id, amount, name FROM " + tableName));
+        qint64 sum = 0;
+        qsizetype length = 0;
+        while (q.nextBatch(&batch, 1000)) {
+            const QList<qint64> ids = batch.int64Column(0);
+            const QList<double> amounts = batch.doubleColumn(1);
+            const QList<QString> names = batch.stringColumn(2);
+            for (int row = 0; row < batch.rowCount(); ++row) {
+                sum += ids.at(row) + qint64(amounts.at(row));
+                length += names.at(row).size();
+            }
+        }
+        QVERIFY(sum > 0 && length > 0);
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 #include "main.moc"